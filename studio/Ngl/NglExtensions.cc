@@ -42,6 +42,7 @@
 #include "NglExtensions.h"
 
 #include <iostream>
+#include <cstring>
 
 namespace Ngl
 {
@@ -52,6 +53,11 @@ namespace Ngl
 ok &= bool((f = (_gl##f) context->getProcAddress(QLatin1String("gl" #f)))); \
 if(!ok) std::cerr << "ERROR BINDING gl " << #f << std::endl; }
 
+// Optional functions do not affect the result of resolve().
+
+#define RESOLVE_OPTIONAL_GL_FUNC(f) { \
+f = (_gl##f) context->getProcAddress(QLatin1String("gl" #f)); }
+
 bool
 GLExtensionFunctions::resolve(const QGLContext *context)
 {
@@ -144,10 +150,65 @@ GLExtensionFunctions::resolve(const QGLContext *context)
     RESOLVE_GL_FUNC(GetBufferParameteriv)
     RESOLVE_GL_FUNC(GetBufferSubData)
 
+    // Query Objects
+
+    RESOLVE_OPTIONAL_GL_FUNC(GenQueries)
+    RESOLVE_OPTIONAL_GL_FUNC(DeleteQueries)
+    RESOLVE_OPTIONAL_GL_FUNC(BeginQuery)
+    RESOLVE_OPTIONAL_GL_FUNC(EndQuery)
+    RESOLVE_OPTIONAL_GL_FUNC(GetQueryObjectuiv)
+
+    // Occlusion queries are core since OpenGL 1.5.
+
+    _occlusionQuery =
+        GenQueries && DeleteQueries && BeginQuery && EndQuery &&
+        GetQueryObjectuiv;
+
+    // Timer queries need either extension, core since OpenGL 3.3.
+
+    const char *ext(reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS)));
+    _timerQuery =
+        GenQueries && DeleteQueries && BeginQuery && EndQuery &&
+        GetQueryObjectuiv &&
+        0 != ext && (0 != std::strstr(ext, "GL_ARB_timer_query") ||
+                     0 != std::strstr(ext, "GL_EXT_timer_query"));
+
     // Vertex Arrays.
 
     RESOLVE_GL_FUNC(DrawRangeElements)
 
+    // Instancing, core since OpenGL 3.3. Fall back on the ARB entry points,
+    // the shaders read gl_InstanceIDARB so GL_ARB_draw_instanced is needed
+    // either way.
+
+    RESOLVE_OPTIONAL_GL_FUNC(DrawArraysInstanced)
+    RESOLVE_OPTIONAL_GL_FUNC(VertexAttribDivisor)
+    if (0 == DrawArraysInstanced) {
+        DrawArraysInstanced = (_glDrawArraysInstanced)
+            context->getProcAddress(QLatin1String("glDrawArraysInstancedARB"));
+    }
+    if (0 == VertexAttribDivisor) {
+        VertexAttribDivisor = (_glVertexAttribDivisor)
+            context->getProcAddress(QLatin1String("glVertexAttribDivisorARB"));
+    }
+    _instancing =
+        DrawArraysInstanced && VertexAttribDivisor &&
+        0 != ext && 0 != std::strstr(ext, "GL_ARB_draw_instanced");
+
+    // Program binaries, core since OpenGL 4.1. Drivers may support the
+    // extension but offer no binary formats, in which case nothing can be
+    // saved.
+
+    RESOLVE_OPTIONAL_GL_FUNC(GetProgramBinary)
+    RESOLVE_OPTIONAL_GL_FUNC(ProgramBinary)
+    RESOLVE_OPTIONAL_GL_FUNC(ProgramParameteri)
+    GLint binaryFormats(0);
+    if (GetProgramBinary && ProgramBinary && ProgramParameteri &&
+        0 != ext && 0 != std::strstr(ext, "GL_ARB_get_program_binary")) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    _programBinary = (0 < binaryFormats);
+
     // Vertex Array Objects
 
     //RESOLVE_GL_FUNC(GenVertexArrays)
@@ -251,6 +312,7 @@ bool GLExtensionFunctions::openGL15Supported() {
 }
 
 #undef RESOLVE_GL_FUNC
+#undef RESOLVE_OPTIONAL_GL_FUNC
 
 #endif
 
@@ -92,6 +92,21 @@ typedef ptrdiff_t GLsizeiptr;
 #define GL_STATIC_DRAW          0x88E4
 #endif
 
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT           0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+#endif
+
 #ifndef GL_EXT_framebuffer_object
 #define GL_RENDERBUFFER_EXT         0x8D41
 #define GL_FRAMEBUFFER_EXT          0x8D40
@@ -201,10 +216,30 @@ typedef GLboolean (APIENTRY *_glIsBuffer) (GLuint);
 typedef void      (APIENTRY *_glGetBufferParameteriv) (GLenum, GLenum, GLint *);
 typedef void      (APIENTRY *_glGetBufferSubData) (GLenum, GLintptr, GLsizeiptr, GLvoid*);
 
+// Query Objects. Optional, see occlusionQuerySupported() and
+// timerQuerySupported().
+
+typedef void (APIENTRY *_glGenQueries) (GLsizei, GLuint *);
+typedef void (APIENTRY *_glDeleteQueries) (GLsizei, const GLuint *);
+typedef void (APIENTRY *_glBeginQuery) (GLenum, GLuint);
+typedef void (APIENTRY *_glEndQuery) (GLenum);
+typedef void (APIENTRY *_glGetQueryObjectuiv) (GLuint, GLenum, GLuint *);
+
 // Vertex Arrays.
 
 typedef void (APIENTRY *_glDrawRangeElements)(GLenum, GLuint, GLuint, GLsizei, GLenum, GLvoid*);
 
+// Instancing. Optional, see instancingSupported().
+
+typedef void (APIENTRY *_glDrawArraysInstanced) (GLenum, GLint, GLsizei, GLsizei);
+typedef void (APIENTRY *_glVertexAttribDivisor) (GLuint, GLuint);
+
+// Program binaries. Optional, see programBinarySupported().
+
+typedef void (APIENTRY *_glGetProgramBinary) (GLuint, GLsizei, GLsizei *, GLenum *, GLvoid *);
+typedef void (APIENTRY *_glProgramBinary) (GLuint, GLenum, const GLvoid *, GLsizei);
+typedef void (APIENTRY *_glProgramParameteri) (GLuint, GLenum, GLint);
+
 // Vertex Array Objects
 
 //typedef void      (APIENTRY *_glGenVertexArrays) (GLsizei, GLuint *);
@@ -258,6 +293,22 @@ public:
     bool
     openGL15Supported(); // the rest: multi-texture, 3D-texture, VBOs
 
+    bool
+    occlusionQuerySupported() const
+    { return _occlusionQuery; }
+
+    bool
+    timerQuerySupported() const
+    { return _timerQuery; }
+
+    bool
+    instancingSupported() const
+    { return _instancing; }
+
+    bool
+    programBinarySupported() const
+    { return _programBinary; }
+
 public: // Member variables.
 
     //---------------------
@@ -347,6 +398,14 @@ public: // Member variables.
     _glGetBufferParameteriv GetBufferParameteriv;
     _glGetBufferSubData     GetBufferSubData;
 
+    // Query Objects
+
+    _glGenQueries        GenQueries;
+    _glDeleteQueries     DeleteQueries;
+    _glBeginQuery        BeginQuery;
+    _glEndQuery          EndQuery;
+    _glGetQueryObjectuiv GetQueryObjectuiv;
+
     // Vertex Array Objects
 
     //_glGenVertexArrays    GenVertexArrays;
@@ -360,6 +419,17 @@ public: // Member variables.
 
     _glDrawRangeElements    DrawRangeElements;
 
+    // Instancing
+
+    _glDrawArraysInstanced DrawArraysInstanced;
+    _glVertexAttribDivisor VertexAttribDivisor;
+
+    // Program Binaries
+
+    _glGetProgramBinary  GetProgramBinary;
+    _glProgramBinary     ProgramBinary;
+    _glProgramParameteri ProgramParameteri;
+
     // etc.
 
     _glGenFramebuffersEXT GenFramebuffersEXT;
@@ -380,6 +450,13 @@ public: // Member variables.
     _glActiveTexture ActiveTexture;
     _glDrawBuffers   DrawBuffers;
     _glTexImage3D TexImage3D;
+
+private:
+
+    bool _occlusionQuery;   //!< True if GL_SAMPLES_PASSED queries exist.
+    bool _timerQuery;       //!< True if GL_TIME_ELAPSED queries are available.
+    bool _instancing;       //!< True if instanced arrays are available.
+    bool _programBinary;    //!< True if program binaries can be saved/loaded.
 };
 
 inline GLExtensionFunctions&
@@ -476,10 +553,29 @@ getGLExtensionFunctions()
 #define glGetBufferParameteriv Ngl::getGLExtensionFunctions().GetBufferParameteriv
 #define glGetBufferSubData     Ngl::getGLExtensionFunctions().GetBufferSubData
 
+// Query Objects
+
+#define glGenQueries        Ngl::getGLExtensionFunctions().GenQueries
+#define glDeleteQueries     Ngl::getGLExtensionFunctions().DeleteQueries
+#define glBeginQuery        Ngl::getGLExtensionFunctions().BeginQuery
+#define glEndQuery          Ngl::getGLExtensionFunctions().EndQuery
+#define glGetQueryObjectuiv Ngl::getGLExtensionFunctions().GetQueryObjectuiv
+
 // Vertex Arrays.
 
 #define glDrawRangeElements    Ngl::getGLExtensionFunctions().DrawRangeElements
 
+// Instancing
+
+#define glDrawArraysInstanced Ngl::getGLExtensionFunctions().DrawArraysInstanced
+#define glVertexAttribDivisor Ngl::getGLExtensionFunctions().VertexAttribDivisor
+
+// Program Binaries
+
+#define glGetProgramBinary  Ngl::getGLExtensionFunctions().GetProgramBinary
+#define glProgramBinary     Ngl::getGLExtensionFunctions().ProgramBinary
+#define glProgramParameteri Ngl::getGLExtensionFunctions().ProgramParameteri
+
 // Vertex Array Objects
 
 //#define glGenVertexArrays    Ngl::getGLExtensionFunctions().GenVertexArrays
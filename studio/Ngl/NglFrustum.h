@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------
+//
+// NglFrustum.h
+//
+// View frustum for conservative culling of axis-aligned boxes.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -----------------------------------------------------------------------------
+
+#ifndef NGL_FRUSTUM_H
+#define NGL_FRUSTUM_H
+
+#include "NglTypes.h"
+
+namespace Ngl
+{
+// -----------------------------------------------------------------------------
+
+// Frustum
+// -------
+//! Six clip planes extracted from a combined projection-modelview matrix.
+//! Planes point inwards, i.e. a point x is inside a plane (n,d) if
+//! dot(n,x) + d >= 0. Tests against boxes are conservative: a box that is
+//! reported as outside is guaranteed not to be visible, but some boxes near
+//! the frustum corners may be reported as intersecting when they are not.
+
+class Frustum
+{
+public:
+
+    enum Result { Outside = 0, Intersecting, Inside };
+
+public:
+
+    //! Extract planes from P*MV. Matrices are column-major, as in OpenGL.
+    explicit
+    Frustum(const mat44f &pmv)
+    {
+        for (int i = 0; i < 3; ++i) {
+            _setPlane(2*i,     pmv, i,  1.f);   // Left, bottom, near.
+            _setPlane(2*i + 1, pmv, i, -1.f);   // Right, top, far.
+        }
+    }
+
+    // Default copy, assign & destruct
+
+    //! Classify an axis-aligned box against the frustum.
+    Result
+    classify(const vec3f &wmin, const vec3f &wmax) const
+    {
+        Result result(Inside);
+        for (int p = 0; p < 6; ++p) {
+            const vec4f &pl(_plane[p]);
+
+            // Box corners furthest along (pos) and against (neg) the normal.
+
+            const vec3f pos(pl[0] >= 0.f ? wmax[0] : wmin[0],
+                            pl[1] >= 0.f ? wmax[1] : wmin[1],
+                            pl[2] >= 0.f ? wmax[2] : wmin[2]);
+            if (_dist(pl, pos) < 0.f) {
+                return Outside;
+            }
+
+            const vec3f neg(pl[0] >= 0.f ? wmin[0] : wmax[0],
+                            pl[1] >= 0.f ? wmin[1] : wmax[1],
+                            pl[2] >= 0.f ? wmin[2] : wmax[2]);
+            if (_dist(pl, neg) < 0.f) {
+                result = Intersecting;
+            }
+        }
+        return result;
+    }
+
+    bool
+    intersects(const vec3f &wmin, const vec3f &wmax) const
+    { return Outside != classify(wmin, wmax); }
+
+private:    // Member variables
+
+    vec4f _plane[6];
+
+private:    // Utility functions
+
+    //! Plane = row(3) + sign*row(i).
+    void
+    _setPlane(const int p, const mat44f &m, const int i, const GLfloat sign)
+    {
+        for (int c = 0; c < 4; ++c) {
+            _plane[p][c] = m[c][3] + sign*m[c][i];
+        }
+    }
+
+    static GLfloat
+    _dist(const vec4f &pl, const vec3f &x)
+    { return pl[0]*x[0] + pl[1]*x[1] + pl[2]*x[2] + pl[3]; }
+};
+
+// -----------------------------------------------------------------------------
+}   // Namespace: Ngl.
+
+#endif  // NGL_FRUSTUM_H
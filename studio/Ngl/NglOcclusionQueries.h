@@ -0,0 +1,162 @@
+// -----------------------------------------------------------------------------
+//
+// NglOcclusionQueries.h
+//
+// Hardware occlusion queries read back without stalling.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -----------------------------------------------------------------------------
+
+#ifndef NGL_OCCLUSION_QUERIES_H
+#define NGL_OCCLUSION_QUERIES_H
+
+#include "NglExtensions.h"
+#include "NglNonCopyable.h"
+
+#include <vector>
+
+namespace Ngl
+{
+// -----------------------------------------------------------------------------
+
+// OcclusionQueries
+// ----------------
+//! A set of GL_SAMPLES_PASSED queries, e.g. one per super-tile. Results are
+//! only read once available, so a result describes an earlier frame. Until
+//! a query has produced a result its item is considered visible.
+//!
+//! Queries are deleted in the destructor, so the context they were created
+//! in must be current then.
+
+class OcclusionQueries : private NonCopyable
+{
+public:
+
+    OcclusionQueries()
+    {}
+
+    ~OcclusionQueries()
+    { clear(); }
+
+    //! Number of queries.
+    int
+    size() const
+    { return static_cast<int>(_queries.size()); }
+
+    //! Set the number of queries. Results are discarded if the number
+    //! changes.
+    void
+    resize(const int count)
+    {
+        if (count == size()) {
+            return;
+        }
+
+        clear();
+        _queries.resize(count);
+        for (int i = 0; i < count; ++i) {
+            glGenQueries(1, &_queries[i].id);
+        }
+    }
+
+    void
+    clear()
+    {
+        for (int i = 0; i < size(); ++i) {
+            glDeleteQueries(1, &_queries[i].id);
+        }
+        _queries.clear();
+    }
+
+    //! Returns true if the most recent result for item i passed no samples.
+    //! A pending query is polled, and its result used if it is available.
+    bool
+    occluded(const int i)
+    {
+        _Query &q(_queries[i]);
+        if (q.pending) {
+            GLuint available(GL_FALSE);
+            glGetQueryObjectuiv(q.id, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (GL_FALSE != available) {
+                GLuint samples(0);
+                glGetQueryObjectuiv(q.id, GL_QUERY_RESULT, &samples);
+                q.occluded = (0 == samples);
+                q.pending = false;
+            }
+        }
+        return q.occluded;
+    }
+
+    //! Start a query for item i, unless one is still pending for it. Returns
+    //! true if the query was started, in which case end() must be called.
+    bool
+    begin(const int i)
+    {
+        _Query &q(_queries[i]);
+        if (q.pending) {
+            return false;
+        }
+
+        glBeginQuery(GL_SAMPLES_PASSED, q.id);
+        q.pending = true;
+        return true;
+    }
+
+    void
+    end()
+    { glEndQuery(GL_SAMPLES_PASSED); }
+
+private:
+
+    struct _Query
+    {
+        _Query()
+            : id(0)
+            , pending(false)
+            , occluded(false)
+        {}
+
+        GLuint id;
+        bool   pending;     //!< Issued, result not yet read.
+        bool   occluded;    //!< Most recent result.
+    };
+
+private:    // Member variables
+
+    std::vector<_Query> _queries;
+};
+
+// -----------------------------------------------------------------------------
+}   // Namespace: Ngl.
+
+#endif  // NGL_OCCLUSION_QUERIES_H
@@ -0,0 +1,363 @@
+// -----------------------------------------------------------------------------
+//
+// NglProgramCache.cc
+//
+// Process-wide cache of linked shader programs.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "NglProgramCache.h"
+#include "NglShader.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QGLContext>
+
+#include <cstring>
+#include <vector>
+
+
+namespace Ngl
+{
+// -----------------------------------------------------------------------------
+
+// acquire
+// -------
+//! Returns a linked program for the given shaders in the current GL context,
+//! building it (or loading its binary from disk) if this is the first user.
+//! Must be matched by a call to release(). [static]
+
+GLuint
+ProgramCache::acquire(const NtString& vtxShaderPath,
+                      const NtString& fragShaderPath)
+{
+    const NtString vtxSrc(VtxShader::readSource(vtxShaderPath));   // May throw
+    const NtString fragSrc(FragShader::readSource(fragShaderPath)); // May throw
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(vtxSrc.c_str(), static_cast<int>(vtxSrc.size()));
+    hash.addData(fragSrc.c_str(), static_cast<int>(fragSrc.size()));
+    const NtString srcHash(hash.result().toHex().constData());
+
+    const _Key key(QGLContext::currentContext(), srcHash);
+    _EntryMap::iterator iter(_entries().find(key));
+    if (iter != _entries().end()) {
+        ++iter->second.refCount;
+        return iter->second.handle;     // Already linked in this context.
+    }
+
+    // The on-disk cache is only valid for the driver that wrote it.
+
+    NtString fileName;
+    GLuint handle(0);
+    const bool binary(!_binaryPath().empty() &&
+                      getGLExtensionFunctions().programBinarySupported());
+
+    if (binary) {
+        QCryptographicHash binaryHash(QCryptographicHash::Sha1);
+        binaryHash.addData(srcHash.c_str());
+
+        const GLubyte* driver[] = {
+            glGetString(GL_VENDOR),
+            glGetString(GL_RENDERER),
+            glGetString(GL_VERSION)
+        };
+        for (int d(0); d < 3; ++d) {
+            if (0 != driver[d]) {
+                binaryHash.addData(reinterpret_cast<const char*>(driver[d]));
+            }
+        }
+
+        fileName = NtString(_binaryPath().str() + "/" +
+                            binaryHash.result().toHex().constData() + ".bin");
+        handle = _loadBinary(fileName);
+    }
+
+    if (0 == handle) {
+        handle = _build(vtxShaderPath,
+                        vtxSrc,
+                        fragShaderPath,
+                        fragSrc,
+                        binary);
+
+        if (binary && _linked(handle)) {
+            _saveBinary(fileName, handle);
+        }
+    }
+
+    _Entry entry;
+    entry.handle = handle;
+    entry.refCount = 1;
+    entry.uploader = 0;
+    _entries().insert(_EntryMap::value_type(key, entry));
+
+    return handle;
+}
+
+
+// release
+// -------
+//! Drop a reference to a program returned by acquire() in the current GL
+//! context. Handles are only unique within a context (or share group), so
+//! the program is looked up by context too. The program is deleted with
+//! its last reference. [static]
+
+void
+ProgramCache::release(const GLuint handle)
+{
+    const void* context(QGLContext::currentContext());
+    _EntryMap::iterator iter(_entries().begin());
+    for (; iter != _entries().end(); ++iter) {
+        if (context == iter->first.first && handle == iter->second.handle) {
+            if (0 == --iter->second.refCount) {
+                glDeleteProgram(handle);
+                _entries().erase(iter);
+            }
+            return;
+        }
+    }
+}
+
+
+// uploaderSlot
+// ------------
+//! Returns the slot recording which user last uploaded uniform values to a
+//! program returned by acquire(). Users sharing a program must re-upload
+//! all their uniforms when the slot holds someone else. The slot stays
+//! valid until the program is deleted. [static]
+
+const void**
+ProgramCache::uploaderSlot(const GLuint handle)
+{
+    const void* context(QGLContext::currentContext());
+    _EntryMap::iterator iter(_entries().begin());
+    for (; iter != _entries().end(); ++iter) {
+        if (context == iter->first.first && handle == iter->second.handle) {
+            return &iter->second.uploader;
+        }
+    }
+
+    NB_THROW("Unknown shader program: [" << handle << "]");
+}
+
+
+// setBinaryPath
+// -------------
+//! Set the directory where program binaries are stored. An empty path
+//! disables the on-disk cache. [static]
+
+void
+ProgramCache::setBinaryPath(const NtString& path)
+{
+    _binaryPath() = path;
+}
+
+
+// binaryPath
+// ----------
+//! Returns the directory where program binaries are stored. [static]
+
+const NtString&
+ProgramCache::binaryPath()
+{
+    return _binaryPath();
+}
+
+
+// _entries
+// --------
+//! Programs currently in use. [static]
+
+ProgramCache::_EntryMap&
+ProgramCache::_entries()
+{
+    static _EntryMap entries;
+    return entries;
+}
+
+
+// _binaryPath
+// -----------
+//! [static]
+
+NtString&
+ProgramCache::_binaryPath()
+{
+    static NtString path;
+    return path;
+}
+
+
+// _build
+// ------
+//! Compile and link a program from source. [static]
+
+GLuint
+ProgramCache::_build(const NtString& vtxShaderPath,
+                     const NtString& vtxSrc,
+                     const NtString& fragShaderPath,
+                     const NtString& fragSrc,
+                     const bool      retrievable)
+{
+    const GLuint handle(glCreateProgram());
+    if (0 == handle) {
+        NB_THROW("Invalid Shader Program handle: " << handle);
+    }
+
+    try {
+        // The shader objects are only needed until the program is linked.
+
+        const VtxShader  vtxShader(vtxShaderPath, vtxSrc);      // May throw
+        const FragShader fragShader(fragShaderPath, fragSrc);   // May throw
+
+        glAttachShader(handle, vtxShader.handle());
+        glAttachShader(handle, fragShader.handle());
+
+        if (retrievable) {
+            glProgramParameteri(
+                handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        glLinkProgram(handle);
+
+        glDetachShader(handle, vtxShader.handle());
+        glDetachShader(handle, fragShader.handle());
+    }
+    catch (...) {
+        glDeleteProgram(handle);    // Don't leak the program.
+        throw;
+    }
+
+    return handle;
+}
+
+
+// _loadBinary
+// -----------
+//! Returns a program created from a stored binary, or zero if there is no
+//! binary or the driver rejects it. [static]
+
+GLuint
+ProgramCache::_loadBinary(const NtString& fileName)
+{
+    QFile file(fileName.c_str());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;   // Not cached yet.
+    }
+
+    const QByteArray data(file.readAll());
+    GLenum format(0);
+    if (data.size() <= static_cast<int>(sizeof(format))) {
+        return 0;
+    }
+    std::memcpy(&format, data.constData(), sizeof(format));
+
+    const GLuint handle(glCreateProgram());
+    if (0 == handle) {
+        return 0;
+    }
+
+    glProgramBinary(handle,
+                    format,
+                    data.constData() + sizeof(format),
+                    data.size() - static_cast<int>(sizeof(format)));
+
+    if (!_linked(handle)) {
+        // Stale binary, e.g. after a driver update. Rebuild from source.
+
+        glDeleteProgram(handle);
+        file.remove();
+        return 0;
+    }
+
+    return handle;
+}
+
+
+// _saveBinary
+// -----------
+//! Store the binary of a linked program. Failures are not fatal, the
+//! program is simply built from source again next time. [static]
+
+void
+ProgramCache::_saveBinary(const NtString& fileName, const GLuint handle)
+{
+    GLint length(0);
+    glGetProgramiv(handle, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (0 >= length) {
+        return;
+    }
+
+    std::vector<char> data(sizeof(GLenum) + length);
+    GLenum format(0);
+    GLsizei written(0);
+    glGetProgramBinary(handle,
+                       length,
+                       &written,
+                       &format,
+                       &data[sizeof(GLenum)]);
+    if (0 >= written) {
+        return;
+    }
+    std::memcpy(&data[0], &format, sizeof(format));
+
+    if (!QDir().mkpath(_binaryPath().c_str())) {
+        NB_WARNING("Cannot create program binary cache: '"
+                   << _binaryPath() << "'");
+        return;
+    }
+
+    QFile file(fileName.c_str());
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(&data[0], sizeof(GLenum) + written);
+    }
+}
+
+
+// _linked
+// -------
+//! [static]
+
+bool
+ProgramCache::_linked(const GLuint handle)
+{
+    GLint status(GL_FALSE);
+    glGetProgramiv(handle, GL_LINK_STATUS, &status);
+    return (GL_TRUE == status);
+}
+
+// -----------------------------------------------------------------------------
+}   // Namespace: Ngl.
@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------
+//
+// NglProgramCache.h
+//
+// Process-wide cache of linked shader programs.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NGL_PROGRAM_CACHE_H
+#define NGL_PROGRAM_CACHE_H
+
+#include "NglNonConstructible.h"
+#include "NglExtensions.h"
+
+#include <Ni.h>
+
+#include <map>
+#include <utility>
+
+
+namespace Ngl
+{
+// -----------------------------------------------------------------------------
+
+// ProgramCache
+// ------------
+//! Linked shader programs shared between all ShaderProgram instances built
+//! from the same sources in the same GL context, so that each program is
+//! compiled and linked once per process. Programs are reference counted and
+//! deleted when the last user releases them.
+//!
+//! If a binary path is set and the driver supports program binaries, linked
+//! programs are also stored on disk, keyed by their sources and the GL
+//! driver, so that later sessions skip compiling and linking altogether.
+
+class ProgramCache : private NonConstructible
+{
+public:     // Interface
+
+    static GLuint acquire(const NtString& vtxShaderPath,
+                          const NtString& fragShaderPath);
+
+    static void release(GLuint handle);
+
+    static const void** uploaderSlot(GLuint handle);
+
+    static void            setBinaryPath(const NtString& path);
+    static const NtString& binaryPath();
+
+private:
+
+    struct _Entry
+    {
+        GLuint      handle;
+        int         refCount;
+        const void* uploader;   //!< Last user to upload uniform values.
+    };
+
+    // Key: <GL context, hash of shader sources>.
+
+    typedef std::pair<const void*, NtString> _Key;
+    typedef std::map<_Key, _Entry>           _EntryMap;
+
+    static _EntryMap& _entries();
+    static NtString&  _binaryPath();
+
+private:    // Utility functions.
+
+    static GLuint _build(const NtString& vtxShaderPath,
+                         const NtString& vtxSrc,
+                         const NtString& fragShaderPath,
+                         const NtString& fragSrc,
+                         bool            retrievable);
+
+    static GLuint _loadBinary(const NtString& fileName);
+    static void   _saveBinary(const NtString& fileName, GLuint handle);
+    static bool   _linked(GLuint handle);
+};
+
+// -----------------------------------------------------------------------------
+}   // Namespace: Ngl.
+
+#endif  // NGL_PROGRAM_CACHE_H
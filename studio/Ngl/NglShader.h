@@ -69,50 +69,16 @@ public:     // Interface
     explicit
     Shader(const NtString& fname)
         : _handle(glCreateShader(T))
-    {                
-        if (0 == _handle) {
-            NB_THROW("Invalid Shader handle: '" << fname << "':" << _handle);
-        }
-
-        // Valid handle, read shader source from file
-
-        NtString src;
-        read(fname, &src);
-
-        if (src.empty()) {
-            NB_THROW(
-                "Empty Shader Source: '" << fname << "' [" << _handle << "]"
-                );
-        }
-
-        // Non-empty shader source
-
-        const GLchar* src0 = &src[0];
-        glShaderSource(_handle, 1, &src0, 0);
-
-        // Compile shader
-
-        glCompileShader(_handle);
-
-        NtString info;
-        if (0 < infoLog(&info) ) {
-            // Display log contents, if any. A non-empty log is not
-            // a critical error and should be a warning.
-
-            NB_WARNING(
-                "Shader Info Log: '" << fname
-                    << "' [" << _handle << "]: " << info
-                    );
-        }
-
-        if (!compiled()) {
-            // Compilation failed. Ideally we would throw when this
-            // happens, but it is left as a warning for now.
+    {
+        _compile(fname, readSource(fname));
+    };
 
-            NB_WARNING(
-                "Error Compiling Shader: '" << fname << "' [" << _handle << "]"
-                );
-        }
+    //! Compile the given source. The file name is only used in messages.
+    explicit
+    Shader(const NtString& fname, const NtString& src)
+        : _handle(glCreateShader(T))
+    {
+        _compile(fname, src);
     };
 
     ~Shader()
@@ -157,28 +123,69 @@ public:     // Interface
     }
 
 
-private:
-
-    static
-    void
-    read(const NtString& fname, NtString* src)
+    //! Returns the null-terminated contents of a shader file.
+    static NtString
+    readSource(const NtString& fname)
     {
-        if (0 == src) {
-            return;
-        }
-
         FILE *fptr(std::fopen(fname.c_str(), "r"));
         if(!fptr) {
             NB_THROW("Shader file '" << fname << "' does not exist");
         }
 
+        NtString src;
         std::fseek(fptr, 0, SEEK_END);
         const int length(std::ftell(fptr));
-        src->resize(length + 1);
+        src.resize(length + 1);
         std::fseek(fptr, 0, SEEK_SET);
-        std::fread(&(*src)[0], length, 1, fptr);
+        std::fread(&src[0], length, 1, fptr);
         std::fclose(fptr);
-        (*src)[length] = 0;     // Null-termination
+        src[length] = 0;     // Null-termination
+        return src;
+    }
+
+private:
+
+    void
+    _compile(const NtString& fname, const NtString& src)
+    {
+        if (0 == _handle) {
+            NB_THROW("Invalid Shader handle: '" << fname << "':" << _handle);
+        }
+
+        if (src.empty()) {
+            NB_THROW(
+                "Empty Shader Source: '" << fname << "' [" << _handle << "]"
+                );
+        }
+
+        // Non-empty shader source
+
+        const GLchar* src0 = &src[0];
+        glShaderSource(_handle, 1, &src0, 0);
+
+        // Compile shader
+
+        glCompileShader(_handle);
+
+        NtString info;
+        if (0 < infoLog(&info) ) {
+            // Display log contents, if any. A non-empty log is not
+            // a critical error and should be a warning.
+
+            NB_WARNING(
+                "Shader Info Log: '" << fname
+                    << "' [" << _handle << "]: " << info
+                    );
+        }
+
+        if (!compiled()) {
+            // Compilation failed. Ideally we would throw when this
+            // happens, but it is left as a warning for now.
+
+            NB_WARNING(
+                "Error Compiling Shader: '" << fname << "' [" << _handle << "]"
+                );
+        }
     }
 
 private:    // Member variables.
@@ -46,21 +46,28 @@ namespace Ngl
 
 // ShaderProgram
 // -------------
-//! Constructor.
+//! Constructor. The linked program is shared with other instances built
+//! from the same sources, see ProgramCache.
 
 ShaderProgram::ShaderProgram(const NtString& vtxShaderPath,
                              const NtString& fragShaderPath)
-    : _handle(glCreateProgram()),
-      _vtxShader(vtxShaderPath),    // May throw
-      _fragShader(fragShaderPath)   // May throw
+    : _handle(ProgramCache::acquire(vtxShaderPath, fragShaderPath)),
+      _uploader(0)
 {
-    if (0 == _handle) {
-        NB_THROW("Invalid Shader Program handle: " << _handle);
+    try {
+        _uploader = ProgramCache::uploaderSlot(_handle);
+        _queryInterface();
     }
+    catch (...) {
+        // The destructor does not run, so free the uniforms created so far
+        // and drop the cache reference here.
 
-    glAttachShader(_handle, _vtxShader.handle());
-    glAttachShader(_handle, _fragShader.handle());
-    _link();
+        for (std::size_t u = 0; u < _uniforms.size(); ++u) {
+            delete _uniforms[u];
+        }
+        ProgramCache::release(_handle);
+        throw;
+    }
 }
 
 
@@ -73,35 +80,14 @@ ShaderProgram::~ShaderProgram()
     UniformMap::const_iterator iter(_uniformMap.begin());
     for(; iter!=_uniformMap.end(); iter++)
         delete iter->second;
-    
-    glDetachShader(_handle, _vtxShader.handle());
-    glDetachShader(_handle, _fragShader.handle());
-
-    // Free handle resource.
-
-    glDeleteProgram(_handle);
-}
-
-
-// vtxShader
-// ---------
-//! Return vertex shader.
-
-const VtxShader&
-ShaderProgram::vtxShader() const
-{
-    return _vtxShader;
-}
 
+    if (this == *_uploader) {
+        *_uploader = 0;
+    }
 
-// fragShader
-// ----------
-//! Return fragment shader.
+    // Free handle resource.
 
-const FragShader&
-ShaderProgram::fragShader() const
-{
-    return _fragShader;
+    ProgramCache::release(_handle);
 }
 
 
@@ -197,14 +183,32 @@ ShaderProgram::use() const
 
 // uploadUniforms
 // --------------
-//! Upload all uniform variables to the shader
+//! Upload all uniform variables to the shader. Only values that changed
+//! since the last upload are sent to GL.
 
 void
 ShaderProgram::uploadUniforms(const Nb::TimeBundle& tb) const
 {
-    UniformMap::const_iterator iter(_uniformMap.begin());
-    for(; iter != _uniformMap.end(); ++iter)
-        iter->second->upload(tb);
+    _claimUniforms();
+
+    _UniformList::const_iterator iter(_uniforms.begin());
+    for(; iter != _uniforms.end(); ++iter)
+        (*iter)->upload(tb);
+}
+
+
+// uploadUniform
+// -------------
+//! Upload a single uniform variable, given by handle, to the shader. The
+//! value is only sent if it changed since the last upload.
+
+void
+ShaderProgram::uploadUniform(const int handle, const Nb::TimeBundle& tb) const
+{
+    if (0 <= handle && handle < static_cast<int>(_uniforms.size())) {
+        _claimUniforms();
+        _uniforms[handle]->upload(tb);
+    }
 }
 
 
@@ -271,15 +275,52 @@ ShaderProgram::queryMutableUniformBase(const NtString& name)
 }
 
 
-// _link
-// ----
-//! Link the shader program.
+// uniformHandle
+// -------------
+//! Returns the handle of a uniform, or -1 if the shader has no such uniform.
+//! Handles stay valid for the lifetime of the shader program.
+
+int
+ShaderProgram::uniformHandle(const NtString& name) const
+{
+    for (int u(0); u < static_cast<int>(_uniforms.size()); ++u) {
+        if (name == _uniforms[u]->name()) {
+            return u;
+        }
+    }
+
+    return -1;  // Not found.
+}
+
+
+// _claimUniforms
+// --------------
+//! The GL program is shared with other instances, see ProgramCache, and
+//! holds whatever values the last of them uploaded. If that was not us,
+//! forget what we uploaded so that all our values are sent again.
 
 void
-ShaderProgram::_link()
+ShaderProgram::_claimUniforms() const
 {
-    glLinkProgram(_handle);
+    if (this != *_uploader) {
+        _UniformList::const_iterator iter(_uniforms.begin());
+        for(; iter != _uniforms.end(); ++iter)
+            (*iter)->invalidate();
+        *_uploader = this;
+    }
+}
+
+
+// _queryInterface
+// ---------------
+//! Check the link status and retrieve the attributes and uniforms of the
+//! shader program. Uniform values are kept per instance and uploaded by
+//! uploadUniforms(), so sharing the program between instances is safe.
+//! Uniform handles are indices into the list of active uniforms.
 
+void
+ShaderProgram::_queryInterface()
+{
     NtString info;
     if (0 < infoLog(&info) ) {
         // Display log contents, if any. A non-empty log is not
@@ -355,6 +396,7 @@ ShaderProgram::_link()
                    &activeUniformMaxLength);
 
     _uniformMap.clear();
+    _uniforms.clear();
 
     for(GLint u = 0; u < activeUniforms; ++u) {
         // Get uniform information.
@@ -418,6 +460,7 @@ ShaderProgram::_link()
         }
         
         _uniformMap.insert(UniformMap::value_type(name, uniform));
+        _uniforms.push_back(uniform);
     }
 }
 
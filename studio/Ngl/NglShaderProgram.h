@@ -41,7 +41,7 @@
 #define NGL_SHADER_PROGRAM_H
 
 #include "NglNonCopyable.h"
-#include "NglShader.h"
+#include "NglProgramCache.h"
 #include "NglShaderAttrib.h"
 #include "NglShaderUniform.h"
 
@@ -50,7 +50,9 @@
 
 #include <em_array1.h>
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 
 namespace Ngl
@@ -73,9 +75,6 @@ public:     // Interface
     ~ShaderProgram();
 
 
-    const VtxShader&  vtxShader()  const;
-    const FragShader& fragShader() const;
-
     const AttribMap&  attribMap()  const;
     const UniformMap& uniformMap() const;
 
@@ -89,6 +88,7 @@ public:     // Interface
     void unuse() const;
 
     void uploadUniforms(const Nb::TimeBundle& tb) const;
+    void uploadUniform(int handle, const Nb::TimeBundle& tb) const;
     
     // Attributes
 
@@ -99,6 +99,12 @@ public:     // Interface
 
     ShaderUniformBase* queryMutableUniformBase(const NtString& name);
 
+    // Integer handle for a uniform, resolved once at link time, or -1 if
+    // the shader has no such uniform. Storing through a handle skips the
+    // name lookup, and is what per-draw loops should use.
+
+    int uniformHandle(const NtString& name) const;
+
     // Bind uniforms to external Nb::Values, where the evaluation is delayed
     // until the upload occurs
     
@@ -185,20 +191,66 @@ public:     // Interface
     storeUniform4m(const NtString& name, const float* values)
     { _storeUniform<float,16>(name,values); }
 
+    // As above, for uniforms given by handle. Invalid handles are ignored.
+
+    void
+    storeUniform1f(const int handle, const float value)
+    { _storeUniform<float,1>(handle,value); }
+
+    void
+    storeUniform3f(const int handle, const NtVec3f& value)
+    { _storeUniform<float,3>(handle,&value[0]); }
+
+    void
+    storeUniform3f(const int handle, const float* values)
+    { _storeUniform<float,3>(handle,values); }
+
+    void
+    storeUniform4f(const int handle, const float* values)
+    { _storeUniform<float,4>(handle,values); }
+
+    void
+    storeUniform1i(const int handle, const int value)
+    { _storeUniform<int,1>(handle,value); }
+
+    void
+    storeUniform3i(const int handle, const int* values)
+    { _storeUniform<int,3>(handle,values); }
+
+    void
+    storeUniform4m(const int handle, const float* values)
+    { _storeUniform<float,16>(handle,values); }
+
 private:        // Member variables.
 
-    GLuint     _handle;
-    VtxShader  _vtxShader;
-    FragShader _fragShader;
-    AttribMap  _attribMap;
-    UniformMap _uniformMap;    
+    typedef std::vector<ShaderUniformBase*> _UniformList;
+
+    GLuint       _handle;
+    const void** _uploader;     //!< Last instance to upload to _handle.
+    AttribMap    _attribMap;
+    UniformMap   _uniformMap;    
+    _UniformList _uniforms;     //!< Uniforms by handle.
 
 private:        // Utility functions.
 
     template<typename T, unsigned int N, unsigned int VN> ShaderUniform<T,N,VN>*
     _typed_uniform_ptr(const NtString& name)
     {
-        ShaderUniformBase* sub=queryMutableUniformBase(name);
+        return _typed_uniform_ptr<T,N,VN>(queryMutableUniformBase(name), name);
+    }
+
+    template<typename T, unsigned int N, unsigned int VN> ShaderUniform<T,N,VN>*
+    _typed_uniform_ptr(const int handle)
+    {
+        if(handle < 0 || static_cast<int>(_uniforms.size()) <= handle)
+            return 0;
+        ShaderUniformBase* sub=_uniforms[handle];
+        return _typed_uniform_ptr<T,N,VN>(sub, sub->name());
+    }
+
+    template<typename T, unsigned int N, unsigned int VN> ShaderUniform<T,N,VN>*
+    _typed_uniform_ptr(ShaderUniformBase* sub, const NtString& name)
+    {
         if(!sub) return 0;
         ShaderUniform<T,N,VN>* ptr=dynamic_cast<ShaderUniform<T,N,VN>*>(sub);
         // auto-create ShaderUniform in case we have fed it a value of another
@@ -213,6 +265,7 @@ private:        // Utility functions.
                     ptr2->location()
                     );
                 _uniformMap.erase(ptr2->name());
+                *std::find(_uniforms.begin(), _uniforms.end(), ptr2) = ptr;
                 delete ptr2;
                 _uniformMap.insert(UniformMap::value_type(ptr->name(),ptr));
             }
@@ -243,8 +296,23 @@ private:        // Utility functions.
         ShaderUniform<T,N,N>* su=_typed_uniform_ptr<T,N,N>(name);
         if(su) su->store(value);
     }
+
+    template<typename T, unsigned int N> void
+    _storeUniform(const int handle, const T* value)
+    { 
+        ShaderUniform<T,N,N>* su=_typed_uniform_ptr<T,N,N>(handle);
+        if(su) su->store(value);
+    }
+
+    template<typename T, unsigned int N> void
+    _storeUniform(const int handle, const T value)
+    { 
+        ShaderUniform<T,N,N>* su=_typed_uniform_ptr<T,N,N>(handle);
+        if(su) su->store(value);
+    }
     
-    void _link();
+    void _queryInterface();
+    void _claimUniforms() const;
 
 private:        // Disabled.
 
@@ -46,6 +46,8 @@
 
 #include <NbValue.h>
 
+#include <algorithm>
+
 namespace Ngl
 {
 // -----------------------------------------------------------------------------
@@ -81,6 +83,11 @@ namespace Ngl
 //            glUniform1i and
 //            glUniform1iv.
 
+//! The last value uploaded is kept in a shadow copy and upload() only calls
+//! glUniform* when the current value differs from it. Program objects
+//! remember their uniform values, so unchanged uniforms need not be resent
+//! on every draw.
+
 template<typename T, unsigned int N, unsigned int VN>
 class ShaderUniform : public ShaderUniformBase
 {
@@ -91,10 +98,13 @@ public:     // Interface
                   GLint             size, 
                   GLint             location)
         : ShaderUniformBase(name, type, size, location),
-          _value(0)
+          _value(0),
+          _uploadedValid(false)
     {
-        for(unsigned int i(0); i < N; ++i)
+        for(unsigned int i(0); i < N; ++i) {
             _constant[i] = 0;
+            _uploaded[i] = 0;
+        }
     }
 
     // Store a copy of a constant value in this uniform.
@@ -126,15 +136,41 @@ public:     // Interface
     }
 
     // Upload constant value to shader, or evaluated value at given time
-    // and upload that to shader.
+    // and upload that to shader. Nothing is sent if the value is the same
+    // as the one last uploaded.
 
     virtual void
-    upload(const Nb::TimeBundle& tb);
+    upload(const Nb::TimeBundle& tb)
+    {
+        T current[N];
+        _current(tb, current);
+
+        if (_uploadedValid && std::equal(current, current + N, _uploaded))
+            return;
+
+        EM_ASSERT(Error::check());
+        _glUpload(current);
+        EM_ASSERT(Error::check());
+
+        std::copy(current, current + N, _uploaded);
+        _uploadedValid = true;
+    }
+
+    virtual void
+    invalidate()
+    { _uploadedValid = false; }
+
+private:    // Utility functions.
+
+    void _current(const Nb::TimeBundle& tb, T* current) const;
+    void _glUpload(const T* values) const;
 
 private:    // Member variables.
 
     Nb::Value<T,VN>* _value;
     T                _constant[N];
+    T                _uploaded[N];      //!< Last value sent to GL.
+    bool             _uploadedValid;
 
 private:    // Disabled.
 
@@ -143,167 +179,96 @@ private:    // Disabled.
 
 // -----------------------------------------------------------------------------
 
-template<> inline void
-ShaderUniform<float,1,1>::upload(const Nb::TimeBundle& tb)
+//! Value to upload, evaluated at the given time if bound. Components missing
+//! from a bound value are set to one.
+
+template<typename T, unsigned int N, unsigned int VN> inline void
+ShaderUniform<T,N,VN>::_current(const Nb::TimeBundle& tb, T* current) const
 {
-    EM_ASSERT(Error::check());
     if(_value) {
-        glUniform1f(
-            location(),
-            _value->eval(tb)
-            );
+        for(unsigned int i(0); i < VN; ++i)
+            current[i] = _value->eval(tb,i);
+        for(unsigned int i(VN); i < N; ++i)
+            current[i] = 1;
     } else {
-        glUniform1f(location(), _constant[0]);
+        for(unsigned int i(0); i < N; ++i)
+            current[i] = _constant[i];
     }
-    EM_ASSERT(Error::check());
 }
 
-// -----------------------------------------------------------------------------
-
 template<> inline void
-ShaderUniform<float,3,3>::upload(const Nb::TimeBundle& tb)
+ShaderUniform<float,1,1>::_current(const Nb::TimeBundle& tb,
+                                   float*                current) const
 {
-    EM_ASSERT(Error::check());
-    if(_value) {
-        glUniform3f(
-            location(), 
-            _value->eval(tb,0),
-            _value->eval(tb,1),
-            _value->eval(tb,2)
-            );
-    } else {
-        glUniform3f(
-            location(), 
-            _constant[0],
-            _constant[1],
-            _constant[2]
-            );            
-    }
-    EM_ASSERT(Error::check());
+    current[0] = (_value ? _value->eval(tb) : _constant[0]);
 }
 
-// -----------------------------------------------------------------------------
-
 template<> inline void
-ShaderUniform<float,4,4>::upload(const Nb::TimeBundle& tb)
+ShaderUniform<int,1,1>::_current(const Nb::TimeBundle& tb,
+                                 int*                  current) const
 {
-    EM_ASSERT(Error::check());
-    if(_value) {
-        glUniform4f(
-            location(), 
-            _value->eval(tb,0),
-            _value->eval(tb,1),
-            _value->eval(tb,2),
-            _value->eval(tb,3)
-            );
-    } else {
-        glUniform4fv(location(), 1, _constant);
-    }
-    EM_ASSERT(Error::check());
+    current[0] = (_value ? _value->eval(tb) : _constant[0]);
 }
 
-// -----------------------------------------------------------------------------
-
 template<> inline void
-ShaderUniform<float,4,3>::upload(const Nb::TimeBundle& tb)
+ShaderUniform<float,9,9>::_current(const Nb::TimeBundle& tb,
+                                   float*                current) const
 {
-    EM_ASSERT(Error::check());
-    if(_value) {
-        glUniform4f(
-            location(), 
-            _value->eval(tb,0),
-            _value->eval(tb,1),
-            _value->eval(tb,2),
-            1
-            );
-    } else {
-        glUniform4fv(location(), 1, _constant);
-    }
-    EM_ASSERT(Error::check());
+    if(_value)
+        NB_THROW("Value9f not supported!");
+    std::copy(_constant, _constant + 9, current);
 }
 
-// -----------------------------------------------------------------------------
-
 template<> inline void
-ShaderUniform<int,1,1>::upload(const Nb::TimeBundle& tb)
+ShaderUniform<float,16,16>::_current(const Nb::TimeBundle& tb,
+                                     float*                current) const
 {
-    EM_ASSERT(Error::check());
-    if(_value) {
-        glUniform1i(
-            location(),
-            _value->eval(tb)
-            );
-    } else {
-        glUniform1i(location(), _constant[0]);        
-    }
-    EM_ASSERT(Error::check());
+    if(_value)
+        NB_THROW("Value16f not supported!");
+    std::copy(_constant, _constant + 16, current);
 }
 
 // -----------------------------------------------------------------------------
 
 template<> inline void
-ShaderUniform<int,3,3>::upload(const Nb::TimeBundle& tb)
-{
-    EM_ASSERT(Error::check());
-    if(_value)
-        glUniform3i(
-            location(), 
-            _value->eval(tb,0),
-            _value->eval(tb,1),
-            _value->eval(tb,2)
-            );
-    else
-        glUniform3i(
-            location(), 
-            _constant[0],
-            _constant[1],
-            _constant[2]
-            );
-    EM_ASSERT(Error::check());
-}
+ShaderUniform<float,1,1>::_glUpload(const float* values) const
+{ glUniform1f(location(), values[0]); }
 
-// -----------------------------------------------------------------------------
+template<> inline void
+ShaderUniform<float,3,3>::_glUpload(const float* values) const
+{ glUniform3f(location(), values[0], values[1], values[2]); }
 
 template<> inline void
-ShaderUniform<int,4,4>::upload(const Nb::TimeBundle& tb)
-{
-    EM_ASSERT(Error::check());
-    if(_value)
-        glUniform4i(
-            location(), 
-            _value->eval(tb,0),
-            _value->eval(tb,1),
-            _value->eval(tb,2),
-            _value->eval(tb,3)
-            );
-    else
-        glUniform4iv(location(), 1, _constant);
-    EM_ASSERT(Error::check());
-}
+ShaderUniform<float,4,4>::_glUpload(const float* values) const
+{ glUniform4fv(location(), 1, values); }
 
-// -----------------------------------------------------------------------------
+template<> inline void
+ShaderUniform<float,4,3>::_glUpload(const float* values) const
+{ glUniform4fv(location(), 1, values); }
 
 template<> inline void
-ShaderUniform<float,9,9>::upload(const Nb::TimeBundle& tb)
-{
-    EM_ASSERT(Error::check());
-    if(_value)
-        NB_THROW("Value9f not supported!");
-    glUniformMatrix3fv(location(), 1, transpose(), _constant);
-    EM_ASSERT(Error::check());
-}
+ShaderUniform<int,1,1>::_glUpload(const int* values) const
+{ glUniform1i(location(), values[0]); }
 
-// -----------------------------------------------------------------------------
+template<> inline void
+ShaderUniform<int,3,3>::_glUpload(const int* values) const
+{ glUniform3i(location(), values[0], values[1], values[2]); }
 
 template<> inline void
-ShaderUniform<float,16,16>::upload(const Nb::TimeBundle& tb)
-{
-    EM_ASSERT(Error::check());
-    if(_value)
-        NB_THROW("Value16f not supported!");
-    glUniformMatrix4fv(location(), 1, transpose(), _constant);
-    EM_ASSERT(Error::check());
-}
+ShaderUniform<int,4,4>::_glUpload(const int* values) const
+{ glUniform4iv(location(), 1, values); }
+
+template<> inline void
+ShaderUniform<int,4,3>::_glUpload(const int* values) const
+{ glUniform4iv(location(), 1, values); }
+
+template<> inline void
+ShaderUniform<float,9,9>::_glUpload(const float* values) const
+{ glUniformMatrix3fv(location(), 1, transpose(), values); }
+
+template<> inline void
+ShaderUniform<float,16,16>::_glUpload(const float* values) const
+{ glUniformMatrix4fv(location(), 1, transpose(), values); }
 
 // -----------------------------------------------------------------------------
 
@@ -80,6 +80,13 @@ public:     // Interface
     upload(const Nb::TimeBundle& tb)
     { NB_THROW("ShaderUniform::upload() not implemented for this type."); }
 
+    //! Forget the last uploaded value, so that the next upload() always
+    //! reaches GL.
+
+    virtual void
+    invalidate()
+    {}
+
 private:    // Member variables.
 
     const NtString _name;
@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------------
+//
+// NglStats.h
+//
+// Counters for data transferred to GPU memory.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -----------------------------------------------------------------------------
+
+#ifndef NGL_STATS_H
+#define NGL_STATS_H
+
+#include "NglInclude.h"
+#include <cstddef>
+
+namespace Ngl
+{
+// -----------------------------------------------------------------------------
+
+// Stats
+// -----
+//! Running totals of bytes uploaded to buffer and texture objects. Profilers
+//! sample the totals before and after the code they measure.
+
+struct Stats
+{
+public:
+
+    Stats()
+        : bufferBytes(0)
+        , textureBytes(0)
+    {}
+
+    std::size_t
+    uploadBytes() const
+    { return bufferBytes + textureBytes; }
+
+public:     // Member variables.
+
+    std::size_t bufferBytes;
+    std::size_t textureBytes;
+};
+
+inline Stats&
+getStats()
+{
+    static Stats stats;
+    return stats;
+}
+
+
+// countBufferUpload
+// -----------------
+//! Record the given number of bytes as uploaded to a buffer object.
+
+inline void
+countBufferUpload(const std::size_t bytes)
+{
+    getStats().bufferBytes += bytes;
+}
+
+
+// texelBytes
+// ----------
+//! Returns the size in bytes of a single texel in the given pixel format
+//! and type.
+
+inline std::size_t
+texelBytes(const GLenum format, const GLenum type)
+{
+    std::size_t components(4);
+    switch (format) {
+    case GL_RED:
+    case GL_GREEN:
+    case GL_BLUE:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+        components = 1;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        components = 2;
+        break;
+    case GL_RGB:
+        components = 3;
+        break;
+    default:
+        break;
+    }
+
+    std::size_t componentBytes(4);
+    switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+        componentBytes = 1;
+        break;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+        componentBytes = 2;
+        break;
+    default:
+        break;
+    }
+
+    return components*componentBytes;
+}
+
+
+// countTextureUpload
+// ------------------
+//! Record an upload of the given number of texels in the given pixel format
+//! and type to a texture object.
+
+inline void
+countTextureUpload(const std::size_t texels,
+                   const GLenum      format,
+                   const GLenum      type)
+{
+    getStats().textureBytes += texels*texelBytes(format, type);
+}
+
+// -----------------------------------------------------------------------------
+}   // Namespace: Ngl.
+
+#endif  // NGL_STATS_H
@@ -44,6 +44,7 @@
 #include <NbTileLayout.h>
 #include <Nbx.h>
 
+#include <algorithm>
 #include <limits>
 
 
@@ -92,8 +93,11 @@ SuperTileLayout::SuperTileLayout(const Nb::TileLayout* layout,
                                  const float           clipXform[16],
                                  const int             connectivity)
     : _wsMin( (std::numeric_limits<float>::max)()),
-      _wsMax(-(std::numeric_limits<float>::max)())
+      _wsMax(-(std::numeric_limits<float>::max)()),
+      _connectivity(connectivity)
 {
+    std::copy(clipXform, clipXform + 16, _clipXform);
+
     typedef std::vector<SuperTile> SuperTileVec;
 
     if (0 == layout) { // Handle an empty layout!
@@ -244,5 +248,19 @@ SuperTileLayout::bounds(NtVec3f &min, NtVec3f &max) const
     max = _wsMax;
 }
 
+
+// builtFor
+// --------
+//! Return true if the layout was built for the given clip-box transform
+//! and connectivity, i.e. if it does not need to be rebuilt for them.
+
+bool
+SuperTileLayout::builtFor(const float clipXform[16],
+                          const int   connectivity) const
+{
+    return connectivity == _connectivity &&
+           std::equal(clipXform, clipXform + 16, _clipXform);
+}
+
 // -----------------------------------------------------------------------------
 }   // Namespace: Ngl.
@@ -71,11 +71,15 @@ public:
 
     void bounds(NtVec3f& min, NtVec3f& max) const;
 
+    bool builtFor(const float clipXform[16], int connectivity = 26) const;
+
 private:
 
     std::vector<SuperTile> _superTileVec;
     NtVec3f              _wsMin;
     NtVec3f              _wsMax;
+    float                _clipXform[16];    //!< Clip-box used to build.
+    int                  _connectivity;
 };
 
 // -----------------------------------------------------------------------------
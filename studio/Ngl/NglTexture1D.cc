@@ -39,6 +39,7 @@
 
 #include "NglTexture1D.h"
 #include "NglTextureTarget.h"
+#include "NglStats.h"
 
 namespace Ngl
 {
@@ -97,6 +98,10 @@ Texture1D::Texture1D(const GLvoid* data,
                  data);
 
     unbind();
+
+    if (0 != data) {
+        countTextureUpload(_width, _base.format(), _base.type());
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 
 #include "NglTexture2D.h"
 #include "NglTextureTarget.h"
+#include "NglStats.h"
 
 namespace Ngl
 {
@@ -105,6 +106,12 @@ Texture2D::Texture2D(const GLvoid* data,
                  data);
 
     unbind();
+
+    if (0 != data) {
+        countTextureUpload(std::size_t(_width)*_height,
+                           _base.format(),
+                           _base.type());
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 
 #include "NglTexture3D.h"
 #include "NglTextureTarget.h"
+#include "NglStats.h"
 
 namespace Ngl
 {
@@ -113,6 +114,12 @@ Texture3D::Texture3D(const GLvoid* data,
                  data);
 
     unbind();
+
+    if (0 != data) {
+        countTextureUpload(std::size_t(_width)*_height*_depth,
+                           _base.format(),
+                           _base.type());
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -45,6 +45,9 @@
 //#include <em_array1.h>
 #include <em_array3.h>
 
+#include <limits>
+#include <vector>
+
 namespace Ngl
 {
 
@@ -83,16 +86,33 @@ initTexture3DDeltas(const NtVec3i&                 texDim,
 
 // -----------------------------------------------------------------------------
 
+//! RGBA texel data of a 3D texture, filled in by the sample functions below.
+//! Sampling only reads the given fields and may be done on any thread,
+//! whereas creating the texture from the data requires a current GL context.
+
+typedef em::array3<em::vec<4,GLfloat> > Texture3DData;
+
+
 inline Texture3D*
-createTexture3DFromField1f(const Nb::TileLayout&     layout,
+createTexture3D(const Texture3DData& texData)
+{
+    return new Ngl::Texture3D(
+        &texData(0, 0, 0),texData.ni,texData.nj,texData.nk
+        );
+}
+
+// -----------------------------------------------------------------------------
+
+inline void
+sampleTexture3DFromField1f(const Nb::TileLayout&     layout,
                            const Nb::Field1f&        fld,
-                           const NtVec3i&          texDim,
+                           const NtVec3i&            texDim,
                            const em::vec<3,GLfloat>& wsMin,
                            const em::vec<3,GLfloat>& wsMax,
+                           Texture3DData&            texData,
                            const bool                computeGradient=true,
                            em::vec<2,GLfloat>*       valRange=0)
 {
-    em::array3<em::vec<4,GLfloat> > texData;
     const em::vec<3,GLfloat> wsDelta = initTexture3DDeltas(
         texDim,wsMin,wsMax,texData
         );
@@ -141,40 +161,64 @@ createTexture3DFromField1f(const Nb::TileLayout&     layout,
     }
 
     if (0 != valRange) {
-        (*valRange)[0] =  std::numeric_limits<GLfloat>::max();
-        (*valRange)[1] = -std::numeric_limits<GLfloat>::max();
+        // Reduce each slice separately, then the slices, so that threads
+        // never update the same range.
+
+        std::vector<em::vec<2,GLfloat> > sliceRange(
+            nnk,
+            em::vec<2,GLfloat>( std::numeric_limits<GLfloat>::max(),
+                               -std::numeric_limits<GLfloat>::max()));
 
 #pragma omp parallel for
         for (int k = 0; k < nnk; ++k) {
             for (int j = 0; j < nnj; ++j) {
                 for (int i = 0; i < nni; ++i) {
                     GLfloat val = texData(i, j, k)[3];
-                    (*valRange)[0] = std::min((*valRange)[0], val);
-                    (*valRange)[1] = std::max((*valRange)[1], val);
+                    sliceRange[k][0] = std::min(sliceRange[k][0], val);
+                    sliceRange[k][1] = std::max(sliceRange[k][1], val);
                 }
             }
         }
+
+        (*valRange)[0] =  std::numeric_limits<GLfloat>::max();
+        (*valRange)[1] = -std::numeric_limits<GLfloat>::max();
+
+        for (int k = 0; k < nnk; ++k) {
+            (*valRange)[0] = std::min((*valRange)[0], sliceRange[k][0]);
+            (*valRange)[1] = std::max((*valRange)[1], sliceRange[k][1]);
+        }
     }
+}
 
-    return new Ngl::Texture3D(
-        &texData(0, 0, 0),texData.ni,texData.nj,texData.nk
+
+inline Texture3D*
+createTexture3DFromField1f(const Nb::TileLayout&     layout,
+                           const Nb::Field1f&        fld,
+                           const NtVec3i&          texDim,
+                           const em::vec<3,GLfloat>& wsMin,
+                           const em::vec<3,GLfloat>& wsMax,
+                           const bool                computeGradient=true,
+                           em::vec<2,GLfloat>*       valRange=0)
+{
+    Texture3DData texData;
+    sampleTexture3DFromField1f(
+        layout,fld,texDim,wsMin,wsMax,texData,computeGradient,valRange
         );
+    return createTexture3D(texData);
 }
 
 
 // -----------------------------------------------------------------------------
 
-inline Texture3D*
-createTexture3DFrom1f(const float               value,
-                      const NtVec3i&          texDim,
+inline void
+sampleTexture3DFrom1f(const float               value,
+                      const NtVec3i&            texDim,
                       const em::vec<3,GLfloat>& wsMin,
                       const em::vec<3,GLfloat>& wsMax,
+                      Texture3DData&            texData,
                       em::vec<2,GLfloat>*       valRange=0)
 {
-    em::array3<em::vec<4,GLfloat> > texData;
-    const em::vec<3,GLfloat> wsDelta = initTexture3DDeltas(
-        texDim,wsMin,wsMax,texData
-        );
+    initTexture3DDeltas(texDim,wsMin,wsMax,texData);
 
     const int nnk(texData.nk);
     const int nnj(texData.nj);
@@ -184,10 +228,6 @@ createTexture3DFrom1f(const float               value,
     for (int k = 0; k < nnk; ++k) {
         for (int j = 0; j < nnj; ++j) {
             for (int i = 0; i < nni; ++i) {
-                const em::vec<3,GLfloat> wsx(wsMin[0] + i*wsDelta[0],
-                                             wsMin[1] + j*wsDelta[1],
-                                             wsMin[2] + k*wsDelta[2]);
-                
                 // Texture is RGBA, value is duplicated across all channels.
                 
                 texData(i, j, k)
@@ -200,24 +240,33 @@ createTexture3DFrom1f(const float               value,
         (*valRange)[0]=value;
         (*valRange)[1]=value;
     }
+}
 
-    return new Ngl::Texture3D(
-        &texData(0, 0, 0),texData.ni,texData.nj,texData.nk
-        );
+
+inline Texture3D*
+createTexture3DFrom1f(const float               value,
+                      const NtVec3i&          texDim,
+                      const em::vec<3,GLfloat>& wsMin,
+                      const em::vec<3,GLfloat>& wsMax,
+                      em::vec<2,GLfloat>*       valRange=0)
+{
+    Texture3DData texData;
+    sampleTexture3DFrom1f(value,texDim,wsMin,wsMax,texData,valRange);
+    return createTexture3D(texData);
 }
 
 // -----------------------------------------------------------------------------
 
-inline Texture3D*
-createTexture3DFromField3f(const Nb::TileLayout&     layout,
+inline void
+sampleTexture3DFromField3f(const Nb::TileLayout&     layout,
                            const Nb::Field1f&        fld0,
                            const Nb::Field1f&        fld1,
                            const Nb::Field1f&        fld2,
-                           const NtVec3i&          texDim,
+                           const NtVec3i&            texDim,
                            const em::vec<3,GLfloat>& wsMin,
-                           const em::vec<3,GLfloat>& wsMax)
+                           const em::vec<3,GLfloat>& wsMax,
+                           Texture3DData&            texData)
 {
-    em::array3<em::vec<4,GLfloat> > texData;
     const em::vec<3,GLfloat> wsDelta = initTexture3DDeltas(
         texDim,wsMin,wsMax,texData
         );
@@ -247,24 +296,35 @@ createTexture3DFromField3f(const Nb::TileLayout&     layout,
             }
         }
     }
+}
 
-    return new Ngl::Texture3D(
-        &texData(0, 0, 0),texData.ni,texData.nj,texData.nk
+
+inline Texture3D*
+createTexture3DFromField3f(const Nb::TileLayout&     layout,
+                           const Nb::Field1f&        fld0,
+                           const Nb::Field1f&        fld1,
+                           const Nb::Field1f&        fld2,
+                           const NtVec3i&          texDim,
+                           const em::vec<3,GLfloat>& wsMin,
+                           const em::vec<3,GLfloat>& wsMax)
+{
+    Texture3DData texData;
+    sampleTexture3DFromField3f(
+        layout,fld0,fld1,fld2,texDim,wsMin,wsMax,texData
         );
+    return createTexture3D(texData);
 }
 
 // -----------------------------------------------------------------------------
 
-inline Texture3D*
-createTexture3DFrom3f(const NtVec3f&          value,
-                      const NtVec3i&          texDim,
+inline void
+sampleTexture3DFrom3f(const NtVec3f&            value,
+                      const NtVec3i&            texDim,
                       const em::vec<3,GLfloat>& wsMin,
-                      const em::vec<3,GLfloat>& wsMax)
+                      const em::vec<3,GLfloat>& wsMax,
+                      Texture3DData&            texData)
 {
-    em::array3<em::vec<4,GLfloat> > texData;
-    const em::vec<3,GLfloat> wsDelta = initTexture3DDeltas(
-        texDim,wsMin,wsMax,texData
-        );
+    initTexture3DDeltas(texDim,wsMin,wsMax,texData);
 
     const int nnk(texData.nk);
     const int nnj(texData.nj);
@@ -274,10 +334,6 @@ createTexture3DFrom3f(const NtVec3f&          value,
     for (int k = 0; k < nnk; ++k) {
         for (int j = 0; j < nnj; ++j) {
             for (int i = 0; i < nni; ++i) {
-                const em::vec<3,GLfloat> wsx(wsMin[0] + i*wsDelta[0],
-                                             wsMin[1] + j*wsDelta[1],
-                                             wsMin[2] + k*wsDelta[2]);
-                
                 // Texture is RGBA, value is duplicated across all channels.
                 
                 texData(i, j, k)
@@ -285,10 +341,18 @@ createTexture3DFrom3f(const NtVec3f&          value,
             }           
         }
     }
+}
 
-    return new Ngl::Texture3D(
-        &texData(0, 0, 0),texData.ni,texData.nj,texData.nk
-        );
+
+inline Texture3D*
+createTexture3DFrom3f(const NtVec3f&          value,
+                      const NtVec3i&          texDim,
+                      const em::vec<3,GLfloat>& wsMin,
+                      const em::vec<3,GLfloat>& wsMax)
+{
+    Texture3DData texData;
+    sampleTexture3DFrom3f(value,texDim,wsMin,wsMax,texData);
+    return createTexture3D(texData);
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 
 #include "NglUtils.h"
 #include "NglViewport.h"
+#include "NglVertexBuffer.h"
 //#include <em_mat44_algo.h>
 #include <em_glmat44.h>
 #include <em_glmat44_algo.h>
@@ -330,6 +331,116 @@ projectAxis(const Viewport     &vp,
 
 // -----------------------------------------------------------------------------
 
+Mesh::Mesh(const GLenum mode)
+    : _mode(mode),
+      _normals(false),
+      _vbo(0)
+{
+}
+
+
+//! The vertex buffer is not shared, copies upload their own on first draw.
+
+Mesh::Mesh(const Mesh &rhs)
+    : _mode(rhs._mode),
+      _normals(rhs._normals),
+      _data(rhs._data),
+      _vbo(0)
+{
+}
+
+
+Mesh::~Mesh()
+{
+    delete _vbo;
+}
+
+
+Mesh&
+Mesh::operator=(const Mesh &rhs)
+{
+    if (this != &rhs) {
+        _mode = rhs._mode;
+        _normals = rhs._normals;
+        _data = rhs._data;
+        delete _vbo;
+        _vbo = 0;
+    }
+    return *this;
+}
+
+
+void
+Mesh::setVertices(const std::vector<vec3f> &vtx)
+{
+    _normals = false;
+    _data.resize(3*vtx.size());
+    for (std::vector<vec3f>::size_type v = 0; v < vtx.size(); ++v) {
+        _data[3*v + 0] = vtx[v][0];
+        _data[3*v + 1] = vtx[v][1];
+        _data[3*v + 2] = vtx[v][2];
+    }
+    delete _vbo;    // Upload again on next draw.
+    _vbo = 0;
+}
+
+
+void
+Mesh::setVertices(const std::vector<vec3f> &vtx,
+                  const std::vector<vec3f> &nml)
+{
+    _normals = true;
+    _data.resize(6*vtx.size());
+    for (std::vector<vec3f>::size_type v = 0; v < vtx.size(); ++v) {
+        _data[6*v + 0] = vtx[v][0];
+        _data[6*v + 1] = vtx[v][1];
+        _data[6*v + 2] = vtx[v][2];
+        _data[6*v + 3] = nml[v][0];
+        _data[6*v + 4] = nml[v][1];
+        _data[6*v + 5] = nml[v][2];
+    }
+    delete _vbo;    // Upload again on next draw.
+    _vbo = 0;
+}
+
+
+GLsizei
+Mesh::vertexCount() const
+{
+    return static_cast<GLsizei>(_data.size()/(_normals ? 6 : 3));
+}
+
+
+void
+Mesh::draw() const
+{
+    if (_data.empty()) {
+        return;
+    }
+
+    if (0 == _vbo) {
+        _vbo = new VertexBuffer(_data.size()*sizeof(GLfloat), &_data[0]);
+    }
+
+    const GLsizei stride((_normals ? 6 : 3)*sizeof(GLfloat));
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    _vbo->bind();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, 0);
+    if (_normals) {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_FLOAT,
+                        stride,
+                        reinterpret_cast<const GLvoid*>(3*sizeof(GLfloat)));
+    }
+    glDrawArrays(_mode, 0, vertexCount());
+    _vbo->unbind();
+    glPopClientAttrib();
+}
+
+// -----------------------------------------------------------------------------
+
 const vec3i
 Cuboid::face[12] = {
     vec3i(1, 5, 6), vec3i(6, 2, 1),     // X+
@@ -354,6 +465,7 @@ Cuboid::normal[6] = {
 
 Cuboid::Cuboid(const GLfloat  dim,
                const vec3f   &centre)
+    : _mesh(GL_TRIANGLES)
 {
     set(dim, centre);
 }
@@ -362,6 +474,7 @@ Cuboid::Cuboid(const GLfloat  dim,
 Cuboid::Cuboid(const GLfloat xmin, const GLfloat xmax,
                const GLfloat ymin, const GLfloat ymax,
                const GLfloat zmin, const GLfloat zmax)
+    : _mesh(GL_TRIANGLES)
 {
     set(xmin, xmax,
         ymin, ymax,
@@ -373,6 +486,7 @@ Cuboid::Cuboid(const vec3f   &axis,
                const GLfloat  thickness,
                const GLfloat  len,
                const GLfloat  offset)
+    : _mesh(GL_TRIANGLES)
 {
     set(axis, thickness, len, offset);
 }
@@ -391,6 +505,7 @@ Cuboid::set(const GLfloat xmin, const GLfloat xmax,
     _vtx[5] = vec3f(xmax, ymax, zmin);
     _vtx[6] = vec3f(xmax, ymax, zmax);
     _vtx[7] = vec3f(xmin, ymax, zmax);
+    _updateMesh();
 }
 
 
@@ -406,6 +521,7 @@ Cuboid::set(const GLfloat dim, const vec3f &c)
     _vtx[5] = vec3f( hdim + c[0],  hdim + c[1], -hdim + c[2]);
     _vtx[6] = vec3f( hdim + c[0],  hdim + c[1],  hdim + c[2]);
     _vtx[7] = vec3f(-hdim + c[0],  hdim + c[1],  hdim + c[2]);
+    _updateMesh();
 }
 
 
@@ -443,14 +559,24 @@ Cuboid::set(const vec3f   &axis,
 void
 Cuboid::draw() const
 {
-    glBegin(GL_TRIANGLES);
+    _mesh.draw();
+}
+
+
+void
+Cuboid::_updateMesh()
+{
+    std::vector<vec3f> vtx;
+    std::vector<vec3f> nml;
+    vtx.reserve(36);
+    nml.reserve(36);
     for (int f = 0; f < 12; ++f) {
-        glNormal3fv(&Cuboid::normal[f >> 1][0]);  // NB: Bit-shift divide-by-two
         for (int v = 0; v < 3; ++v) {
-            glVertex3fv(&_vtx[Cuboid::face[f][v]][0]);
+            vtx.push_back(_vtx[Cuboid::face[f][v]]);
+            nml.push_back(Cuboid::normal[f >> 1]);  // NB: Bit-shift div-by-2
         }
     }
-    glEnd();
+    _mesh.setVertices(vtx, nml);
 }
 
 // -----------------------------------------------------------------------------
@@ -460,6 +586,7 @@ Ring::Ring(const vec3f &t0,
            GLfloat      r,
            GLint        subd,
            const vec3f &c)
+    : _mesh(GL_LINE_LOOP)
 {
     _vtx.resize(std::max<GLint>(3, subd));
 
@@ -471,6 +598,8 @@ Ring::Ring(const vec3f &t0,
          ++v) {
         _vtx[v] = c + (rad*cosf(v*dTheta))*t0 + (rad*sinf(v*dTheta))*t1;
     }
+
+    _mesh.setVertices(_vtx);
 }
 
 
@@ -478,13 +607,7 @@ void
 Ring::draw(GLfloat lineWidth) const
 {
     glLineWidth(lineWidth);
-    glBegin(GL_LINE_LOOP);
-    for (std::vector<vec3f >::size_type v = 0;
-         v < _vtx.size();
-         ++v) {
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glEnd();
+    _mesh.draw();
 }
 
 // -----------------------------------------------------------------------------
@@ -494,41 +617,37 @@ Disk::Disk(const vec3f &t0,
            GLfloat      radius,
            GLint        subd,
            const vec3f &c)
+    : _mesh(GL_TRIANGLE_FAN)
 {
-    _vtx.resize(std::max<GLint>(3, subd));
+    std::vector<vec3f> rim(std::max<GLint>(3, subd));
 
-    GLfloat dTheta = deg2rad(360.f/_vtx.size());
+    GLfloat dTheta = deg2rad(360.f/rim.size());
     const GLfloat rad(std::max<GLfloat>(0.f, radius));
 
     for (std::vector<vec3f >::size_type v = 0;
-         v < _vtx.size();
+         v < rim.size();
          ++v) {
-        _vtx[v] = c + (rad*cosf(v*dTheta))*t0 + (rad*sinf(v*dTheta))*t1;
+        rim[v] = c + (rad*cosf(v*dTheta))*t0 + (rad*sinf(v*dTheta))*t1;
     }
 
-    _nml = em::normalized(em::cross(t0, t1));
+    // Fan around the first rim vertex, wound clockwise.
+
+    std::vector<vec3f> vtx;
+    vtx.reserve(rim.size() + 2);
+    vtx.push_back(rim[0]);
+    vtx.insert(vtx.end(), rim.rbegin(), rim.rend());
+    vtx.push_back(rim.back());
+
+    const std::vector<vec3f> nml(vtx.size(),
+                                 em::normalized(em::cross(t0, t1)));
+    _mesh.setVertices(vtx, nml);
 }
 
 
 void
 Disk::draw() const
 {
-    glNormal3fv(&_nml[0]);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3fv(&_vtx[0][0]);
-    for (int v = _vtx.size() - 1; v >= 0 ; --v) {
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glVertex3fv(&_vtx[_vtx.size() - 1][0]);
-    glEnd();
-
-//    glBegin(GL_LINE_LOOP);
-//    for (std::vector<vec3f >::size_type v = 0;
-//         v < _vtx.size();
-//         ++v) {
-//        glVertex3fv(&_vtx[v][0]);
-//    }
-//    glEnd();
+    _mesh.draw();
 }
 
 // -----------------------------------------------------------------------------
@@ -536,7 +655,8 @@ Disk::draw() const
 Sphere::Sphere(const GLfloat  radius,
                const GLint    subd,
                const vec3f   &c)
-    : _radius(radius),
+    : _mesh(GL_TRIANGLE_STRIP),
+      _radius(radius),
       _center(c)
 {
     const GLint subdh(subd/2);
@@ -548,8 +668,10 @@ Sphere::Sphere(const GLfloat  radius,
     vec3f vtx;
     vec3f nml;
 
-    _vtx.reserve(2*subdh*subd);
-    _nml.reserve(2*subdh*subd);
+    std::vector<vec3f> vertices;
+    std::vector<vec3f> normals;
+    vertices.reserve(2*subdh*(subd + 1));
+    normals.reserve(2*subdh*(subd + 1));
 
     for (lat = 0; lat < subdh; ++lat) {
         for (lon = 0; lon <= subd; ++lon) {
@@ -562,8 +684,8 @@ Sphere::Sphere(const GLfloat  radius,
             vtx[0] = c[0] + radius*nml[0];
             vtx[1] = c[1] + radius*nml[1];
             vtx[2] = c[2] + radius*nml[2];
-            _vtx.push_back(vtx);
-            _nml.push_back(nml);
+            vertices.push_back(vtx);
+            normals.push_back(nml);
 
             latf = (lat+1)*factor;
             lonf = lon*factor;
@@ -574,24 +696,19 @@ Sphere::Sphere(const GLfloat  radius,
             vtx[0] = c[0] + radius*nml[0];
             vtx[1] = c[1] + radius*nml[1];
             vtx[2] = c[2] + radius*nml[2];
-            _vtx.push_back(vtx);
-            _nml.push_back(nml);
+            vertices.push_back(vtx);
+            normals.push_back(nml);
         }
     }
+
+    _mesh.setVertices(vertices, normals);
 }
 
 
 void
 Sphere::draw() const
 {
-    glBegin(GL_TRIANGLE_STRIP);
-    for (std::vector<vec3f>::size_type v = 0;
-         v < _vtx.size();
-         ++v) {
-        glNormal3fv(&_nml[v][0]);
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glEnd();
+    _mesh.draw();
 }
 
 // -----------------------------------------------------------------------------
@@ -604,62 +721,68 @@ Cone::Cone(const vec3f   &axis,
            const GLfloat  r,
            const GLint    subd,
            const vec3f   &c)
-    : _axis(axis),
-      _baseMid(c[0] + axis[0]*std::min<GLfloat>(h0, h),
-               c[1] + axis[1]*std::min<GLfloat>(h0, h),
-               c[2] + axis[2]*std::min<GLfloat>(h0, h)),
-      _top(c[0] + axis[0]*(std::max<GLfloat>(h0, h)),
-           c[1] + axis[1]*(std::max<GLfloat>(h0, h)),
-           c[2] + axis[2]*(std::max<GLfloat>(h0, h)))
+    : _base(GL_TRIANGLE_FAN),
+      _side(GL_TRIANGLE_FAN)
 {
-    _vtx.resize(std::max<GLint>(3, subd));
-    _nml.resize(_vtx.size());
+    const vec3f baseMid(c[0] + axis[0]*std::min<GLfloat>(h0, h),
+                        c[1] + axis[1]*std::min<GLfloat>(h0, h),
+                        c[2] + axis[2]*std::min<GLfloat>(h0, h));
+    const vec3f top(c[0] + axis[0]*(std::max<GLfloat>(h0, h)),
+                    c[1] + axis[1]*(std::max<GLfloat>(h0, h)),
+                    c[2] + axis[2]*(std::max<GLfloat>(h0, h)));
 
-    GLfloat dTheta = deg2rad(360.f/_vtx.size());
+    std::vector<vec3f> rim(std::max<GLint>(3, subd));
+    std::vector<vec3f> rimNml(rim.size());
+
+    GLfloat dTheta = deg2rad(360.f/rim.size());
 
     const GLfloat rad(std::max<GLfloat>(0.f, r));
     for (std::vector<vec3f >::size_type v = 0;
-         v < _vtx.size();
+         v < rim.size();
          ++v) {
-        _vtx[v] = _baseMid + (rad*cosf(v*dTheta))*t0 + (rad*sinf(v*dTheta))*t1;
+        rim[v] = baseMid + (rad*cosf(v*dTheta))*t0 + (rad*sinf(v*dTheta))*t1;
     }
 
     for (std::vector<vec3f >::size_type n = 0;
-         n < _nml.size() - 1;
+         n < rimNml.size() - 1;
          ++n) {
-        _nml[n] = em::cross(_top - _vtx[n], _top - _vtx[n+1]);
-        em::normalize(_nml[n]);
+        rimNml[n] = em::cross(top - rim[n], top - rim[n+1]);
+        em::normalize(rimNml[n]);
     }
 
-    _nml.back() = em::cross(_top - _vtx.back(), _top - _vtx[0]);
-    em::normalize(_nml.back());
+    rimNml.back() = em::cross(top - rim.back(), top - rim[0]);
+    em::normalize(rimNml.back());
+
+    // Base, a fan around its mid-point facing away from the top.
+
+    std::vector<vec3f> vtx;
+    vtx.reserve(rim.size() + 2);
+    vtx.push_back(baseMid);
+    vtx.insert(vtx.end(), rim.rbegin(), rim.rend());
+    vtx.push_back(rim.back());
+    const vec3f baseNml(-axis[0], -axis[1], -axis[2]);
+    _base.setVertices(vtx, std::vector<vec3f>(vtx.size(), baseNml));
+
+    // Side, a fan around the top.
+
+    std::vector<vec3f> nml;
+    nml.reserve(rim.size() + 2);
+    vtx.clear();
+    vtx.push_back(top);
+    nml.push_back(axis);
+    vtx.insert(vtx.end(), rim.begin(), rim.end());
+    nml.insert(nml.end(), rimNml.begin(), rimNml.end());
+    vtx.push_back(rim[0]);
+    nml.push_back(rimNml[0]);
+    _side.setVertices(vtx, nml);
 }
 
 
 void
 Cone::draw() const
 {
-    glNormal3f(-_axis[0], -_axis[1], -_axis[2]);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3fv(&_baseMid[0]);
-    for (int v = _vtx.size() - 1; v >= 0 ; --v) {
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glVertex3fv(&_vtx[_vtx.size() - 1][0]);
-    glEnd();
-
-    glBegin(GL_TRIANGLE_FAN);
-    glNormal3f(_axis[0], _axis[1], _axis[2]);
-    glVertex3fv(&_top[0]);
-    for (std::vector<vec3f >::size_type v = 0;
-         v < _vtx.size();
-         ++v) {
-        glNormal3fv(&_nml[v][0]);
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glNormal3fv(&_nml[0][0]);
-    glVertex3fv(&_vtx[0][0]);
-    glEnd();
+    _base.draw();
+    _side.draw();
 }
 
 // -----------------------------------------------------------------------------
@@ -671,6 +794,7 @@ Torus::Torus(//const vec3f   &t0,
              const GLint    subdSide,
              const GLint    subdRing,
              const vec3f   &c)
+    : _mesh(GL_QUAD_STRIP)
 {
     const GLint ss(std::max<GLint>(4, subdSide));
     const GLint sr(std::max<GLint>(4, subdRing));
@@ -678,6 +802,9 @@ Torus::Torus(//const vec3f   &t0,
     const GLfloat ringDelta(deg2rad(360.f/sr));
     const GLfloat sideDelta(deg2rad(360.f/ss));
 
+    std::vector<vec3f> vertices;
+    std::vector<vec3f> normals;
+
     GLfloat thetaRad(0.f);
 
     for (GLint r = sr; r >= 0; --r) {
@@ -691,33 +818,30 @@ Torus::Torus(//const vec3f   &t0,
 
             // Begin the segment here with the normal and the vertex
 
-            _vtx.push_back(vertex(thetaRad, phiRad,
+            vertices.push_back(vertex(thetaRad, phiRad,
                                   innerRadius, outerRadius,
                                   c));
-            _nml.push_back(normal(_vtx.back(), thetaRad, outerRadius));
+            normals.push_back(normal(vertices.back(), thetaRad, outerRadius));
 
             thetaRad += ringDelta;
 
             // End the segment here with the normal and the vertex
 
-            _vtx.push_back(vertex(thetaRad, phiRad,
+            vertices.push_back(vertex(thetaRad, phiRad,
                                   innerRadius, outerRadius,
                                   c));
-            _nml.push_back(normal(_vtx.back(), thetaRad, outerRadius));
+            normals.push_back(normal(vertices.back(), thetaRad, outerRadius));
         }
     }
+
+    _mesh.setVertices(vertices, normals);
 }
 
 
 void
 Torus::draw() const
 {
-    glBegin(GL_QUAD_STRIP);
-    for (std::vector<vec3f>::size_type v = 0; v < _vtx.size(); ++v) {
-        glNormal3fv(&_nml[v][0]);
-        glVertex3fv(&_vtx[v][0]);
-    }
-    glEnd();
+    _mesh.draw();
 }
 
 
@@ -49,6 +49,7 @@ namespace Ngl
 // -----------------------------------------------------------------------------
 
 class Viewport;     // Fwd
+class VertexBuffer; // Fwd
 
 GLfloat deg2rad(GLfloat deg);
 GLfloat rad2deg(GLfloat rad);
@@ -150,6 +151,47 @@ projectAxis(const Viewport &vp,
 
 // -----------------------------------------------------------------------------
 
+// Mesh
+// ----
+//! Static geometry drawn from a vertex buffer. Vertices, and optionally
+//! normals, are kept on the client and uploaded once, the first time the
+//! mesh is drawn, instead of being sent through glBegin/glEnd every frame.
+//! Color and other vertex state is taken from the current GL state, so
+//! meshes can be used for both the color and the selection (ID) passes.
+
+class Mesh
+{
+public:
+
+    explicit
+    Mesh(GLenum mode = GL_TRIANGLES);
+
+    Mesh(const Mesh &rhs);
+
+    ~Mesh();
+
+    Mesh &operator=(const Mesh &rhs);
+
+    void setVertices(const std::vector<vec3f> &vtx);
+
+    void setVertices(const std::vector<vec3f> &vtx,
+                     const std::vector<vec3f> &nml);
+
+    GLenum  mode()        const { return _mode; }
+    GLsizei vertexCount() const;
+
+    void draw() const;
+
+private:
+
+    GLenum               _mode;
+    bool                 _normals;
+    std::vector<GLfloat> _data;     //!< Interleaved position [normal].
+    mutable VertexBuffer *_vbo;     //!< Created on first draw.
+};
+
+// -----------------------------------------------------------------------------
+
 class Cuboid
 {
 public:
@@ -190,9 +232,14 @@ public:
 
     void draw() const;
 
+private:
+
+    void _updateMesh();
+
 private:
 
     vec3f _vtx[8];
+    Mesh  _mesh;
 };
 
 // -----------------------------------------------------------------------------
@@ -215,6 +262,7 @@ public:
 private:
 
     std::vector<vec3f> _vtx;
+    Mesh               _mesh;
 };
 
 // -----------------------------------------------------------------------------
@@ -236,8 +284,7 @@ public:
 
 private:
 
-    std::vector<vec3f> _vtx;
-    vec3f _nml;
+    Mesh _mesh;
 };
 
 // -----------------------------------------------------------------------------
@@ -260,11 +307,8 @@ public:
 
 private:
 
-    vec3f _axis;
-    vec3f _baseMid;
-    vec3f _top;
-    std::vector<vec3f> _vtx;
-    std::vector<vec3f> _nml;
+    Mesh _base;
+    Mesh _side;
 };
 
 // -----------------------------------------------------------------------------
@@ -285,10 +329,9 @@ public:
 
 private:
 
-    std::vector<vec3f> _vtx;
-    std::vector<vec3f> _nml;
-    GLfloat            _radius;
-    vec3f              _center;
+    Mesh    _mesh;
+    GLfloat _radius;
+    vec3f   _center;
 };
 
 // -----------------------------------------------------------------------------
@@ -322,8 +365,7 @@ private:
 
 private:
 
-    std::vector<vec3f> _vtx;
-    std::vector<vec3f> _nml;
+    Mesh _mesh;
 };
 
 // -----------------------------------------------------------------------------
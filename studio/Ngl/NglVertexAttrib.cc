@@ -82,13 +82,16 @@ VertexAttrib::destroyTypeMap()
 
 // connect
 // -------
-//! Connect a shader attribute to a vertex buffer.
+//! Connect a shader attribute to a vertex buffer. A non-zero divisor makes
+//! the attribute advance once per divisor instances rather than per vertex,
+//! which requires instancing support.
 
 GLsizei
 VertexAttrib::connect(const ShaderAttrib& shaderAttrib,
                       const VertexBuffer& vertexBuffer,
                       const GLboolean     normalized,
-                      const GLsizei       stride)
+                      const GLsizei       stride,
+                      const GLuint        divisor)
 {
     EM_ASSERT(Error::check());
 
@@ -115,6 +118,13 @@ VertexAttrib::connect(const ShaderAttrib& shaderAttrib,
                           _validStride(stride),
                           0); // Null, data is read from currently bound VBO
 
+    if (0 < divisor) {
+        if (!getGLExtensionFunctions().instancingSupported()) {
+            NB_THROW("Instanced vertex attributes are not supported");
+        }
+        glVertexAttribDivisor(index, divisor);
+    }
+
 #if 1
     // TODO: Investigate if this is necessary.
     vertexBuffer.unbind();
@@ -142,6 +152,10 @@ VertexAttrib::disconnect(const ShaderAttrib& shaderAttrib)
     const GLuint index(_validIndex(shaderAttrib.location()));
     glDisableVertexAttribArray(index);
 
+    if (getGLExtensionFunctions().instancingSupported()) {
+        glVertexAttribDivisor(index, 0);    // Back to per-vertex.
+    }
+
     EM_ASSERT(Error::check());
 }
 
@@ -83,7 +83,8 @@ public:     // Interface
     static GLsizei connect(const ShaderAttrib& shaderAttrib,
                            const VertexBuffer& vertexBuffer,
                            GLboolean           normalized = GL_FALSE,
-                           GLsizei             stride     = 0);
+                           GLsizei             stride     = 0,
+                           GLuint              divisor    = 0);
 
     static void disconnect(const ShaderAttrib& shaderAttrib);
 
@@ -39,6 +39,7 @@
 
 #include "NglVertexBuffer.h"
 #include "NglError.h"
+#include "NglStats.h"
 
 #include <Nbx.h>
 
@@ -291,6 +292,8 @@ VertexBuffer::setSubData(const GLintptr   offset,
     bind();     // Make current.
     glBufferSubData(_target, range.offset(), range.size(), data);
     unbind();
+
+    countBufferUpload(range.size());
 }
 
 
@@ -497,6 +500,10 @@ VertexBuffer::_alloc(const GLsizeiptr size,         // [bytes]
     GLint i(0);
     glGetBufferParameteriv(_target, GL_BUFFER_SIZE, &i);
     _size = static_cast<GLsizeiptr>(i);
+
+    if (0 != data) {
+        countBufferUpload(_size);
+    }
 }
 
 
@@ -530,6 +537,7 @@ VertexBuffer::_setData(const GLsizeiptr     totalDataSize,
                             _validOffset(offset),    // May throw
                             _validSize(dataSize[i]), // May throw
                             data[i]);
+            countBufferUpload(dataSize[i]);
         }
         offset += dataSize[i];
     }
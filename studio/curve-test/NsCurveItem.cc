@@ -21,6 +21,28 @@
 
 #include "em_keyframe.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Half a pixel, the maximum distance between the curve and its
+// tessellation.
+
+const double pixelTolerance(0.5);
+
+// Every span between keyframes is first split into this many segments, so
+// that features narrower than a span are not missed by the midpoint test.
+
+const int minSpanSegments(4);
+
+// Maximum number of times a segment is halved.
+
+const int maxDepth(12);
+
+}
+
 
 // NsCurveItem
 // -----------
@@ -34,6 +56,10 @@ NsCurveItem::NsCurveItem(const QString &nodeName,
     , _nodeName(nodeName)
     , _prmName(prmName)
     , _timeValue(timeValue)
+    , _tMin(0.0)
+    , _tMax(0.0)
+    , _tolerance(0.0)
+    , _valid(false)
 {
     // TODO: Handle null pointer?!
 
@@ -51,28 +77,37 @@ NsCurveItem::NsCurveItem(const QString &nodeName,
         }
     }
 
+    // Coarse outline of the curve, only used for the bounding rect and
+    // selection shape. What is drawn is tessellated for the view in
+    // paint().
+
     QPainterPath crvPath;
-    const double tMax = 1000.0;
-    const double tMin = -1000.0;
-    double t0 = tMin;
-    double tNext = 0.0;
-    crvPath.moveTo(QPointF(t0, _timeValue->eval_path(t0,
-                                              tMax,
-                                              -100.0,
-                                              100.0,
-                                              &tNext)));
-    while (tNext < tMax) {
-        qDebug() << tNext;
-        t0 = tNext;
-        crvPath.lineTo(t0, _timeValue->eval_path(t0,
-                                             tMax,
-                                             -100.0,
-                                             100.0,
-                                             &tNext));
+    if (0 != _timeValue) {
+        const int samples(256);
+        const double tMax = 1000.0;
+        const double tMin = -1000.0;
+        const double dt((tMax - tMin)/samples);
+        crvPath.moveTo(tMin, _timeValue->eval(tMin));
+        for (int i = 1; i <= samples; ++i) {
+            const double t(tMin + i*dt);
+            crvPath.lineTo(t, _timeValue->eval(t));
+        }
     }
-
-    crvPath.lineTo(tNext, _timeValue->eval(tMax));
     setPath(crvPath);
+
+    setFlag(ItemUsesExtendedStyleOption);   // Exposed rect in paint().
+}
+
+
+// invalidate
+// ----------
+//! Discard the cached tessellation, it is re-built on the next paint.
+
+void
+NsCurveItem::invalidate()
+{
+    _valid = false;
+    update();
 }
 
 
@@ -96,11 +131,26 @@ NsCurveItem::paint(QPainter *painter,
                    const QStyleOptionGraphicsItem *option,
                    QWidget *widget)
 {
+    // Tessellate for the exposed time interval, with an error below half a
+    // pixel at the current zoom. The cached tessellation covers a margin of
+    // one exposed width on either side, so that panning reuses it.
+
+    const QRectF exposed(option->exposedRect);
+    const double lod(option->levelOfDetailFromTransform(
+                         painter->worldTransform()));
+    const double tolerance(pixelTolerance/std::max(lod, 1e-12));
 
+    if (!_valid ||
+        exposed.left() < _tMin || _tMax < exposed.right() ||
+        tolerance < 0.5*_tolerance || 2.0*_tolerance < tolerance) {
+        _tessellate(exposed.left() - exposed.width(),
+                    exposed.right() + exposed.width(),
+                    tolerance);
+    }
 
     painter->setPen(isSelected() ? QPen(Qt::white, 1) : QPen(Qt::black, 1));
     painter->setBrush(Qt::NoBrush);
-    painter->drawPath(path());
+    painter->drawPath(_visiblePath);
 
 //    if (_timeValue->has_keyframes()) {
 //        int numKF(0);
@@ -128,3 +178,82 @@ NsCurveItem::paint(QPainter *painter,
 //    return stroker.createStroke(crvPath);
 //    //return crvPath;
 //}
+
+
+// _tessellate
+// -----------
+//! Re-build the cached tessellation over [tMin, tMax]. Spans between
+//! keyframes are subdivided until the curve is within tolerance of its
+//! chords, so flat parts of the curve cost a single segment.
+
+void
+NsCurveItem::_tessellate(const double tMin,
+                         const double tMax,
+                         const double tolerance)
+{
+    _visiblePath = QPainterPath();
+    _tMin = tMin;
+    _tMax = tMax;
+    _tolerance = tolerance;
+    _valid = true;
+
+    if (0 == _timeValue || !(tMin < tMax)) {
+        return;
+    }
+
+    // Break the interval at keyframes, where the curve may have kinks.
+
+    std::vector<double> breaks;
+    breaks.push_back(tMin);
+    if (_timeValue->has_keyframes()) {
+        int numKF(0);
+        const em::keyframe* kf(_timeValue->keyframes(&numKF));
+        for (int k = 0; k < numKF; ++k) {
+            if (tMin < kf[k].t() && kf[k].t() < tMax) {
+                breaks.push_back(kf[k].t());
+            }
+        }
+        std::sort(breaks.begin() + 1, breaks.end());
+    }
+    breaks.push_back(tMax);
+
+    double t0(breaks[0]);
+    double v0(_timeValue->eval(t0));
+    _visiblePath.moveTo(t0, v0);
+
+    for (std::vector<double>::size_type b = 1; b < breaks.size(); ++b) {
+        const double dt((breaks[b] - breaks[b - 1])/minSpanSegments);
+        for (int i = 1; i <= minSpanSegments; ++i) {
+            const double t1(i < minSpanSegments ?
+                            breaks[b - 1] + i*dt : breaks[b]);
+            const double v1(_timeValue->eval(t1));
+            _subdivide(t0, v0, t1, v1, tolerance, maxDepth);
+            t0 = t1;
+            v0 = v1;
+        }
+    }
+}
+
+
+// _subdivide
+// ----------
+//! Append the segment from (t0, v0) to (t1, v1) to the cached tessellation,
+//! halving it while the curve strays more than tolerance from the chord.
+
+void
+NsCurveItem::_subdivide(const double t0, const double v0,
+                        const double t1, const double v1,
+                        const double tolerance,
+                        const int depth)
+{
+    const double tm(0.5*(t0 + t1));
+    const double vm(_timeValue->eval(tm));
+
+    if (0 < depth && tolerance < std::fabs(vm - 0.5*(v0 + v1))) {
+        _subdivide(t0, v0, tm, vm, tolerance, depth - 1);
+        _subdivide(tm, vm, t1, v1, tolerance, depth - 1);
+    }
+    else {
+        _visiblePath.lineTo(t1, v1);
+    }
+}
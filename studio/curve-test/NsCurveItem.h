@@ -19,6 +19,7 @@
 
 //#include <QGraphicsItem>
 #include <QGraphicsPathItem>
+#include <QPainterPath>
 #include "em_time_value.h"
 
 
@@ -44,6 +45,11 @@ public:
     const QString& nodeName() const { return _nodeName; }
     const QString& prmName() const { return _prmName; }
 
+    // Discard the cached tessellation, must be called when keyframes
+    // have been edited.
+
+    void invalidate();
+
 protected:
 
 //    virtual void mousePressEvent(QGraphicsSceneMouseEvent *event);
@@ -52,10 +58,29 @@ protected:
 //    virtual void hoverEnterEvent(QGraphicsSceneHoverEvent *event);
 //    virtual void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
 
+private:
+
+    void _tessellate(double tMin, double tMax, double tolerance);
+
+    void _subdivide(double t0, double v0,
+                    double t1, double v1,
+                    double tolerance,
+                    int depth);
+
 private:
     QString _nodeName;
     QString _prmName;
     const em::time_value *_timeValue;
+
+    // Tessellation of the curve over [_tMin, _tMax], with a maximum
+    // value error of _tolerance, re-built only when the view leaves that
+    // interval or zooms by more than a factor of two.
+
+    QPainterPath _visiblePath;
+    double _tMin;
+    double _tMax;
+    double _tolerance;
+    bool _valid;
 };
 
 #endif // NS_CURVEITEM_H
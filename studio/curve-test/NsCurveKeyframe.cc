@@ -15,6 +15,7 @@
 // -----------------------------------------------------------------------------
 
 #include "NsCurveKeyframe.h"
+#include "NsCurveItem.h"
 #include <QtGui>
 
 #include <sstream>
@@ -140,6 +141,13 @@ NsCurveKeyframe::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
     ss << scenePos().x() << ":" << scenePos().y();
     setToolTip(ss.str().c_str());
 
+    // The keyframe may have been moved, re-tessellate its curve.
+
+    NsCurveItem *curve(dynamic_cast<NsCurveItem*>(parentItem()));
+    if (0 != curve) {
+        curve->invalidate();
+    }
+
     QGraphicsItem::mouseReleaseEvent(event);
 }
 
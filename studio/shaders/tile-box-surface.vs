@@ -0,0 +1,58 @@
+#version 130
+
+// -----------------------------------------------------------------------------
+//
+// tile-box-surface.vs
+//
+// Vertex shader for rendering the exposed faces of instanced tiles.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved.
+//
+// This file is part of Naiad Studio.
+//
+// Naiad Studio is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// Naiad Studio is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// If you did not receive a copy of the GNU General Public License
+// along with Naiad Studio, please see <http://www.gnu.org/licenses/>.
+//
+
+uniform mat4 projection;
+uniform mat4 modelview;
+
+uniform vec3  tileOrigin;       // World space position of tile (0,0,0).
+uniform float fineTileSize;     // World space size of level 0 tiles.
+uniform float coarseTileSize;   // World space size of level 1 tiles.
+
+in vec4  corner;    // Unit cube corner (xyz) and face index (w).
+in vec4  tile;      // Per instance: tile coordinates (xyz) and level (w).
+in float mask;      // Per instance: one bit per face to draw.
+
+out vec3 fragEye;
+
+
+void main()
+{
+    if (0 == ((int(mask) >> int(corner.w)) & 1)) {
+        // Face not drawn, move it outside the clip volume.
+
+        fragEye     = vec3(0.0);
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    float size = (0.0 == tile.w) ? fineTileSize : coarseTileSize;
+    vec3  wsx  = tileOrigin + (tile.xyz + corner.xyz)*size;
+
+    // Standard transforms.
+
+    vec4 esx     = modelview*vec4(wsx, 1.0);
+    fragEye      = esx.xyz;
+    gl_Position  = projection*esx;    // Clip-space.
+}
@@ -0,0 +1,56 @@
+#version 130
+
+// -----------------------------------------------------------------------------
+//
+// tile-grid.vs
+//
+// Vertex shader for rendering an instanced cell grid.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved.
+//
+// This file is part of Naiad Studio.
+//
+// Naiad Studio is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// Naiad Studio is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// If you did not receive a copy of the GNU General Public License
+// along with Naiad Studio, please see <http://www.gnu.org/licenses/>.
+//
+
+#extension GL_ARB_draw_instanced : require
+
+uniform mat4 projection;
+uniform mat4 modelview;
+
+uniform vec3  gridMin;
+uniform vec3  gridMax;
+uniform float cellSize;
+uniform int   axis0;        // The first lineCount0 lines run along axis0,
+uniform int   axis1;        // the remaining ones along axis1.
+uniform int   lineCount0;
+
+in float endpoint;  // 0 or 1.
+
+void main()
+{
+    // One instance per grid line.
+
+    vec3 wsx = gridMin;
+
+    if (gl_InstanceIDARB < lineCount0) {
+        wsx[axis0]  = mix(gridMin[axis0], gridMax[axis0], endpoint);
+        wsx[axis1] += float(gl_InstanceIDARB)*cellSize;
+    }
+    else {
+        wsx[axis1]  = mix(gridMin[axis1], gridMax[axis1], endpoint);
+        wsx[axis0] += float(gl_InstanceIDARB - lineCount0)*cellSize;
+    }
+
+    gl_Position = (projection*modelview)*vec4(wsx, 1.0);
+}
@@ -49,18 +49,25 @@
 #include <Nbx.h>    // NB_THROW
 #include <NbLog.h>  // NB_WARNING
 #include <NbParticleShape.h>
+#include <NbPointShape.h>
 #include <NbBufferChannelBase.h>
 #include <NbBufferShape.h>
 
+#include <algorithm>
+#include <iomanip>
 #include <sstream>
 
+//! Maximum total size of the kept probe results of a body. [static]
+const std::size_t Ns3DBody::_probeBudget(64*1024*1024);
+
 
 // Ns3DBody
 // ---------------
-//! Constructor.
+//! Constructor. See Ns3DResourceObject for the cache name.
 
-Ns3DBody::Ns3DBody(const Nb::Body* body)
-    : Ns3DResourceObject(),_body(body)
+Ns3DBody::Ns3DBody(const Nb::Body* body, const NtString& cacheName)
+    : Ns3DResourceObject(cacheName),_body(body)
+    , _probeBytes(0)
 {
 #if 0
     std::cerr << "Create Ns3DBody: '" << _body->name() << "'\n";
@@ -912,7 +919,8 @@ Ns3DBody::createChannel3fFrom1iVertexBufferLine(const NtString& bodyChannel,
 
 // sampleChannel1fVertexBuffer
 // ---------------------------
-//! Create a vertex buffer by sampling a Nb::Body channel.
+//! Create a vertex buffer by sampling a scalar Nb::Body field channel at
+//! the locations given by a particle or point channel.
 
 Ngl::VertexBuffer*
 Ns3DBody::sampleChannel1fVertexBuffer(const NtString& bodyChannel,
@@ -921,40 +929,21 @@ Ns3DBody::sampleChannel1fVertexBuffer(const NtString& bodyChannel,
                                       const int         block1,
                                       const GLenum      usage)
 {
-    const NtString name(longName(bodyChannel,samplingChannel));
-    Ngl::VertexBuffer* vtxBuf(
-        queryMutableVertexBuffer(bodyChannel,samplingChannel)
-        );
-
-    if (0 != vtxBuf) {
-        NB_THROW("Vertex buffer '" << name << "' already exists");
-        return vtxBuf;  // Return existing buffer
-    }
-
-    //const Nb::FieldShape& field(_body->constFieldShape());
-
-    const NtString bodyShStr(bodyChannel.parent());   // Shape name
-    //const NtString bodyChStr(bodyChannel.child());    // Channel name
-    const NtString sampShStr(samplingChannel.parent());
-    //const NtString sampChStr(samplingChannel.child());
-
-    if (!("Field" == bodyShStr)) {
-        NB_THROW("Invalid Shape for sampling: '" << bodyShStr <<
-                 "' (must be 'Field'");
-    }
-
-    if (!_validSamplingShape(sampShStr)) {
-        NB_THROW("Invalid sampling shape: '" << sampShStr <<
-                 "' (must be 'Particle' or 'Point'");
-    }
-
-    NB_THROW("TODO: Implement!");
+    return _sampleVertexBuffer(bodyChannel,
+                               samplingChannel,
+                               block0,
+                               block1,
+                               1,
+                               false,
+                               usage);
 }
 
 
 // sampleChannel3fVertexBuffer
 // ---------------------------
-//! Create a vertex attribute by sampling a Nb::Body channel.
+//! Create a vertex attribute by sampling a Nb::Body field channel at the
+//! locations given by a particle or point channel. Scalar channels are
+//! sampled as gradients, vector channels as values.
 
 Ngl::VertexBuffer*
 Ns3DBody::sampleChannel3fVertexBuffer(const NtString& bodyChannel,
@@ -963,243 +952,466 @@ Ns3DBody::sampleChannel3fVertexBuffer(const NtString& bodyChannel,
                                       const int         block1,
                                       const GLenum      usage)
 {
-    const NtString name(longName(bodyChannel,samplingChannel));
-    Ngl::VertexBuffer* vtxBuf=
-        queryMutableVertexBuffer(bodyChannel,samplingChannel);
-    
-    if (0 != vtxBuf) {
-        NB_THROW("Vertex buffer '" << name << "' already exists");
-        return vtxBuf;      // Return existing buffer
-    }
-
-    //const Nb::FieldShape& field(_body->constFieldShape());
+    return _sampleVertexBuffer(bodyChannel,
+                               samplingChannel,
+                               block0,
+                               block1,
+                               3,
+                               false,
+                               usage);
+}
 
-    const NtString bodyShStr(bodyChannel.parent());   // Shape name
-    const NtString bodyChStr(bodyChannel.child());    // Channel name
-    const NtString sampShStr(samplingChannel.parent());
-    const NtString sampChStr(samplingChannel.child());
 
-    if (!("Field" == bodyShStr)) {
-        NB_THROW("Invalid Shape for sampling: '" << bodyShStr <<
-                 "' (must be 'Field'");
-    }
+// sampleChannel3fVertexBufferLine
+// -------------------------------
+//! Create a vertex attribute by sampling a Nb::Body field channel, as for
+//! sampleChannel3fVertexBuffer(), with the samples stored twice, once for
+//! each end of the particle lines.
 
-    if (!_validSamplingShape(sampShStr)) {
-        NB_THROW("Invalid sampling shape: '" << sampShStr <<
-                 "' (must be 'Particle' or 'Point'");
-    }
+Ngl::VertexBuffer*
+Ns3DBody::sampleChannel3fVertexBufferLine(const NtString& bodyChannel,
+                                          const NtString& samplingChannel,
+                                          const int         block0,
+                                          const int         block1,
+                                          const GLenum      usage)
+{
+    return _sampleVertexBuffer(bodyChannel,
+                               samplingChannel,
+                               block0,
+                               block1,
+                               3,
+                               true,
+                               usage);
+}
 
 
-    if ("Particle" == sampShStr && _body->hasShape("Field")) {
-        // Use a particle channel to determine sampling locations
+// particleProbeSet
+// ----------------
+//! Returns the positions stored in a particle channel, over the given
+//! inclusive block range, as a probe set.
 
-        // Will throw if _body has no field shape!
+Ns3DBody::ProbeSet
+Ns3DBody::particleProbeSet(const NtString& particleChannel,
+                           const int       block0,
+                           const int       block1) const
+{
+    ProbeSet probes;
+    _particlePoints(particleChannel, block0, block1, probes.points);
 
-        const Nb::FieldShape& field(_body->constFieldShape());
+    std::stringstream ss;
+    ss << particleChannel << "[" << block0 << "," << block1 << "]";
+    probes.key = ss.str();
+    return probes;
+}
 
-        const Nb::ParticleShape&  particle(_body->constParticleShape());
-        const em::block3_array3f& blocks3f(particle.constBlocks3f(sampChStr));
 
-        const int b0(std::max(0,block0));
-        const int b1(std::min(block1+1,blocks3f.block_count()));
-        const int blockCount(b1-b0);
-        if(blockCount<0)
-            NB_THROW("Invalid block range");
+// pointProbeSet
+// -------------
+//! Returns the positions stored in a point channel as a probe set.
 
-        // Query sampling locations.
+Ns3DBody::ProbeSet
+Ns3DBody::pointProbeSet(const NtString& pointChannel) const
+{
+    ProbeSet probes;
+    _pointPoints(pointChannel, probes.points);
+    probes.key = pointChannel;
+    return probes;
+}
 
-        em::array1i baseCount(blockCount);
-        int count(0);
-        for(int b(b0); b < b1; ++b) {
-            baseCount[b-b0] = count;
-            count += blocks3f(b-b0).size();
-        }
 
-        const Nb::TileLayout& layout(_body->constLayout());
+// lineProbeSet
+// ------------
+//! Returns a probe set of evenly spaced points from p0 to p1, both
+//! included. [static]
 
-        // If the requested channel has scalar values, sample the gradients.
+Ns3DBody::ProbeSet
+Ns3DBody::lineProbeSet(const NtVec3f& p0, const NtVec3f& p1, const int count)
+{
+    ProbeSet probes;
+    probes.points.resize(std::max(0, count));
 
-        if (channelType(bodyChannel) == Nb::ValueBase::FloatType) {
+    const float dt(1 < count ? 1.f/(count - 1) : 0.f);
+    for (int i = 0; i < count; ++i) {
+        probes.points[i] = p0 + (i*dt)*(p1 - p0);
+    }
 
-            const Nb::FieldChannel1f& fieldChannel1f(
-                field.constChannel1f(bodyChannel)
-                );
+    std::stringstream ss;
+    ss << std::setprecision(9) << "Line("
+       << p0[0] << "," << p0[1] << "," << p0[2] << ";"
+       << p1[0] << "," << p1[1] << "," << p1[2] << ";"
+       << count << ")";
+    probes.key = ss.str();
+    return probes;
+}
 
-            std::vector<NtVec3f> gradients(count, NtVec3f(0.f));
 
-#pragma omp parallel for schedule(guided)
-            for(int b=b0; b < b1; ++b) {
-                int count(baseCount[b-b0]);
-                for(int p(0); p < blocks3f(b-b0).size(); ++p) {
-                    NtVec3f grad;
-                    fieldChannel1f.sampleGradientLinear(
-                        blocks3f(b-b0)(p), layout, grad);
-                    gradients[count++] = grad;
-                }
-            }
+// planeProbeSet
+// -------------
+//! Returns a probe set of countU by countV points spanning the
+//! parallelogram origin + s*u + t*v, s and t in [0,1]. Points are stored
+//! row by row, u varying fastest. [static]
 
-            qDebug() << "Ns3DBody::sampleChannel3fVertexBuffer - Create VBO: '" 
-                     << name.str().c_str() << "'";
-            return
-                createVertexBuffer(
-                    bodyChannel,
-                    samplingChannel,
-                    sizeof(NtVec3f)*gradients.size(),
-                    &gradients[0],
-                    GL_ARRAY_BUFFER,
-                    usage);
-        }
-        else if (channelType(bodyChannel) == Nb::ValueBase::Vec3fType) {
-            // If field is a vector field LERP values at sampling locations.
-            NB_THROW("TODO: Implement!");
+Ns3DBody::ProbeSet
+Ns3DBody::planeProbeSet(const NtVec3f& origin,
+                        const NtVec3f& u,
+                        const NtVec3f& v,
+                        const int      countU,
+                        const int      countV)
+{
+    ProbeSet probes;
+    probes.points.resize(std::max(0, countU)*std::max(0, countV));
+
+    const float ds(1 < countU ? 1.f/(countU - 1) : 0.f);
+    const float dt(1 < countV ? 1.f/(countV - 1) : 0.f);
+    for (int j = 0; j < countV; ++j) {
+        for (int i = 0; i < countU; ++i) {
+            probes.points[j*countU + i] = origin + (i*ds)*u + (j*dt)*v;
         }
     }
-    else if ("Point" == sampShStr) {
-        //const Nb::PointShape& point(_body->constPointShape());
 
-        // Body has point shape.
+    std::stringstream ss;
+    ss << std::setprecision(9) << "Plane("
+       << origin[0] << "," << origin[1] << "," << origin[2] << ";"
+       << u[0] << "," << u[1] << "," << u[2] << ";"
+       << v[0] << "," << v[1] << "," << v[2] << ";"
+       << countU << "," << countV << ")";
+    probes.key = ss.str();
+    return probes;
+}
+
+
+// probeChannel
+// ------------
+//! Samples a field channel at the points of a probe set. Scalar channels
+//! give one value per point, or three if the gradient is requested, and
+//! vector channels give three values per point. The result is computed in
+//! parallel on first request and then kept until the body is destroyed or
+//! destroyProbes() is called, or until it is the least recently used
+//! result once the kept results exceed the probe budget. The returned
+//! reference is valid until the next call.
+
+const Ns3DBody::ProbeValues&
+Ns3DBody::probeChannel(const NtString& fieldChannel,
+                       const ProbeSet& probes,
+                       const bool      gradient)
+{
+    const NtString name(_probeName(fieldChannel, probes.key, gradient));
+
+    _ProbeMap::iterator find(_probeMap.find(name));
+    if (find != _probeMap.end()) {
+        _probeLru.splice(_probeLru.end(), _probeLru, find->second.lru);
+        return find->second.values;     // Found.
+    }
+
+    ProbeValues result;
+    _probe(fieldChannel, probes.points, gradient, result);
+
+    find = _probeMap.insert(_ProbeMap::value_type(name, _Probe())).first;
+    _Probe &probe(find->second);
+    probe.values.components = result.components;
+    probe.values.values.swap(result.values);
+    probe.lru = _probeLru.insert(_probeLru.end(), name);
+    _probeBytes += probe.values.values.size()*sizeof(float);
+
+    // Evict the least recently used results, but never the new one.
 
-        NB_THROW("TODO: Implement!");
+    while (_probeBudget < _probeBytes && _probeLru.front() != name) {
+        const _ProbeMap::iterator evict(_probeMap.find(_probeLru.front()));
+        _probeBytes -= evict->second.values.values.size()*sizeof(float);
+        _probeLru.pop_front();
+        _probeMap.erase(evict);
     }
 
-    return 0;   // Null.
+    return probe.values;
 }
 
 
-// sampleChannel3fVertexBufferLine
-// -------------------------------
-//! Create a vertex attribute by sampling a Nb::Body channel.
+// destroyProbes
+// -------------
+//! Releases all kept probe results.
 
-Ngl::VertexBuffer*
-Ns3DBody::sampleChannel3fVertexBufferLine(const NtString& bodyChannel,
-                                          const NtString& samplingChannel,
-                                          const int         block0,
-                                          const int         block1,
-                                          const GLenum      usage)
+void
+Ns3DBody::destroyProbes()
 {
-    const NtString name(longName(bodyChannel + NtString("-line"), samplingChannel));
-    Ngl::VertexBuffer* vtxBuf=
-        queryMutableVertexBuffer(bodyChannel + NtString("-line"), samplingChannel);
+    _probeMap.clear();
+    _probeLru.clear();
+    _probeBytes = 0;
+}
 
-    if (0 != vtxBuf) {
-        NB_THROW("Vertex buffer '" << name << "' already exists");
-        return vtxBuf;      // Return existing buffer
-    }
 
-    //const Nb::FieldShape& field(_body->constFieldShape());
+// queryProbe
+// ----------
+//! Returns a cached probe result, or null if the channel has not been
+//! probed at the given probe set.
 
-    const NtString bodyShStr(bodyChannel.parent());   // Shape name
-    const NtString bodyChStr(bodyChannel.child());    // Channel name
-    const NtString sampShStr(samplingChannel.parent());
-    const NtString sampChStr(samplingChannel.child());
+const Ns3DBody::ProbeValues*
+Ns3DBody::queryProbe(const NtString& fieldChannel,
+                     const NtString& probeKey,
+                     const bool      gradient) const
+{
+    const _ProbeMap::const_iterator find(
+        _probeMap.find(_probeName(fieldChannel, probeKey, gradient)));
 
-    if (!("Field" == bodyShStr)) {
-        NB_THROW("Invalid Shape for sampling: '" << bodyShStr <<
-                 "' (must be 'Field'");
+    if (find != _probeMap.end()) {
+        return &find->second.values;    // Found.
     }
 
-    if (!_validSamplingShape(sampShStr)) {
-        NB_THROW("Invalid sampling shape: '" << sampShStr <<
-                 "' (must be 'Particle' or 'Point'");
-    }
+    return 0;   // Null
+}
 
 
-    if ("Particle" == sampShStr && _body->hasShape("Field")) {
-        // Use a particle channel to determine sampling locations
+// _validSamplingShape
+// ---------------------
+//! Returns true if
 
-        // Will throw if _body has no field shape!
+bool
+Ns3DBody::_validSamplingShape(const NtString& shape)
+{
+    return ("Particle" == shape ||
+            "Point"    == shape);
+}
 
-        const Nb::FieldShape& field(_body->constFieldShape());
 
-        const Nb::ParticleShape&  particle(_body->constParticleShape());
-        const em::block3_array3f& blocks3f(particle.constBlocks3f(sampChStr));
+// _particlePoints
+// ---------------
+//! Gathers the positions of a particle channel over the given inclusive
+//! block range. Each block is copied to its offset in parallel.
+
+void
+Ns3DBody::_particlePoints(const NtString&       particleChannel,
+                          const int             block0,
+                          const int             block1,
+                          std::vector<NtVec3f>& points) const
+{
+    const Nb::ParticleShape&  particle(_body->constParticleShape());
+    const em::block3_array3f& blocks3f(
+        particle.constBlocks3f(particleChannel.child()));
 
-        const int b0(std::max(0, block0));
-        const int b1(std::min(block1 + 1, blocks3f.block_count()));
-        const int blockCount(b1-b0);
+    const int b0(std::max(0, block0));
+    const int b1(std::min(block1 + 1, blocks3f.block_count()));
 
-        if(blockCount<0) {
-            NB_THROW("Invalid block range");
-        }
+    points.clear();
+    if (b1 <= b0) {
+        return;     // Empty range.
+    }
 
-        // Query sampling locations.
+    // Offset of each block in the gathered points, relative to b0.
 
-        em::array1i baseCount(blockCount);
-        int count(0);
-        for(int b(b0); b < b1; ++b) {
-            baseCount[b] = count;
-            count += blocks3f(b).size();
-        }
+    std::vector<int> baseCount(b1 - b0 + 1, 0);
+    for (int b = b0; b < b1; ++b) {
+        baseCount[b - b0 + 1] = baseCount[b - b0] + blocks3f(b).size();
+    }
+
+    points.resize(baseCount.back());
 
-        if (0 == count) {
-            NB_THROW("Invalid count");
+#pragma omp parallel for schedule(guided)
+    for (int b = b0; b < b1; ++b) {
+        const em::block3vec3f &srcb(blocks3f(b));
+        int i(baseCount[b - b0]);
+        for (int p = 0; p < srcb.size(); ++p) {
+            points[i++] = srcb(p);
         }
+    }
+}
 
-        const Nb::TileLayout& layout(_body->constLayout());
 
-        // If the requested channel has scalar values, sample the gradients.
+// _pointPoints
+// ------------
+//! Gathers the positions of a point channel.
 
-        if (channelType(bodyChannel) == Nb::ValueBase::FloatType) {
+void
+Ns3DBody::_pointPoints(const NtString&       pointChannel,
+                       std::vector<NtVec3f>& points) const
+{
+    const Nb::PointShape& point(_body->constPointShape());
+    const Nb::Buffer3f&   buf3f(point.constBuffer3f(pointChannel.child()));
+    const int             count(static_cast<int>(buf3f.size()));
 
-            const Nb::FieldChannel1f& fieldChannel1f(
-                field.constChannel1f(bodyChannel)
-                );
+    points.resize(count);
 
-            std::vector<NtVec3f> gradients(count, NtVec3f(0.f));
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; ++i) {
+        points[i] = buf3f[i];
+    }
+}
 
-#pragma omp parallel for schedule(guided)
-            for(int b=b0; b < b1; ++b) {
-                int count(baseCount[b]);
-                for(int p(0); p < blocks3f(b).size(); ++p) {
-                    NtVec3f grad;
-                    fieldChannel1f.sampleGradientLinear(
-                        blocks3f(b)(p), layout, grad);
-                    gradients[count++] = grad;
-                }
-            }
 
-            // Duplicate!
+// _probe
+// ------
+//! Samples a field channel at the given points, in parallel. Each point
+//! writes its own values, so no synchronization is needed.
 
-            std::vector<NtVec3f> vboData(gradients);
-            vboData.insert(vboData.end(), gradients.begin(), gradients.end());
+void
+Ns3DBody::_probe(const NtString&             fieldChannel,
+                 const std::vector<NtVec3f>& points,
+                 const bool                  gradient,
+                 ProbeValues&                result) const
+{
+    if (!("Field" == fieldChannel.parent())) {
+        NB_THROW("Invalid Shape for probing: '" << fieldChannel.parent() <<
+                 "' (must be 'Field'");
+    }
+
+    // Will throw if _body has no field shape!
+
+    const Nb::FieldShape& field(_body->constFieldShape());
+    const Nb::TileLayout& layout(_body->constLayout());
+    const NtString        chStr(fieldChannel.child());
+    const int             count(static_cast<int>(points.size()));
+
+    const Nb::ValueBase::Type type(channelType(fieldChannel));
 
-            qDebug() << "Ns3DBody::sampleChannel3fVertexBufferLine - Create VBO: '" 
-                     << name.str().c_str() << "'";
+    if (Nb::ValueBase::FloatType == type) {
+        const Nb::Field1f& fld(field.constField1f(chStr));
 
-            return
-                createVertexBuffer(
-                    bodyChannel + NtString("-line"),
-                    samplingChannel,
-                    sizeof(NtVec3f)*vboData.size(),
-                    &vboData[0],
-                    GL_ARRAY_BUFFER,
-                    usage);
+        result.components = (gradient ? 3 : 1);
+        result.values.resize(result.components*count);
+        float *values(result.values.empty() ? 0 : &result.values[0]);
+
+        if (gradient) {
+#pragma omp parallel for schedule(static)
+            for (int i = 0; i < count; ++i) {
+                NtVec3f grad;
+                Nb::sampleFieldGradient1f(points[i], layout, fld, grad);
+                values[3*i + 0] = grad[0];
+                values[3*i + 1] = grad[1];
+                values[3*i + 2] = grad[2];
+            }
         }
-        else if (channelType(bodyChannel) == Nb::ValueBase::Vec3fType) {
-            // If field is a vector field LERP values at sampling locations.
-            NB_THROW("TODO: Implement!");
+        else {
+#pragma omp parallel for schedule(static)
+            for (int i = 0; i < count; ++i) {
+                values[i] = Nb::sampleField1f(points[i], layout, fld);
+            }
         }
     }
-    else if ("Point" == sampShStr) {
-        //const Nb::PointShape& point(_body->constPointShape());
+    else if (Nb::ValueBase::Vec3fType == type) {
+        if (gradient) {
+            NB_THROW("Cannot probe gradient of vector channel '" <<
+                     fieldChannel << "'");
+        }
+
+        const Nb::Field1f& fld0(field.constField3f(chStr, 0));
+        const Nb::Field1f& fld1(field.constField3f(chStr, 1));
+        const Nb::Field1f& fld2(field.constField3f(chStr, 2));
 
-        // Body has point shape.
+        result.components = 3;
+        result.values.resize(3*count);
+        float *values(result.values.empty() ? 0 : &result.values[0]);
 
-        NB_THROW("TODO: Implement!");
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < count; ++i) {
+            values[3*i + 0] = Nb::sampleField1f(points[i], layout, fld0);
+            values[3*i + 1] = Nb::sampleField1f(points[i], layout, fld1);
+            values[3*i + 2] = Nb::sampleField1f(points[i], layout, fld2);
+        }
+    }
+    else {
+        NB_THROW("Channel '" << fieldChannel <<
+                 "' is not of type Float or Vec3f");
     }
+}
 
-    return 0;   // Null.
+
+// _samplingPoints
+// ---------------
+//! Gathers the locations given by a particle channel, over the given
+//! inclusive block range, or by a point channel, which has no blocks.
+
+void
+Ns3DBody::_samplingPoints(const NtString&       samplingChannel,
+                          const int             block0,
+                          const int             block1,
+                          std::vector<NtVec3f>& points) const
+{
+    if ("Particle" == samplingChannel.parent()) {
+        _particlePoints(samplingChannel, block0, block1, points);
+    }
+    else {
+        _pointPoints(samplingChannel, points);
+    }
 }
 
 
-// _validSamplingShape
-// ---------------------
-//! Returns true if
+// _sampleVertexBuffer
+// -------------------
+//! Create a vertex buffer by sampling a field channel at the locations
+//! given by a sampling channel, with the given number of components per
+//! location. Scalar channels give their gradients if three components are
+//! requested. Line buffers store the samples twice, and are named after
+//! the body channel with a "-line" suffix. Returns null if the body has no
+//! field shape.
 
-bool
-Ns3DBody::_validSamplingShape(const NtString& shape)
+Ngl::VertexBuffer*
+Ns3DBody::_sampleVertexBuffer(const NtString& bodyChannel,
+                              const NtString& samplingChannel,
+                              const int       block0,
+                              const int       block1,
+                              const int       components,
+                              const bool      lines,
+                              const GLenum    usage)
 {
-    return ("Particle" == shape ||
-            "Point"    == shape);
-}
+    const NtString bufferChannel(
+        lines ? bodyChannel + NtString("-line") : bodyChannel);
+    const NtString name(longName(bufferChannel, samplingChannel));
+
+    if (0 != queryMutableVertexBuffer(bufferChannel, samplingChannel)) {
+        NB_THROW("Vertex buffer '" << name << "' already exists");
+    }
+
+    const NtString bodyShStr(bodyChannel.parent());   // Shape name
+    const NtString sampShStr(samplingChannel.parent());
 
+    if (!("Field" == bodyShStr)) {
+        NB_THROW("Invalid Shape for sampling: '" << bodyShStr <<
+                 "' (must be 'Field'");
+    }
+
+    if (!_validSamplingShape(sampShStr)) {
+        NB_THROW("Invalid sampling shape: '" << sampShStr <<
+                 "' (must be 'Particle' or 'Point'");
+    }
+
+    if (!_body->hasShape("Field")) {
+        return 0;   // Null.
+    }
+
+    std::vector<NtVec3f> points;
+    _samplingPoints(samplingChannel, block0, block1, points);
+
+    const bool gradient(
+        3 == components &&
+        Nb::ValueBase::FloatType == channelType(bodyChannel));
+
+    ProbeValues samples;
+    _probe(bodyChannel, points, gradient, samples);
+
+    if (components != samples.components) {
+        NB_THROW("Channel '" << bodyChannel << "' cannot be sampled with " <<
+                 components << " component(s)");
+    }
+
+    std::vector<float> &vboData(samples.values);
+
+    if (lines) {
+        // Duplicate!
+
+        const std::size_t size(vboData.size());
+        vboData.resize(2*size);
+        std::copy(vboData.begin(),
+                  vboData.begin() + size,
+                  vboData.begin() + size);
+    }
+
+    qDebug() << "Ns3DBody::_sampleVertexBuffer - Create VBO: '"
+             << name.str().c_str() << "'";
+
+    return
+        createVertexBuffer(
+            bufferChannel,
+            samplingChannel,
+            sizeof(float)*vboData.size(),
+            vboData.empty() ? 0 : &vboData[0],
+            GL_ARRAY_BUFFER,
+            usage);
+}
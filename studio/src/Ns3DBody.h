@@ -49,14 +49,43 @@
 #include <NbBody.h>
 #include <NbFieldShape.h>
 
+#include <cstddef>
+#include <list>
+#include <map>
+#include <vector>
+
 // -----------------------------------------------------------------------------
 
 class Ns3DBody : public Ns3DResourceObject
 {
+public:     // Types
+
+    //! Points at which field channels are probed. The key identifies the
+    //! points in the probe cache, so equal keys must mean equal points.
+
+    struct ProbeSet
+    {
+        NtString             key;
+        std::vector<NtVec3f> points;
+    };
+
+    //! Field values at the points of a probe set, 'components' interleaved
+    //! values per point.
+
+    struct ProbeValues
+    {
+        ProbeValues()
+            : components(0)
+        {}
+
+        int                components;
+        std::vector<float> values;
+    };
+
 public:     // Interface
 
     explicit
-    Ns3DBody(const Nb::Body* body);
+    Ns3DBody(const Nb::Body* body, const NtString& cacheName = "");
 
 
     virtual
@@ -195,6 +224,43 @@ public:     // Interface
                                     GLenum            usage = GL_STATIC_DRAW);
     // ----------
 
+    // Probe field channels at arbitrary points, without going through
+    // vertex buffers. Results are cached by channel and probe set; the
+    // body holds a single frame, so the frame is implied.
+
+    ProbeSet
+    particleProbeSet(const NtString& particleChannel,
+                     int             block0,
+                     int             block1) const;
+
+    ProbeSet
+    pointProbeSet(const NtString& pointChannel) const;
+
+    static ProbeSet
+    lineProbeSet(const NtVec3f& p0, const NtVec3f& p1, int count);
+
+    static ProbeSet
+    planeProbeSet(const NtVec3f& origin,
+                  const NtVec3f& u,
+                  const NtVec3f& v,
+                  int            countU,
+                  int            countV);
+
+    const ProbeValues&
+    probeChannel(const NtString& fieldChannel,
+                 const ProbeSet& probes,
+                 bool            gradient = false);
+
+    const ProbeValues*
+    queryProbe(const NtString& fieldChannel,
+               const NtString& probeKey,
+               bool            gradient = false) const;
+
+    void
+    destroyProbes();
+
+    // ----------
+
     //! Returns the name of the resource.
     virtual const NtString 
     name() const 
@@ -239,10 +305,66 @@ private:        // Member variables
 
     const Nb::Body* _body;
 
+    typedef std::list<NtString> _ProbeLru;
+
+    struct _Probe
+    {
+        ProbeValues         values;
+        _ProbeLru::iterator lru;    //!< Position in the eviction order.
+    };
+
+    typedef std::map<NtString, _Probe> _ProbeMap;
+
+    _ProbeMap   _probeMap;      //!< Probe results, see probeChannel().
+    _ProbeLru   _probeLru;      //!< Probe names, least recently used first.
+    std::size_t _probeBytes;    //!< [bytes]
+
+    static const std::size_t _probeBudget;  //!< [bytes]
+
 private:        // Utility functions
 
     static bool
     _validSamplingShape(const NtString& samplingChannel);
+
+    static NtString
+    _probeName(const NtString& fieldChannel,
+               const NtString& probeKey,
+               bool            gradient)
+    {
+        return longName(
+            fieldChannel + NtString(gradient ? "-gradient" : ""), probeKey);
+    }
+
+    void
+    _particlePoints(const NtString&       particleChannel,
+                    int                   block0,
+                    int                   block1,
+                    std::vector<NtVec3f>& points) const;
+
+    void
+    _pointPoints(const NtString&       pointChannel,
+                 std::vector<NtVec3f>& points) const;
+
+    void
+    _samplingPoints(const NtString&       samplingChannel,
+                    int                   block0,
+                    int                   block1,
+                    std::vector<NtVec3f>& points) const;
+
+    Ngl::VertexBuffer*
+    _sampleVertexBuffer(const NtString& bodyChannel,
+                        const NtString& samplingChannel,
+                        int             block0,
+                        int             block1,
+                        int             components,
+                        bool            lines,
+                        GLenum          usage);
+
+    void
+    _probe(const NtString&             fieldChannel,
+           const std::vector<NtVec3f>& points,
+           bool                        gradient,
+           ProbeValues&                result) const;
 };
 
 #endif // NS3D_BODY_H
@@ -74,6 +74,9 @@
 #include <NgNelContext.h>
 
 #include <climits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 class Ns3DCameraScope;
 
@@ -140,192 +143,55 @@ public:
         , _scopeMax(-std::numeric_limits<float>::max(),
                     -std::numeric_limits<float>::max(),
                     -std::numeric_limits<float>::max())
+        , _displayCellShadow(false)
     {}
 
+    //! Bodies are drawn from a retained draw list, which is only rebuilt
+    //! when the graph, a value or the current time has changed. Pure camera
+    //! motion thus replays the list without looking up plugs, evaluating
+    //! scope parameters or querying body bounds.
     virtual void
     drawBodies(const Ns3DCameraScope* cam,
                const Ngl::Viewport&   vp,
                const int              frame)
     {   
         ssHud.str(""); // Clear HUD info.
+        _labels.clear();
 
         resetBounds(_scopeMin, _scopeMax);
 
-        const NsOpObject *op(
-            NsOpStore::instance()->queryConstOp(fromNbStr(name())));
-
-        if (0 != op && "ACTIVE" == op->state()) {
-            Nb::TimeBundle tb(Nb::ZeroTimeBundle);  // TODO: current time?
-
-            const QString showBodies(
-                evalParam1s(    // TODO: current time?
-                    queryParamLongName(op->longName(), "Show Bodies")));
-
-            const bool displayCellShadow(
-                hasParam("Display Cell Shadow") &&
-                "On" == param1e("Display Cell Shadow")->eval(tb));
-
-            int bodyCount = 0;
-            int bodyDrawCount = 0;
-
-            NtVec3f bodyMin(std::numeric_limits<float>::max(),
-                            std::numeric_limits<float>::max(),
-                            std::numeric_limits<float>::max());
-            NtVec3f bodyMax(-std::numeric_limits<float>::max(),
-                            -std::numeric_limits<float>::max(),
-                            -std::numeric_limits<float>::max());
-
-            foreach (const NsBodyInputPlugObject *bipo, op->constBodyInputs()) {
-                if (0 != bipo->source()) {
-                    NsPlugObject *po(
-                        NsOpStore::instance()->queryMutablePlug(
-                            fromNbStr((bipo->source()->longname()))));
-
-                    if (0 != po) {
-                        //const QList<const NsBodyObject*> bodies(
-                        //    po->constBodies());
-
-                        //qDebug() << bodies;
-
-
-//                        QList<const NsBodyObject*> bodies;
-//                        int cvf(1);
-//                        queryCurrentVisibleFrame(&cvf); // Ignore success.
-//                        if (queryIsFrameLive(cvf)) {
-//                            // Current visible frame is the live frame.
-
-//                            bodies = po->constLiveBodies();
-//                        }
-//                        else {
-//                            // Current visible frame is not the live frame.
-                            
-//                            //po->mutableOp()->updateEmpBodyCache();
-//                            bodies = po->constOp()->constCachedBodies();
-//                        }
-
-                        QList<const NsBodyObject*> bodies;
-                        const bool activeOp(!("INACTIVE" == po->constOp()->state()));
-                        int cvf(1);
-                        queryCurrentVisibleFrame(&cvf); // Ignore success.
-                        const bool liveFrame(queryIsFrameLive(cvf));
-
-                        if (liveFrame && activeOp) {
-                            qDebug() << "Scope Live bodies";
-                            bodies = po->constLiveBodies();
-                        }
-                        else {
-                            qDebug() << "Scope cached bodies";
-                            po->mutableOp()->updateEmpBodyCache();
-                            bodies = po->constOp()->constCachedBodies();
-                        }
-
-                        _labels.clear();
-
-                        for (int i(0); i < bodies.size(); ++i) {
-                            NsBodyObject *bo(const_cast<NsBodyObject *>(bodies[i]));
-                            
-                            bodyCount++;
-
-                            if (admitBody(*bo, *bipo, showBodies)) {
-                                // Body is admitted for drawing.
-
-                                //qDebug() << "Admitted:" << bo;
-
-                                // Important to bind a NEL context before
-                                // drawing bodies, since the scope and 
-                                // the body properties may contain NEL 
-                                // expressions!
-                                const Nb::TimeBundle tb = 
-                                    queryCurrentVisibleFrameTimeBundle();
-                                Ng::NelContext nelContext(
-                                    this,&bo->nbBody(),"",tb
-                                    );
-                                
-                                try {
-                                    
-                                    if(bo->nbBody().empty()) {
-                                        ssHud << "Empty Body: '" 
-                                              << fromQStr(bo->name()) 
-                                              << "'";
-                                        bodyDrawCount++;
-                                        continue;
-                                    }
-
-                                    if (draw(bo, cam, vp)) {
-                                        // Query drawn body's bounds and 
-                                        // update scope bounds.
-                                        
-                                        resetBounds(bodyMin, bodyMax);
-                                        bo->nbBody().bounds(bodyMin, bodyMax);
-                                        updateScopeBounds(bodyMin, bodyMax);
-                                        
-
-                                        GLfloat mv[16];
-                                        GLfloat p[16];
-                                        GLint glvp[4];
-                                        glGetFloatv(GL_MODELVIEW_MATRIX, mv);
-                                        glGetFloatv(GL_PROJECTION_MATRIX, p);
-                                        glGetIntegerv(GL_VIEWPORT, glvp);
-                                        em::vec<4,int> vp(glvp[0], glvp[1], glvp[2], glvp[3]);
-
-                                        em::vec<4,GLfloat> eye;
-                                        em::vec<4,GLfloat> clip;
-                                        em::vec<3,GLfloat> ndc;
-                                        em::vec<3,GLfloat> win;
-
-                                        const Ngl::vec3f vtx(
-                                            0.5*(bodyMin[0] + bodyMax[0]),
-                                            0.5*(bodyMin[1] + bodyMax[1]),
-                                            0.5*(bodyMin[2] + bodyMax[2]));
-
-                                        em::project(vtx,
-                                                    vp,
-                                                    em::glmat44<GLfloat>(mv),
-                                                    em::glmat44<GLfloat>(p),
-                                                    eye,
-                                                    clip,
-                                                    ndc,
-                                                    win);
-                                        if ((vp[0] < win[0] && win[0] < vp[2]) &&
-                                            (vp[1] < win[1] && win[1] < vp[3]) &&
-                                            0.f < win[2]) {
-                                            _labels.append(
-                                                LabelInfo(
-                                                    QPointF(win[0], win[1]),
-                                                    bo->name() + QString(" [Body]"),
-                                                    NsPreferences::instance()->scopeViewBodyLabelTextColor()));
-                                        }
-
-                                        if (displayCellShadow) {
-                                            drawCellShadow(
-                                                bo->ns3DBody(),
-                                                param1e("Shadow Cell Size")
-                                                );
-                                        }
-                                        
-                                        //qDebug() << "Drawn:" << bo;
-                                        bodyDrawCount++;
-                                    }
-                                }
-                                catch(std::exception& e) {
-                                    NB_ERROR(name() << ": " << e.what());
-                                }
-                                catch(...) {
-                                    NB_ERROR("Error drawing scope: " << name());
-                                }
-                            }
-                        }
-                    }
-                }
+        const Nb::TimeBundle cvftb(queryCurrentVisibleFrameTimeBundle());
+        if (_drawListStamp.update(NsOpStore::instance()->sceneRevision(),
+                                  cvftb)) {
+            if (!_buildDrawList(cvftb)) {
+                _drawListStamp.invalidate();
+                return;
             }
 
-            if (bodyDrawCount==0 && bodyCount>0) {
-                NB_WARNING("No bodies admitted for drawing in scope '" <<
-                           name() << "': check scope parameters or body feed");
-            }
+            // Building may have loaded body caches, which bumps the scene
+            // revision. Stamp the list with the revision it was built from.
+
+            _drawListStamp.update(NsOpStore::instance()->sceneRevision(),
+                                  cvftb);
         }
 
+        ssHud << _drawListHud;
+
+        for (std::size_t i(0); i < _drawList.size(); ++i) {
+            _drawListItem(_drawList[i], cam, vp, cvftb);
+        }
     }
+
+    //! Forces the retained draw list to be rebuilt on the next draw.
+    void
+    invalidateDrawList()
+    { _drawListStamp.invalidate(); }
+
+    //! True if the previous draw used reduced, interactive quality. The view
+    //! then redraws once it has been idle for a while.
+    virtual bool
+    drewInteractive() const
+    { return false; }
     
     virtual void
     setContext(const QGLContext* context)
@@ -375,6 +241,13 @@ public:
 
 protected:
 
+    //! Called before drawing whenever a value or the current time has 
+    //! changed. Scopes that cache evaluated parameters re-evaluate them here
+    //! instead of in draw(), which is called once per body.
+    virtual void
+    updateParams(const Nb::TimeBundle &tb)
+    {}
+
     void
     updateScopeBounds(const NtVec3f &bodyMin, const NtVec3f &bodyMax)
     {
@@ -417,6 +290,202 @@ protected:
 
     NtVec3f _scopeMin;  //! Bounds of the bodies most recently drawn.
     NtVec3f _scopeMax;  //! Bounds of the bodies most recently drawn.
+
+private:
+
+    //! A body admitted for drawing, with its bounds.
+    struct _DrawListItem
+    {
+        NsBodyObject *body;
+        NtVec3f       bodyMin;
+        NtVec3f       bodyMax;
+    };
+
+    //! Collects the admitted bodies of all body inputs into the draw list.
+    //! Returns false if the scope parameters could not be evaluated.
+    bool
+    _buildDrawList(const Nb::TimeBundle &cvftb)
+    {
+        _drawList.clear();
+        _drawListHud.clear();
+        _displayCellShadow = false;
+
+        const NsOpObject *op(
+            NsOpStore::instance()->queryConstOp(fromNbStr(name())));
+
+        if (0 == op || "ACTIVE" != op->state()) {
+            return true;    // Nothing to draw.
+        }
+
+        Nb::TimeBundle tb(Nb::ZeroTimeBundle);  // TODO: current time?
+
+        const QString showBodies(
+            evalParam1s(    // TODO: current time?
+                queryParamLongName(op->longName(), "Show Bodies")));
+
+        _displayCellShadow =
+            hasParam("Display Cell Shadow") &&
+            "On" == param1e("Display Cell Shadow")->eval(tb);
+
+        // Re-evaluate cached parameters only if a value or the current
+        // time has changed since the last draw.
+
+        if (_paramStamp.update(NsOpStore::instance()->valueRevision(),
+                               cvftb)) {
+            try {
+                updateParams(cvftb);
+            }
+            catch(std::exception& e) {
+                _paramStamp.invalidate();
+                NB_ERROR(name() << ": " << e.what());
+                return false;
+            }
+        }
+
+        int cvf(1);
+        queryCurrentVisibleFrame(&cvf); // Ignore success.
+        const bool liveFrame(queryIsFrameLive(cvf));
+
+        int bodyCount = 0;
+        int bodyAdmitCount = 0;
+        std::stringstream ss;
+
+        foreach (const NsBodyInputPlugObject *bipo, op->constBodyInputs()) {
+            if (0 == bipo->source()) {
+                continue;
+            }
+
+            NsPlugObject *po(
+                NsOpStore::instance()->queryMutablePlug(
+                    fromNbStr((bipo->source()->longname()))));
+
+            if (0 == po) {
+                continue;
+            }
+
+            QList<const NsBodyObject*> bodies;
+            const bool activeOp(!("INACTIVE" == po->constOp()->state()));
+
+            if (liveFrame && activeOp) {
+                bodies = po->constLiveBodies();
+            }
+            else {
+                po->mutableOp()->updateEmpBodyCache();
+                bodies = po->constOp()->constCachedBodies();
+            }
+
+            for (int i(0); i < bodies.size(); ++i) {
+                NsBodyObject *bo(const_cast<NsBodyObject *>(bodies[i]));
+
+                bodyCount++;
+
+                if (!admitBody(*bo, *bipo, showBodies)) {
+                    continue;
+                }
+
+                bodyAdmitCount++;
+
+                if (bo->nbBody().empty()) {
+                    ss << "Empty Body: '" << fromQStr(bo->name()) << "'";
+                    continue;
+                }
+
+                _DrawListItem item;
+                item.body = bo;
+                resetBounds(item.bodyMin, item.bodyMax);
+                bo->nbBody().bounds(item.bodyMin, item.bodyMax);
+                _drawList.push_back(item);
+            }
+        }
+
+        _drawListHud = ss.str();
+
+        if (bodyAdmitCount==0 && bodyCount>0) {
+            NB_WARNING("No bodies admitted for drawing in scope '" <<
+                       name() << "': check scope parameters or body feed");
+        }
+
+        return true;
+    }
+
+    //! Draws a single body of the draw list and adds its label.
+    void
+    _drawListItem(const _DrawListItem   &item,
+                  const Ns3DCameraScope *cam,
+                  const Ngl::Viewport   &vp,
+                  const Nb::TimeBundle  &cvftb)
+    {
+        NsBodyObject *bo(item.body);
+
+        // Important to bind a NEL context before drawing bodies, since the
+        // scope and the body properties may contain NEL expressions!
+
+        Ng::NelContext nelContext(this, &bo->nbBody(), "", cvftb);
+
+        try {
+            if (draw(bo, cam, vp)) {
+                updateScopeBounds(item.bodyMin, item.bodyMax);
+
+                GLfloat mv[16];
+                GLfloat p[16];
+                GLint glvp[4];
+                glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+                glGetFloatv(GL_PROJECTION_MATRIX, p);
+                glGetIntegerv(GL_VIEWPORT, glvp);
+                em::vec<4,int> evp(glvp[0], glvp[1], glvp[2], glvp[3]);
+
+                em::vec<4,GLfloat> eye;
+                em::vec<4,GLfloat> clip;
+                em::vec<3,GLfloat> ndc;
+                em::vec<3,GLfloat> win;
+
+                const Ngl::vec3f vtx(
+                    0.5*(item.bodyMin[0] + item.bodyMax[0]),
+                    0.5*(item.bodyMin[1] + item.bodyMax[1]),
+                    0.5*(item.bodyMin[2] + item.bodyMax[2]));
+
+                em::project(vtx,
+                            evp,
+                            em::glmat44<GLfloat>(mv),
+                            em::glmat44<GLfloat>(p),
+                            eye,
+                            clip,
+                            ndc,
+                            win);
+                if ((evp[0] < win[0] && win[0] < evp[2]) &&
+                    (evp[1] < win[1] && win[1] < evp[3]) &&
+                    0.f < win[2]) {
+                    _labels.append(
+                        LabelInfo(
+                            QPointF(win[0], win[1]),
+                            bo->name() + QString(" [Body]"),
+                            NsPreferences::instance()->scopeViewBodyLabelTextColor()));
+                }
+
+                if (_displayCellShadow) {
+                    drawCellShadow(bo->ns3DBody(),
+                                   param1e("Shadow Cell Size"));
+                }
+            }
+        }
+        catch(std::exception& e) {
+            NB_ERROR(name() << ": " << e.what());
+        }
+        catch(...) {
+            NB_ERROR("Error drawing scope: " << name());
+        }
+    }
+
+private:
+
+    Ns3DParamStamp _paramStamp; //!< When updateParams() was last called.
+
+    // Retained draw list.
+
+    Ns3DParamStamp             _drawListStamp;  //!< When list was built.
+    std::vector<_DrawListItem> _drawList;
+    std::string                _drawListHud;    //!< HUD lines of the list.
+    bool                       _displayCellShadow;
 };
 
 // -----------------------------------------------------------------------------
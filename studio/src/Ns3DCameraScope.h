@@ -52,6 +52,7 @@
 #include "NsStringUtils.h"
 #include "NsCmdSetParam.h"
 #include "NsCmdSetParam3.h"
+#include "NsGraphCallback.h"
 #include "NsQuery.h"
 #include "NsMessageWidget.h"
 
@@ -71,6 +72,8 @@
 //#include "NsGraph.h"
 
 #include <QObject>
+#include <QMap>
+#include <QStringList>
 #include <QDebug>
 
 class Ns3DBBox;
@@ -453,12 +456,63 @@ public:
                        0.f);
     }
 
+    //! Sets the parameters that were held back while the solver was inside
+    //! an op. Returns false if NI is still busy.
+    bool
+    commitParams()
+    {
+        if (_pendingParams.isEmpty()) {
+            return true;
+        }
+
+        const NsGraphCallback::NiLocker locker(NsGraphCallback::NiLocker::Try);
+        if (!locker.isLocked()) {
+            return false;
+        }
+
+        const _ParamMapType params(_pendingParams);
+        _pendingParams.clear();
+
+        const Nb::TimeBundle cvftb(queryCurrentVisibleFrameTimeBundle());
+        for (_ParamMapType::const_iterator iter(params.begin());
+             iter != params.end();
+             ++iter) {
+            const QStringList &values(iter.value());
+            if (1 == values.size()) {
+                NsCmdSetParam::exec(
+                    NsCmdSetParam::ArgsList() <<
+                        NsCmdSetParam::Args(
+                            fromNbStr(name()), iter.key(), values[0], 0));
+                getParam1f(iter.key(), cvftb);  // Refresh last known value.
+            }
+            else {
+                NsCmdSetParam3::exec(
+                    NsCmdSetParam3::ArgsList() <<
+                        NsCmdSetParam3::Args(
+                            fromNbStr(name()),
+                            iter.key(),
+                            values[0],
+                            values[1],
+                            values[2]));
+                getParam3f(iter.key(), cvftb);  // Refresh last known value.
+            }
+        }
+
+        return true;
+    }
+
 protected:      // Utilities for interacting with GUI parameters.
 
     //! TODO: Set NEL context!?
     virtual float
     getParam1f(const QString &paramName, const Nb::TimeBundle &tb) const
     { 
+        const _ParamMapType::const_iterator iter(
+            _pendingParams.find(paramName));
+        if (_pendingParams.end() != iter) {
+            return iter.value()[0].toFloat();
+        }
+
         return evalParam1f(
             queryParamLongName(fromNbStr(name()), paramName), tb);
         //return param1f(fromQStr(paramName))->eval(tb); 
@@ -468,6 +522,14 @@ protected:      // Utilities for interacting with GUI parameters.
     virtual NtVec3f
     getParam3f(const QString &paramName, const Nb::TimeBundle &tb) const
     {
+        const _ParamMapType::const_iterator iter(
+            _pendingParams.find(paramName));
+        if (_pendingParams.end() != iter) {
+            return NtVec3f(iter.value()[0].toFloat(),
+                           iter.value()[1].toFloat(),
+                           iter.value()[2].toFloat());
+        }
+
         const QString paramLongName = 
             queryParamLongName(fromNbStr(name()), paramName);
         return NtVec3f(
@@ -478,20 +540,18 @@ protected:      // Utilities for interacting with GUI parameters.
         //return NtVec3f(prm->eval(tb, 0), prm->eval(tb, 1), prm->eval(tb, 2));
     }
 
-    //! Set the given parameter using a command.
+    //! Set the given parameter using a command. While the solver is inside
+    //! an op the value is held back, see commitParams().
     virtual void
     setParam1f(const QString &paramName, const float value, const int prec = 6)
     {
-        NsCmdSetParam::exec(
-            NsCmdSetParam::ArgsList() <<
-                NsCmdSetParam::Args(
-                    fromNbStr(name()),
-                    paramName,
-                    QString::number(value, 'g', prec),
-                    0));
+        _pendingParams.insert(
+            paramName, QStringList() << QString::number(value, 'g', prec));
+        commitParams();
     }
 
-    //! Set the given vector parameter using a command.
+    //! Set the given vector parameter using a command. While the solver is
+    //! inside an op the value is held back, see commitParams().
     virtual void
     setParam3f(const QString &paramName,
                const float    value0,
@@ -499,14 +559,12 @@ protected:      // Utilities for interacting with GUI parameters.
                const float    value2,
                const int      prec = 6)
     {
-        NsCmdSetParam3::exec(
-            NsCmdSetParam3::ArgsList() <<
-                NsCmdSetParam3::Args(
-                    fromNbStr(name().str()),
-                    paramName,
-                    QString::number(value0, 'g', prec),
-                    QString::number(value1, 'g', prec),
-                    QString::number(value2, 'g', prec)));
+        _pendingParams.insert(
+            paramName,
+            QStringList() << QString::number(value0, 'g', prec)
+                          << QString::number(value1, 'g', prec)
+                          << QString::number(value2, 'g', prec));
+        commitParams();
     }
 
     //! Return pivot.
@@ -687,9 +745,12 @@ private:
 
 private:    // Member variables.
 
+    typedef QMap<QString, QStringList> _ParamMapType;
+
     unsigned int _texId;
     Ngl::ShaderProgram *_imagePlaneShader;
     QString _imagePlaneFileName;
+    _ParamMapType _pendingParams;   //!< Values not yet set in NI.
 };
 
 // -----------------------------------------------------------------------------
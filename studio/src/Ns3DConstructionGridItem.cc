@@ -49,21 +49,14 @@ Ns3DConstructionGridItem::draw(LabelInfo *label) const
 {
     const NtTimeBundle cvftb = queryCurrentVisibleFrameTimeBundle();
     const float mvs = evalParam1f("Global.Master Voxel Size", cvftb);
-    const int halfCount = _count/2;
     glLineWidth(1.f);
-    glBegin(GL_LINES);
     const QColor color =
         NsPreferences::instance()->scopeViewConstructionGridColor();
     glColor3ub(color.red(), color.green(), color.blue());
-    for (int k = 0; k < _count; ++k) {
-        const float z = (k - halfCount)*mvs;
-        glVertex3f(-halfCount*mvs, 0.f, z);
-        glVertex3f( halfCount*mvs, 0.f, z);
-
-        glVertex3f(z, 0.f, -halfCount*mvs);
-        glVertex3f(z, 0.f,  halfCount*mvs);
-    }
-    glEnd();
+    glPushMatrix();
+    glScalef(mvs, mvs, mvs);
+    _grid.draw();
+    glPopMatrix();
 }
 
 // -----------------------------------------------------------------------------
@@ -79,3 +72,23 @@ Ns3DConstructionGridItem::worldBoundingBox() const
                     -mvs, mvs,
                     -halfCount*mvs, halfCount*mvs);
 }
+
+void
+Ns3DConstructionGridItem::_buildGrid()
+{
+    const int halfCount = _count/2;
+    const float h = static_cast<float>(halfCount);
+    std::vector<Ngl::vec3f> vtx;
+    vtx.reserve(4*_count);
+    for (int k = 0; k < _count; ++k) {
+        const float z = static_cast<float>(k - halfCount);
+        vtx.push_back(Ngl::vec3f(-h,  0.f, z));
+        vtx.push_back(Ngl::vec3f( h,  0.f, z));
+
+        vtx.push_back(Ngl::vec3f(z, 0.f, -h));
+        vtx.push_back(Ngl::vec3f(z, 0.f,  h));
+    }
+    _grid.setVertices(vtx);
+}
+
+// -----------------------------------------------------------------------------
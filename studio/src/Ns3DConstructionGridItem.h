@@ -42,6 +42,7 @@
 #define NS3D_CONSTRUCTION_GRID_ITEM_H
 
 #include "Ns3DGraphicsItem.h"
+#include <NglUtils.h>
 
 // -----------------------------------------------------------------------------
 
@@ -54,7 +55,8 @@ public:
         : Ns3DGraphicsItem(-1, false)
         , _count(count)
         , _visible(true)
-    {}
+        , _grid(GL_LINES)
+    { _buildGrid(); }
 
     //! DTOR.
     virtual
@@ -106,10 +108,16 @@ public:
     virtual Ns3DBBox
     worldBoundingBox() const;
 
+private:
+
+    void
+    _buildGrid();
+
 private:    // Member variables.
 
-    int  _count;
-    bool _visible;
+    int       _count;
+    bool      _visible;
+    Ngl::Mesh _grid;    //!< Lines at unit spacing, scaled when drawn.
 };
 
 // -----------------------------------------------------------------------------
@@ -137,7 +137,12 @@ public:
             param3f("Rotate"),
             param3f("Scale"),
             param1i("Slice Count"),
-            param3f("Supersampling")            
+            param3f("Supersampling"),
+            0,  // minValue
+            0,  // maxValue
+            0,  // adaptiveResParam
+            0,  // voxelBudgetParam
+            param1e("Occlusion Culling")
             );
 
         return hudAddField(fld);
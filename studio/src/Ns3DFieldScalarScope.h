@@ -135,7 +135,9 @@ public:
             param1i("Slice Count"),
             param3f("Supersampling"),
             param1f("Min Value"),
-            param1f("Max Value")
+            param1f("Max Value"),
+            param1e("Adaptive Resolution"),
+            param1i("Voxel Budget")
             );
 
         // set the param value to itself, just to trigger the proper
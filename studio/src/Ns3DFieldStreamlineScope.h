@@ -45,6 +45,7 @@
 
 #include "Ns3DOpBoxItem.h"
 #include "Ns3DFieldScope.h"
+#include "NsOpStore.h"
 
 #include <Ni.h>
 #include <NgBodyOp.h>
@@ -88,20 +89,28 @@ public:
          const Ns3DCameraScope* cam,
          const Ngl::Viewport&   vp)
     {
-        drawStreamlines(
-            name(),
-            "",
-            fld,
-            param3f("Translate"),
-            param3f("Rotate"),
-            param3f("Scale"),
-            param1f("Streamline Spacing"),
-            param1f("Streamline Time"),
-            param1i("Samples Per Streamline")
-            );
+        const Nb::TimeBundle cvftb(queryCurrentVisibleFrameTimeBundle());
+        if (_paramStamp.update(NsOpStore::instance()->valueRevision(), 
+                               cvftb)) {
+            evalStreamlineParams(
+                param3f("Translate"),
+                param3f("Rotate"),
+                param3f("Scale"),
+                param1f("Streamline Spacing"),
+                param1f("Streamline Time"),
+                param1i("Samples Per Streamline"),
+                _params);
+        }
+
+        drawStreamlines(name(), "", fld, _params);
 
         return hudAddField(fld);
     }
+
+private:     // Member variables
+
+    Ns3DParamStamp       _paramStamp;
+    Ns3DStreamlineParams _params;
 };
 
 // -----------------------------------------------------------------------------
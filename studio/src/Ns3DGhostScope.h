@@ -65,6 +65,7 @@
 
 #include <QGLFramebufferObject>
 
+#include <algorithm>
 #include <sstream>
 #include <limits>
 //#include <map>
@@ -84,8 +85,12 @@ public:
         , _shader1(0)
         , _shader2(0)
         , _shader3(0)
+        , _interactive(false)
         //, _valRange(0,0)
-    {}
+    {
+        std::fill(_eyeModelviewXf, _eyeModelviewXf + 16, 0.f);
+        std::fill(_eyeProjectionXf, _eyeProjectionXf + 16, 0.f);
+    }
 
     virtual
     ~Ns3DGhostScope() 
@@ -120,6 +125,33 @@ public:
                                      NtString(shaderPath() + "ghost-pass3.fs"));
     }
 
+    //! The camera is considered to be moving if it differs from the 
+    //! previous draw, in which case fewer slices are used. Once the view
+    //! is idle it is redrawn with the full slice count.
+    virtual void
+    drawBodies(const Ns3DCameraScope* cam,
+               const Ngl::Viewport&   vp,
+               const int              frame)
+    {
+        GLfloat eyeModelviewXf[16];
+        GLfloat eyeProjectionXf[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX,  eyeModelviewXf);
+        glGetFloatv(GL_PROJECTION_MATRIX, eyeProjectionXf);
+
+        _interactive = 
+            !std::equal(eyeModelviewXf, eyeModelviewXf + 16, _eyeModelviewXf) ||
+            !std::equal(eyeProjectionXf, eyeProjectionXf + 16, _eyeProjectionXf);
+
+        std::copy(eyeModelviewXf, eyeModelviewXf + 16, _eyeModelviewXf);
+        std::copy(eyeProjectionXf, eyeProjectionXf + 16, _eyeProjectionXf);
+
+        Ns3DBodyScope::drawBodies(cam, vp, frame);
+    }
+
+    virtual bool
+    drewInteractive() const
+    { return _interactive; }
+
     virtual bool
     draw(NsBodyObject*          nsBody,
          const Ns3DCameraScope* cam,
@@ -138,13 +170,17 @@ public:
             param3f("Rotate"),
             param3f("Scale"),
             param1i("Slice Count"),
+            param1i("Interactive Slice Count"),
             param3f("Supersampling"),
             param1i("Light Buffer Size"),
             param3f("Light Direction"),
             param3f("Light Color"),
             param1f("Light Alpha"),
             param3f("Reflective Color"),
-            param1f("Reflective Alpha")
+            param1f("Reflective Alpha"),
+            param1e("Adaptive Resolution"),
+            param1i("Voxel Budget"),
+            _interactive
             );
         
         ssHud << "Body: '" << fromQStr(nsBody->name()) << "\n";
@@ -161,6 +197,9 @@ private:     // Member variables
     Ngl::ShaderProgram* _shader1;   // Pass 1
     Ngl::ShaderProgram* _shader2;   // Pass 2
     Ngl::ShaderProgram* _shader3;   // Pass 3
+    bool                _interactive;
+    GLfloat             _eyeModelviewXf[16];    // At previous draw.
+    GLfloat             _eyeProjectionXf[16];   // At previous draw.
     //Nb::Vec2f           _valRange;
 };
 
@@ -43,6 +43,7 @@
 #define NS3D_GHOST_SCOPE_UTILS_H
 
 #include "Ns3DScopeUtils.h"
+#include "Ns3DSliceScopeUtils.h"
 
 #include <NglShaderProgram.h>
 #include <NglVertexAttrib.h>
@@ -130,6 +131,11 @@ computeLightXforms(const Ngl::SuperTileLayout* superLayout,
 
 // -----------------------------------------------------------------------------
 
+//! Draws the ghost volume using half-angle slicing. Slices are processed 
+//! front-to-back (or back-to-front) across all super-tiles intersecting the
+//! clip-box, alternating between the eye and light buffers once per slice.
+//! When interactive is true the cheaper interactive slice count is used.
+
 inline void
 drawGhostSlicedClipBox(const NtString&      clientName,
                        const NtString&      fieldName,
@@ -143,15 +149,23 @@ drawGhostSlicedClipBox(const NtString&      clientName,
                        const Nb::Value3f*     rotateParam,
                        const Nb::Value3f*     scaleParam,
                        const Nb::Value1i*     sliceCountParam,
+                       const Nb::Value1i*     interactiveSliceCountParam,
                        const Nb::Value3f*     supersamplingParam,
                        const Nb::Value1i*     lightBufSizeParam,
                        const Nb::Value3f*     lightDirParam,
                        const Nb::Value3f*     lightColorParam,
                        const Nb::Value1f*     lightAlphaParam,
                        const Nb::Value3f*     reflColorParam,
-                       const Nb::Value1f*     reflAlphaParam)
+                       const Nb::Value1f*     reflAlphaParam,
+                       const Nb::Value1e*     adaptiveResParam = 0,
+                       const Nb::Value1i*     voxelBudgetParam = 0,
+                       const bool             interactive = false)
 {   
-    const int sliceCount(sliceCountParam->eval(Nb::ZeroTimeBundle));    
+    int sliceCount(sliceCountParam->eval(Nb::ZeroTimeBundle));
+    if (interactive) {
+        sliceCount = std::min(
+            sliceCount, interactiveSliceCountParam->eval(Nb::ZeroTimeBundle));
+    }
     const int lightBufSize(lightBufSizeParam->eval(Nb::ZeroTimeBundle));
 
     // Ensure the window coordinate vertex buffer exists.
@@ -188,9 +202,7 @@ drawGhostSlicedClipBox(const NtString&      clientName,
         invClipBoxXform);
 
     const Ngl::SuperTileLayout* superLayout = 
-        robject->queryConstSuperTileLayout();
-    if(!superLayout)
-        superLayout = robject->createSuperTileLayout(&clipBoxXform[0][0]);
+        robject->createSuperTileLayout(&clipBoxXform[0][0]);
 
     // Modelview & Projection from pov of light
 
@@ -283,14 +295,29 @@ drawGhostSlicedClipBox(const NtString&      clientName,
     Ngl::VertexBuffer* sliceVtxBuf = 
         sliceClipBoxVertexBuffer(clientName,
                                  robject,
-                                 sliceCountParam,
+                                 sliceCount,
                                  clipBoxXform,
                                  sliceModelViewXform,
                                  &sliceSpacing);
 
+    if (!sliceVtxBuf) {
+        return; // No (visible) slices.
+    }
+
     Nb::Vec2f valRange(
         (std::numeric_limits<float>::max)(),
         -(std::numeric_limits<float>::max)());
+
+    // Adapt the super-tile texture resolutions to the current view.
+
+    const bool adaptiveRes(
+        adaptiveResParam &&
+        "On" == adaptiveResParam->eval(Nb::ZeroTimeBundle));
+    const Ns3DResourceObject::TextureLod lod(
+        Ns3DResourceObject::TextureLod::current(
+            voxelBudgetParam ?
+            1.e6*voxelBudgetParam->eval(Nb::ZeroTimeBundle) : 0.));
+
     robject->computeSuperTileTextures(
         clientName,
         fieldName,
@@ -301,7 +328,8 @@ drawGhostSlicedClipBox(const NtString&      clientName,
         &clipBoxXform[0][0],
         true,
         0,
-        &valRange
+        &valRange,
+        adaptiveRes ? &lod : 0
         );
 
     for(int st = 0; st < superLayout->superTileCount(); ++st){
@@ -382,7 +410,7 @@ drawGhostSlicedClipBox(const NtString&      clientName,
         sliceSpacing/robject->constLayoutPtr()->cellSize()
         );
 
-#if 1
+#if 0
     std::cerr << "Min: " << valRange[0] << " | Max: " << valRange[1] << "\n";
 #endif
 
@@ -414,108 +442,122 @@ drawGhostSlicedClipBox(const NtString&      clientName,
     
     shader2->storeUniform1i("ghostTex", 0); // Texture unit 0.
         
+    // Only super-tiles that intersect the clip-box can contribute.
+
+    NtVec3f clipMin, clipMax;
+    computeClipBoxBounds(clipBoxXform, clipMin, clipMax);
+
+    std::vector<const Ngl::Texture3D*> superTileTex;
+    std::vector<NtVec3f> superTileMin;
+    std::vector<NtVec3f> invSuperTileRange;
+
     for(int superTile(0); superTile<superLayout->superTileCount(); ++superTile){
-        // TODO: Check if super-tile intersects clip-box.
-        
         NtVec3f min, max;        
-        superLayout->bounds(min, max);
-        const NtVec3f superTileMin(min);
-        const NtVec3f invSuperTileRange(
-            1.f/(max[0] - min[0]),
-            1.f/(max[1] - min[1]),
-            1.f/(max[2] - min[2])
-            );
-        
-        // Update super-tile shader uniforms only.
-        
-        shader1->storeUniform3f("superTileMin", superTileMin);
-        shader1->storeUniform3f("invSuperTileRange", invSuperTileRange);
-        
-        shader2->storeUniform3f("superTileMin", superTileMin);
-        shader2->storeUniform3f("invSuperTileRange", invSuperTileRange);
-        
-        // Pass super-tile information to shader.
-        
+        superLayout->superTile(superTile).bounds(min, max);
+
+        if (max[0] < clipMin[0] || clipMax[0] < min[0] ||
+            max[1] < clipMin[1] || clipMax[1] < min[1] ||
+            max[2] < clipMin[2] || clipMax[2] < min[2]) {
+            continue;
+        }
+
+        // TODO: Check errors!?
+        superTileTex.push_back(
+            robject->queryConstTexture3D(clientName, fieldName, superTile));
+        superTileMin.push_back(min);
+        invSuperTileRange.push_back(
+            NtVec3f(1.f/(max[0] - min[0]),
+                    1.f/(max[1] - min[1]),
+                    1.f/(max[2] - min[2])));
+    }
+
+    // Upload uniforms shared by all super-tiles once. The per super-tile
+    // uniforms are uploaded by handle below.
+
+    shader1->use();
+    shader1->uploadUniforms(Nb::ZeroTimeBundle);
+    shader1->unuse();
+    
+    shader2->use();
+    shader2->uploadUniforms(Nb::ZeroTimeBundle);
+    shader2->unuse();
+
+    const int superTileMin1(shader1->uniformHandle("superTileMin"));
+    const int invSuperTileRange1(shader1->uniformHandle("invSuperTileRange"));
+    const int superTileMin2(shader2->uniformHandle("superTileMin"));
+    const int invSuperTileRange2(shader2->uniformHandle("invSuperTileRange"));
+
+    // Bind light buffer to texture unit 1, for all slices.
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, lightBuffer->texture());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glActiveTexture(GL_TEXTURE0);
+
+    // Render slices. The eye and light buffers differ in size and each
+    // slice's eye pass reads the light accumulated by the previous slices,
+    // so the buffers cannot be attached to a single framebuffer; we switch
+    // target twice per slice rather than twice per slice and super-tile.
+
+    const GLsizei superTileCount(superTileTex.size());
+    const GLsizei sliceVtxCount(
+        static_cast<GLsizei>(sliceVtxBuf->size()/sizeof(NtVec3f)));
+
+    glPushAttrib(GL_VIEWPORT_BIT);
+
+    for (GLint s(0); 4*s + 4 <= sliceVtxCount; ++s) {
+        // Pass 1, set blending depending on eye/light configuration,
+        // computed when slicing the clip-box.
+
+        eyeBuffer->bind();
+        glViewport(0, 0, eyeBuffer->width(), eyeBuffer->height());
+        glBlendFunc(srcFactor, dstFactor);
+
         shader1->use();
-        shader1->uploadUniforms(Nb::ZeroTimeBundle);
+        Ngl::VertexAttrib::connect(shader1->constAttrib("wsx"),*sliceVtxBuf);
+        for (GLsizei st(0); st < superTileCount; ++st) {
+            superTileTex[st]->bind();   // Texture unit 0.
+            shader1->storeUniform3f(superTileMin1, superTileMin[st]);
+            shader1->storeUniform3f(invSuperTileRange1, invSuperTileRange[st]);
+            shader1->uploadUniform(superTileMin1, Nb::ZeroTimeBundle);
+            shader1->uploadUniform(invSuperTileRange1, Nb::ZeroTimeBundle);
+            glDrawArrays(GL_QUADS, s*4, 4);
+        }
+        Ngl::VertexAttrib::disconnect(shader1->constAttrib("wsx"));
         shader1->unuse();
-        
+
+        // Pass 2, make light buffer current render target. Always render
+        // front-to-back, using over-blending.
+
+        lightBuffer->bind();
+        glViewport(0, 0, lightBuffer->width(), lightBuffer->height());
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);  // Over
+
         shader2->use();
-        shader2->uploadUniforms(Nb::ZeroTimeBundle);
-        shader2->unuse();
-        
-        // TODO: Check errors!?
-        const Ngl::Texture3D* tex3D(
-            robject->queryConstTexture3D(clientName, fieldName, superTile)
-            );
-        
-        // Bind ghost texture to texture unit 0.
-        
-        glActiveTexture(GL_TEXTURE0);
-        tex3D->bind();
-        
-        // Bind light buffer to texture unit 1.
-        
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, lightBuffer->texture());
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        
-        // Render slices.
-        
-        for (GLint s(0); s < sliceCount; ++s) {
-            // Pass 1, set blending depending on eye/light configuration,
-            // computed when slicing the clip-box.
-
-            eyeBuffer->bind();
-            glPushAttrib(GL_VIEWPORT_BIT);
-            glViewport(0, 0, eyeBuffer->width(), eyeBuffer->height());
-            
-            glBlendFunc(srcFactor, dstFactor);
-            
-            Ngl::VertexAttrib::connect(
-                shader1->constAttrib("wsx"),*sliceVtxBuf
-                );
-            shader1->use();
-            glDrawArrays(GL_QUADS, s*4, 4);
-            shader1->unuse();
-            
-            Ngl::VertexAttrib::disconnect(shader1->constAttrib("wsx"));
-            
-            glPopAttrib();  // GL_VIEWPORT_BIT
-            eyeBuffer->release();
-            
-            // Pass 2, make light buffer current render target.
-            
-            lightBuffer->bind();
-            glPushAttrib(GL_VIEWPORT_BIT);
-            glViewport(0, 0, lightBuffer->width(), lightBuffer->height());
-            
-            // Always render front-to-back, using over-blending.
-            
-            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);  // Over
-            
-            Ngl::VertexAttrib::connect(
-                shader2->constAttrib("wsx"),*sliceVtxBuf
-                );
-            shader2->use();
+        Ngl::VertexAttrib::connect(shader2->constAttrib("wsx"),*sliceVtxBuf);
+        for (GLsizei st(0); st < superTileCount; ++st) {
+            superTileTex[st]->bind();   // Texture unit 0.
+            shader2->storeUniform3f(superTileMin2, superTileMin[st]);
+            shader2->storeUniform3f(invSuperTileRange2, invSuperTileRange[st]);
+            shader2->uploadUniform(superTileMin2, Nb::ZeroTimeBundle);
+            shader2->uploadUniform(invSuperTileRange2, Nb::ZeroTimeBundle);
             glDrawArrays(GL_QUADS, s*4, 4);
-            shader2->unuse();
-            
-            Ngl::VertexAttrib::disconnect(shader2->constAttrib("wsx"));
-            
-            glPopAttrib();  // GL_VIEWPORT_BIT
-            lightBuffer->release();
         }
-        
-        // Release light texture.
-        
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        
-        glActiveTexture(GL_TEXTURE0);
-        tex3D->unbind();
+        Ngl::VertexAttrib::disconnect(shader2->constAttrib("wsx"));
+        shader2->unuse();
     }
+
+    lightBuffer->release();
+    glPopAttrib();  // GL_VIEWPORT_BIT
+
+    // Release textures.
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_3D, 0);
     
     // Pass 3, composite eye-buffer onto the screen, or the FBO that was
     // bound before we started rendering.
@@ -176,13 +176,7 @@ public:
         const NtString stLayoutName(_superTileLayoutName(body));
 
         const Ngl::SuperTileLayout* stLayout(
-            nsBody->ns3DBody()->queryConstSuperTileLayout());
-
-        if (0 == stLayout) {
-            const Nb::TileLayout& layout(body->constLayout());
-            stLayout =
-                nsBody->ns3DBody()->createSuperTileLayout(_xf);
-        }
+            nsBody->ns3DBody()->createSuperTileLayout(_xf));
 
         _isoFieldChannel
             = Nb::Op::param1s("Iso Field Channel")->eval(Nb::ZeroTimeBundle, 0);
@@ -376,7 +370,12 @@ public:
             param3f("Rotate"),
             param3f("Scale"),
             param1i("Slice Count"),
-            param3f("Supersampling")
+            param3f("Supersampling"),
+            0,  // minValue
+            0,  // maxValue
+            0,  // adaptiveResParam
+            0,  // voxelBudgetParam
+            param1e("Occlusion Culling")
             );
 
         ssHud << "Body: '" << fromQStr(nsBody->name()) << "\n";
@@ -196,13 +196,7 @@ Ns3DOpBoxItem::_draw(LabelInfo *label) const
                                scale()));
         glMultMatrixf(&xf[0][0]);
 
-        glBegin(GL_LINES);
-        for (int e(0); e < 12; ++e) {
-            for (int i(0); i < 2; ++i) {
-                glVertex3fv(&Ns3DOpBoxItem::vtx[Ns3DOpBoxItem::edge[e][i]][0]);
-            }
-        }
-        glEnd();
+        _unitEdges().draw();
 
         if (0 != label) {
             QPointF pos;
@@ -218,3 +212,26 @@ Ns3DOpBoxItem::_draw(LabelInfo *label) const
 }
 
 // -----------------------------------------------------------------------------
+
+// _unitEdges
+// ----------
+//! Edges of the unit box, shared by all box items. The mesh is never
+//! deleted, since GL may be gone by the time static objects are destroyed.
+
+const Ngl::Mesh&
+Ns3DOpBoxItem::_unitEdges()
+{
+    static Ngl::Mesh *mesh(0);
+    if (0 == mesh) {
+        std::vector<Ngl::vec3f> lineVtx;
+        for (int e(0); e < 12; ++e) {
+            lineVtx.push_back(Ns3DOpBoxItem::vtx[Ns3DOpBoxItem::edge[e][0]]);
+            lineVtx.push_back(Ns3DOpBoxItem::vtx[Ns3DOpBoxItem::edge[e][1]]);
+        }
+        mesh = new Ngl::Mesh(GL_LINES);
+        mesh->setVertices(lineVtx);
+    }
+    return *mesh;
+}
+
+// -----------------------------------------------------------------------------
@@ -48,6 +48,8 @@
 #include <NglTypes.h>
 #include <QString>
 
+namespace Ngl { class Mesh; }
+
 // -----------------------------------------------------------------------------
 
 class Ns3DOpBoxItem : public Ns3DOpItem
@@ -106,6 +108,9 @@ private:
     void
     _draw(LabelInfo *label = 0) const;
 
+    static const Ngl::Mesh&
+    _unitEdges();
+
 protected:  // Member variables. TODO: private
 
     Ngl::vec4f _matAmb;
@@ -204,32 +204,47 @@ Ns3DOpPlaneItem::drawFace()
 void
 Ns3DOpPlaneItem::drawEdge()
 {
-    glBegin(GL_LINES);
-    for (int e = 0; e < 4; ++e) {
-        for (int v = 0; v < 2; ++v) {
-            glVertex3fv(&Ns3DOpPlaneItem::vtx[Ns3DOpPlaneItem::edge[e][v]][0]);
+    // The outline never changes, so it is built once and shared by all
+    // plane items. The meshes are never deleted, since GL may be gone by
+    // the time static objects are destroyed.
+
+    static Ngl::Mesh *edgeMesh(0);
+    static Ngl::Mesh *arrowMesh(0);
+
+    if (0 == edgeMesh) {
+        std::vector<Ngl::vec3f> lineVtx;
+        for (int e = 0; e < 4; ++e) {
+            for (int v = 0; v < 2; ++v) {
+                lineVtx.push_back(
+                    Ns3DOpPlaneItem::vtx[Ns3DOpPlaneItem::edge[e][v]]);
+            }
         }
+        edgeMesh = new Ngl::Mesh(GL_LINES);
+        edgeMesh->setVertices(lineVtx);
+
+        //static const GLfloat h2(0.5f);
+        static const GLfloat h1 = 0.5f*height;//(0.25f);
+        static const GLfloat h0 = 0.5f*height;//(0.25f);
+        static const GLfloat w2(0.1);
+        static const GLfloat w1(0.033);
+        static const GLfloat w0(0.033);
+
+        std::vector<Ngl::vec3f> arrowVtx;
+        arrowVtx.push_back(Ngl::vec3f( 0.5f, 0.f,    0.f));
+        arrowVtx.push_back(Ngl::vec3f( w0,   0.f,    0.f));
+        arrowVtx.push_back(Ngl::vec3f( w1,   h0,     0.f));
+        arrowVtx.push_back(Ngl::vec3f( w2,   h1,     0.f));
+        arrowVtx.push_back(Ngl::vec3f( 0.f,  height, 0.f));
+        arrowVtx.push_back(Ngl::vec3f(-w2,   h1,     0.f));
+        arrowVtx.push_back(Ngl::vec3f(-w1,   h0,     0.f));
+        arrowVtx.push_back(Ngl::vec3f(-w0,   0.f,    0.f));
+        arrowVtx.push_back(Ngl::vec3f(-0.5f, 0.f,    0.f));
+        arrowMesh = new Ngl::Mesh(GL_LINE_STRIP);
+        arrowMesh->setVertices(arrowVtx);
     }
-    glEnd();
 
-    //static const GLfloat h2(0.5f);
-    static const GLfloat h1 = 0.5f*height;//(0.25f);
-    static const GLfloat h0 = 0.5f*height;//(0.25f);
-    static const GLfloat w2(0.1);
-    static const GLfloat w1(0.033);
-    static const GLfloat w0(0.033);
-
-    glBegin(GL_LINE_STRIP);
-    glVertex3f( 0.5f, 0.f,    0.f);
-    glVertex3f( w0,   0.f,    0.f);
-    glVertex3f( w1,   h0,     0.f);
-    glVertex3f( w2,   h1,     0.f);
-    glVertex3f( 0.f,  height, 0.f);
-    glVertex3f(-w2,   h1,     0.f);
-    glVertex3f(-w1,   h0,     0.f);
-    glVertex3f(-w0,   0.f,    0.f);
-    glVertex3f(-0.5f, 0.f,    0.f);
-    glEnd();
+    edgeMesh->draw();
+    arrowMesh->draw();
 }
 
 // -----------------------------------------------------------------------------
@@ -75,8 +75,9 @@ Ns3DOpVectorItem::Ns3DOpVectorItem(NsOpObject    *opObject,
                                    const GLfloat  lineWidth,
                                    const GLfloat  selLineWidth)
     : Ns3DOpItem(opObject, selId)
-    //, _tube(axis, 0.5f*rad, 0.8f*length, 0.f)
-    //, _cone(axis, tangent0, tangent1, 0.8f*length, length, rad)
+    , _tube(axis, 0.5f*rad, 0.8f*length, 0.f)
+    , _cone(axis, tangent0, tangent1, 0.8f*length, length, rad)
+    , _arrowLen(length)
     , _lineWidth(lineWidth)
     , _selLineWidth(selLineWidth)
     , _rollDeg(0.f)
@@ -164,10 +165,13 @@ Ns3DOpVectorItem::_draw(LabelInfo *label) const
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
     const Ngl::vec3f v = getParam3f("Vector");
     const GLfloat len = em::mag(v);
-    const Ngl::Cuboid tube(axis, 0.5f*rad, 0.8f*len, 0.f);
-    const Ngl::Cone cone(axis, tangent0, tangent1, 0.8f*len, len, rad);
-    tube.draw();
-    cone.draw();
+    if (len != _arrowLen) {
+        _tube.set(axis, 0.5f*rad, 0.8f*len, 0.f);
+        _cone = Ngl::Cone(axis, tangent0, tangent1, 0.8f*len, len, rad);
+        _arrowLen = len;
+    }
+    _tube.draw();
+    _cone.draw();
 
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // Default.
 
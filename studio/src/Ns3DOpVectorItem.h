@@ -120,8 +120,12 @@ private:
 
 protected:  // Member variables. TODO: private
 
-    //Ngl::Cuboid _tube;
-    //Ngl::Cone   _cone;
+    // Arrow geometry for the last drawn vector length, rebuilt only when
+    // the length changes.
+
+    mutable Ngl::Cuboid _tube;
+    mutable Ngl::Cone   _cone;
+    mutable GLfloat     _arrowLen;
     GLfloat     _lineWidth;
     GLfloat     _selLineWidth;
     GLfloat     _rollDeg;
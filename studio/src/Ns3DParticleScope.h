@@ -395,7 +395,7 @@ public:
 
         const NtTimeBundle cvftb(queryCurrentVisibleFrameTimeBundle());
 
-        if ("On" == param1e("Frame Bodies")->eval(cvftb)) {
+        if (_params.frameBodies) {
             frameBody(nsBody);
         }
 
@@ -424,12 +424,7 @@ public:
 
         // Set shader
 
-        Ngl::ShaderProgram* shader(_getShader(param1e("Shader")->eval(cvftb)));
-
-        // Update channel info in attribute mapping. [hard-coded!]
-        
-        updateAttribChannel("Gradient Channel", "Field", "xgradient", cvftb);
-        updateAttribChannel("Color Channel", "Particle", "colorChannel", cvftb);
+        Ngl::ShaderProgram* shader(_params.shader);
 
         //Nb::String gc = param1s("Gradient Channel")->eval(Nb::ZeroTimeBundle);
         //if(gc.parent(".")=="") gc = Nb::String("Field.") + gc;
@@ -443,7 +438,7 @@ public:
 
         // Set shader attributes
 
-        const bool drawLines("On" == param1e("Velocity Vectors")->eval(cvftb));
+        const bool drawLines(_params.velocityVectors);
         const GLsizei minCount(
             connectShaderAttribs(*shader, nsBody, cvftb, drawLines));
 
@@ -469,7 +464,7 @@ public:
 
         EM_ASSERT(Ngl::Error::check());
         _drawPoints(cvftb, 
-                    param1f("Pixel Radius")->eval(cvftb),
+                    _params.pixelRadius,
                     drawLines ? minCount/2 : minCount,
                     false);
         EM_ASSERT(Ngl::Error::check());
@@ -518,6 +513,58 @@ public:
 
 protected:
 
+    //! Evaluate all parameters used while drawing bodies. Enumerations are
+    //! resolved here so that draw() never touches the expression evaluator.
+    virtual void
+    updateParams(const Nb::TimeBundle &tb)
+    {
+        _params.frameBodies = ("On" == param1e("Frame Bodies")->eval(tb));
+        _params.shader = _getShader(param1e("Shader")->eval(tb));
+        _params.velocityVectors = 
+            ("On" == param1e("Velocity Vectors")->eval(tb));
+        _params.pixelRadius = param1f("Pixel Radius")->eval(tb);
+
+        // Update channel info in attribute mapping. [hard-coded!]
+
+        updateAttribChannel("Gradient Channel", "Field", "xgradient", tb);
+        updateAttribChannel("Color Channel", "Particle", "colorChannel", tb);
+
+        const bool allBlocks("All" == param1e("Blocks Visibility")->eval(tb));
+        _params.block0 = 
+            allBlocks ? 0 : param1i("Block Range Start")->eval(tb);
+        _params.block1 = 
+            allBlocks ? 200000000 : param1i("Block Range End")->eval(tb);
+
+        const float uscale(param1f("Velocity Display Scale")->eval(tb));
+        _params.scaledDt = uscale/evalParam1i("Global.Fps", tb);
+
+        // Uniforms have always been evaluated at time zero.
+
+        const Nb::TimeBundle &ztb(Nb::ZeroTimeBundle);
+
+        computeClipBoxXforms(
+            param3f("Translate"),
+            param3f("Rotate"),
+            param3f("Scale"),
+            _params.clipXform,
+            _params.invClipXform);
+
+        _params.gradLighting = 
+            ("On" == param1e("Gradient Lighting")->eval(ztb));
+        _params.normalizedGrad = 
+            ("On" == param1e("Normalized Gradient")->eval(ztb));
+        _params.scalarChannel = 
+            ("Scalar" == param1e("Channel Type")->eval(ztb));
+        _params.ambientBrightness = param1f("Ambient Brightness")->eval(ztb);
+        _params.lightDirection = 
+            em::normalized(evalValue3f(param3f("Light Direction"), ztb));
+        _params.whitewaterSpeed = param1f("Whitewater Speed")->eval(ztb);
+        _params.minMag = param1f("Min Visible Magnitude")->eval(ztb);
+        _params.maxMag = param1f("Max Visible Magnitude")->eval(ztb);
+        _params.normalizedRange = 
+            ("On" == param1e("Normalized Range")->eval(ztb));
+    }
+
     //! Set the given vector parameter using a command.
     virtual void
     setParam3f(const QString &paramName,
@@ -571,6 +618,50 @@ private:     // TMP!!
 
 private:     // Member variables
 
+    //! Parameter values cached by updateParams().
+    struct _Params
+    {
+        _Params()
+            : frameBodies(false)
+            , shader(0)
+            , velocityVectors(false)
+            , pixelRadius(1.f)
+            , block0(0)
+            , block1(0)
+            , scaledDt(0.f)
+            , gradLighting(false)
+            , normalizedGrad(false)
+            , scalarChannel(false)
+            , ambientBrightness(0.f)
+            , lightDirection(0.f, 0.f, 1.f)
+            , whitewaterSpeed(0.f)
+            , minMag(0.f)
+            , maxMag(0.f)
+            , normalizedRange(false)
+        {}
+
+        bool                frameBodies;
+        Ngl::ShaderProgram* shader;
+        bool                velocityVectors;
+        GLfloat             pixelRadius;
+        int                 block0;
+        int                 block1;
+        float               scaledDt;
+        em::glmat44f        clipXform;
+        em::glmat44f        invClipXform;
+        bool                gradLighting;
+        bool                normalizedGrad;
+        bool                scalarChannel;
+        GLfloat             ambientBrightness;
+        NtVec3f             lightDirection;
+        GLfloat             whitewaterSpeed;
+        GLfloat             minMag;
+        GLfloat             maxMag;
+        bool                normalizedRange;
+    };
+
+    _Params _params;
+
     typedef std::map<NtString, Ngl::ShaderProgram*> ShaderMap;
 
     ShaderMap           _shaderMap;
@@ -645,20 +736,9 @@ private:    // Utility functions
             return 0; // Shader has no inputs!?
         }
 
-        const NtString blockVisibility(param1e("Blocks Visibility")->eval(tb));
-        const int startBlock(param1i("Block Range Start")->eval(tb));
-        const int endBlock(param1i("Block Range End")->eval(tb));
-
-        const int block0(blockVisibility=="All" ? 0         : startBlock);
-        const int block1(blockVisibility=="All" ? 200000000 : endBlock);
-
-        const float uscale(param1f("Velocity Display Scale")->eval(tb));
-        const float scaledDt(uscale/evalParam1i("Global.Fps", tb));
-
-        const bool gradLighting("On" == param1e("Gradient Lighting")->eval(tb));
-
-        qDebug() << "Gradient Lighting: " << gradLighting;
-        qDebug() << "Draw Lines: " << drawLines;
+        const int block0(_params.block0);
+        const int block1(_params.block1);
+        const float scaledDt(_params.scaledDt);
 
         Ns3DBody *ns3DBody = nsBody->ns3DBody();
 
@@ -921,17 +1001,6 @@ private:    // Utility functions
     void
     setShaderUniforms(Ngl::ShaderProgram& shader)
     {
-        // Compute clip-box matrices.
-
-        em::glmat44f clipXform;
-        em::glmat44f invClipXform;
-        computeClipBoxXforms(
-            param3f("Translate"),
-            param3f("Rotate"),
-            param3f("Scale"),
-            clipXform,
-            invClipXform);
-
         em::glmat44f modelViewXform;
         em::glmat44f projectionXform;
 
@@ -959,54 +1028,19 @@ private:    // Utility functions
 
         shader.storeUniform4m("modelview",  &modelViewXform[0][0]);
         shader.storeUniform4m("projection", &projectionXform[0][0]);
-        shader.storeUniform4m("worldToBox", &invClipXform[0][0]);
-
-        // Read values from GUI
-
-        const bool prmGradientLighting(
-            param1e("Gradient Lighting")->eval(Nb::ZeroTimeBundle) == "On"
-            );
-        const bool prmNormalizedGrad(
-            param1e("Normalized Gradient")->eval(Nb::ZeroTimeBundle) == "On"
-            );
-        const bool prmScalarChannel(
-            param1e("Channel Type")->eval(Nb::ZeroTimeBundle) == "Scalar"
-            );
-        const GLfloat prmAmbientBrightness(
-            param1f("Ambient Brightness")->eval(Nb::ZeroTimeBundle)
-            );
-        const NtVec3f prmLightDirection(
-            em::normalized(
-                NtVec3f(
-                    param3f("Light Direction")->eval(Nb::ZeroTimeBundle,0),
-                    param3f("Light Direction")->eval(Nb::ZeroTimeBundle,1),
-                    param3f("Light Direction")->eval(Nb::ZeroTimeBundle,2))
-                )
-            );
-        const GLfloat prmWhitewaterSpeed(
-            param1f("Whitewater Speed")->eval(Nb::ZeroTimeBundle)
-            );
-        const GLfloat prmMinMag(
-            param1f("Min Visible Magnitude")->eval(Nb::ZeroTimeBundle)
-            );
-        const GLfloat prmMaxMag(
-            param1f("Max Visible Magnitude")->eval(Nb::ZeroTimeBundle)
-            );
-        const GLint prmNormalizedRange(
-            param1e("Normalized Range")->eval(Nb::ZeroTimeBundle)=="On"
-            );
+        shader.storeUniform4m("worldToBox", &_params.invClipXform[0][0]);
 
         // Pass values to shader
 
-        shader.storeUniform1i("gradLighting",     prmGradientLighting ? 1 : 0);
-        shader.storeUniform1i("normGrad",         prmNormalizedGrad ? 1 : 0);
-        shader.storeUniform1i("scalarChannel",    prmScalarChannel);
-        shader.storeUniform1f("ambient",          prmAmbientBrightness);
-        shader.storeUniform3f("lightDir",        -prmLightDirection);
-        shader.storeUniform1f("whiteWaterSpeed",  prmWhitewaterSpeed);
-        shader.storeUniform1f("minMag",           prmMinMag);
-        shader.storeUniform1f("maxMag",           prmMaxMag);
-        shader.storeUniform1i("normalizedRange",  prmNormalizedRange);
+        shader.storeUniform1i("gradLighting",     _params.gradLighting ? 1 : 0);
+        shader.storeUniform1i("normGrad",         _params.normalizedGrad ? 1 : 0);
+        shader.storeUniform1i("scalarChannel",    _params.scalarChannel);
+        shader.storeUniform1f("ambient",          _params.ambientBrightness);
+        shader.storeUniform3f("lightDir",        -_params.lightDirection);
+        shader.storeUniform1f("whiteWaterSpeed",  _params.whitewaterSpeed);
+        shader.storeUniform1f("minMag",           _params.minMag);
+        shader.storeUniform1f("maxMag",           _params.maxMag);
+        shader.storeUniform1i("normalizedRange",  _params.normalizedRange ? 1 : 0);
     }
 
 };
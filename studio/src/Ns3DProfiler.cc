@@ -0,0 +1,511 @@
+// -----------------------------------------------------------------------------
+//
+// Ns3DProfiler.cc
+//
+// Naiad Studio 3D view frame profiler, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "Ns3DProfiler.h"
+
+#include <NglStats.h>
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+namespace {
+
+//! Name of the section covering the whole frame.
+
+const char* const frameSectionName = "Frame";
+
+}   // Namespace.
+
+// -----------------------------------------------------------------------------
+
+// Ns3DProfiler
+// ------------
+//! CTOR. Samples are kept for the given number of frames.
+
+Ns3DProfiler::Ns3DProfiler(const int windowSize)
+    : _enabled(false)
+    , _windowSize(std::max(1, windowSize))
+    , _frame(0)
+    , _sectionStartMs(0.)
+    , _sectionStartBytes(0)
+    , _sectionQuery(0)
+    , _inFrame(false)
+    , _frameStartMs(0.)
+    , _frameStartBytes(0)
+{}
+
+
+// ~Ns3DProfiler
+// -------------
+//! DTOR. Query objects must be released with releaseQueries() while the
+//! OpenGL context is still current.
+
+Ns3DProfiler::~Ns3DProfiler()
+{}
+
+
+// setEnabled
+// ----------
+//! Start or stop collecting samples. Stopping discards the samples
+//! collected so far.
+
+void
+Ns3DProfiler::setEnabled(const bool enabled)
+{
+    if (enabled != _enabled) {
+        _enabled = enabled;
+        _inFrame = false;
+        _current.clear();
+        _histories.clear();
+        _order.clear();
+    }
+}
+
+
+// beginFrame
+// ----------
+//! Collect GPU results of earlier frames and start timing a new frame.
+
+void
+Ns3DProfiler::beginFrame()
+{
+    _collectQueries();
+
+    if (_enabled) {
+        _inFrame = true;
+        _frameStartMs = nowMs();
+        _frameStartBytes = Ngl::getStats().uploadBytes();
+    }
+}
+
+
+// endFrame
+// --------
+//! Move the samples of the current frame into the per-section histories.
+
+void
+Ns3DProfiler::endFrame()
+{
+    if (!_enabled || !_inFrame) {
+        return;
+    }
+
+    if (!_sectionName.isEmpty()) {
+        endSection();   // Unbalanced section, close it.
+    }
+
+    _Sample &frameSample(_current[frameSectionName]);
+    frameSample.cpuMs = nowMs() - _frameStartMs;
+    frameSample.uploadBytes = Ngl::getStats().uploadBytes() - _frameStartBytes;
+    _inFrame = false;
+
+    QHash<QString, _Sample>::const_iterator iter(_current.constBegin());
+    for (; iter != _current.constEnd(); ++iter) {
+        if (!_histories.contains(iter.key())) {
+            _History history;
+            history.samples.resize(_windowSize);
+            history.next = 0;
+            _histories.insert(iter.key(), history);
+            _order.append(iter.key());
+        }
+
+        _History &history(_histories[iter.key()]);
+        _Sample sample(iter.value());
+        sample.frame = _frame;
+        history.samples[history.next] = sample;
+        history.next = (history.next + 1) % _windowSize;
+    }
+
+    _current.clear();
+    ++_frame;
+}
+
+
+// beginSection
+// ------------
+//! Start timing a section of the current frame. Sections with the same
+//! name in one frame are accumulated. Sections outside beginFrame() and
+//! endFrame() would not belong to any frame sample and are ignored. GPU
+//! timing is skipped if not requested or not supported.
+
+void
+Ns3DProfiler::beginSection(const QString &name, const bool gpu)
+{
+    if (!_enabled || !_inFrame) {
+        return;
+    }
+
+    if (!_sectionName.isEmpty()) {
+        endSection();   // Sections do not nest.
+    }
+
+    _sectionName = name;
+    _sectionStartBytes = Ngl::getStats().uploadBytes();
+    _sectionQuery = 0;
+
+    if (gpu && Ngl::getGLExtensionFunctions().timerQuerySupported()) {
+        if (_freeQueries.isEmpty()) {
+            GLuint id(0);
+            glGenQueries(1, &id);
+            _freeQueries.append(id);
+        }
+
+        _sectionQuery = _freeQueries.takeLast();
+        glBeginQuery(GL_TIME_ELAPSED, _sectionQuery);
+    }
+
+    _sectionStartMs = nowMs();
+}
+
+
+// endSection
+// ----------
+//! Stop timing the current section.
+
+void
+Ns3DProfiler::endSection()
+{
+    if (!_enabled || _sectionName.isEmpty()) {
+        return;
+    }
+
+    const double cpuMs(nowMs() - _sectionStartMs);
+
+    _Sample &sample(_current[_sectionName]);
+    sample.cpuMs += cpuMs;
+    sample.uploadBytes += Ngl::getStats().uploadBytes() - _sectionStartBytes;
+
+    if (0 != _sectionQuery) {
+        glEndQuery(GL_TIME_ELAPSED);
+
+        _Query query;
+        query.name = _sectionName;
+        query.frame = _frame;
+        query.id = _sectionQuery;
+        _pendingQueries.append(query);
+        _sectionQuery = 0;
+    }
+
+    _sectionName.clear();
+}
+
+
+// hudText
+// -------
+//! Returns a table of average and peak times per section over the window,
+//! suitable for drawing with a fixed-width font.
+
+QString
+Ns3DProfiler::hudText() const
+{
+    QString text;
+    QTextStream ts(&text);
+
+    ts << QString("%1 %2 %3 %4")
+              .arg("Section (last " + QString::number(_windowSize) +
+                   " frames)", -32)
+              .arg("CPU avg/max ms", 16)
+              .arg("GPU avg/max ms", 16)
+              .arg("Upload KB", 10)
+       << "\n";
+
+    foreach (const QString &name, _recentNames()) {
+        const _Summary s(_summarize(_histories[name]));
+
+        const QString cpu(QString("%1/%2")
+                              .arg(s.cpuAvg, 0, 'f', 2)
+                              .arg(s.cpuMax, 0, 'f', 2));
+        const QString gpu(0 < s.gpuFrames ?
+                              QString("%1/%2")
+                                  .arg(s.gpuAvg, 0, 'f', 2)
+                                  .arg(s.gpuMax, 0, 'f', 2) :
+                              QString("-"));
+
+        ts << QString("%1 %2 %3 %4")
+                  .arg(name.left(32), -32)
+                  .arg(cpu, 16)
+                  .arg(gpu, 16)
+                  .arg(s.uploadAvg/1024., 10, 'f', 1)
+           << "\n";
+    }
+
+    ts.flush();
+    return text;
+}
+
+
+// writeLog
+// --------
+//! Write per-section statistics and the raw samples of the window to the
+//! given file as comma-separated values. Returns false if the file could
+//! not be written.
+
+bool
+Ns3DProfiler::writeLog(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream ts(&file);
+
+    ts << "section,frames,cpu_avg_ms,cpu_max_ms,"
+       << "gpu_avg_ms,gpu_max_ms,upload_avg_bytes\n";
+
+    foreach (const QString &name, _order) {
+        const _Summary s(_summarize(_histories[name]));
+        ts << '"' << name << "\","
+           << s.frames << ','
+           << s.cpuAvg << ',' << s.cpuMax << ','
+           << (0 < s.gpuFrames ? QString::number(s.gpuAvg) : QString()) << ','
+           << (0 < s.gpuFrames ? QString::number(s.gpuMax) : QString()) << ','
+           << s.uploadAvg << "\n";
+    }
+
+    ts << "\nsection,frame,cpu_ms,gpu_ms,upload_bytes\n";
+
+    foreach (const QString &name, _order) {
+        foreach (const _Sample &sample, _histories[name].samples) {
+            if (0 <= sample.frame) {
+                ts << '"' << name << "\","
+                   << sample.frame << ','
+                   << sample.cpuMs << ','
+                   << (0. <= sample.gpuMs ?
+                           QString::number(sample.gpuMs) : QString()) << ','
+                   << sample.uploadBytes << "\n";
+            }
+        }
+    }
+
+    ts.flush();
+    return (QFile::NoError == file.error());
+}
+
+
+// releaseQueries
+// --------------
+//! Delete all query objects. Requires the OpenGL context to be current.
+
+void
+Ns3DProfiler::releaseQueries()
+{
+    if (!Ngl::getGLExtensionFunctions().timerQuerySupported()) {
+        return;
+    }
+
+    foreach (const _Query &query, _pendingQueries) {
+        _freeQueries.append(query.id);
+    }
+
+    _pendingQueries.clear();
+
+    if (0 != _sectionQuery) {
+        glEndQuery(GL_TIME_ELAPSED);
+        _freeQueries.append(_sectionQuery);
+        _sectionQuery = 0;
+    }
+
+    foreach (GLuint id, _freeQueries) {
+        glDeleteQueries(1, &id);
+    }
+
+    _freeQueries.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+// _collectQueries
+// ---------------
+//! Read back the GPU times of earlier sections whose results have become
+//! available. Queries are returned to the free list.
+
+void
+Ns3DProfiler::_collectQueries()
+{
+    QList<_Query> pending;
+
+    foreach (const _Query &query, _pendingQueries) {
+        GLuint available(0);
+        glGetQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (GL_FALSE == available) {
+            pending.append(query);
+            continue;
+        }
+
+        GLuint ns(0);
+        glGetQueryObjectuiv(query.id, GL_QUERY_RESULT, &ns);
+        _freeQueries.append(query.id);
+
+        _Sample *sample(_findSample(query.name, query.frame));
+        if (0 != sample) {
+            sample->gpuMs = std::max(0., sample->gpuMs) + 1e-6*ns;
+        }
+    }
+
+    _pendingQueries = pending;
+}
+
+
+// _findSample
+// -----------
+//! Returns the stored sample of the given section and frame, or null if it
+//! has left the window or profiling was restarted.
+
+Ns3DProfiler::_Sample*
+Ns3DProfiler::_findSample(const QString &name, const int frame)
+{
+    if (frame == _frame) {
+        QHash<QString, _Sample>::iterator iter(_current.find(name));
+        return (_current.end() != iter ? &iter.value() : 0);
+    }
+
+    QHash<QString, _History>::iterator iter(_histories.find(name));
+    if (_histories.end() != iter) {
+        for (int i = 0; i < iter.value().samples.size(); ++i) {
+            if (frame == iter.value().samples[i].frame) {
+                return &iter.value().samples[i];
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+// _summarize
+// ----------
+//! Returns averages and peaks over the samples of a section.
+
+Ns3DProfiler::_Summary
+Ns3DProfiler::_summarize(const _History &history) const
+{
+    _Summary s;
+    double uploadSum(0.);
+
+    foreach (const _Sample &sample, history.samples) {
+        if (0 <= sample.frame) {
+            ++s.frames;
+            s.cpuAvg += sample.cpuMs;
+            s.cpuMax = std::max(s.cpuMax, sample.cpuMs);
+            uploadSum += sample.uploadBytes;
+
+            if (0. <= sample.gpuMs) {
+                ++s.gpuFrames;
+                s.gpuAvg += sample.gpuMs;
+                s.gpuMax = std::max(s.gpuMax, sample.gpuMs);
+            }
+        }
+    }
+
+    if (0 < s.frames) {
+        s.cpuAvg /= s.frames;
+        s.uploadAvg = uploadSum/s.frames;
+    }
+
+    if (0 < s.gpuFrames) {
+        s.gpuAvg /= s.gpuFrames;
+    }
+
+    return s;
+}
+
+
+// _recentNames
+// ------------
+//! Returns the names of sections sampled within the window, the frame
+//! section first.
+
+QStringList
+Ns3DProfiler::_recentNames() const
+{
+    QStringList names;
+
+    foreach (const QString &name, _order) {
+        bool recent(false);
+        foreach (const _Sample &sample, _histories[name].samples) {
+            if (0 <= sample.frame && _frame - sample.frame <= _windowSize) {
+                recent = true;
+                break;
+            }
+        }
+
+        if (recent) {
+            if (frameSectionName == name) {
+                names.prepend(name);
+            }
+            else {
+                names.append(name);
+            }
+        }
+    }
+
+    return names;
+}
+
+
+// nowMs
+// -----
+//! Returns wall-clock time in milliseconds. [static]
+
+double
+Ns3DProfiler::nowMs()
+{
+#ifdef WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return 1000.*static_cast<double>(count.QuadPart)/freq.QuadPart;
+#else
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return 1000.*tv.tv_sec + 0.001*tv.tv_usec;
+#endif
+}
@@ -0,0 +1,223 @@
+// -----------------------------------------------------------------------------
+//
+// Ns3DProfiler.h
+//
+// Naiad Studio 3D view frame profiler, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS3D_PROFILER_H
+#define NS3D_PROFILER_H
+
+#include <NglExtensions.h>
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <cstddef>
+
+// -----------------------------------------------------------------------------
+
+// Ns3DProfiler
+// ------------
+//! Collects CPU times, GPU times and uploaded bytes for named sections of
+//! 3D view frames, e.g. each scope's draw call, and keeps the samples of
+//! the most recent frames so that averages and peaks can be shown in a
+//! HUD or written to a log.
+//!
+//! GPU times use GL_TIME_ELAPSED queries when available. Results are read
+//! back at the start of later frames so that the CPU never waits for the
+//! GPU. Sections cannot be nested, since only one time query may be active
+//! at a time.
+
+class Ns3DProfiler
+{
+public:
+
+    explicit
+    Ns3DProfiler(int windowSize = 60);
+
+    ~Ns3DProfiler();
+
+    bool
+    isEnabled() const
+    { return _enabled; }
+
+    void
+    setEnabled(bool enabled);
+
+    void
+    beginFrame();
+
+    void
+    endFrame();
+
+    void
+    beginSection(const QString &name, bool gpu = true);
+
+    void
+    endSection();
+
+    QString
+    hudText() const;
+
+    bool
+    writeLog(const QString &fileName) const;
+
+    void
+    releaseQueries();
+
+    static double
+    nowMs();
+
+public:
+
+    // Section
+    // -------
+    //! Times a section for the duration of its scope.
+
+    class Section
+    {
+    public:
+
+        Section(Ns3DProfiler &profiler, const QString &name, bool gpu = true)
+            : _profiler(profiler.isEnabled() ? &profiler : 0)
+        {
+            if (0 != _profiler) {
+                _profiler->beginSection(name, gpu);
+            }
+        }
+
+        ~Section()
+        {
+            if (0 != _profiler) {
+                _profiler->endSection();
+            }
+        }
+
+    private:
+
+        Ns3DProfiler *_profiler;
+
+        Section(const Section&);            //!< Disabled.
+        Section& operator=(const Section&); //!< Disabled.
+    };
+
+private:
+
+    struct _Sample
+    {
+        _Sample()
+            : frame(-1), cpuMs(0.), gpuMs(-1.), uploadBytes(0)
+        {}
+
+        int         frame;
+        double      cpuMs;
+        double      gpuMs;          //!< Negative until a result arrives.
+        std::size_t uploadBytes;
+    };
+
+    struct _History
+    {
+        QVector<_Sample> samples;   //!< Ring buffer, one sample per frame.
+        int              next;
+    };
+
+    struct _Query
+    {
+        QString name;
+        int     frame;
+        GLuint  id;
+    };
+
+    struct _Summary
+    {
+        _Summary()
+            : frames(0), cpuAvg(0.), cpuMax(0.), gpuFrames(0), gpuAvg(0.),
+              gpuMax(0.), uploadAvg(0.)
+        {}
+
+        int    frames;
+        double cpuAvg;
+        double cpuMax;
+        int    gpuFrames;
+        double gpuAvg;
+        double gpuMax;
+        double uploadAvg;           //!< [bytes]
+    };
+
+    void
+    _collectQueries();
+
+    _Sample*
+    _findSample(const QString &name, int frame);
+
+    _Summary
+    _summarize(const _History &history) const;
+
+    QStringList
+    _recentNames() const;
+
+private:    // Member variables.
+
+    bool _enabled;
+    int  _windowSize;
+    int  _frame;                    //!< Frame counter.
+
+    QHash<QString, _Sample>  _current;     //!< Samples of current frame.
+    QHash<QString, _History> _histories;
+    QStringList              _order;       //!< Names in order of appearance.
+
+    QList<_Query>  _pendingQueries;
+    QList<GLuint>  _freeQueries;
+
+    QString     _sectionName;       //!< Empty if no open section.
+    double      _sectionStartMs;
+    std::size_t _sectionStartBytes;
+    GLuint      _sectionQuery;      //!< Zero if section is not GPU timed.
+    bool        _inFrame;
+    double      _frameStartMs;
+    std::size_t _frameStartBytes;
+
+private:
+
+    Ns3DProfiler(const Ns3DProfiler&);            //!< Disabled.
+    Ns3DProfiler& operator=(const Ns3DProfiler&); //!< Disabled.
+};
+
+#endif // NS3D_PROFILER_H
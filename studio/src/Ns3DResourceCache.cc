@@ -0,0 +1,395 @@
+// -----------------------------------------------------------------------------
+//
+// Ns3DResourceCache.cc
+//
+// Naiad Studio cache of GPU resources from reloaded bodies, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "Ns3DResourceCache.h"
+
+#include <NglStats.h>
+#include <NglSuperTileLayout.h>
+#include <NglTexture3D.h>
+#include <NglVertexBuffer.h>
+
+// -----------------------------------------------------------------------------
+
+// instance
+// --------
+//! Provide access to singleton. [static]
+
+Ns3DResourceCache*
+Ns3DResourceCache::instance()
+{
+    if (0 == _instance) {
+        createInstance();
+    }
+
+    return _instance;
+}
+
+
+// createInstance
+// --------------
+//! Reset singleton. [static]
+
+void
+Ns3DResourceCache::createInstance()
+{
+    destroyInstance();
+    _instance = new Ns3DResourceCache;
+}
+
+
+// destroyInstance
+// ---------------
+//! Reset singleton. [static]
+
+void
+Ns3DResourceCache::destroyInstance()
+{
+    delete _instance;
+    _instance = 0;
+}
+
+
+//! Singleton pointer. [static]
+Ns3DResourceCache *Ns3DResourceCache::_instance = 0;
+
+// -----------------------------------------------------------------------------
+
+// Ns3DResourceCache
+// -----------------
+//! CTOR.
+
+Ns3DResourceCache::Ns3DResourceCache()
+    : _budget(512*1024*1024)
+    , _usedBytes(0)
+{
+}
+
+
+// ~Ns3DResourceCache
+// ------------------
+//! DTOR.
+
+Ns3DResourceCache::~Ns3DResourceCache()
+{
+    clear();
+}
+
+
+// store
+// -----
+//! Takes ownership of the given resources, which are left empty. Resources
+//! already stored under the same cache name are destroyed.
+
+void
+Ns3DResourceCache::store(const NtString &cacheName, Resources &resources)
+{
+    _EntryMap::iterator find(_entries.find(cacheName));
+    if (find != _entries.end()) {
+        _erase(find);
+    }
+
+    if (resources.empty()) {
+        return;
+    }
+
+    _Entry &entry(_entries[cacheName]);
+    std::swap(entry.resources.superLayout, resources.superLayout);
+    entry.resources.tex3DMap.swap(resources.tex3DMap);
+    entry.resources.vtxBufMap.swap(resources.vtxBufMap);
+    entry.bytes = _bytes(entry.resources);
+    entry.lru = _lru.insert(_lru.end(), cacheName);
+    _index(cacheName, entry.resources);
+
+    _usedBytes += entry.bytes;
+
+    _evict();
+}
+
+
+// take
+// ----
+//! Moves the resources stored under the given cache name to the given
+//! (empty) resources, which then own them. Returns false if nothing is
+//! stored under the cache name.
+
+bool
+Ns3DResourceCache::take(const NtString &cacheName, Resources &resources)
+{
+    const _EntryMap::iterator find(_entries.find(cacheName));
+    if (find == _entries.end()) {
+        return false;
+    }
+
+    _Entry &entry(find->second);
+    _unindex(cacheName, entry.resources);
+    std::swap(resources.superLayout, entry.resources.superLayout);
+    resources.tex3DMap.swap(entry.resources.tex3DMap);
+    resources.vtxBufMap.swap(entry.resources.vtxBufMap);
+
+    _usedBytes -= entry.bytes;
+    _lru.erase(entry.lru);
+    _entries.erase(find);
+
+    return true;
+}
+
+
+// discard
+// -------
+//! Destroys every stored resource with the given resource name, whatever
+//! cache name it is stored under. Resource objects call this when a client
+//! destroys a resource, e.g. because its sampling parameters have changed,
+//! so that stale versions are not taken back for other frames. Only the
+//! entries holding the resource are visited.
+
+void
+Ns3DResourceCache::discard(const NtString &resourceName)
+{
+    const _ResourceIndex::iterator index(_resourceIndex.find(resourceName));
+    if (index == _resourceIndex.end()) {
+        return;     // Not stored.
+    }
+
+    std::set<NtString> cacheNames;
+    cacheNames.swap(index->second);
+    _resourceIndex.erase(index);
+
+    for (std::set<NtString>::const_iterator name(cacheNames.begin());
+         name != cacheNames.end();
+         ++name) {
+        const _EntryMap::iterator iter(_entries.find(*name));
+        _Entry &entry(iter->second);
+
+        const Tex3DMap::iterator tex3D(
+            entry.resources.tex3DMap.find(resourceName));
+        if (tex3D != entry.resources.tex3DMap.end()) {
+            delete tex3D->second;
+            entry.resources.tex3DMap.erase(tex3D);
+        }
+
+        const VertexBufferMap::iterator vtxBuf(
+            entry.resources.vtxBufMap.find(resourceName));
+        if (vtxBuf != entry.resources.vtxBufMap.end()) {
+            delete vtxBuf->second;
+            entry.resources.vtxBufMap.erase(vtxBuf);
+        }
+
+        const std::size_t bytes(_bytes(entry.resources));
+        _usedBytes -= (entry.bytes - bytes);
+        entry.bytes = bytes;
+
+        if (entry.resources.empty()) {
+            _erase(iter);
+        }
+    }
+}
+
+
+// clear
+// -----
+//! Destroys all stored resources.
+
+void
+Ns3DResourceCache::clear()
+{
+    while (!_entries.empty()) {
+        _erase(_entries.begin());
+    }
+}
+
+
+// setBudget
+// ---------
+//! Sets the maximum total size of the stored resources, evicting the least
+//! recently stored resources if necessary.
+
+void
+Ns3DResourceCache::setBudget(const std::size_t bytes)
+{
+    _budget = bytes;
+    _evict();
+}
+
+// -----------------------------------------------------------------------------
+
+// _erase
+// ------
+//! Destroys the resources of the given entry and removes it.
+
+void
+Ns3DResourceCache::_erase(const _EntryMap::iterator iter)
+{
+    _Entry &entry(iter->second);
+    _unindex(iter->first, entry.resources);
+    _destroy(entry.resources);
+    _usedBytes -= entry.bytes;
+    _lru.erase(entry.lru);
+    _entries.erase(iter);
+}
+
+
+// _index
+// ------
+//! Records that the given entry holds the given resources.
+
+void
+Ns3DResourceCache::_index(const NtString &cacheName,
+                          const Resources &resources)
+{
+    for (Tex3DMap::const_iterator iter(resources.tex3DMap.begin());
+         iter != resources.tex3DMap.end();
+         ++iter) {
+        _resourceIndex[iter->first].insert(cacheName);
+    }
+
+    for (VertexBufferMap::const_iterator iter(resources.vtxBufMap.begin());
+         iter != resources.vtxBufMap.end();
+         ++iter) {
+        _resourceIndex[iter->first].insert(cacheName);
+    }
+}
+
+
+// _unindex
+// --------
+//! Forgets that the given entry holds the given resources.
+
+void
+Ns3DResourceCache::_unindex(const NtString &cacheName,
+                            const Resources &resources)
+{
+    for (Tex3DMap::const_iterator iter(resources.tex3DMap.begin());
+         iter != resources.tex3DMap.end();
+         ++iter) {
+        _unindex(cacheName, iter->first);
+    }
+
+    for (VertexBufferMap::const_iterator iter(resources.vtxBufMap.begin());
+         iter != resources.vtxBufMap.end();
+         ++iter) {
+        _unindex(cacheName, iter->first);
+    }
+}
+
+
+// _unindex
+// --------
+//! Forgets that the given entry holds the given resource.
+
+void
+Ns3DResourceCache::_unindex(const NtString &cacheName,
+                            const NtString &resourceName)
+{
+    const _ResourceIndex::iterator index(_resourceIndex.find(resourceName));
+    if (index != _resourceIndex.end()) {
+        index->second.erase(cacheName);
+        if (index->second.empty()) {
+            _resourceIndex.erase(index);
+        }
+    }
+}
+
+
+// _evict
+// ------
+//! Destroys the least recently stored resources until the stored resources
+//! fit the budget.
+
+void
+Ns3DResourceCache::_evict()
+{
+    while (_budget < _usedBytes && !_lru.empty()) {
+        _erase(_entries.find(_lru.front()));
+    }
+}
+
+
+// _bytes
+// ------
+//! Returns the GPU memory used by the given resources. [static]
+
+std::size_t
+Ns3DResourceCache::_bytes(const Resources &resources)
+{
+    std::size_t bytes(0);
+
+    for (Tex3DMap::const_iterator iter(resources.tex3DMap.begin());
+         iter != resources.tex3DMap.end();
+         ++iter) {
+        const Ngl::Texture3D *tex3D(iter->second);
+        bytes +=
+            std::size_t(tex3D->width())*tex3D->height()*tex3D->depth()*
+            Ngl::texelBytes(tex3D->base().format(), tex3D->base().type());
+    }
+
+    for (VertexBufferMap::const_iterator iter(resources.vtxBufMap.begin());
+         iter != resources.vtxBufMap.end();
+         ++iter) {
+        bytes += iter->second->size();
+    }
+
+    return bytes;
+}
+
+
+// _destroy
+// --------
+//! Deletes the given resources. [static]
+
+void
+Ns3DResourceCache::_destroy(Resources &resources)
+{
+    delete resources.superLayout;
+    resources.superLayout = 0;
+
+    for (Tex3DMap::iterator iter(resources.tex3DMap.begin());
+         iter != resources.tex3DMap.end();
+         ++iter) {
+        delete iter->second;
+    }
+    resources.tex3DMap.clear();
+
+    for (VertexBufferMap::iterator iter(resources.vtxBufMap.begin());
+         iter != resources.vtxBufMap.end();
+         ++iter) {
+        delete iter->second;
+    }
+    resources.vtxBufMap.clear();
+}
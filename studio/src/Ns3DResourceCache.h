@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------
+//
+// Ns3DResourceCache.h
+//
+// Naiad Studio cache of GPU resources from reloaded bodies, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS3D_RESOURCE_CACHE_H
+#define NS3D_RESOURCE_CACHE_H
+
+#include <NglExtensions.h>
+
+#include <Ni.h>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <set>
+
+namespace Ngl {
+class SuperTileLayout;
+class Texture3D;
+class VertexBuffer;
+}
+
+// -----------------------------------------------------------------------------
+
+// Ns3DResourceCache
+// -----------------
+//! Keeps the GPU resources of destroyed resource objects, so that a body
+//! that is reloaded for a frame that was recently viewed can take back its
+//! vertex buffers and textures instead of creating and uploading them
+//! again. Resources are stored under a cache name identifying the body and
+//! the frame, and each resource keeps the name it had in its resource
+//! object, which already encodes the channels and the client it was
+//! sampled for.
+//!
+//! The least recently stored resources are destroyed once the total size
+//! of the stored resources exceeds the budget. Resources must only be
+//! stored, taken and destroyed while a GL context is current.
+
+class Ns3DResourceCache
+{
+public:     // Singleton interface.
+
+    static Ns3DResourceCache*
+    instance();
+
+    static void
+    createInstance();
+
+    static void
+    destroyInstance();
+
+private:
+
+    static Ns3DResourceCache *_instance;
+
+public:
+
+    typedef std::map<NtString, Ngl::Texture3D*>    Tex3DMap;
+    typedef std::map<NtString, Ngl::VertexBuffer*> VertexBufferMap;
+
+    //! The resources of a single resource object.
+
+    struct Resources
+    {
+        Resources()
+            : superLayout(0)
+        {}
+
+        bool
+        empty() const
+        { return 0 == superLayout && tex3DMap.empty() && vtxBufMap.empty(); }
+
+        Ngl::SuperTileLayout *superLayout;
+        Tex3DMap              tex3DMap;
+        VertexBufferMap       vtxBufMap;
+    };
+
+    void
+    store(const NtString &cacheName, Resources &resources);
+
+    bool
+    take(const NtString &cacheName, Resources &resources);
+
+    void
+    discard(const NtString &resourceName);
+
+    void
+    clear();
+
+    std::size_t
+    budget() const
+    { return _budget; }
+
+    void
+    setBudget(std::size_t bytes);
+
+    std::size_t
+    usedBytes() const
+    { return _usedBytes; }
+
+private:
+
+    explicit
+    Ns3DResourceCache();
+
+    ~Ns3DResourceCache();
+
+    Ns3DResourceCache(const Ns3DResourceCache&);            //!< Disabled.
+    Ns3DResourceCache& operator=(const Ns3DResourceCache&); //!< Disabled.
+
+private:
+
+    typedef std::list<NtString> _LruList;
+
+    struct _Entry
+    {
+        Resources          resources;
+        std::size_t        bytes;
+        _LruList::iterator lru;     //!< Position in the eviction order.
+    };
+
+    typedef std::map<NtString, _Entry> _EntryMap;
+
+    //! Cache names of the entries holding a resource, by resource name.
+
+    typedef std::map<NtString, std::set<NtString> > _ResourceIndex;
+
+    void
+    _erase(_EntryMap::iterator iter);
+
+    void
+    _index(const NtString &cacheName, const Resources &resources);
+
+    void
+    _unindex(const NtString &cacheName, const Resources &resources);
+
+    void
+    _unindex(const NtString &cacheName, const NtString &resourceName);
+
+    void
+    _evict();
+
+    static std::size_t
+    _bytes(const Resources &resources);
+
+    static void
+    _destroy(Resources &resources);
+
+private:    // Member variables.
+
+    _EntryMap      _entries;
+    _ResourceIndex _resourceIndex;
+    _LruList       _lru;        //!< Cache names, least recently stored first.
+    std::size_t    _budget;     //!< [bytes]
+    std::size_t    _usedBytes;  //!< [bytes]
+};
+
+#endif // NS3D_RESOURCE_CACHE_H
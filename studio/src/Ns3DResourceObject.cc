@@ -40,6 +40,7 @@
 // -----------------------------------------------------------------------------
 
 #include "Ns3DResourceObject.h"
+#include "Ns3DResourceCache.h"
 
 #include <NglSlicing.h>
 #include <NglShaderProgram.h>
@@ -48,20 +49,40 @@
 #include <NglSuperTile.h>
 #include <NglTextureUtils.h>
 #include <NglVertexBuffer.h>
+#include <NglOcclusionQueries.h>
 
 #include <Nbx.h>    // NB_THROW
 #include <NbLog.h>  // NB_WARNING
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 // Ns3DResourceObject
 // ---------------
-//! Constructor.
+//! Constructor. Resources kept in the resource cache under the given cache
+//! name are taken back, so that they need not be created again.
 
-Ns3DResourceObject::Ns3DResourceObject()
+Ns3DResourceObject::Ns3DResourceObject(const NtString& cacheName)
     : _superLayout(0)
+    , _cacheName(cacheName)
 {
+    if (!_cacheName.empty()) {
+        Ns3DResourceCache::Resources resources;
+        if (Ns3DResourceCache::instance()->take(_cacheName, resources)) {
+            _superLayout = resources.superLayout;
+            _tex3DMap.swap(resources.tex3DMap);
+            _vtxBufMap.swap(resources.vtxBufMap);
+        }
+    }
+
 #if 0
     std::cerr << "Create Ns3DResourceObject" << std::endl;
 #endif
@@ -74,6 +95,18 @@ Ns3DResourceObject::Ns3DResourceObject()
 
 Ns3DResourceObject::~Ns3DResourceObject()
 {
+    // Keep resources in the resource cache, if a cache name was given.
+    // Framebuffers depend on the view rather than the data and are always
+    // freed.
+
+    if (!_cacheName.empty()) {
+        Ns3DResourceCache::Resources resources;
+        std::swap(resources.superLayout, _superLayout);
+        resources.tex3DMap.swap(_tex3DMap);
+        resources.vtxBufMap.swap(_vtxBufMap);
+        Ns3DResourceCache::instance()->store(_cacheName, resources);
+    }
+
     // Free resources.
     //
 
@@ -108,6 +141,15 @@ Ns3DResourceObject::~Ns3DResourceObject()
         delete iter->second;
     }
 
+    // Occlusion queries
+
+    for (_OcclusionMap::iterator iter = _occlusionMap.begin();
+         iter != _occlusionMap.end();
+         ++iter)
+    {
+        delete iter->second;
+    }
+
 #if 0
     std::cerr << "Destroy Ns3DResourceObject\n";
 #endif
@@ -116,15 +158,29 @@ Ns3DResourceObject::~Ns3DResourceObject()
 
 // createConstSuperTileLayout
 // --------------------------
-//! Create and store a super-tile layout.
+//! Returns the super-tile layout for the given clip-box, creating and
+//! storing it if necessary. A layout built for another clip-box, e.g. one
+//! taken back from the resource cache after the clip-box was edited, is
+//! rebuilt. Super-tile textures are indexed by super-tile, so those
+//! sampled for the old layout are destroyed with it.
 
 const Ngl::SuperTileLayout*
 Ns3DResourceObject::createSuperTileLayout(const float clipXform[16],
                                           const int   connectivity)
 {
-    if(_superLayout) {
-        NB_WARNING("Super-tile layout '" << name() << "' already exists");
-    } else {
+    if (0 != _superLayout && !_superLayout->builtFor(clipXform, connectivity)) {
+        destroySuperTileLayout();
+
+        for (_Tex3DMap::iterator iter = _tex3DMap.begin();
+             iter != _tex3DMap.end();
+             ++iter)
+        {
+            delete iter->second;
+        }
+        _tex3DMap.clear();
+    }
+
+    if (0 == _superLayout) {
         _superLayout = 
             new Ngl::SuperTileLayout(
                 constLayoutPtr(),clipXform,connectivity
@@ -353,6 +409,27 @@ Ns3DResourceObject::queryMutableFramebufferObject(const NtString& clientName,
 }
 
 
+// occlusionQueries
+// ----------------
+//! Query occlusion queries by name, creating an empty set if not found.
+
+Ngl::OcclusionQueries*
+Ns3DResourceObject::occlusionQueries(const NtString& clientName,
+                                     const NtString& bufferName)
+{
+    const NtString resourceName(longName(clientName,bufferName));
+    _OcclusionMap::iterator find(_occlusionMap.find(resourceName));
+
+    if (find == _occlusionMap.end()) {
+        find = _occlusionMap.insert(
+            _OcclusionMap::value_type(
+                resourceName, new Ngl::OcclusionQueries)).first;
+    }
+
+    return find->second;
+}
+
+
 // destroySuperTileLayout
 // ----------------------
 //! Destroy super-tile layout.
@@ -361,6 +438,7 @@ void
 Ns3DResourceObject::destroySuperTileLayout()
 {
     delete _superLayout;
+    _superLayout = 0;
 }
 
 
@@ -386,6 +464,12 @@ Ns3DResourceObject::destroyVertexBuffer(const NtString& clientName,
         delete find->second;
         _vtxBufMap.erase(find);
     }
+
+    // Versions of the buffer kept for other frames are stale as well.
+
+    if (!_cacheName.empty()) {
+        Ns3DResourceCache::instance()->discard(resourceName);
+    }
 }
 
 
@@ -407,6 +491,12 @@ Ns3DResourceObject::destroyTexture3D(const NtString& clientName,
         delete find->second;
         _tex3DMap.erase(find);
     }
+
+    // Versions of the texture kept for other frames are stale as well.
+
+    if (!_cacheName.empty()) {
+        Ns3DResourceCache::instance()->discard(resourceName);
+    }
 }
 
 
@@ -433,7 +523,15 @@ Ns3DResourceObject::destroyFramebufferObject(const NtString& clientName,
 // computeSuperTileTextures
 // ------------------------
 //! Computes/recomputes 3D textures corresponding to each super tile in the
-//! super-tile layout.
+//! super-tile layout. Only super tiles that have no texture, or whose
+//! texture has the wrong resolution, are sampled. With enough super tiles
+//! to keep all threads busy, the super tiles are sampled concurrently, and
+//! textures are created on the calling (GL) thread as samples complete, so
+//! that sampled data does not pile up. Otherwise the super tiles are
+//! sampled one at a time, each using all threads.
+//!
+//! If screen-space information is given, resolutions are chosen per super
+//! tile instead, see _adaptSuperTileResolutions().
 
 void
 Ns3DResourceObject::computeSuperTileTextures(const NtString& clientName,
@@ -442,12 +540,12 @@ Ns3DResourceObject::computeSuperTileTextures(const NtString& clientName,
                                              const float       clipXform[16],
                                              const bool        gradientTexture,
                                              const int         component,
-                                             Nb::Vec2f*        valRange)
+                                             Nb::Vec2f*        valRange,
+                                             const TextureLod* lod)
 {
     // Create a SuperTileLayout if one does not exist.
 
-    if (0 == _superLayout)
-        createSuperTileLayout(clipXform, 26);
+    createSuperTileLayout(clipXform, 26);
 
     // Get a worldspace texture-sampling spacing from the actual tile-layout
     // if it exists, otherwise just assume the supersampling is in worldpace
@@ -458,64 +556,161 @@ Ns3DResourceObject::computeSuperTileTextures(const NtString& clientName,
     if(layout)
         invCellSize=(1.f/layout->cellSize());
 
-    // Update each supertile's texture
-    
-    for(int superTile=0; superTile<_superLayout->superTileCount(); ++superTile){
+    // Compute the full texture resolution for each supertile.
+
+    const int superTileCount(_superLayout->superTileCount());
+    std::vector<NtVec3f> wsMins(superTileCount);
+    std::vector<NtVec3f> wsMaxs(superTileCount);
+    std::vector<NtVec3i> texRess(superTileCount);
 
-        // Compute current texture resolution for each supertile
-        NtVec3f wsMin, wsMax;
+    for(int superTile=0; superTile<superTileCount; ++superTile){
+        NtVec3f& wsMin(wsMins[superTile]);
+        NtVec3f& wsMax(wsMaxs[superTile]);
         _superLayout->superTile(superTile).bounds(wsMin, wsMax);
 
         const NtVec3f wsDim(wsMax - wsMin);
-        NtVec3i texRes(
+        texRess[superTile] = NtVec3i(
             supersampling[0]*(wsDim[0]*invCellSize) + 1,
             supersampling[1]*(wsDim[1]*invCellSize) + 1,
             supersampling[2]*(wsDim[2]*invCellSize) + 1
             );
+    }
+
+    if (0 != lod) {
+        _adaptSuperTileResolutions(
+            *lod, clientName, bufferName, wsMins, wsMaxs, texRess);
+    }
+
+    // Collect the supertiles whose textures must be (re)computed.
+
+    std::vector<_SuperTileJob> jobs;
+    
+    for(int superTile=0; superTile<superTileCount; ++superTile){
+        const NtVec3f& wsMin(wsMins[superTile]);
+        const NtVec3f& wsMax(wsMaxs[superTile]);
+        const NtVec3i& texRes(texRess[superTile]);
         
         // Check if a texture already exists for this supertile
         const Ngl::Texture3D* tex3D = 
             queryConstTexture3D(clientName,bufferName,superTile);
         
-        // Wipe texture if resolution has changed
+        // Wipe texture if resolution has changed. Textures are always
+        // checked against the wanted resolution, also when taken back from
+        // the resource cache, so versions kept for other frames are not
+        // discarded, e.g. when only the level of detail changed.
         if(tex3D &&
            (tex3D->width()  != texRes[0] ||
             tex3D->height() != texRes[1] ||
             tex3D->depth()  != texRes[2])) {
-            destroyTexture3D(clientName,bufferName,superTile);
+            const _Tex3DMap::iterator find(
+                _tex3DMap.find(longName(clientName,bufferName,superTile)));
+            delete find->second;
+            _tex3DMap.erase(find);
             tex3D = 0;
         }
         
         // Create super-tile texture if necessary
         if(0 == tex3D) {
-            if(gradientTexture) {
-                Nb::Vec2f vr(
-                     (std::numeric_limits<float>::max)(),
-                    -(std::numeric_limits<float>::max)()
-                    );
-                superTileGradientTexture3D(
-                    clientName,
-                    bufferName,
-                    superTile,
-                    texRes,
-                    wsMin,
-                    wsMax,
-                    component,
-                    &vr
-                    );
-                if(valRange) {
-                    (*valRange)[0] = std::min((*valRange)[0], vr[0]);
-                    (*valRange)[1] = std::max((*valRange)[1], vr[1]);
+            _SuperTileJob job;
+            job.superTile = superTile;
+            job.texRes = texRes;
+            job.wsMin = wsMin;
+            job.wsMax = wsMax;
+            job.valRange = Nb::Vec2f(
+                 (std::numeric_limits<float>::max)(),
+                -(std::numeric_limits<float>::max)()
+                );
+            job.texData = 0;
+            jobs.push_back(job);
+        }
+    }
+
+    const int jobCount(static_cast<int>(jobs.size()));
+
+#ifdef _OPENMP
+    const bool concurrent(1 < jobCount && omp_get_max_threads() <= jobCount);
+#else
+    const bool concurrent(false);
+#endif
+
+    if (concurrent) {
+        std::vector<int> ready;     // Sampled jobs waiting for upload.
+        std::string      error;     // Exceptions cannot leave the threads.
+
+#pragma omp parallel
+        {
+#pragma omp for schedule(dynamic, 1)
+            for (int j = 0; j < jobCount; ++j) {
+                _SuperTileJob& job(jobs[j]);
+                try {
+                    job.texData = new Ngl::Texture3DData;
+                    _sampleSuperTileTexture3D(
+                        bufferName,
+                        job.texRes,
+                        job.wsMin,
+                        job.wsMax,
+                        gradientTexture,
+                        component,
+                        *job.texData,
+                        &job.valRange
+                        );
+
+#pragma omp critical(Ns3DResourceObjectSuperTileReady)
+                    ready.push_back(j);
+
+                    // Only the calling thread may issue GL commands. Texture
+                    // creation may throw too, which must not leave the
+                    // parallel region either.
+
+#ifdef _OPENMP
+                    if (0 == omp_get_thread_num()) {
+                        _uploadSuperTileTextures(
+                            clientName, bufferName, jobs, ready);
+                    }
+#endif
+                }
+                catch (std::exception& e) {
+#pragma omp critical(Ns3DResourceObjectSuperTileError)
+                    error = e.what();
                 }
             }
-            else {
-                superTileTexture3D(
-                    clientName,bufferName,superTile,texRes,wsMin,wsMax
-                    );
+        }
+
+        if (!error.empty()) {
+            for (int j = 0; j < jobCount; ++j) {
+                delete jobs[j].texData;
             }
+            NB_THROW(error);
         }
 
+        _uploadSuperTileTextures(clientName, bufferName, jobs, ready);
+    }
+    else {
+        for (int j = 0; j < jobCount; ++j) {
+            _SuperTileJob& job(jobs[j]);
+            Ngl::Texture3DData texData;
+            _sampleSuperTileTexture3D(
+                bufferName,
+                job.texRes,
+                job.wsMin,
+                job.wsMax,
+                gradientTexture,
+                component,
+                texData,
+                &job.valRange
+                );
+            _tex3DMap.insert(
+                _Tex3DMap::value_type(
+                    longName(clientName, bufferName, job.superTile),
+                    Ngl::createTexture3D(texData)));
+        }
+    }
 
+    if(gradientTexture && valRange) {
+        for (int j = 0; j < jobCount; ++j) {
+            (*valRange)[0] = std::min((*valRange)[0], jobs[j].valRange[0]);
+            (*valRange)[1] = std::max((*valRange)[1], jobs[j].valRange[1]);
+        }
     }
 }
 
@@ -538,20 +733,11 @@ Ns3DResourceObject::superTileTexture3D(const NtString&         clientName,
     if(tex3D) {
         NB_WARNING("Texture3D '" << name() << "' already exists");
     } else {
-        if(constLayoutPtr())
-            tex3D = Ngl::createTexture3DFromField3f(
-                *constLayoutPtr(),
-                constNbField(bufferName,0),
-                constNbField(bufferName,1),
-                constNbField(bufferName,2),
-                texDim,
-                wsMin,
-                wsMax
-                );
-        else
-            tex3D = Ngl::createTexture3DFrom3f(
-                backgroundValue(),texDim,wsMin,wsMax
-                );
+        Ngl::Texture3DData texData;
+        _sampleSuperTileTexture3D(
+            bufferName, texDim, wsMin, wsMax, false, 0, texData, 0
+            );
+        tex3D = Ngl::createTexture3D(texData);
 
         const NtString resourceName(
             longName(clientName, bufferName, superTile)
@@ -585,27 +771,297 @@ Ns3DResourceObject::superTileGradientTexture3D(const NtString& clientName,
     if(tex3D) {
         NB_WARNING("Texture3D '" << name() << "' already exists");
     } else {
+        Ngl::Texture3DData texData;
+        _sampleSuperTileTexture3D(
+            bufferName, texDim, wsMin, wsMax, true, component, texData,
+            valRange
+            );
+        tex3D = Ngl::createTexture3D(texData);
+
+        const NtString resourceName(
+            longName(clientName, bufferName, superTile)
+            );
+
+        _tex3DMap.insert(_Tex3DMap::value_type(resourceName, tex3D));
+    }
+    
+    return tex3D;
+}
+
+
+// _adaptSuperTileResolutions
+// --------------------------
+//! Replaces the given full super-tile texture resolutions by levels of
+//! detail, where each level halves the number of texels along every axis.
+//! Each super tile gets the coarsest level that still has a texel per pixel
+//! across its projected footprint. Super tiles outside the view keep their
+//! current level, or get the coarsest level if they have no texture. If
+//! the total number of voxels exceeds the budget, the super tiles with the
+//! most voxels per pixel are coarsened further until it fits.
+//!
+//! A super tile keeps its current level as long as the footprint is within
+//! a quarter of a level of the range of that level, so that textures are
+//! not resampled back and forth as the camera moves across a level change.
+
+void
+Ns3DResourceObject::_adaptSuperTileResolutions(
+    const TextureLod&           lod,
+    const NtString&             clientName,
+    const NtString&             bufferName,
+    const std::vector<NtVec3f>& wsMins,
+    const std::vector<NtVec3f>& wsMaxs,
+    std::vector<NtVec3i>&       texRess) const
+{
+    const int superTileCount(static_cast<int>(texRess.size()));
+
+    std::vector<int>    levels(superTileCount);
+    std::vector<int>    maxLevels(superTileCount);
+    std::vector<double> pixels(superTileCount);
+    double              voxelCount(0);
+
+    for (int st = 0; st < superTileCount; ++st) {
+        const NtVec3i& fullRes(texRess[st]);
+        const int texels(
+            std::max(fullRes[0], std::max(fullRes[1], fullRes[2])));
+
+        int maxLevel(0);
+        while (2 < ((texels - 1) >> maxLevel) + 1) {
+            ++maxLevel;
+        }
+        maxLevels[st] = maxLevel;
+
+        // Current level, if any.
+
+        int current(-1);
+        const Ngl::Texture3D* tex3D(
+            queryConstTexture3D(clientName, bufferName, st));
+        if (tex3D) {
+            for (int level = 0; level <= maxLevel; ++level) {
+                const NtVec3i res(_levelRes(fullRes, level));
+                if (tex3D->width()  == res[0] &&
+                    tex3D->height() == res[1] &&
+                    tex3D->depth()  == res[2]) {
+                    current = level;
+                    break;
+                }
+            }
+        }
+
+        bool visible(false);
+        pixels[st] = _projectedSize(lod, wsMins[st], wsMaxs[st], &visible);
+
+        int level(maxLevel);
+        if (!visible) {
+            level = (0 <= current ? current : maxLevel);
+        }
+        else {
+            const double f(
+                std::log(texels/std::max(1., pixels[st]))/std::log(2.));
+
+            if (0 <= current && current - 0.25 <= f && f <= current + 1.25) {
+                level = current;
+            }
+            else {
+                level = std::max(0, std::min(maxLevel, int(std::floor(f))));
+            }
+        }
+        levels[st] = level;
+
+        const NtVec3i res(_levelRes(fullRes, level));
+        voxelCount += double(res[0])*res[1]*res[2];
+    }
+
+    // Coarsen super tiles until the voxel budget is met.
+
+    while (0 < lod.voxelBudget && lod.voxelBudget < voxelCount) {
+        int    worst(-1);
+        double worstDensity(0);
+        for (int st = 0; st < superTileCount; ++st) {
+            if (levels[st] < maxLevels[st]) {
+                const NtVec3i res(_levelRes(texRess[st], levels[st]));
+                const double density(
+                    double(res[0])*res[1]*res[2]/
+                    std::max(1., pixels[st]*pixels[st]));
+                if (worst < 0 || worstDensity < density) {
+                    worst = st;
+                    worstDensity = density;
+                }
+            }
+        }
+
+        if (worst < 0) {
+            break;  // Everything is as coarse as it gets.
+        }
+
+        const NtVec3i oldRes(_levelRes(texRess[worst], levels[worst]));
+        const NtVec3i newRes(_levelRes(texRess[worst], ++levels[worst]));
+        voxelCount -= double(oldRes[0])*oldRes[1]*oldRes[2];
+        voxelCount += double(newRes[0])*newRes[1]*newRes[2];
+    }
+
+    for (int st = 0; st < superTileCount; ++st) {
+        texRess[st] = _levelRes(texRess[st], levels[st]);
+    }
+}
+
+
+// _levelRes
+// ---------
+//! Returns the texture resolution at the given level of detail, where each
+//! level halves the number of texel intervals along every axis. [static]
+
+NtVec3i
+Ns3DResourceObject::_levelRes(const NtVec3i& fullRes, const int level)
+{
+    return NtVec3i(std::max(2, ((fullRes[0] - 1) >> level) + 1),
+                   std::max(2, ((fullRes[1] - 1) >> level) + 1),
+                   std::max(2, ((fullRes[2] - 1) >> level) + 1));
+}
+
+
+// _projectedSize
+// --------------
+//! Returns the largest extent in pixels of the given world space box as
+//! seen through the given view. Boxes reaching behind the eye are treated
+//! as filling the viewport. [static]
+
+double
+Ns3DResourceObject::_projectedSize(const TextureLod& lod,
+                                   const NtVec3f&    wsMin,
+                                   const NtVec3f&    wsMax,
+                                   bool*             visible)
+{
+    GLfloat ndcMin[2] = {  (std::numeric_limits<GLfloat>::max)(),
+                           (std::numeric_limits<GLfloat>::max)() };
+    GLfloat ndcMax[2] = { -(std::numeric_limits<GLfloat>::max)(),
+                          -(std::numeric_limits<GLfloat>::max)() };
+
+    for (int c = 0; c < 8; ++c) {
+        const GLfloat ws[4] = {
+            (c & 1) ? wsMax[0] : wsMin[0],
+            (c & 2) ? wsMax[1] : wsMin[1],
+            (c & 4) ? wsMax[2] : wsMin[2],
+            1.f
+        };
+
+        // Column-major transforms, as stored by OpenGL.
+
+        GLfloat eye[4];
+        GLfloat clip[4];
+        for (int r = 0; r < 4; ++r) {
+            eye[r] = 0.f;
+            for (int k = 0; k < 4; ++k) {
+                eye[r] += lod.modelview[4*k + r]*ws[k];
+            }
+        }
+        for (int r = 0; r < 4; ++r) {
+            clip[r] = 0.f;
+            for (int k = 0; k < 4; ++k) {
+                clip[r] += lod.projection[4*k + r]*eye[k];
+            }
+        }
+
+        if (clip[3] <= 0.f) {
+            *visible = true;
+            return std::max(lod.viewportWidth, lod.viewportHeight);
+        }
+
+        for (int a = 0; a < 2; ++a) {
+            const GLfloat ndc(clip[a]/clip[3]);
+            ndcMin[a] = std::min(ndcMin[a], ndc);
+            ndcMax[a] = std::max(ndcMax[a], ndc);
+        }
+    }
+
+    *visible = (ndcMin[0] <= 1.f && -1.f <= ndcMax[0] &&
+                ndcMin[1] <= 1.f && -1.f <= ndcMax[1]);
+
+    return std::max(0.5*(ndcMax[0] - ndcMin[0])*lod.viewportWidth,
+                    0.5*(ndcMax[1] - ndcMin[1])*lod.viewportHeight);
+}
+
+
+// _sampleSuperTileTexture3D
+// -------------------------
+//! Samples the texel data of a super-tile texture. Gradient textures store
+//! the gradient of the given component in RGB and its value in A, other
+//! textures store the three components in RGB, with A = 1. Only reads
+//! field data, so it may be called from any thread.
+
+void
+Ns3DResourceObject::_sampleSuperTileTexture3D(const NtString&     bufferName,
+                                              const NtVec3i&      texDim,
+                                              const NtVec3f&      wsMin,
+                                              const NtVec3f&      wsMax,
+                                              const bool          gradient,
+                                              const int           component,
+                                              Ngl::Texture3DData& texData,
+                                              Nb::Vec2f*          valRange) const
+{
+    if (gradient) {
         if(constLayoutPtr())
-            tex3D = Ngl::createTexture3DFromField1f(
+            Ngl::sampleTexture3DFromField1f(
                 *constLayoutPtr(),
                 constNbField(bufferName,component),
                 texDim,
                 wsMin,
                 wsMax,
+                texData,
                 true,
                 valRange
                 );
         else
-            tex3D = Ngl::createTexture3DFrom1f(
-                backgroundValue()[component],texDim,wsMin,wsMax,valRange
+            Ngl::sampleTexture3DFrom1f(
+                backgroundValue()[component],texDim,wsMin,wsMax,texData,
+                valRange
+                );
+    }
+    else {
+        if(constLayoutPtr())
+            Ngl::sampleTexture3DFromField3f(
+                *constLayoutPtr(),
+                constNbField(bufferName,0),
+                constNbField(bufferName,1),
+                constNbField(bufferName,2),
+                texDim,
+                wsMin,
+                wsMax,
+                texData
+                );
+        else
+            Ngl::sampleTexture3DFrom3f(
+                backgroundValue(),texDim,wsMin,wsMax,texData
                 );
+    }
+}
 
-        const NtString resourceName(
-            longName(clientName, bufferName, superTile)
-            );
 
-        _tex3DMap.insert(_Tex3DMap::value_type(resourceName, tex3D));
+// _uploadSuperTileTextures
+// ------------------------
+//! Creates textures from the sampled jobs in the ready list, freeing their
+//! texel data. Must be called on the GL thread.
+
+void
+Ns3DResourceObject::_uploadSuperTileTextures(
+    const NtString&             clientName,
+    const NtString&             bufferName,
+    std::vector<_SuperTileJob>& jobs,
+    std::vector<int>&           ready)
+{
+    std::vector<int> batch;
+
+#pragma omp critical(Ns3DResourceObjectSuperTileReady)
+    batch.swap(ready);
+
+    for (std::size_t b = 0; b < batch.size(); ++b) {
+        _SuperTileJob& job(jobs[batch[b]]);
+
+        _tex3DMap.insert(
+            _Tex3DMap::value_type(
+                longName(clientName, bufferName, job.superTile),
+                Ngl::createTexture3D(*job.texData)));
+
+        delete job.texData;
+        job.texData = 0;
     }
-    
-    return tex3D;
 }
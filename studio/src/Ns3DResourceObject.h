@@ -45,13 +45,17 @@
 #include <Ni.h>
 #include <NbField.h>
 
+#include <NglTextureUtils.h>   // Ngl::Texture3DData
+
 #include <sstream>
+#include <vector>
 
 namespace Ngl {
 class SuperTileLayout;
 class Texture3D;
 class VertexBuffer;
 class ShaderProgram;
+class OcclusionQueries;
 }
 
 
@@ -61,8 +65,41 @@ public:     // Interface
 
     typedef QGLFramebufferObject::Attachment FBOAttachment;
 
+    //! View used to choose super-tile texture resolutions adaptively, see
+    //! computeSuperTileTextures().
+
+    struct TextureLod
+    {
+        TextureLod()
+            : viewportWidth(0)
+            , viewportHeight(0)
+            , voxelBudget(0)
+        {}
+
+        //! Returns the current GL view, with the given voxel budget.
+        static TextureLod
+        current(const double voxelBudget)
+        {
+            TextureLod lod;
+            glGetFloatv(GL_MODELVIEW_MATRIX, lod.modelview);
+            glGetFloatv(GL_PROJECTION_MATRIX, lod.projection);
+            GLint vp[4];
+            glGetIntegerv(GL_VIEWPORT, vp);
+            lod.viewportWidth = vp[2];
+            lod.viewportHeight = vp[3];
+            lod.voxelBudget = voxelBudget;
+            return lod;
+        }
+
+        GLfloat modelview[16];
+        GLfloat projection[16];
+        int     viewportWidth;
+        int     viewportHeight;
+        double  voxelBudget;    //!< Total voxels, zero for no limit.
+    };
+
     explicit
-    Ns3DResourceObject();
+    Ns3DResourceObject(const NtString& cacheName = "");
 
     virtual
     ~Ns3DResourceObject();
@@ -71,7 +108,8 @@ public:     // Interface
     // Create resources.
     //
 
-    //! Create super-tile layout resource from tile layout.
+    //! Create super-tile layout resource from tile layout, or return the
+    //! existing one if it was built for the same clip-box.
 
     const Ngl::SuperTileLayout*
     createSuperTileLayout(const float clipXform[16],
@@ -174,6 +212,13 @@ public:     // Interface
     queryMutableFramebufferObject(const NtString& clientName,
                                   const NtString& bufferName);
 
+    //! Occlusion queries for the given client, created if needed. Like
+    //! framebuffers they depend on the view and are never cached.
+
+    Ngl::OcclusionQueries*
+    occlusionQueries(const NtString& clientName,
+                     const NtString& bufferName);
+
 
     //
     // Free resources.
@@ -190,7 +235,8 @@ public:     // Interface
     
 
     //! Computes/recomputes 3D textures corresponding to each super tile in the
-    //! super-tile layout.
+    //! super-tile layout. If a view is given, the resolution of each super
+    //! tile is adapted to its size on screen.
 
     void computeSuperTileTextures(const NtString&   clientName,
                                   const NtString&   bufferName,
@@ -198,8 +244,14 @@ public:     // Interface
                                   const float         clipXform[16],
                                   const bool          gradientTexture,
                                   const int           component = 0,
-                                  Nb::Vec2f*          valRange = 0);
+                                  Nb::Vec2f*          valRange = 0,
+                                  const TextureLod*   lod = 0);
     
+    //! Returns the name under which the resources are kept in the resource
+    //! cache when the object is destroyed, or an empty string if they are
+    //! destroyed along with the object.
+    const NtString& cacheName() const { return _cacheName; }
+
     //! Returns the name of the resource object.
     virtual const NtString name() const = 0;
 
@@ -236,18 +288,69 @@ public:     // Interface
         return ss.str();
     }
 
+private:
+
+    //! A super-tile texture to be sampled by computeSuperTileTextures().
+
+    struct _SuperTileJob
+    {
+        int                 superTile;
+        NtVec3i             texRes;
+        NtVec3f             wsMin;
+        NtVec3f             wsMax;
+        Nb::Vec2f           valRange;
+        Ngl::Texture3DData *texData;    //!< Null until sampled.
+    };
+
+    void
+    _sampleSuperTileTexture3D(const NtString&     bufferName,
+                              const NtVec3i&      texDim,
+                              const NtVec3f&      wsMin,
+                              const NtVec3f&      wsMax,
+                              bool                gradient,
+                              int                 component,
+                              Ngl::Texture3DData& texData,
+                              Nb::Vec2f*          valRange) const;
+
+    void
+    _adaptSuperTileResolutions(const TextureLod&           lod,
+                               const NtString&             clientName,
+                               const NtString&             bufferName,
+                               const std::vector<NtVec3f>& wsMins,
+                               const std::vector<NtVec3f>& wsMaxs,
+                               std::vector<NtVec3i>&       texRess) const;
+
+    static NtVec3i
+    _levelRes(const NtVec3i& fullRes, int level);
+
+    static double
+    _projectedSize(const TextureLod& lod,
+                   const NtVec3f&    wsMin,
+                   const NtVec3f&    wsMax,
+                   bool*             visible);
+
+    void
+    _uploadSuperTileTextures(const NtString&             clientName,
+                             const NtString&             bufferName,
+                             std::vector<_SuperTileJob>& jobs,
+                             std::vector<int>&           ready);
+
 protected:        // Member variables
 
     typedef std::map<NtString, Ngl::Texture3D*>       _Tex3DMap;
     typedef std::map<NtString, Ngl::VertexBuffer*>    _VertexBufferMap;
     typedef std::map<NtString, QGLFramebufferObject*> _FBOMap;
+    typedef std::map<NtString, Ngl::OcclusionQueries*> _OcclusionMap;
 
     _Tex3DMap        _tex3DMap;
     _VertexBufferMap _vtxBufMap;
     _FBOMap          _fboMap;
+    _OcclusionMap    _occlusionMap;
 
     Ngl::SuperTileLayout* _superLayout;
 
+    NtString _cacheName;
+
 };
 
 #endif // NS3D_RESOURCE_OBJECT_H
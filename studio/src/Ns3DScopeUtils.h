@@ -49,7 +49,9 @@
 
 #include <em_glmat44_algo.h>
 
+#include <climits>
 #include <cstring>
+#include <limits>
 #include <QtGlobal>
 
 // -----------------------------------------------------------------------------
@@ -123,32 +125,14 @@ computeModelViewXform(const NtVec3f& pos,
 // -----------------------------------------------------------------------------
 
 inline void
-computeClipBoxXforms(const Nb::Value3f*  translateParam,
-                     const Nb::Value3f*  rotateParam,
-                     const Nb::Value3f*  scaleParam,
-                     em::glmat44f&       clipXform,
-                     em::glmat44f&       invClipXform)
+computeClipBoxXforms(const NtVec3f&   translate,
+                     const NtVec3f&   rotate,
+                     const NtVec3f&   scale,
+                     em::glmat44f&    clipXform,
+                     em::glmat44f&    invClipXform)
 {
     // Create clip-box transform (and inverse).
 
-    NtVec3f translate(
-        translateParam->eval(Nb::ZeroTimeBundle, 0),
-        translateParam->eval(Nb::ZeroTimeBundle, 1),
-        translateParam->eval(Nb::ZeroTimeBundle, 2)
-        );
-    
-    NtVec3f rotate(
-        rotateParam->eval(Nb::ZeroTimeBundle, 0),
-        rotateParam->eval(Nb::ZeroTimeBundle, 1),
-        rotateParam->eval(Nb::ZeroTimeBundle, 2)
-        );
-    
-    NtVec3f scale(
-        scaleParam->eval(Nb::ZeroTimeBundle, 0),
-        scaleParam->eval(Nb::ZeroTimeBundle, 1),
-        scaleParam->eval(Nb::ZeroTimeBundle, 2)
-        );
-    
     clipXform = em::make_transform(translate, rotate, scale);
 
     em::glmat44d xfd;
@@ -169,6 +153,104 @@ computeClipBoxXforms(const Nb::Value3f*  translateParam,
 
 }
 
+
+inline NtVec3f
+evalValue3f(const Nb::Value3f* param, const Nb::TimeBundle& tb)
+{
+    return NtVec3f(param->eval(tb, 0), param->eval(tb, 1), param->eval(tb, 2));
+}
+
+
+inline void
+computeClipBoxXforms(const Nb::Value3f*  translateParam,
+                     const Nb::Value3f*  rotateParam,
+                     const Nb::Value3f*  scaleParam,
+                     em::glmat44f&       clipXform,
+                     em::glmat44f&       invClipXform)
+{
+    computeClipBoxXforms(evalValue3f(translateParam, Nb::ZeroTimeBundle),
+                         evalValue3f(rotateParam, Nb::ZeroTimeBundle),
+                         evalValue3f(scaleParam, Nb::ZeroTimeBundle),
+                         clipXform,
+                         invClipXform);
+}
+
+//! World-space axis-aligned bounds of the unit clip-box under the given
+//! transform.
+
+inline void
+computeClipBoxBounds(const em::glmat44f& clipXform,
+                     NtVec3f&            wsMin,
+                     NtVec3f&            wsMax)
+{
+    wsMin = NtVec3f( std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max());
+    wsMax = NtVec3f(-std::numeric_limits<float>::max(),
+                    -std::numeric_limits<float>::max(),
+                    -std::numeric_limits<float>::max());
+
+    for (int v = 0; v < 8; ++v) {
+        const NtVec3f corner((v & 1) ? 0.5f : -0.5f,
+                             (v & 2) ? 0.5f : -0.5f,
+                             (v & 4) ? 0.5f : -0.5f);
+        const NtVec3f wsx(clipXform*corner);
+        for (int i = 0; i < 3; ++i) {
+            wsMin[i] = std::min(wsMin[i], wsx[i]);
+            wsMax[i] = std::max(wsMax[i], wsx[i]);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+//! Records the value revision and time bundle that a scope's cached
+//! parameter values were evaluated at, so that scopes only need to go
+//! through the expression evaluator when something has actually changed.
+
+class Ns3DParamStamp
+{
+public:
+
+    Ns3DParamStamp()
+        : _revision(-1)
+        , _frame(INT_MIN)
+        , _timestep(INT_MIN)
+        , _time(0.)
+    {}
+
+    //! Returns true (and updates the stamp) if the given revision or time
+    //! differs from the stamped ones, i.e. if cached values are stale.
+    bool
+    update(const int revision, const Nb::TimeBundle& tb)
+    {
+        if (revision == _revision && 
+            tb.frame == _frame && 
+            tb.timestep == _timestep && 
+            tb.time == _time) {
+            return false;
+        }
+
+        _revision = revision;
+        _frame = tb.frame;
+        _timestep = tb.timestep;
+        _time = tb.time;
+        return true;
+    }
+
+    //! Forces the next update() to report stale values.
+    void
+    invalidate()
+    { _revision = -1; }
+
+private:    // Member variables.
+
+    int    _revision;
+    int    _frame;
+    int    _timestep;
+    double _time;
+};
+
 // -----------------------------------------------------------------------------
 
 inline void
@@ -45,23 +45,27 @@
 
 #include <em_glmat44_algo.h>
 
+#include <NglFrustum.h>
+#include <NglOcclusionQueries.h>
 #include <NglSlicing.h>
 #include <NglTexture3D.h>
 #include <NglSuperTile.h>
 #include <NglSuperTileLayout.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 // -----------------------------------------------------------------------------
 
 inline Ngl::VertexBuffer*
 sliceClipBoxVertexBuffer(const NtString&     clientName,
                          Ns3DResourceObject* robject,                         
-                         const Nb::Value1i*  sliceCountParam,
+                         const int           sliceCount,
                          const em::glmat44f  xfModel,
                          const em::glmat44f  xfView,
                          GLfloat*            spacing=0)
 {   
-    const int sliceCount(sliceCountParam->eval(Nb::ZeroTimeBundle));
-
     // We begin by constructing/updating the vertex buffer holding
     // the slices.
 
@@ -107,6 +111,49 @@ sliceClipBoxVertexBuffer(const NtString&     clientName,
     return sliceVtxBuf;
 }
 
+
+inline Ngl::VertexBuffer*
+sliceClipBoxVertexBuffer(const NtString&     clientName,
+                         Ns3DResourceObject* robject,                         
+                         const Nb::Value1i*  sliceCountParam,
+                         const em::glmat44f  xfModel,
+                         const em::glmat44f  xfView,
+                         GLfloat*            spacing=0)
+{
+    return sliceClipBoxVertexBuffer(
+        clientName,
+        robject,
+        sliceCountParam->eval(Nb::ZeroTimeBundle),
+        xfModel,
+        xfView,
+        spacing);
+}
+
+// -----------------------------------------------------------------------------
+
+//! Draws the faces of an axis-aligned box, used as occlusion query proxy.
+
+inline void
+drawOcclusionBox(const NtVec3f& wsMin, const NtVec3f& wsMax)
+{
+    const NtVec3f b[2] = { wsMin, wsMax };
+
+    glBegin(GL_QUADS);
+    for (int axis = 0; axis < 3; ++axis) {
+        const int u((axis + 1)%3);
+        const int v((axis + 2)%3);
+        for (int side = 0; side < 2; ++side) {
+            NtVec3f p;
+            p[axis] = b[side][axis];
+            p[u] = b[0][u]; p[v] = b[0][v]; glVertex3fv(&p[0]);
+            p[u] = b[1][u];                 glVertex3fv(&p[0]);
+            p[v] = b[1][v];                 glVertex3fv(&p[0]);
+            p[u] = b[0][u];                 glVertex3fv(&p[0]);
+        }
+    }
+    glEnd();
+}
+
 // -----------------------------------------------------------------------------
 
 inline void
@@ -121,7 +168,10 @@ drawSlicedClipBox(const NtString&   clientName,
                   const Nb::Value1i*  sliceCountParam,
                   const Nb::Value3f*  supersamplingParam,
                   Nb::Value1f*        minValue=0,
-                  Nb::Value1f*        maxValue=0)
+                  Nb::Value1f*        maxValue=0,
+                  const Nb::Value1e*  adaptiveResParam=0,
+                  const Nb::Value1i*  voxelBudgetParam=0,
+                  const Nb::Value1e*  occlusionParam=0)
 {       
     // Compute clip-box matrices.
 
@@ -173,14 +223,21 @@ drawSlicedClipBox(const NtString&   clientName,
     // Make the super-tile textures for this scope & channel.
 
     const Ngl::SuperTileLayout* superLayout = 
-        robject->queryConstSuperTileLayout();
-    if(!superLayout) {
-        superLayout = robject->createSuperTileLayout(&clipXform[0][0]);
-    }
+        robject->createSuperTileLayout(&clipXform[0][0]);
 
     Nb::Vec2f valRange(minValue ? minValue->eval(Nb::ZeroTimeBundle) : 0,
                        maxValue ? maxValue->eval(Nb::ZeroTimeBundle) : 0);
 
+    // Adapt the super-tile texture resolutions to the current view.
+
+    const bool adaptiveRes(
+        adaptiveResParam &&
+        "On" == adaptiveResParam->eval(Nb::ZeroTimeBundle));
+    const Ns3DResourceObject::TextureLod lod(
+        Ns3DResourceObject::TextureLod::current(
+            voxelBudgetParam ?
+            1.e6*voxelBudgetParam->eval(Nb::ZeroTimeBundle) : 0.));
+
     robject->computeSuperTileTextures(
         clientName,
         fieldName,
@@ -190,7 +247,8 @@ drawSlicedClipBox(const NtString&   clientName,
         &clipXform[0][0],
         true, // gradientTextures
         component,
-        &valRange);
+        &valRange,
+        adaptiveRes ? &lod : 0);
 
     if(minValue) {
         std::stringstream ss; ss << valRange[0];
@@ -202,16 +260,95 @@ drawSlicedClipBox(const NtString&   clientName,
         maxValue->setExpr(ss.str());
     }
 
-    // We continue by rendering the slice vertex buffer.
-    
-    shader->use();    
-        
+    // World-space bounds of the clip-box, super-tiles outside these bounds
+    // or outside the view frustum contribute no fragments.
+
+    NtVec3f clipMin, clipMax;
+    computeClipBoxBounds(clipXform, clipMin, clipMax);
+
+    const Ngl::Frustum frustum(projectionXform*modelViewXform);
+
+    // Super-tiles overlapping the clip-box and the view frustum, with their
+    // eye-space distance.
+
+    std::vector<std::pair<GLfloat, int> > visible;
+    std::vector<NtVec3f> cullMins(superLayout->superTileCount());
+    std::vector<NtVec3f> cullMaxs(superLayout->superTileCount());
     for(int superTile=0; superTile<superLayout->superTileCount(); ++superTile) {
+        NtVec3f wsMin, wsMax;
+        superLayout->superTile(superTile).bounds(wsMin, wsMax);
+
+        const NtVec3f cullMin(std::max(wsMin[0], clipMin[0]),
+                              std::max(wsMin[1], clipMin[1]),
+                              std::max(wsMin[2], clipMin[2]));
+        const NtVec3f cullMax(std::min(wsMax[0], clipMax[0]),
+                              std::min(wsMax[1], clipMax[1]),
+                              std::min(wsMax[2], clipMax[2]));
+        if (cullMax[0] < cullMin[0] || 
+            cullMax[1] < cullMin[1] || 
+            cullMax[2] < cullMin[2] ||
+            !frustum.intersects(cullMin, cullMax)) {
+            continue;
+        }
+
+        cullMins[superTile] = cullMin;
+        cullMaxs[superTile] = cullMax;
+
+        GLfloat eyeZ(modelViewXform[3][2]);
+        for (int k = 0; k < 3; ++k) {
+            eyeZ += modelViewXform[k][2]*0.5f*(cullMin[k] + cullMax[k]);
+        }
+        visible.push_back(std::make_pair(-eyeZ, superTile));
+    }
+
+    // With the opaque iso shader, super-tiles hidden behind nearer parts of
+    // the surface can be skipped. They are drawn front-to-back, and each
+    // super-tile's box is tested with an occlusion query before the
+    // super-tile itself is drawn. Results are read in later frames, so a
+    // super-tile that becomes visible appears one frame late.
+
+    Ngl::OcclusionQueries* queries(0);
+    if (occlusionParam &&
+        "On" == occlusionParam->eval(Nb::ZeroTimeBundle) &&
+        Ngl::getGLExtensionFunctions().occlusionQuerySupported()) {
+        queries = robject->occlusionQueries(clientName, fieldName);
+        queries->resize(superLayout->superTileCount());
+        std::sort(visible.begin(), visible.end());
+    }
+
+    // We continue by rendering the slice vertex buffer. Only the super-tile
+    // bounds change between draws, so only they are uploaded in the loop.
 
-        // TODO: Check if super-tile intersects clip-box!
+    const int wsMinHandle(shader->uniformHandle("wsMin"));
+    const int invWsRangeHandle(shader->uniformHandle("invWsRange"));
+    
+    shader->use();    
         
+    for(std::size_t i = 0; i < visible.size(); ++i) {
+        const int superTile(visible[i].second);
         NtVec3f wsMin, wsMax;
         superLayout->superTile(superTile).bounds(wsMin, wsMax);
+
+        if (queries) {
+            const bool occluded(queries->occluded(superTile));
+            if (queries->begin(superTile)) {
+                shader->unuse();
+                glPushAttrib(GL_COLOR_BUFFER_BIT | 
+                             GL_DEPTH_BUFFER_BIT | 
+                             GL_ENABLE_BIT);
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                glDepthMask(GL_FALSE);
+                glDisable(GL_CULL_FACE);
+                drawOcclusionBox(cullMins[superTile], cullMaxs[superTile]);
+                glPopAttrib();
+                queries->end();
+                shader->use();
+            }
+
+            if (occluded) {
+                continue;
+            }
+        }
         
         const NtVec3f invWsRange(
             1.f/(wsMax[0] - wsMin[0]),
@@ -219,8 +356,8 @@ drawSlicedClipBox(const NtString&   clientName,
             1.f/(wsMax[2] - wsMin[2])
             );
         
-        shader->storeUniform3f("wsMin", wsMin);
-        shader->storeUniform3f("invWsRange", invWsRange);
+        shader->storeUniform3f(wsMinHandle, wsMin);
+        shader->storeUniform3f(invWsRangeHandle, invWsRange);
         shader->uploadUniforms(Nb::ZeroTimeBundle);
         
         const Ngl::Texture3D* tex3D = 
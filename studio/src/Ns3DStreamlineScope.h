@@ -70,22 +70,33 @@ public:
          const Ns3DCameraScope* cam,
          const Ngl::Viewport&   vp)
     {        
-        drawStreamlines(
-            name(),
-            param1s("Channel")->eval(Nb::ZeroTimeBundle),
-            nsBody->ns3DBody(),
+        drawStreamlines(name(), _channel, nsBody->ns3DBody(), _params);
+
+        ssHud << "Body: '" << fromQStr(nsBody->name()) << "\n";
+
+        return true;
+    }
+
+protected:
+
+    virtual void
+    updateParams(const Nb::TimeBundle &tb)
+    {
+        _channel = param1s("Channel")->eval(Nb::ZeroTimeBundle);
+        evalStreamlineParams(
             param3f("Translate"),
             param3f("Rotate"),
             param3f("Scale"),
             param1f("Streamline Spacing"),
             param1f("Streamline Time"),
-            param1i("Samples Per Streamline")
-            );
+            param1i("Samples Per Streamline"),
+            _params);
+    }
 
-        ssHud << "Body: '" << fromQStr(nsBody->name()) << "\n";
+private:     // Member variables
 
-        return true;
-    }
+    NtString             _channel;
+    Ns3DStreamlineParams _params;
 };
 
 // -----------------------------------------------------------------------------
@@ -48,49 +48,72 @@
 
 // -----------------------------------------------------------------------------
 
+//! Evaluated streamline scope parameters.
+
+struct Ns3DStreamlineParams
+{
+    Ns3DStreamlineParams()
+        : spacing(1.f)
+        , timeLength(0.f)
+        , sampleDt(0.f)
+    {}
+
+    em::mat44f M;           //!< Seed box transform (without scale).
+    NtVec3f    x0;          //!< Seed box min, in box space.
+    NtVec3f    x1;          //!< Seed box max, in box space.
+    float      spacing;
+    float      timeLength;
+    float      sampleDt;
+};
+
+
 inline void
-drawStreamlines(const NtString&     clientName,
-                const NtString&     fieldName,
-                Ns3DResourceObject* robject,
-                const Nb::Value3f*  translateParam,
-                const Nb::Value3f*  rotateParam,
-                const Nb::Value3f*  scaleParam,
-                const Nb::Value1f*  streamlineSpacingParam,
-                const Nb::Value1f*  streamlineTimeParam,
-                const Nb::Value1i*  streamlineSamplesParam,
-                Nb::Value1f*        minValue=0,
-                Nb::Value1f*        maxValue=0)
-{       
+evalStreamlineParams(const Nb::Value3f*    translateParam,
+                     const Nb::Value3f*    rotateParam,
+                     const Nb::Value3f*    scaleParam,
+                     const Nb::Value1f*    streamlineSpacingParam,
+                     const Nb::Value1f*    streamlineTimeParam,
+                     const Nb::Value1i*    streamlineSamplesParam,
+                     Ns3DStreamlineParams& params)
+{
     const Ngl::vec3f translate(
-        translateParam->eval(Nb::ZeroTimeBundle,0),
-        translateParam->eval(Nb::ZeroTimeBundle,1),
-        translateParam->eval(Nb::ZeroTimeBundle,2)
-        );
+        evalValue3f(translateParam, Nb::ZeroTimeBundle));
     const Ngl::vec3f rotate(
-        rotateParam->eval(Nb::ZeroTimeBundle,0),
-        rotateParam->eval(Nb::ZeroTimeBundle,1),
-        rotateParam->eval(Nb::ZeroTimeBundle,2)
-        );
+        evalValue3f(rotateParam, Nb::ZeroTimeBundle));
     const Ngl::vec3f scale(
-        scaleParam->eval(Nb::ZeroTimeBundle,0),
-        scaleParam->eval(Nb::ZeroTimeBundle,1),
-        scaleParam->eval(Nb::ZeroTimeBundle,2)
-        );
+        evalValue3f(scaleParam, Nb::ZeroTimeBundle));
 
     em::quaternionf qr;
     qr.set_euler_angles(rotate);
-    const em::mat44f M(em::make_transform(translate, qr, em::vec3f(1)));
+    params.M = em::make_transform(translate, qr, em::vec3f(1));
 
-    const NtVec3f x0(-0.5f*scale[0],-0.5f*scale[1],-0.5f*scale[2]);
-    const NtVec3f x1( 0.5f*scale[0], 0.5f*scale[1], 0.5f*scale[2]);
+    params.x0 = NtVec3f(-0.5f*scale[0],-0.5f*scale[1],-0.5f*scale[2]);
+    params.x1 = NtVec3f( 0.5f*scale[0], 0.5f*scale[1], 0.5f*scale[2]);
                                                    
-    const float dx=
-        streamlineSpacingParam->eval(Nb::ZeroTimeBundle);
+    params.spacing = streamlineSpacingParam->eval(Nb::ZeroTimeBundle);
+    params.timeLength = streamlineTimeParam->eval(Nb::ZeroTimeBundle);
+    params.sampleDt = 
+        params.timeLength/streamlineSamplesParam->eval(Nb::ZeroTimeBundle);
+}
 
-    const float timelen=
-        streamlineTimeParam->eval(Nb::ZeroTimeBundle);
-    const float sampleDt=
-        timelen/streamlineSamplesParam->eval(Nb::ZeroTimeBundle);
+// -----------------------------------------------------------------------------
+
+inline void
+drawStreamlines(const NtString&             clientName,
+                const NtString&             fieldName,
+                Ns3DResourceObject*         robject,
+                const Ns3DStreamlineParams& params)
+{       
+    const em::mat44f& M(params.M);
+    const NtVec3f& x0(params.x0);
+    const NtVec3f& x1(params.x1);
+    const float dx(params.spacing);
+    const float timelen(params.timeLength);
+    const float sampleDt(params.sampleDt);
+
+    if (!(dx > 0.f) || !(sampleDt > 0.f)) {
+        return; // Would never terminate.
+    }
 
     const Nb::TileLayout* layout(robject->constLayoutPtr());
     if(!layout) {
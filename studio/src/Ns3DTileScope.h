@@ -53,8 +53,11 @@
 #include "Ns3DCameraScope.h"
 #include "Ns3DTileScopeUtils.h"
 
-#include <map>
-#include <set>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // -----------------------------------------------------------------------------
 
@@ -65,6 +68,7 @@ public:
         : Ns3DBodyScope()
         , _surfaceShader(0)
         , _lineShader(0)
+        , _gridShader(0)
     {
     }
     
@@ -75,16 +79,20 @@ public:
 
         delete _surfaceShader;
         delete _lineShader;
+        delete _gridShader;
     }
 
     virtual void
     reset()
     {
         _surfaceShader = new Ngl::ShaderProgram(
-            NtString(shaderPath() + "tile-surface.vs"),
+            NtString(shaderPath() + "tile-box-surface.vs"),
             NtString(shaderPath() + "tile-surface.fs"));
         _lineShader = new Ngl::ShaderProgram(
-            NtString(shaderPath() + "tile-lines.vs"),
+            NtString(shaderPath() + "tile-box-lines.vs"),
+            NtString(shaderPath() + "tile-lines.fs"));
+        _gridShader = new Ngl::ShaderProgram(
+            NtString(shaderPath() + "tile-grid.vs"),
             NtString(shaderPath() + "tile-lines.fs"));
     }
 
@@ -101,6 +109,11 @@ public:
             return true; // Early exit!
         }
 
+        if (!Ngl::getGLExtensionFunctions().instancingSupported()) {
+            ssHud << "Tile-Scope: instanced arrays not supported\n";
+            return true; // Tiles and cells are drawn instanced.
+        }
+
         _drawTiles(
             name(),
             queryCurrentVisibleFrameTimeBundle(),
@@ -210,173 +223,147 @@ private:    // _Vtx
         _Vec3f _wsx;   //!< World space.
     };
 
-private:    // _Line.
+private:    // _Cube.
 
-    class _Line
+    class _Cube
     {
     public:
 
         //! CTOR.
         explicit
-        _Line(const GLuint v0, const GLuint v1)
-        {
-            _v[0] = v0;
-            _v[1] = v1;
-        }
-
-        //! Copy CTOR.
-        _Line(const _Line &rhs)
-        {
-            _v[0] = rhs._v[0];
-            _v[1] = rhs._v[1];
-        }
-
-        //! Assign.
-        _Line&
-        operator=(const _Line &rhs)
-        {
-            _v[0] = rhs._v[0];
-            _v[1] = rhs._v[1];
-            return *this;
-        }
-
-        bool
-        operator<(const _Line &rhs) const
-        {
-            const GLuint sv0[] = {
-                qMin(_v[0], _v[1]), qMax(_v[0], _v[1])
-            };
-
-            const GLuint sv1[] = {
-                qMin(rhs._v[0], rhs._v[1]), qMax(rhs._v[0], rhs._v[1])
-            };
-
-            return (sv0[0] < sv1[0]) ||
-                   ((sv0[0] == sv1[0]) && (sv0[1] < sv1[1]));
-        }
+        _Cube(const _Vtx &vtx0, const _Vtx &vtx1)
+            : _vtx0(vtx0)
+            , _vtx1(vtx1)
+        {}
 
-        //! No bounds checking!
-        const GLuint&
-        operator[](const int i) const
-        { return _v[i]; }
+        int i0() const { return _vtx0.i(); }
+        int j0() const { return _vtx0.j(); }
+        int k0() const { return _vtx0.k(); }
+        int i1() const { return _vtx1.i(); }
+        int j1() const { return _vtx1.j(); }
+        int k1() const { return _vtx1.k(); }
 
-        //! No bounds checking!
-        GLuint&
-        operator[](const int i)
-        { return _v[i]; }
+        float x0() const { return _vtx0.x(); }
+        float y0() const { return _vtx0.y(); }
+        float z0() const { return _vtx0.z(); }
+        float x1() const { return _vtx1.x(); }
+        float y1() const { return _vtx1.y(); }
+        float z1() const { return _vtx1.z(); }
 
-    private:
+    private:    // Member variables.
 
-        GLuint _v[2];   //!< Indices.
+        _Vtx _vtx0;
+        _Vtx _vtx1;
     };
 
-private:    // _Quad.
+private:    // _TileSet.
+
+    //! Open-addressing hash set of tile coordinates. Read-only once built,
+    //! so it may be queried concurrently.
 
-    class _Quad
+    class _TileSet
     {
     public:
 
         //! CTOR.
         explicit
-        _Quad(const GLuint v0,const GLuint v1,const GLuint v2,const GLuint v3)
+        _TileSet(const std::vector<_Cube> &cubes)
+            : _mask(0)
         {
-            _v[0] = v0;
-            _v[1] = v1;
-            _v[2] = v2;
-            _v[3] = v3;
+            std::size_t slotCount(16);
+            while (slotCount < 2*cubes.size()) {
+                slotCount <<= 1;
+            }
+            _slots.assign(slotCount, _emptyKey());
+            _mask = slotCount - 1;
+
+            std::vector<_Cube>::const_iterator iter(cubes.begin());
+            const std::vector<_Cube>::const_iterator iend(cubes.end());
+            for (; iter != iend; ++iter) {
+                _insert(_key(iter->i0(), iter->j0(), iter->k0()));
+            }
         }
 
-        //! Copy CTOR.
-        _Quad(const _Quad &rhs)
+        bool
+        contains(const int i, const int j, const int k) const
         {
-            _v[0] = rhs._v[0];
-            _v[1] = rhs._v[1];
-            _v[2] = rhs._v[2];
-            _v[3] = rhs._v[3];
+            const quint64 key(_key(i, j, k));
+            std::size_t slot(_hash(key));
+            while (_emptyKey() != _slots[slot]) {
+                if (key == _slots[slot]) {
+                    return true;
+                }
+                slot = (slot + 1) & _mask;
+            }
+            return false;
         }
 
-        //! Assign.
-        _Quad&
-        operator=(const _Quad &rhs)
+    private:
+
+        void
+        _insert(const quint64 key)
         {
-            _v[0] = rhs._v[0];
-            _v[1] = rhs._v[1];
-            _v[2] = rhs._v[2];
-            _v[3] = rhs._v[3];
-            return *this;
+            std::size_t slot(_hash(key));
+            while (_emptyKey() != _slots[slot]) {
+                if (key == _slots[slot]) {
+                    return; // Already present.
+                }
+                slot = (slot + 1) & _mask;
+            }
+            _slots[slot] = key;
         }
 
-        bool
-        operator<(const _Quad &rhs) const
+        std::size_t
+        _hash(const quint64 key) const
+        { return static_cast<std::size_t>(
+                (key*Q_UINT64_C(0x9E3779B97F4A7C15)) >> 32) & _mask; }
+
+        //! Pack tile coordinates into 21 bits each, leaving the top bit
+        //! free for the empty marker.
+        static quint64
+        _key(const int i, const int j, const int k)
         {
-            GLuint sv0[] = {     _v[0],     _v[1],     _v[2],     _v[3] };
-            GLuint sv1[] = { rhs._v[0], rhs._v[1], rhs._v[2], rhs._v[3] };
-            std::sort(sv0, sv0 + 4);
-            std::sort(sv1, sv1 + 4);
-            const bool v0_eq(sv0[0] == sv1[0]);
-            const bool v1_eq(sv0[1] == sv1[1]);
-            return (sv0[0] < sv1[0]) ||
-                   (v0_eq && (sv0[1] < sv1[1])) ||
-                   (v0_eq && v1_eq && (sv0[2] <  sv1[2])) ||
-                   (v0_eq && v1_eq && (sv0[2] == sv1[2]) && (sv0[3]<sv1[3]));
+            static const int bias(1 << 20);
+            return (quint64((i + bias) & 0x1FFFFF) << 42) |
+                   (quint64((j + bias) & 0x1FFFFF) << 21) |
+                    quint64((k + bias) & 0x1FFFFF);
         }
 
-        //! No bounds checking!
-        const GLuint&
-        operator[](const int i) const
-        { return _v[i]; }
-
-        //! No bounds checking!
-        GLuint&
-        operator[](const int i)
-        { return _v[i]; }
+        static quint64
+        _emptyKey()
+        { return ~Q_UINT64_C(0); }
 
     private:    // Member variables.
 
-        GLuint _v[4];   //!< Indices.
+        std::vector<quint64> _slots;
+        std::size_t          _mask;
     };
 
-private:    // _Cube.
-
-    class _Cube
-    {
-    public:
-
-        //! CTOR.
-        explicit
-        _Cube(const _Vtx &vtx0, const _Vtx &vtx1)
-            : _vtx0(vtx0)
-            , _vtx1(vtx1)
-        {}
+private:    // _Boundary.
 
-        int i0() const { return _vtx0.i(); }
-        int j0() const { return _vtx0.j(); }
-        int k0() const { return _vtx0.k(); }
-        int i1() const { return _vtx1.i(); }
-        int j1() const { return _vtx1.j(); }
-        int k1() const { return _vtx1.k(); }
+    //! Per-tile instance data for the boundary of a set of tiles. Only tiles
+    //! with at least one face or edge to draw get an instance.
 
-        float x0() const { return _vtx0.x(); }
-        float y0() const { return _vtx0.y(); }
-        float z0() const { return _vtx0.z(); }
-        float x1() const { return _vtx1.x(); }
-        float y1() const { return _vtx1.y(); }
-        float z1() const { return _vtx1.z(); }
+    struct _Boundary
+    {
+        std::vector<GLfloat> tiles;             //!< (ti,tj,tk,level).
+        std::vector<GLfloat> surfaceMask;       //!< Exposed faces.
+        std::vector<GLfloat> surfaceLineMask;   //!< Edges on the surface.
+        std::vector<GLfloat> internalLineMask;  //!< Edges shared by 4 tiles.
+    };
 
-    private:    // Member variables.
+    //! Names of the instance buffers making up one tile level.
 
-        _Vtx _vtx0;
-        _Vtx _vtx1;
+    struct _BoundaryVboNames
+    {
+        NtString tiles;
+        NtString surfaceMask;
+        NtString surfaceLineMask;
+        NtString internalLineMask;
     };
 
 private:
 
-    typedef std::map<_Vec3i, GLuint> _TsxMapType;
-    typedef std::vector<_Vec3f>      _WsxVecType;
-    typedef std::map<_Line, int>     _LineMapType;
-    typedef std::map<_Quad, int>     _QuadMapType;
-
-
     void
     _drawTiles(const NtString        &clientName,
                const Nb::TimeBundle  &cvftb,
@@ -424,33 +411,25 @@ private:
                      const Ns3DCameraScope &cam,
                      Ns3DResourceObject    &robject)
     {
+        static const _BoundaryVboNames vboNames = {
+            "Tile/coarse-tiles",
+            "Tile/coarse-surface-mask",
+            "Tile/coarse-surface-line-mask",
+            "Tile/coarse-internal-line-mask"
+        };
+
+        if (0 == robject.queryConstVertexBuffer("SHARED", vboNames.tiles)) {
+            std::vector<_Cube> cubes;
+            _extractCoarseCubes(layout, cubes);
+            _createBoundaryVertexBuffers(cubes, 1, vboNames, robject);
+        }
+
+        const Ngl::VertexBuffer &tileVbo(
+            *robject.queryConstVertexBuffer("SHARED", vboNames.tiles));
+
         // Surface.
 
         if ("On" == param1e("Coarse Surface")->eval(cvftb)) {
-            static const NtString posVboName("Tile/coarse-surface");
-            const Ngl::VertexBuffer* posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractCoarseCubes(layout, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> surfaceVtx;
-                _surfaceVertices(quadMap,wsxVec, surfaceVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*surfaceVtx.size(),
-                        &surfaceVtx[0]);
-            }
-
             const Nb::Value3f *ambientParam(
                 param3f(("Coarse Ambient Color")));
             const Ngl::vec4f matAmbient(
@@ -483,7 +462,10 @@ private:
                 cullFace = GL_FRONT;
             }
 
-            _drawSurface(*posVbo,
+            _drawSurface(tileVbo,
+                         *robject.queryConstVertexBuffer(
+                             "SHARED", vboNames.surfaceMask),
+                         _cornerVertexBuffer(robject, false),
                          cam.modelviewMat(),
                          cam.projectionMat(),
                          matAmbient,
@@ -498,30 +480,6 @@ private:
         // Surface lines.
 
         if ("On" == param1e("Coarse Surface Lines")->eval(cvftb)) {
-            static const NtString posVboName("Tile/coarse-surface-lines");
-            const Ngl::VertexBuffer* posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractCoarseCubes(layout, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> surfaceLineVtx;
-                _surfaceLineVertices(lineMap, wsxVec, surfaceLineVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*surfaceLineVtx.size(),
-                        &surfaceLineVtx[0]);
-            }
-
             const Nb::Value3f *lineColorParam(
                 param3f("Coarse Surface Line Color"));
 
@@ -531,42 +489,21 @@ private:
                 lineColorParam->eval(cvftb, 2),
                 param1f("Coarse Surface Line Alpha")->eval(cvftb));
 
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       true);
+            _drawBoxLines(tileVbo,
+                          *robject.queryConstVertexBuffer(
+                              "SHARED", vboNames.surfaceLineMask),
+                          _cornerVertexBuffer(robject, true),
+                          param1f("Pixel Radius")->eval(cvftb),
+                          cam.modelviewMat(),
+                          cam.projectionMat(),
+                          lineColor,
+                          cvftb,
+                          true);
         }
 
         // Internal lines.
 
         if ("On" == param1e("Coarse Internal Lines")->eval(cvftb)) {
-            static const NtString posVboName("Tile/coarse-internal-lines");
-            const Ngl::VertexBuffer* posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractCoarseCubes(layout, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> internalLineVtx;
-                _internalLineVertices(lineMap, wsxVec, internalLineVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*internalLineVtx.size(),
-                        &internalLineVtx[0]);
-            }
-
             const Nb::Value3f *lineColorParam(
                 param3f("Coarse Internal Line Color"));
 
@@ -576,13 +513,16 @@ private:
                 lineColorParam->eval(cvftb, 2),
                 param1f("Coarse Internal Line Alpha")->eval(cvftb));
 
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       true);
+            _drawBoxLines(tileVbo,
+                          *robject.queryConstVertexBuffer(
+                              "SHARED", vboNames.internalLineMask),
+                          _cornerVertexBuffer(robject, true),
+                          param1f("Pixel Radius")->eval(cvftb),
+                          cam.modelviewMat(),
+                          cam.projectionMat(),
+                          lineColor,
+                          cvftb,
+                          true);
         }
     }
 
@@ -593,6 +533,13 @@ private:
                    const Ns3DCameraScope &cam,
                    Ns3DResourceObject    &robject)
     {
+        static const _BoundaryVboNames vboNames = {
+            "Tile/fine-tiles",
+            "Tile/fine-surface-mask",
+            "Tile/fine-surface-line-mask",
+            "Tile/fine-internal-line-mask"
+        };
+
         const int ftStart(param1i("Fine Tile Range Start")->eval(cvftb));
         const int ftEnd(param1i("Fine Tile Range End")->eval(cvftb));
 
@@ -602,45 +549,29 @@ private:
         const int tile0(ftAll ? 0 : qMax(0, ftStart));
         const int tile1(ftAll ? ftCount : qMin(ftCount, ftEnd + 1));
 
-        // Surface.
+        // Rebuild the instance buffers if the range changed. Exposed faces
+        // and edges depend on which tiles are in the range.
 
-        if ("On" == param1e("Fine Surface")->eval(cvftb)) {
-            static const NtString posVboName("Tile/fine-surface");
-            Ngl::VertexBuffer* posVbo(
-                robject.queryMutableVertexBuffer("SHARED", posVboName));
+        const Ngl::VertexBuffer* tileVbo(
+            robject.queryConstVertexBuffer("SHARED", vboNames.tiles));
 
-            // Rebuild tile VBO's if range changed.
+        if (0 == tileVbo ||
+            tile0 != tileVbo->metaData1i("tile0") ||
+            tile1 != tileVbo->metaData1i("tile1")) {
+            std::vector<_Cube> cubes;
+            _extractFineCubes(layout, tile0, tile1, cubes);
+            _createBoundaryVertexBuffers(cubes, 0, vboNames, robject);
 
-            if (0 != posVbo) {
-                if (tile0 != posVbo->metaData1i("tile0") ||
-                    tile1 != posVbo->metaData1i("tile1")) {
-                    robject.destroyVertexBuffer("SHARED", posVboName);
-                    posVbo = 0; // Rebuild below.
-                }
-            }
+            Ngl::VertexBuffer* mutableTileVbo(
+                robject.queryMutableVertexBuffer("SHARED", vboNames.tiles));
+            mutableTileVbo->attachMetaData1i("tile0", tile0);
+            mutableTileVbo->attachMetaData1i("tile1", tile1);
+            tileVbo = mutableTileVbo;
+        }
 
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractFineCubes(layout, tile0, tile1, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> surfaceVtx;
-                _surfaceVertices(quadMap, wsxVec, surfaceVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*surfaceVtx.size(),
-                        &surfaceVtx[0]);
-                posVbo->attachMetaData1i("tile0", tile0);
-                posVbo->attachMetaData1i("tile1", tile1);
-            }
+        // Surface.
 
+        if ("On" == param1e("Fine Surface")->eval(cvftb)) {
             const Nb::Value3f *ambientParam(
                 param3f(("Fine Ambient Color")));
             const Ngl::vec4f matAmbient(
@@ -673,7 +604,10 @@ private:
                 cullFace = GL_FRONT;
             }
 
-            _drawSurface(*posVbo,
+            _drawSurface(*tileVbo,
+                         *robject.queryConstVertexBuffer(
+                             "SHARED", vboNames.surfaceMask),
+                         _cornerVertexBuffer(robject, false),
                          cam.modelviewMat(),
                          cam.projectionMat(),
                          matAmbient,
@@ -688,40 +622,6 @@ private:
         // Surface lines.
 
         if ("On" == param1e("Fine Surface Lines")->eval(cvftb)) {
-            static const NtString posVboName("Tile/fine-surface-lines");
-            Ngl::VertexBuffer* posVbo(
-                robject.queryMutableVertexBuffer("SHARED", posVboName));
-
-            if (0 != posVbo) {
-                if (tile0 != posVbo->metaData1i("tile0") ||
-                    tile1 != posVbo->metaData1i("tile1")) {
-                    robject.destroyVertexBuffer("SHARED", posVboName);
-                    posVbo = 0; // Rebuild below.
-                }
-            }
-
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractFineCubes(layout, tile0, tile1, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> surfaceLineVtx;
-                _surfaceLineVertices(lineMap, wsxVec, surfaceLineVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*surfaceLineVtx.size(),
-                        &surfaceLineVtx[0]);
-                posVbo->attachMetaData1i("tile0", tile0);
-                posVbo->attachMetaData1i("tile1", tile1);
-            }
-
             const Nb::Value3f *lineColorParam(
                 param3f("Fine Surface Line Color"));
 
@@ -731,52 +631,21 @@ private:
                 lineColorParam->eval(cvftb, 2),
                 param1f("Fine Surface Line Alpha")->eval(cvftb));
 
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       "On" == param1e("Fine Blend")->eval(cvftb));
+            _drawBoxLines(*tileVbo,
+                          *robject.queryConstVertexBuffer(
+                              "SHARED", vboNames.surfaceLineMask),
+                          _cornerVertexBuffer(robject, true),
+                          param1f("Pixel Radius")->eval(cvftb),
+                          cam.modelviewMat(),
+                          cam.projectionMat(),
+                          lineColor,
+                          cvftb,
+                          "On" == param1e("Fine Blend")->eval(cvftb));
         }
 
         // Internal lines.
 
         if ("On" == param1e("Fine Internal Lines")->eval(cvftb)) {
-            static const NtString posVboName("Tile/fine-internal-lines");
-            Ngl::VertexBuffer* posVbo(
-                robject.queryMutableVertexBuffer("SHARED", posVboName));
-
-            if (0 != posVbo) {
-                if (tile0 != posVbo->metaData1i("tile0") ||
-                    tile1 != posVbo->metaData1i("tile1")) {
-                    robject.destroyVertexBuffer("SHARED", posVboName);
-                    posVbo = 0; // Rebuild below.
-                }
-            }
-
-            if (0 == posVbo) {
-                std::vector<_Cube> cubes;
-                _extractFineCubes(layout, tile0, tile1, cubes);
-
-                _WsxVecType  wsxVec;
-                _LineMapType lineMap;
-                _QuadMapType quadMap;
-                _addCubes(cubes, wsxVec, lineMap, quadMap);
-
-                std::vector<_Vec3f> internalLineVtx;
-                _internalLineVertices(lineMap, wsxVec, internalLineVtx);
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(_Vec3f)*internalLineVtx.size(),
-                        &internalLineVtx[0]);
-                posVbo->attachMetaData1i("tile0", tile0);
-                posVbo->attachMetaData1i("tile1", tile1);
-            }
-
             const Nb::Value3f *lineColorParam(
                 param3f("Fine Internal Line Color"));
 
@@ -786,13 +655,16 @@ private:
                 lineColorParam->eval(cvftb, 2),
                 param1f("Fine Internal Line Alpha")->eval(cvftb));
 
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       "On" == param1e("Fine Blend")->eval(cvftb));
+            _drawBoxLines(*tileVbo,
+                          *robject.queryConstVertexBuffer(
+                              "SHARED", vboNames.internalLineMask),
+                          _cornerVertexBuffer(robject, true),
+                          param1f("Pixel Radius")->eval(cvftb),
+                          cam.modelviewMat(),
+                          cam.projectionMat(),
+                          lineColor,
+                          cvftb,
+                          "On" == param1e("Fine Blend")->eval(cvftb));
         }
     }
 
@@ -824,118 +696,74 @@ private:
         const Nb::Value1e *cellPlaneParam(param1e("Cell Plane"));
         const NtString planeStr(cellPlaneParam->eval(cvftb));
 
-        if ("XY" == planeStr) {
-            static const NtString posVboName("Tile/cell-xy");
-            const Ngl::VertexBuffer *posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Vec3f> p;
-                p.reserve(2*cellCount[1] + 2*cellCount[0]);
-                for (int c(0); c <= cellCount[1]; ++c) {
-                    // "horizontal"
-                    p.push_back(_Vec3f(tmin[0],tmin[1]+c*cellSize,tmin[2]));
-                    p.push_back(_Vec3f(tmax[0],tmin[1]+c*cellSize,tmin[2]));
-                }
-
-                for(int c(0); c <= cellCount[0]; ++c) {
-                    // "vertical"
-                    p.push_back(_Vec3f(tmin[0]+c*cellSize,tmin[1],tmin[2]));
-                    p.push_back(_Vec3f(tmin[0]+c*cellSize,tmax[1],tmin[2]));
-                }
+        // The grid lines are generated in the vertex shader, one instance
+        // per line. The first lines run along axis0, the rest along axis1.
 
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(em::vec<3,GLfloat>)*p.size(),
-                        &p[0]);
-            }
-
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       false);
-        }
-        else if ("XZ" == planeStr) {
-            static const NtString posVboName("Tile/cell-xz");
-            const Ngl::VertexBuffer *posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Vec3f> p;
-                p.reserve(2*cellCount[2] + 2*cellCount[0]);
-                for(int c(0); c <= cellCount[2]; ++c) {
-                    // "horizontal"
-                    p.push_back(_Vec3f(tmin[0],tmin[1],tmin[2]+c*cellSize));
-                    p.push_back(_Vec3f(tmax[0],tmin[1],tmin[2]+c*cellSize));
-                }
-
-                for(int c(0); c <= cellCount[0]; ++c) {
-                    // "vertical"
-                    p.push_back(_Vec3f(tmin[0]+c*cellSize,tmin[1],tmin[2]));
-                    p.push_back(_Vec3f(tmin[0]+c*cellSize,tmin[1],tmax[2]));
-                }
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(em::vec<3,GLfloat>)*p.size(),
-                        &p[0]);
-            }
-
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       false);
+        int axis0(0);
+        int axis1(1);
+        if ("XZ" == planeStr) {
+            axis1 = 2;
         }
         else if ("YZ" == planeStr) {
-            static const NtString posVboName("Tile/cell-yz");
-            const Ngl::VertexBuffer *posVbo(
-                robject.queryConstVertexBuffer("SHARED", posVboName));
-
-            if (0 == posVbo) {
-                std::vector<_Vec3f> p;
-                p.reserve(2*cellCount[2] + 2*cellCount[1]);
-                for(int c(0); c <= cellCount[2]; ++c) {
-                    // "horizontal"
-                    p.push_back(_Vec3f(tmin[0],tmin[1],tmin[2]+c*cellSize));
-                    p.push_back(_Vec3f(tmin[0],tmax[1],tmin[2]+c*cellSize));
-                }
-
-                for(int c(0); c <= cellCount[1]; ++c) {
-                    // "vertical"
-                    p.push_back(_Vec3f(tmin[0],tmin[1]+c*cellSize,tmin[2]));
-                    p.push_back(_Vec3f(tmin[0],tmin[1]+c*cellSize,tmax[2]));
-                }
-
-                posVbo =
-                    robject.createVertexBuffer(
-                        "SHARED",
-                        posVboName,
-                        sizeof(em::vec<3,GLfloat>)*p.size(),
-                        &p[0]);
-            }
+            axis0 = 1;
+            axis1 = 2;
+        }
+        else if (!("XY" == planeStr)) {
+            return; // Unknown plane.
+        }
 
-            _drawLines(*posVbo,
-                       param1f("Pixel Radius")->eval(cvftb),
-                       cam.modelviewMat(),
-                       cam.projectionMat(),
-                       lineColor,
-                       cvftb,
-                       false);
+        static const NtString endpointVboName("Tile/grid-endpoints");
+        const Ngl::VertexBuffer *endpointVbo(
+            robject.queryConstVertexBuffer("SHARED", endpointVboName));
+
+        if (0 == endpointVbo) {
+            const GLfloat endpoints[] = { 0.f, 1.f };
+            endpointVbo =
+                robject.createVertexBuffer(
+                    "SHARED",
+                    endpointVboName,
+                    sizeof(endpoints),
+                    endpoints);
         }
+
+        const Ngl::ShaderAttrib* endpointAttrib(
+            _gridShader->queryConstAttrib("endpoint"));
+
+        EM_ASSERT(0 != endpointAttrib);
+
+        const GLsizei vtxCount(
+            Ngl::VertexAttrib::connect(*endpointAttrib, *endpointVbo));
+
+        const em::glmat44f &modelview(cam.modelviewMat());
+        const em::glmat44f &projection(cam.projectionMat());
+
+        _gridShader->use();
+        _gridShader->storeUniform4m("projection", &projection[0][0]);
+        _gridShader->storeUniform4m("modelview",  &modelview[0][0]);
+        _gridShader->storeUniform4f("lineColor",  &lineColor[0]);
+        _gridShader->storeUniform3f("gridMin",    &tmin[0]);
+        _gridShader->storeUniform3f("gridMax",    &tmax[0]);
+        _gridShader->storeUniform1f("cellSize",   cellSize);
+        _gridShader->storeUniform1i("axis0",      axis0);
+        _gridShader->storeUniform1i("axis1",      axis1);
+        _gridShader->storeUniform1i("lineCount0", cellCount[axis1] + 1);
+        _gridShader->uploadUniforms(cvftb);
+
+        glLineWidth(param1f("Pixel Radius")->eval(cvftb));
+        glDrawArraysInstanced(
+            GL_LINES,
+            0,
+            vtxCount,
+            (cellCount[axis1] + 1) + (cellCount[axis0] + 1));
+
+        _gridShader->unuse();
+        Ngl::VertexAttrib::disconnect(*endpointAttrib);
     }
 
     void
-    _drawSurface(const Ngl::VertexBuffer &posVbo,
+    _drawSurface(const Ngl::VertexBuffer &tileVbo,
+                 const Ngl::VertexBuffer &maskVbo,
+                 const Ngl::VertexBuffer &cornerVbo,
                  const em::glmat44f      &modelview,
                  const em::glmat44f      &projection,
                  const Ngl::vec4f        &matAmbient,
@@ -946,12 +774,7 @@ private:
                  const bool               culling,
                  const GLenum             cullFace)
     {
-        const Ngl::ShaderAttrib* posAttrib(
-            _surfaceShader->queryConstAttrib("position"));
-
-        EM_ASSERT(0 != posAttrib);
-
-        const GLsizei minCount(Ngl::VertexAttrib::connect(*posAttrib, posVbo));
+        _BoxAttribs attribs(*_surfaceShader, tileVbo, maskVbo, cornerVbo);
 
         _surfaceShader->use();
         _surfaceShader->storeUniform4m("projection",   &projection[0][0]);
@@ -961,6 +784,8 @@ private:
         _surfaceShader->storeUniform4f("matDiffuse",  &matDiffuse[0]);
         _surfaceShader->storeUniform4f("matSpecular", &matSpecular[0]);
 
+        _storeTileFrame(*_surfaceShader, tileVbo);
+
         _surfaceShader->uploadUniforms(cvftb);
 
         Ngl::FlipState<GL_BLEND>      blendState;
@@ -978,31 +803,28 @@ private:
             glDepthMask(GL_FALSE);
         }
 
-        glDrawArrays(GL_QUADS, 0, minCount);
+        glDrawArraysInstanced(
+            GL_QUADS, 0, attribs.vtxCount, attribs.instanceCount);
 
         if (blend) {
             glDepthMask(GL_TRUE);
         }
 
         _surfaceShader->unuse();
-        Ngl::VertexAttrib::disconnect(*posAttrib);
     }
 
     void
-    _drawLines(const Ngl::VertexBuffer &posVbo,
-               const GLfloat            lineWidth,
-               const em::glmat44f      &modelview,
-               const em::glmat44f      &projection,
-               const Ngl::vec4f        &lineColor,
-               const NtTimeBundle      &cvftb,
-               const bool               blend)
+    _drawBoxLines(const Ngl::VertexBuffer &tileVbo,
+                  const Ngl::VertexBuffer &maskVbo,
+                  const Ngl::VertexBuffer &cornerVbo,
+                  const GLfloat            lineWidth,
+                  const em::glmat44f      &modelview,
+                  const em::glmat44f      &projection,
+                  const Ngl::vec4f        &lineColor,
+                  const NtTimeBundle      &cvftb,
+                  const bool               blend)
     {
-        const Ngl::ShaderAttrib* posAttrib(
-            _lineShader->queryConstAttrib("position"));
-
-        EM_ASSERT(0 != posAttrib);
-
-        const GLsizei minCount(Ngl::VertexAttrib::connect(*posAttrib, posVbo));
+        _BoxAttribs attribs(*_lineShader, tileVbo, maskVbo, cornerVbo);
 
         _lineShader->use();
         _lineShader->storeUniform4m("projection", &projection[0][0]);
@@ -1010,6 +832,8 @@ private:
 
         _lineShader->storeUniform4f("lineColor",  &lineColor[0]);
 
+        _storeTileFrame(*_lineShader, tileVbo);
+
         _lineShader->uploadUniforms(cvftb);
 
         Ngl::FlipState<GL_BLEND>      blendState;
@@ -1022,185 +846,383 @@ private:
         }
 
         glLineWidth(lineWidth);
-        glDrawArrays(GL_LINES, 0, minCount);
+        glDrawArraysInstanced(
+            GL_LINES, 0, attribs.vtxCount, attribs.instanceCount);
 
         if (blend) {
             glDepthMask(GL_TRUE);
         }
 
         _lineShader->unuse();
-        Ngl::VertexAttrib::disconnect(*posAttrib);
     }
 
-    void
-    _addCubes(const std::vector<_Cube> &cubes,
-              _WsxVecType              &wsxVec,
-              _LineMapType             &lineMap,
-              _QuadMapType             &quadMap)
+private:    // _BoxAttribs.
+
+    //! Connects the unit cube corners per vertex and the tile and mask
+    //! buffers per instance for the lifetime of the object.
+
+    class _BoxAttribs
     {
-        _TsxMapType  tsxMap;
+    public:
 
-        std::vector<_Cube>::const_iterator cubeIter(cubes.begin());
-        for (; cubeIter != cubes.end(); ++cubeIter) {
-            _addCube(*cubeIter, tsxMap, wsxVec, lineMap, quadMap);
+        //! CTOR.
+        explicit
+        _BoxAttribs(const Ngl::ShaderProgram &shader,
+                    const Ngl::VertexBuffer  &tileVbo,
+                    const Ngl::VertexBuffer  &maskVbo,
+                    const Ngl::VertexBuffer  &cornerVbo)
+            : _cornerAttrib(shader.queryConstAttrib("corner"))
+            , _tileAttrib(shader.queryConstAttrib("tile"))
+            , _maskAttrib(shader.queryConstAttrib("mask"))
+        {
+            EM_ASSERT(0 != _cornerAttrib);
+            EM_ASSERT(0 != _tileAttrib);
+            EM_ASSERT(0 != _maskAttrib);
+
+            vtxCount =
+                Ngl::VertexAttrib::connect(*_cornerAttrib, cornerVbo);
+            instanceCount =
+                Ngl::VertexAttrib::connect(
+                    *_tileAttrib, tileVbo, GL_FALSE, 0, 1);
+            Ngl::VertexAttrib::connect(*_maskAttrib, maskVbo, GL_FALSE, 0, 1);
+        }
+
+        //! DTOR.
+        ~_BoxAttribs()
+        {
+            Ngl::VertexAttrib::disconnect(*_maskAttrib);
+            Ngl::VertexAttrib::disconnect(*_tileAttrib);
+            Ngl::VertexAttrib::disconnect(*_cornerAttrib);
         }
+
+    public:     // Member variables.
+
+        GLsizei vtxCount;
+        GLsizei instanceCount;
+
+    private:
+
+        const Ngl::ShaderAttrib *_cornerAttrib;
+        const Ngl::ShaderAttrib *_tileAttrib;
+        const Ngl::ShaderAttrib *_maskAttrib;
+    };
+
+private:    // Tables.
+
+    typedef int _CornerRow[3];
+    typedef int _FaceRow[7];
+    typedef int _EdgeRow[5];
+
+    //! Unit cube corners, in tile space.
+    static const _CornerRow*
+    _corners()
+    {
+        static const _CornerRow corners[8] = {
+            { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 },
+            { 0, 1, 0 }, { 1, 1, 0 }, { 1, 1, 1 }, { 0, 1, 1 }
+        };
+        return corners;
     }
 
-    void
-    _addCube(const _Cube  &c,
-             _TsxMapType  &tsxMap,
-             _WsxVecType  &wsxVec,
-             _LineMapType &lineMap,
-             _QuadMapType &quadMap)
+    //! Faces: neighbour offset and corners.
+    static const _FaceRow*
+    _faces()
+    {
+        static const _FaceRow faces[6] = {
+            {  1,  0,  0,   1, 5, 6, 2 },  // X+
+            { -1,  0,  0,   7, 4, 0, 3 },  // X-
+            {  0,  1,  0,   7, 6, 5, 4 },  // Y+
+            {  0, -1,  0,   3, 0, 1, 2 },  // Y-
+            {  0,  0,  1,   2, 6, 7, 3 },  // Z+
+            {  0,  0, -1,   4, 5, 1, 0 }   // Z-
+        };
+        return faces;
+    }
+
+    //! Edges: axis, corners and offset of the edge along the two remaining
+    //! axes (in increasing axis order).
+    static const _EdgeRow*
+    _edges()
     {
-        const GLuint v[] = {
-            _addVtx(
-                _Vtx(_Vec3i(c.i0(),c.j0(),c.k0()),
-                     _Vec3f(c.x0(),c.y0(),c.z0())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i1(),c.j0(),c.k0()),
-                     _Vec3f(c.x1(),c.y0(),c.z0())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i1(),c.j0(),c.k1()),
-                     _Vec3f(c.x1(),c.y0(),c.z1())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i0(),c.j0(),c.k1()),
-                     _Vec3f(c.x0(),c.y0(),c.z1())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i0(),c.j1(),c.k0()),
-                     _Vec3f(c.x0(),c.y1(),c.z0())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i1(),c.j1(),c.k0()),
-                     _Vec3f(c.x1(),c.y1(),c.z0())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i1(),c.j1(),c.k1()),
-                     _Vec3f(c.x1(),c.y1(),c.z1())), tsxMap, wsxVec),
-            _addVtx(
-                _Vtx(_Vec3i(c.i0(),c.j1(),c.k1()),
-                     _Vec3f(c.x0(),c.y1(),c.z1())), tsxMap, wsxVec)};
-
-        _addLine(_Line(v[0], v[1]), lineMap);
-        _addLine(_Line(v[1], v[2]), lineMap);
-        _addLine(_Line(v[2], v[3]), lineMap);
-        _addLine(_Line(v[3], v[0]), lineMap);
-        _addLine(_Line(v[4], v[5]), lineMap);
-        _addLine(_Line(v[5], v[6]), lineMap);
-        _addLine(_Line(v[6], v[7]), lineMap);
-        _addLine(_Line(v[7], v[4]), lineMap);
-        _addLine(_Line(v[0], v[4]), lineMap);
-        _addLine(_Line(v[1], v[5]), lineMap);
-        _addLine(_Line(v[2], v[6]), lineMap);
-        _addLine(_Line(v[3], v[7]), lineMap);
-
-        _addQuad(_Quad(v[1], v[5], v[6], v[2]), quadMap); // X+
-        _addQuad(_Quad(v[7], v[4], v[0], v[3]), quadMap); // X-
-        _addQuad(_Quad(v[7], v[6], v[5], v[4]), quadMap); // Y+
-        _addQuad(_Quad(v[3], v[0], v[1], v[2]), quadMap); // Y-
-        _addQuad(_Quad(v[2], v[6], v[7], v[3]), quadMap); // Z+
-        _addQuad(_Quad(v[4], v[5], v[1], v[0]), quadMap); // Z-
+        static const _EdgeRow edges[12] = {
+            { 0,   0, 1,   0, 0 },
+            { 0,   3, 2,   0, 1 },
+            { 0,   4, 5,   1, 0 },
+            { 0,   7, 6,   1, 1 },
+            { 1,   0, 4,   0, 0 },
+            { 1,   3, 7,   0, 1 },
+            { 1,   1, 5,   1, 0 },
+            { 1,   2, 6,   1, 1 },
+            { 2,   0, 3,   0, 0 },
+            { 2,   4, 7,   0, 1 },
+            { 2,   1, 2,   1, 0 },
+            { 2,   5, 6,   1, 1 }
+        };
+        return edges;
     }
 
-    //! Add the vertex to the data-structures.
-    const GLuint
-    _addVtx(const _Vtx  &vtx, _TsxMapType &tsxMap, _WsxVecType &wsxVec)
+private:
+
+    //! Shared per-vertex geometry of the instanced tile boxes: unit cube
+    //! corners with the face (or edge) index they belong to.
+    static const Ngl::VertexBuffer&
+    _cornerVertexBuffer(Ns3DResourceObject &robject, const bool lines)
     {
-        const _TsxMapType::const_iterator tsxIter(
-            tsxMap.find(vtx.tsx()));
+        static const NtString quadVboName("Tile/box-face-corners");
+        static const NtString lineVboName("Tile/box-edge-corners");
+        const NtString &vboName(lines ? lineVboName : quadVboName);
+
+        const Ngl::VertexBuffer* cornerVbo(
+            robject.queryConstVertexBuffer("SHARED", vboName));
+
+        if (0 == cornerVbo) {
+            std::vector<GLfloat> corners;
+            if (lines) {
+                for (int e(0); e < 12; ++e) {
+                    for (int v(1); v <= 2; ++v) {
+                        _pushCorner(_edges()[e][v], e, corners);
+                    }
+                }
+            }
+            else {
+                for (int f(0); f < 6; ++f) {
+                    for (int v(3); v < 7; ++v) {
+                        _pushCorner(_faces()[f][v], f, corners);
+                    }
+                }
+            }
 
-        if (tsxIter != tsxMap.end()) {
-            return tsxIter->second; // Vertex exists in map, return index.
+            cornerVbo =
+                robject.createVertexBuffer(
+                    "SHARED",
+                    vboName,
+                    sizeof(GLfloat)*corners.size(),
+                    &corners[0]);
         }
-        else {
-            // Vertex not found in map, add it.
 
-            wsxVec.push_back(vtx.wsx());
-            const GLuint tsxMapSize(static_cast<GLuint>(tsxMap.size()));
-            tsxMap.insert(_TsxMapType::value_type(vtx.tsx(), tsxMapSize));
-            return tsxMapSize;
-        }
+        return *cornerVbo;
     }
 
-    void
-    _addLine(const _Line  &line, _LineMapType &lineMap)
+    static void
+    _pushCorner(const int corner, const int feature, std::vector<GLfloat> &v)
     {
-        const _LineMapType::iterator lineIter(lineMap.find(line));
+        v.push_back(static_cast<GLfloat>(_corners()[corner][0]));
+        v.push_back(static_cast<GLfloat>(_corners()[corner][1]));
+        v.push_back(static_cast<GLfloat>(_corners()[corner][2]));
+        v.push_back(static_cast<GLfloat>(feature));
+    }
 
-        if (lineIter != lineMap.end()) {
-            ++lineIter->second;    // Line exists, increment count.
-        }
-        else {
-            lineMap.insert(_LineMapType::value_type(line, 1)); // Count = 1.
-        }
+    //! Upload the world space placement of the tile grid, attached to the
+    //! tile buffer when it was built.
+    static void
+    _storeTileFrame(Ngl::ShaderProgram      &shader,
+                    const Ngl::VertexBuffer &tileVbo)
+    {
+        const float tileOrigin[] = {
+            tileVbo.metaData1f("originX"),
+            tileVbo.metaData1f("originY"),
+            tileVbo.metaData1f("originZ")
+        };
+        shader.storeUniform3f("tileOrigin", tileOrigin);
+        shader.storeUniform1f(
+            0 == tileVbo.metaData1i("level") ?
+                "fineTileSize" : "coarseTileSize",
+            tileVbo.metaData1f("size"));
     }
 
+    //! (Re-)create the tile and mask instance buffers from a single boundary
+    //! pass over the cubes.
     void
-    _addQuad(const _Quad  &quad, _QuadMapType &quadMap)
+    _createBoundaryVertexBuffers(const std::vector<_Cube>  &cubes,
+                                 const int                  level,
+                                 const _BoundaryVboNames   &vboNames,
+                                 Ns3DResourceObject        &robject)
     {
-        const _QuadMapType::iterator quadIter(quadMap.find(quad));
+        _Boundary boundary;
+        _extractBoundary(cubes, level, boundary);
+
+        const NtString* names[] = {
+            &vboNames.tiles,
+            &vboNames.surfaceMask,
+            &vboNames.surfaceLineMask,
+            &vboNames.internalLineMask
+        };
+        const std::vector<GLfloat>* data[] = {
+            &boundary.tiles,
+            &boundary.surfaceMask,
+            &boundary.surfaceLineMask,
+            &boundary.internalLineMask
+        };
+
+        for (int n(0); n < 4; ++n) {
+            if (0 != robject.queryConstVertexBuffer("SHARED", *names[n])) {
+                robject.destroyVertexBuffer("SHARED", *names[n]);
+            }
 
-        if (quadIter != quadMap.end()) {
-            ++quadIter->second;    // Quad exists, increment count.
+            robject.createVertexBuffer(
+                "SHARED",
+                *names[n],
+                sizeof(GLfloat)*data[n]->size(),
+                data[n]->empty() ? 0 : &(*data[n])[0]);
         }
-        else {
-            quadMap.insert(_QuadMapType::value_type(quad, 1)); // Count = 1.
+
+        // World space placement: tile (i,j,k) starts at origin + (i,j,k)*size.
+
+        float size(0.f);
+        float origin[] = { 0.f, 0.f, 0.f };
+        if (!cubes.empty()) {
+            const _Cube &c(cubes.front());
+            size = c.x1() - c.x0();
+            origin[0] = c.x0() - c.i0()*size;
+            origin[1] = c.y0() - c.j0()*size;
+            origin[2] = c.z0() - c.k0()*size;
         }
+
+        Ngl::VertexBuffer* tileVbo(
+            robject.queryMutableVertexBuffer("SHARED", vboNames.tiles));
+        tileVbo->attachMetaData1i("level", level);
+        tileVbo->attachMetaData1f("size", size);
+        tileVbo->attachMetaData1f("originX", origin[0]);
+        tileVbo->attachMetaData1f("originY", origin[1]);
+        tileVbo->attachMetaData1f("originZ", origin[2]);
     }
 
+    //! Find the exposed faces, surface edges and internal edges of a set of
+    //! unit cubes in tile space. Faces are exposed when the neighbouring
+    //! tile is empty. An edge is shared by up to four tiles and belongs to
+    //! the first occupied tile around it; it is internal when all four
+    //! tiles are occupied.
     void
-    _surfaceVertices(const _QuadMapType  &quadMap,
-                     const _WsxVecType   &wsxVec,
-                     std::vector<_Vec3f> &vtx)
+    _extractBoundary(const std::vector<_Cube> &cubes,
+                     const int                 level,
+                     _Boundary                &boundary)
     {
-        vtx.clear();
-        vtx.reserve(4*quadMap.size());
-
-        _QuadMapType::const_iterator iter(quadMap.begin());
-        const _QuadMapType::const_iterator iend(quadMap.end());
-        for (; iter != iend; ++iter) {
-            if (1 == iter->second) {
-                for (int i(0); i < 4; ++i) {
-                    vtx.push_back(wsxVec[iter->first[i]]);
-                }
+        const _TileSet tiles(cubes);
+        const int cubeCount(static_cast<int>(cubes.size()));
+
+#ifdef _OPENMP
+        const int threadCount(qMax(1, qMin(omp_get_max_threads(), cubeCount)));
+#else
+        const int threadCount(1);
+#endif
+
+        // Per-thread output, concatenated in thread order below. With a
+        // static schedule each thread owns a contiguous range of cubes, so
+        // the result is independent of timing.
+
+        std::vector<_Boundary> parts(threadCount);
+
+        #pragma omp parallel num_threads(threadCount)
+        {
+#ifdef _OPENMP
+            _Boundary &part(parts[omp_get_thread_num()]);
+#else
+            _Boundary &part(parts[0]);
+#endif
+
+            #pragma omp for schedule(static)
+            for (int c = 0; c < cubeCount; ++c) {
+                _addCubeBoundary(cubes[c], level, tiles, part);
             }
         }
+
+        std::size_t instanceCount(0);
+        for (int t(0); t < threadCount; ++t) {
+            instanceCount += parts[t].surfaceMask.size();
+        }
+
+        boundary.tiles.clear();
+        boundary.surfaceMask.clear();
+        boundary.surfaceLineMask.clear();
+        boundary.internalLineMask.clear();
+        boundary.tiles.reserve(4*instanceCount);
+        boundary.surfaceMask.reserve(instanceCount);
+        boundary.surfaceLineMask.reserve(instanceCount);
+        boundary.internalLineMask.reserve(instanceCount);
+
+        for (int t(0); t < threadCount; ++t) {
+            const _Boundary &part(parts[t]);
+            boundary.tiles.insert(
+                boundary.tiles.end(),
+                part.tiles.begin(),
+                part.tiles.end());
+            boundary.surfaceMask.insert(
+                boundary.surfaceMask.end(),
+                part.surfaceMask.begin(),
+                part.surfaceMask.end());
+            boundary.surfaceLineMask.insert(
+                boundary.surfaceLineMask.end(),
+                part.surfaceLineMask.begin(),
+                part.surfaceLineMask.end());
+            boundary.internalLineMask.insert(
+                boundary.internalLineMask.end(),
+                part.internalLineMask.begin(),
+                part.internalLineMask.end());
+        }
     }
 
-    void
-    _surfaceLineVertices(const _LineMapType  &lineMap,
-                         const _WsxVecType   &wsxVec,
-                         std::vector<_Vec3f> &vtx)
+    static void
+    _addCubeBoundary(const _Cube    &c,
+                     const int       level,
+                     const _TileSet &tiles,
+                     _Boundary      &part)
     {
-        vtx.clear();
-        vtx.reserve(4*lineMap.size());
-
-        _LineMapType::const_iterator iter(lineMap.begin());
-        const _LineMapType::const_iterator iend(lineMap.end());
-        for (; iter != iend; ++iter) {
-            if (3 >= iter->second) {
-                for (int i(0); i < 2; ++i) {
-                    vtx.push_back(wsxVec[iter->first[i]]);
-                }
+        const int tsx[] = { c.i0(), c.j0(), c.k0() };
+
+        int faceMask(0);
+        for (int f(0); f < 6; ++f) {
+            if (!tiles.contains(tsx[0] + _faces()[f][0],
+                                tsx[1] + _faces()[f][1],
+                                tsx[2] + _faces()[f][2])) {
+                faceMask |= (1 << f);
             }
         }
-    }
 
-    void
-    _internalLineVertices(const _LineMapType  &lineMap,
-                          const _WsxVecType   &wsxVec,
-                          std::vector<_Vec3f> &vtx)
-    {
-        vtx.clear();
-        vtx.reserve(4*lineMap.size());
-
-        _LineMapType::const_iterator iter(lineMap.begin());
-        const _LineMapType::const_iterator iend(lineMap.end());
-        for (; iter != iend; ++iter) {
-            if (4 <= iter->second) {
-                for (int i(0); i < 2; ++i) {
-                    vtx.push_back(wsxVec[iter->first[i]]);
+        int surfaceLineMask(0);
+        int internalLineMask(0);
+        for (int e(0); e < 12; ++e) {
+            const _EdgeRow &edge(_edges()[e]);
+            const int axis0(0 == edge[0] ? 1 : 0);
+            const int axis1(2 == edge[0] ? 1 : 2);
+            const int self(2*(1 - edge[3]) + (1 - edge[4]));
+
+            int count(0);
+            bool owner(true);
+            for (int s(0); s < 2; ++s) {
+                for (int t(0); t < 2; ++t) {
+                    int n[] = { tsx[0], tsx[1], tsx[2] };
+                    n[axis0] += edge[3] - 1 + s;
+                    n[axis1] += edge[4] - 1 + t;
+                    if (tiles.contains(n[0], n[1], n[2])) {
+                        ++count;
+                        if (2*s + t < self) {
+                            owner = false;
+                        }
+                    }
+                }
+            }
+
+            if (owner) {
+                if (4 == count) {
+                    internalLineMask |= (1 << e);
+                }
+                else {
+                    surfaceLineMask |= (1 << e);
                 }
             }
         }
+
+        if (0 == faceMask && 0 == surfaceLineMask && 0 == internalLineMask) {
+            return; // Nothing to draw for this tile.
+        }
+
+        part.tiles.push_back(static_cast<GLfloat>(tsx[0]));
+        part.tiles.push_back(static_cast<GLfloat>(tsx[1]));
+        part.tiles.push_back(static_cast<GLfloat>(tsx[2]));
+        part.tiles.push_back(static_cast<GLfloat>(level));
+        part.surfaceMask.push_back(static_cast<GLfloat>(faceMask));
+        part.surfaceLineMask.push_back(static_cast<GLfloat>(surfaceLineMask));
+        part.internalLineMask.push_back(static_cast<GLfloat>(internalLineMask));
     }
 
     void
@@ -1253,6 +1275,7 @@ private:    // Member variables.
 
     Ngl::ShaderProgram *_surfaceShader;
     Ngl::ShaderProgram *_lineShader;
+    Ngl::ShaderProgram *_gridShader;
 };
 
 // -----------------------------------------------------------------------------
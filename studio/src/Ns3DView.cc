@@ -60,6 +60,7 @@
 
 #include "Ns3DCameraScope.h"
 #include "Ns3DFieldScope.h"
+#include "Ns3DResourceCache.h"
 
 #include "NsMainWindow.h"
 #include "NsPreferences.h"
@@ -75,6 +76,7 @@
 #include "NsCmdSetCurrentVisibleFrame.h"
 #include "NsCmdSetMeta.h"
 #include "NsGraphCallback.h"
+#include "NsStepProfiler.h"
 #include "NsPlayblastProgressWidget.h"
 
 #include <em_mat44_algo.h>
@@ -84,6 +86,7 @@
 // Ngl
 #include <Ngl.h>
 #include <NglExtensions.h>
+#include <NglProgramCache.h>
 #include <NglState.h>
 
 #include <sstream>
@@ -120,6 +123,8 @@ Ns3DView::Ns3DView(Ns3DScene *scene, QWidget *parent)
     , _drawAxesAction(0)        // Null.
     , _drawItemLabelsAction(0)
     , _drawBodyLabelsAction(0)
+    , _drawTimingsAction(0)
+    , _exportTimingsAction(0)
     , _frameSceneAction(0)      // Null.
     , _playblastAction(0)       // Null.
     , _stepPlayblastAction(0)       // Null.
@@ -129,6 +134,7 @@ Ns3DView::Ns3DView(Ns3DScene *scene, QWidget *parent)
     , _scaleManipAction(0)
     , _nullManipAction(0)
     , _drawSelection(true)
+    , _scopeListRevision(-1)
     , dragging(false)
     , glInitd(false)
 
@@ -139,6 +145,13 @@ Ns3DView::Ns3DView(Ns3DScene *scene, QWidget *parent)
 
     //_scene->setParent(this);         // Own scene.
 
+    // Scopes may draw at reduced quality while the camera moves; give them
+    // a chance to refine once interaction stops.
+
+    _idleTimer.setSingleShot(true);
+    _idleTimer.setInterval(250);
+    connect(&_idleTimer, SIGNAL(timeout()), SLOT(update()));
+
     _createActions();
     _onReadSettings();
 }
@@ -152,6 +165,10 @@ Ns3DView::~Ns3DView()
 {
     _onWriteSettings();
 
+    makeCurrent();
+    _profiler.releaseQueries();
+    Ns3DResourceCache::instance()->clear();
+
     Ngl::End();
 }
 
@@ -613,21 +630,32 @@ Ns3DView::resizeGL(const int w, const int h)
 // paintGL
 // -------
 //! This function is called whenever the widget needs to be painted.
+//!
+//! Painting does not wait for the solver thread. While it is inside an op,
+//! scopes draw their cached resources using the last known parameter values
+//! (see NsQuery) and camera edits are held back until NI is available.
 
 void
 Ns3DView::paintGL()
 {
     QGLWidget::paintGL();   // Parent method.
 
-    
+    const NsStepProfiler::Scope scope(NsStepProfiler::GuiLane,
+                                      "Scope Redraw");
 
     glViewport(_viewport.x(),
                _viewport.y(),
                _viewport.width(),
                _viewport.height());
 
+    _profiler.beginFrame();
+
     Ns3DCameraScope *cam(_activeCameraScope());
 
+    if (0 != cam && !cam->commitParams()) {
+        _idleTimer.start();     // Try again once the solver yields.
+    }
+
     _clear(cam);
 //    glClearColor(0.69f, 0.71f, 0.72f, 1.f);
 //    glClearDepth(1.0);
@@ -657,6 +685,8 @@ Ns3DView::paintGL()
         painter.end();
     }
 
+    _profiler.endFrame();
+
     swapBuffers();
 }
 
@@ -995,7 +1025,10 @@ Ns3DView::_drawScene(Ns3DCameraScope &cam, const bool drawSelection)
     // Draw graphics (Op) items.
 
     QList<Ns3DGraphicsItem::LabelInfo> itemLabels;
-    _drawOpItems(cam, _scene->items(), itemLabels);
+    {
+        const Ns3DProfiler::Section section(_profiler, "Op Items");
+        _drawOpItems(cam, _scene->items(), itemLabels);
+    }
 
 #if 0
     // TMP!!
@@ -1048,6 +1081,7 @@ Ns3DView::_drawScene(Ns3DCameraScope &cam, const bool drawSelection)
         Ngl::ShadeModelState::set(GL_FLAT);
 
         //_selMgr.resizeIdBuffer(_viewport);  // TMP!!
+        const Ns3DProfiler::Section section(_profiler, "Picking");
         _selMgr.drawIdBuffer(_viewport,
                              cam.modelviewMat(),
                              cam.projectionMat(),
@@ -1103,6 +1137,26 @@ Ns3DView::_drawHud(const QString &str,
                          str);
     }
 
+    if (_drawTimingsAction->isChecked()) {
+        // Draw scope timings in the top right corner.
+
+        const QString timings(_profiler.hudText());
+        QFont font("Monospace", 9);
+        font.setStyleHint(QFont::TypeWriter);
+        painter.setPen(QPen(NsPreferences::instance()->scopeViewHudTextColor()));
+        painter.setFont(font);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        const QRect tbounds(
+            painter.boundingRect(painter.window(), Qt::AlignLeft, timings));
+
+        painter.drawText(width() - tbounds.width() - 5,
+                         5,
+                         tbounds.width(),
+                         tbounds.height(),
+                         Qt::AlignLeft,
+                         timings);
+    }
+
     if (_drawItemLabelsAction->isChecked()) {
         // Draw item labels.
 
@@ -1174,27 +1228,31 @@ Ns3DView::_drawActiveScopes(const Ns3DCameraScope &cam,
         _sceneMax[2] = -std::numeric_limits<float>::max();
 
 
-        // let the body scopes draw...
-
         int cvf(1);
         queryCurrentVisibleFrame(&cvf);
 
-        const NtStringList bodyScopes =
-            NiQueryOpNames(NI_INSTANCE, "BODY_SCOPE");
+        _updateScopeLists();
 
-        for(unsigned int i(0); i<bodyScopes.size(); ++i) {
-            Ng::Op* op(NiMutableOp(bodyScopes[i]));
+        // let the body scopes draw...
 
-            Nb::MessageCallback::pushValueObject(op);
+        foreach (Ns3DBodyScope *bs, _bodyScopes) {
+            Nb::MessageCallback::pushValueObject(bs);
 
             // Let the body scopes draw whatever bodies they admit.
 
-            Ns3DBodyScope *bs(dynamic_cast<Ns3DBodyScope*>(op));
-            Ns3DCameraScope *cs(dynamic_cast<Ns3DCameraScope*>(op));
-
-            if (bs && !cs && bs->opState() == Ng::BodyOp::ActiveOpState) {
+            if (bs->opState() == Ng::BodyOp::ActiveOpState) {
                 bs->setContext(context());
-                bs->drawBodies(&cam, _viewport, cvf);
+                {
+                    const Ns3DProfiler::Section section(
+                        _profiler, fromNbStr(bs->name()));
+                    bs->drawBodies(&cam, _viewport, cvf);
+                }
+
+                // Redraw at full quality once the view is at rest.
+
+                if (bs->drewInteractive()) {
+                    _idleTimer.start();
+                }
                 bs->hudInfo(ss);
                 labels.append(bs->labels());
 
@@ -1222,29 +1280,23 @@ Ns3DView::_drawActiveScopes(const Ns3DCameraScope &cam,
                 }
             }
 
-            if (!bs) {
-                NB_WARNING("Op '" << op->name() <<
-                           "' fraudulently claims to be a body scope when in "
-                           << "fact it is a " << op->typeName());
-            }
-
             Nb::MessageCallback::popValueObject();
         }
 
         // let the field scopes draw...
-        const NtStringList fieldScopes=
-            NiQueryOpNames(NI_INSTANCE, "FIELD_SCOPE");
-        for(unsigned int i(0); i<fieldScopes.size(); ++i) {
-            Ng::Op* op(NiMutableOp(fieldScopes[i]));
 
-            Nb::MessageCallback::pushValueObject(op);
+        foreach (Ns3DFieldScope *fs, _fieldScopes) {
+            Nb::MessageCallback::pushValueObject(fs);
 
             // let the field scopes draw their fields
-            Ns3DFieldScope *fs(dynamic_cast<Ns3DFieldScope*>(op));
-            if(fs && fs->opState() == Ng::FieldOp::ActiveOpState) {
+            if(fs->opState() == Ng::FieldOp::ActiveOpState) {
                 fs->setContext(context());
                 //fieldScope->envMapHandle=envMapHandle;
-                fs->drawField(&cam,_viewport, cvf);
+                {
+                    const Ns3DProfiler::Section section(
+                        _profiler, fromNbStr(fs->name()));
+                    fs->drawField(&cam,_viewport, cvf);
+                }
                 fs->hudInfo(ss);
 
                 // Get bounds of the bodies drawn by the scope.
@@ -1271,12 +1323,6 @@ Ns3DView::_drawActiveScopes(const Ns3DCameraScope &cam,
                 }
             }
 
-            if (!fs) {
-                NB_WARNING("Op '" << op->name() <<
-                           "' fraudulently claims to be a field scope when in "
-                           << "fact it is a " << op->typeName());
-            }
-
             Nb::MessageCallback::popValueObject();
         }
     }
@@ -1288,6 +1334,66 @@ Ns3DView::_drawActiveScopes(const Ns3DCameraScope &cam,
 }
 
 
+// _updateScopeLists
+// -----------------
+//! Collects the body and field scopes of the graph. The lists are kept
+//! between repaints and only rebuilt once the graph has changed, so that
+//! camera-only repaints skip the op name queries.
+
+void
+Ns3DView::_updateScopeLists()
+{
+    const int revision(NsOpStore::instance()->sceneRevision());
+    if (revision == _scopeListRevision) {
+        return;
+    }
+
+    _bodyScopes.clear();
+    _fieldScopes.clear();
+
+    const NsGraphCallback::NiLocker locker;
+
+    const NtStringList bodyScopes =
+        NiQueryOpNames(NI_INSTANCE, "BODY_SCOPE");
+
+    for(unsigned int i(0); i<bodyScopes.size(); ++i) {
+        Ng::Op* op(NiMutableOp(bodyScopes[i]));
+
+        Ns3DBodyScope *bs(dynamic_cast<Ns3DBodyScope*>(op));
+        Ns3DCameraScope *cs(dynamic_cast<Ns3DCameraScope*>(op));
+
+        if (!bs) {
+            NB_WARNING("Op '" << op->name() <<
+                       "' fraudulently claims to be a body scope when in "
+                       << "fact it is a " << op->typeName());
+        }
+        else if (!cs) {
+            _bodyScopes.append(bs);
+        }
+    }
+
+    const NtStringList fieldScopes=
+        NiQueryOpNames(NI_INSTANCE, "FIELD_SCOPE");
+
+    for(unsigned int i(0); i<fieldScopes.size(); ++i) {
+        Ng::Op* op(NiMutableOp(fieldScopes[i]));
+
+        Ns3DFieldScope *fs(dynamic_cast<Ns3DFieldScope*>(op));
+
+        if (!fs) {
+            NB_WARNING("Op '" << op->name() <<
+                       "' fraudulently claims to be a field scope when in "
+                       << "fact it is a " << op->typeName());
+        }
+        else {
+            _fieldScopes.append(fs);
+        }
+    }
+
+    _scopeListRevision = revision;
+}
+
+
 //// _drawOriginGrid
 //// ---------------
 ////! Draws a grid centered at worldspace origin, where each cell in the grid
@@ -1381,7 +1487,16 @@ Ns3DView::_drawCameraPivot(const Ns3DCameraScope &cam)
     Ngl::Light light(Ngl::vec4f(1.f, 1.f, 1.f, 1.f));
     light.set();
 
-    Ngl::Sphere sph(cam.pivotSize(Nb::ZeroTimeBundle), 64, piv);
+    // A unit sphere, built once and placed and scaled below. Never
+    // deleted, since GL may be gone by the time static objects are.
+
+    static Ngl::Sphere *sph(new Ngl::Sphere(1.f, 64));
+    const GLfloat pivotSize(cam.pivotSize(Nb::ZeroTimeBundle));
+
+    glPushMatrix();
+    glTranslatef(piv[0], piv[1], piv[2]);
+    glScalef(pivotSize, pivotSize, pivotSize);
+    glEnable(GL_NORMALIZE);
 
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_POLYGON_STIPPLE);
@@ -1407,13 +1522,16 @@ Ns3DView::_drawCameraPivot(const Ns3DCameraScope &cam)
         0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55 };
     glPolygonStipple(halftone);
 
-    sph.draw();
+    sph->draw();
 
 //        glDisable(GL_CULL_FACE);
     glDisable(GL_POLYGON_STIPPLE);
     glEnable(GL_DEPTH_TEST);
 
-    sph.draw();
+    sph->draw();
+
+    glDisable(GL_NORMALIZE);
+    glPopMatrix();
 
     glDisable(GL_LIGHT0);
     glDisable(GL_LIGHTING);
@@ -1596,6 +1714,26 @@ Ns3DView::_onReadSettings()
     _drawAxesAction->setChecked(settings.value("DrawAxes").toBool());
     _drawItemLabelsAction->setChecked(settings.value("DrawItemLabels").toBool());
     _drawBodyLabelsAction->setChecked(settings.value("DrawBodyLabels").toBool());
+    _drawTimingsAction->setChecked(settings.value("DrawTimings").toBool());
+    _profiler.setEnabled(_drawTimingsAction->isChecked());
+
+    // GPU memory kept for bodies that have been reloaded. [MB]
+
+    Ns3DResourceCache::instance()->setBudget(
+        std::size_t(settings.value("ResourceCacheBudget", 512).toInt())*
+        1024*1024);
+
+    // Linked shader programs are kept next to the settings file so that
+    // later sessions do not have to compile them again.
+
+    if (settings.value("ProgramBinaryCache", true).toBool()) {
+        Ngl::ProgramCache::setBinaryPath(
+            fromQStr(QFileInfo(settings.fileName()).absolutePath() +
+                     "/ShaderCache"));
+    }
+    else {
+        Ngl::ProgramCache::setBinaryPath("");
+    }
 
     settings.endGroup();
 }
@@ -1633,6 +1771,13 @@ Ns3DView::_onWriteSettings()
                       QVariant(_drawItemLabelsAction->isChecked()));
     settings.setValue("DrawBodyLabels",
                       QVariant(_drawBodyLabelsAction->isChecked()));
+    settings.setValue("DrawTimings",
+                      QVariant(_drawTimingsAction->isChecked()));
+    settings.setValue("ResourceCacheBudget",
+                      QVariant(int(Ns3DResourceCache::instance()->budget()/
+                                   (1024*1024))));
+    settings.setValue("ProgramBinaryCache",
+                      QVariant(!Ngl::ProgramCache::binaryPath().empty()));
 
     settings.endGroup();
 }
@@ -1671,6 +1816,46 @@ Ns3DView::_onNullManip()
     update();
 }
 
+
+// _onDrawTimings
+// --------------
+//! Timings are only collected while they are shown. [slot]
+
+void
+Ns3DView::_onDrawTimings(const bool checked)
+{
+    _profiler.setEnabled(checked);
+    update();
+}
+
+
+// _onExportTimings
+// ----------------
+//! Write the timings of the most recent frames to a user-selected file.
+//! [slot]
+
+void
+Ns3DView::_onExportTimings()
+{
+    if (!_profiler.isEnabled()) {
+        NsMessageWidget::instance()->clientWarning(
+            tr("Enable 'Show Timings' to collect 3D view timings"));
+        return;
+    }
+
+    const QString fileName(
+        QFileDialog::getSaveFileName(
+            this,
+            tr("Export Timings"),
+            QString(),
+            tr("CSV files (*.csv);;All files (*)")));
+
+    if (!fileName.isEmpty() && !_profiler.writeLog(fileName)) {
+        NsMessageWidget::instance()->clientError(
+            tr("Failed to write timings to '") + fileName + "'");
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 // createActions
@@ -1730,6 +1915,26 @@ Ns3DView::_createActions()
                 SLOT(updateGL()));
     }
 
+    if (0 == _drawTimingsAction) {
+        _drawTimingsAction = new QAction(tr("Show &Timings"), this); // Child.
+        _drawTimingsAction->setStatusTip(
+            tr("Toggle per-scope CPU and GPU timings in 3D View"));
+        _drawTimingsAction->setCheckable(true);
+        _drawTimingsAction->setChecked(false);
+        connect(_drawTimingsAction,
+                SIGNAL(toggled(bool)),
+                SLOT(_onDrawTimings(bool)));
+    }
+
+    if (0 == _exportTimingsAction) {
+        _exportTimingsAction = new QAction(tr("E&xport Timings..."), this);
+        _exportTimingsAction->setStatusTip(
+            tr("Write recent 3D View timings to a file"));
+        connect(_exportTimingsAction,
+                SIGNAL(triggered()),
+                SLOT(_onExportTimings()));
+    }
+
     if (0 == _frameSceneAction) {
         _frameSceneAction= new QAction(tr("&Frame"), this); // Child.
         _frameSceneAction->setStatusTip(tr("Fit view"));
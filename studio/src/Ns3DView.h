@@ -50,9 +50,12 @@
 #include "Ns3DSelectionManager.h"
 #include "Ns3DScene.h"
 #include "Ns3DGraphicsItem.h"
+#include "Ns3DProfiler.h"
 
 #include <QtGui>    // TODO: TMP!!
 
+class Ns3DFieldScope;
+
 // -----------------------------------------------------------------------------
 
 #if 0
@@ -121,6 +124,14 @@ public:
     drawBodyLabelsAction() const
     { return _drawBodyLabelsAction; }
 
+    QAction*
+    drawTimingsAction() const
+    { return _drawTimingsAction; }
+
+    QAction*
+    exportTimingsAction() const
+    { return _exportTimingsAction; }
+
     QAction*
     frameSceneAction() const
     { return _frameSceneAction; }
@@ -237,6 +248,12 @@ private slots:
     void
     _onNullManip();
 
+    void
+    _onDrawTimings(bool checked);
+
+    void
+    _onExportTimings();
+
 
 //    void connectionUpdate(const QString &terminal, bool scope);
 
@@ -270,6 +287,7 @@ private:    // Draw.
     void _drawActiveScopes(const Ns3DCameraScope &cam,
                            std::stringstream *ss,
                            QList<Ns3DBodyScope::LabelInfo> &labels);
+    void _updateScopeLists();
     //void _drawOriginGrid();
     void _drawAxes(const Ngl::mat44f &mv);
     void _drawCameraPivot(const Ns3DCameraScope &cam);
@@ -317,6 +335,8 @@ private:    // Member variables.
     QAction             *_drawAxesAction;
     QAction             *_drawItemLabelsAction;
     QAction             *_drawBodyLabelsAction;
+    QAction             *_drawTimingsAction;
+    QAction             *_exportTimingsAction;
     QAction             *_frameSceneAction;
     QAction             *_playblastAction;
     QAction             *_stepPlayblastAction;
@@ -329,6 +349,16 @@ private:    // Member variables.
 
     bool                 _drawSelection;
 
+    QTimer               _idleTimer;    //!< Redraws once the camera is at rest.
+
+    Ns3DProfiler         _profiler;     //!< Scope timings, see _drawHud().
+
+    // Scopes drawn by _drawActiveScopes(), rebuilt when the graph changes.
+
+    QList<Ns3DBodyScope*>  _bodyScopes;
+    QList<Ns3DFieldScope*> _fieldScopes;
+    int                    _scopeListRevision;
+
     QPoint               dragStart;
     QPoint               lastPos;
     bool                 dragging;
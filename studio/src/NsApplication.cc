@@ -44,6 +44,8 @@
 #include "NsCmdCentral.h"
 #include "NsOpStore.h"
 #include "NsGraphCallback.h"
+#include "Ns3DResourceCache.h"
+#include "NsStepProfiler.h"
 #include "NsGraphOpItemFactory.h"
 //#include "NsGraphInputPlugItemFactory.h"
 //#include "NsGraphOutputPlugItemFactory.h"
@@ -176,12 +178,12 @@ NsApplication::NsApplication(int &argc, char **argv)
 
         // Value editing.
 
-        //connect(cc, SIGNAL(valueChanged(QString,QString,int,bool)),
-        //        os, SLOT(onValueChanged(QString,QString,int,bool)));
+        connect(cc, SIGNAL(valuesChanged(QStringList,bool)),
+                os, SLOT(onValuesChanged(QStringList,bool)));
         //connect(cc, SIGNAL(metaChanged(QString,QString,QString,bool)),
         //        os, SLOT(onMetaChanged(QString,QString,QString,bool)));
-        //connect(cc, SIGNAL(projectPathChanged(QString,bool)),
-        //        os, SLOT(onProjectPathChanged(QString,bool)));
+        connect(cc, SIGNAL(projectPathChanged(QString,bool)),
+                os, SLOT(onProjectPathChanged(QString,bool)));
         connect(cc, SIGNAL(currentVisibleFrameChanged(int,bool,bool)),
                 os, SLOT(onCurrentVisibleFrameChanged(int,bool,bool)));
         //connect(cc, SIGNAL(firstVisibleFrameChanged(int,bool)),
@@ -193,6 +195,8 @@ NsApplication::NsApplication(int &argc, char **argv)
 
         connect(cc, SIGNAL(graphCleared(bool)),
                 os, SLOT(onGraphCleared(bool)));
+        connect(cc, SIGNAL(graphLoaded(QStringList,bool)),
+                os, SLOT(onGraphLoaded(QStringList,bool)));
 
         //connect(cc, SIGNAL(graphViewFramed(bool,int,bool)),
         //        os, SLOT(onGraphViewFramed(bool,int,bool)));
@@ -239,6 +243,8 @@ NsApplication::~NsApplication()
 
         NsOpStore::destroyInstance();
         NsGraphCallback::destroyInstance();
+        NsStepProfiler::destroyInstance();
+        Ns3DResourceCache::destroyInstance();
 
         NiEnd();
     }
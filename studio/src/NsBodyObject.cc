@@ -205,10 +205,19 @@ NsBodyObject::eraseShapes()
     }
 }
 
+// init3DBody
+// ----------
+//! Creates the GPU resource object of the body. If a cache name is given,
+//! the GPU resources are kept in the resource cache under that name when
+//! the body is destroyed, and taken back by the next body with the same
+//! cache name.
+
 void
-NsBodyObject::init3DBody() 
+NsBodyObject::init3DBody(const QString &cacheName)
 {
-    _ns3DBody = new Ns3DBody(_body); // This object owns this memory.
+    // This object owns this memory.
+
+    _ns3DBody = new Ns3DBody(_body, fromQStr(cacheName));
 }
 
 // -----------------------------------------------------------------------------
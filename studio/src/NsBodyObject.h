@@ -125,7 +125,7 @@ public:
     eraseShapes();
 
     void
-    init3DBody();
+    init3DBody(const QString &cacheName = QString());
 
 public: // Shapes.
 
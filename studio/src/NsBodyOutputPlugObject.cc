@@ -43,8 +43,10 @@
 #include "NsOpStore.h"
 #include "NsOpObject.h"
 #include "NsBodyObject.h"
+#include "NsStepProfiler.h"
 #include "NsQuery.h"
 #include "NsStringUtils.h"
+#include "NsGraphCallback.h"
 #include <NiNb.h>
 #include <NgInput.h>
 #include <NgBodyOp.h>
@@ -239,9 +241,14 @@ NsBodyOutputPlugObject::_updateBodyCachePolicy()
 void
 NsBodyOutputPlugObject::_updateLiveBodyCache(const _BodyCachePolicy bcp)
 {
+    const NsGraphCallback::NiLocker locker;
+
     typedef std::vector<Nb::Body*> BodyVectorType;
     typedef BodyVectorType::const_iterator BodyIterType;
 
+    const NsStepProfiler::Scope scope(NsStepProfiler::GuiLane,
+                                      "Clone " + longName());
+
     _liveBodyCache.clear(); // Clear the current cache no matter what.
     const BodyVectorType bodies = NiCloneLiveBodies(fromQStr(longName()));
     const BodyIterType iend = bodies.end();
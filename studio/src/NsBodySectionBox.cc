@@ -56,11 +56,19 @@
 NsBodySectionBox::NsBodySectionBox(const NsValueSectionObject &vso,
                                    NsBodyObjectBox            &parent)
     : NsValueSectionBox(vso, parent)
-{
-    QVBoxLayout *layout(new QVBoxLayout);
+    , _parent(parent)
+{}
+
+
+// populate
+// --------
+//! Create the property widgets of the section.
 
+void
+NsBodySectionBox::populate(QVBoxLayout *layout)
+{
     NsPropBaseWidget *pbw(0);
-    foreach (NsValueBaseObject *vbo, vso.constValues()) {
+    foreach (NsValueBaseObject *vbo, section().constValues()) {
         if (!vbo->hidden()) {
             // Create a property widget using a factory.
 
@@ -68,7 +76,7 @@ NsBodySectionBox::NsBodySectionBox(const NsValueSectionObject &vso,
                 NsPropWidgetFactory::instance()->create(
                     NsPropWidgetFactory::KeyType(vbo->typeName(),
                                                  vbo->subTypeName()),
-                    NsPropWidgetFactory::ArgsType(parent.body(), vbo, this));
+                    NsPropWidgetFactory::ArgsType(_parent.body(), vbo, this));
 
             if (0 != pbw) {
                 // Valid property widget.
@@ -81,8 +89,6 @@ NsBodySectionBox::NsBodySectionBox(const NsValueSectionObject &vso,
             }
         }
     }
-
-    setLayout(layout); // Pass ownership of layout to box.
 }
 
 // -----------------------------------------------------------------------------
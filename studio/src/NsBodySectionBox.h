@@ -67,6 +67,15 @@ public:
     virtual
     ~NsBodySectionBox()
     {}
+
+protected:
+
+    virtual void
+    populate(QVBoxLayout *layout);
+
+private:    // Member variables.
+
+    NsBodyObjectBox &_parent;
 };
 
 #endif // NS_BODY_SECTION_BOX_H
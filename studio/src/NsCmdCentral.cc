@@ -39,6 +39,9 @@
 // -----------------------------------------------------------------------------
 
 #include "NsCmdCentral.h"
+#include "NsValueChannel.h"
+#include "NsOpObject.h"
+#include <QSet>
 
 // -----------------------------------------------------------------------------
 
@@ -82,6 +85,167 @@ NsCmdCentral::destroyInstance()
 }
 
 
+// -----------------------------------------------------------------------------
+
+// valueChannel
+// ------------
+//! Returns the notification channel for the given value long name, creating
+//! it on first use. Receivers connected to the channel are only notified
+//! about changes to that value.
+
+NsValueChannel*
+NsCmdCentral::valueChannel(const QString &valueLongName)
+{
+    NsValueChannel *channel(_valueChannels.value(valueLongName, 0));
+
+    if (0 == channel) {
+        channel = new NsValueChannel(this);   // Child.
+        _valueChannels.insert(valueLongName, channel);
+    }
+
+    return channel;
+}
+
+
+// addValueListener
+// ----------------
+//! Register an Op on the channel of the given value.
+
+void
+NsCmdCentral::addValueListener(const QString &valueLongName, NsOpObject *op)
+{
+    valueChannel(valueLongName)->addOp(op);
+}
+
+
+// removeValueListener
+// -------------------
+//! Unregister an Op from the channel of the given value, if it exists.
+
+void
+NsCmdCentral::removeValueListener(const QString &valueLongName,
+                                  NsOpObject    *op)
+{
+    NsValueChannel *channel(_valueChannels.value(valueLongName, 0));
+    if (0 != channel) {
+        channel->removeOp(op);
+    }
+}
+
+
+// eraseValueChannels
+// ------------------
+//! Free the channels of the given values, e.g. when their Op is erased.
+//! Receivers connected to a channel are disconnected when it is deleted.
+
+void
+NsCmdCentral::eraseValueChannels(const QStringList &valueLongNames)
+{
+    foreach (const QString &valueLongName, valueLongNames) {
+        delete _valueChannels.take(valueLongName);
+    }
+}
+
+
+// endValueBatch
+// -------------
+//! Close a value batch, delivering its changes if it was the outermost one.
+
+void
+NsCmdCentral::endValueBatch()
+{
+    if (0 < _valueBatchDepth && 0 == --_valueBatchDepth) {
+        _flushValueChanges();
+    }
+}
+
+
+// _flushValueChanges
+// ------------------
+//! Deliver pending value changes to their channels, then announce the
+//! distinct changed values once for each outcome.
+
+void
+NsCmdCentral::_flushValueChanges()
+{
+    QStringList   succeeded;
+    QStringList   failed;
+    QSet<QString> seen[2];
+
+    const QList<_ValueChange> pending(_pendingValues);
+    _pendingValues.clear();
+
+    foreach (const _ValueChange &vc, pending) {
+        NsValueChannel *channel(_valueChannels.value(vc.valueLongName, 0));
+        if (0 != channel) {
+            channel->emitValueChanged(
+                vc.valueLongName, vc.expr, vc.comp, vc.success);
+        }
+
+        QSet<QString> &s(seen[vc.success ? 1 : 0]);
+        if (!s.contains(vc.valueLongName)) {
+            s.insert(vc.valueLongName);
+            (vc.success ? succeeded : failed) << vc.valueLongName;
+        }
+    }
+
+    if (!succeeded.isEmpty()) {
+        _deliverValueChanges(succeeded, true);
+        emit valuesChanged(succeeded, true);
+    }
+
+    if (!failed.isEmpty()) {
+        _deliverValueChanges(failed, false);
+        emit valuesChanged(failed, false);
+    }
+}
+
+
+// _deliverValueChanges
+// --------------------
+//! Notify the Ops registered on the channels of the given values, each Op
+//! once with the values it is registered for.
+
+void
+NsCmdCentral::_deliverValueChanges(const QStringList &valueLongNames,
+                                   const bool         success)
+{
+    QList<NsOpObject*>               ops;
+    QHash<NsOpObject*, QStringList>  opValues;
+
+    foreach (const QString &valueLongName, valueLongNames) {
+        const NsValueChannel *channel(_valueChannels.value(valueLongName, 0));
+        if (0 == channel) {
+            continue;
+        }
+
+        foreach (NsOpObject *op, channel->ops()) {
+            if (!opValues.contains(op)) {
+                ops << op;
+            }
+            opValues[op] << valueLongName;
+        }
+    }
+
+    foreach (NsOpObject *op, ops) {
+        op->onValuesChanged(opValues.value(op), success);
+    }
+}
+
+
+// _clearValueChannels
+// -------------------
+//! Free all value channels, on graph clear.
+
+void
+NsCmdCentral::_clearValueChannels()
+{
+    qDeleteAll(_valueChannels);
+    _valueChannels.clear();
+}
+
+// -----------------------------------------------------------------------------
+
 //! Singleton instance, initialized to null. [static]
 NsCmdCentral *NsCmdCentral::_instance(0);
 
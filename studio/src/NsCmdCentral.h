@@ -43,8 +43,13 @@
 
 #include "NsInputPlugObject.h"
 #include <QObject>
+#include <QHash>
+#include <QList>
 #include <QDebug>
 
+class NsValueChannel;
+class NsOpObject;
+
 // -----------------------------------------------------------------------------
 
 class NsCmdCentral : public QObject
@@ -66,6 +71,50 @@ private:    // Singleton implementation.
 
     static NsCmdCentral *_instance;
 
+public:     // Bulk loading.
+
+    //! True while the notifications of a bulk load are being replayed.
+    //! Receivers may skip work that graphLoaded() will redo once.
+    bool
+    isBulkLoading() const
+    { return _bulkLoading; }
+
+    void
+    beginBulkLoad()
+    { _bulkLoading = true; }
+
+    void
+    endBulkLoad(const QStringList &opInstances, const bool success)
+    {
+        _bulkLoading = false;
+        emit graphLoaded(opInstances, success);
+    }
+
+public:     // Targeted value notification.
+
+    NsValueChannel*
+    valueChannel(const QString &valueLongName);
+
+    //! Register an Op to be notified about changes to the given value.
+    void
+    addValueListener(const QString &valueLongName, NsOpObject *op);
+
+    void
+    removeValueListener(const QString &valueLongName, NsOpObject *op);
+
+    //! Free the channels of values that no longer exist.
+    void
+    eraseValueChannels(const QStringList &valueLongNames);
+
+    //! Value changes made until the matching endValueBatch() are delivered
+    //! to value channels and valuesChanged() in one go. Batches nest.
+    void
+    beginValueBatch()
+    { ++_valueBatchDepth; }
+
+    void
+    endValueBatch();
+
 public slots:   // Op-related notification.
 
     void
@@ -98,6 +147,11 @@ public slots:   // Op-related notification.
         }
 
         emit valueChanged(valueLongName, expr, comp, success);
+
+        _pendingValues.append(_ValueChange(valueLongName, expr, comp, success));
+        if (0 == _valueBatchDepth) {
+            _flushValueChanges();
+        }
     }
 
     void
@@ -153,7 +207,12 @@ public slots:   // Misc. notification.
 
     void
     onGraphCleared(const bool success)
-    { emit graphCleared(success); }
+    {
+        if (success) {
+            _clearValueChannels();
+        }
+        emit graphCleared(success);
+    }
 
     void
     onCurrentVisibleFrameChanged(const int  cvf, 
@@ -212,6 +271,13 @@ signals:
                  int            comp,
                  bool           success);
 
+    //! Signal emitted once per value change, or once per value batch, with
+    //! the distinct long names of the changed values. Preferred over
+    //! valueChanged() by receivers that do not need each component.
+    void
+    valuesChanged(const QStringList &valueLongNames,
+                  bool               success);
+
     //! Signal emitted when the project path has changed.
     void
     projectPathChanged(const QString &path,
@@ -273,6 +339,11 @@ signals:
     void
     graphCleared(bool success);
 
+    //! Signal emitted once when a bulk load has finished, in place of the
+    //! value and meta notifications of the loaded Ops.
+    void
+    graphLoaded(const QStringList &opInstances, bool success);
+
     //! Signal emitted when the current visible frame has changed.
     void
     currentVisibleFrameChanged(int cvf, bool update3DView, bool success);
@@ -302,6 +373,8 @@ private:
     explicit
     NsCmdCentral()
         : QObject()
+        , _bulkLoading(false)
+        , _valueBatchDepth(0)
     {}
 
     //! DTOR.
@@ -311,6 +384,45 @@ private:
 
     NsCmdCentral(const NsCmdCentral&);              //!< Disabled.
     NsCmdCentral& operator=(const NsCmdCentral&);   //!< Disabled.
+
+    void
+    _flushValueChanges();
+
+    void
+    _deliverValueChanges(const QStringList &valueLongNames, bool success);
+
+    void
+    _clearValueChannels();
+
+private:    // Member variables.
+
+    // _ValueChange
+    // ------------
+    //! A value change waiting to be delivered.
+
+    struct _ValueChange
+    {
+        _ValueChange(const QString &valueLongName,
+                     const QString &expr,
+                     const int      comp,
+                     const bool     success)
+            : valueLongName(valueLongName)
+            , expr(expr)
+            , comp(comp)
+            , success(success)
+        {}
+
+        QString valueLongName;
+        QString expr;
+        int     comp;
+        bool    success;
+    };
+
+    bool _bulkLoading;
+
+    QHash<QString, NsValueChannel*> _valueChannels;
+    QList<_ValueChange>             _pendingValues;
+    int                             _valueBatchDepth;
 };
 
 // -----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include "NsCmdCentral.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -103,6 +104,8 @@ NsCmdClearGraph::_Callback::_notify(const bool success) const
 void
 NsCmdClearGraph::_request()
 {
+    const NsGraphCallback::NiLocker locker;
+
     qDebug() << "NsCmdClearGraph::request";
 
     // Create a callback object and provide it to NI.
@@ -44,6 +44,7 @@
 #include "NsInputPlugObject.h"
 #include "NsQuery.h"
 #include "NsStringUtils.h"
+#include "NsGraphCallback.h"
 #include <Ni.h>
 #include <QApplication>
 #include <QClipboard>
@@ -82,6 +83,8 @@ void
 NsCmdCopy::_request(const QStringList &opInstances,
                     QUndoCommand      *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     QByteArray mime;
 
     // Export Ops first.
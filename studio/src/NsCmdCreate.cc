@@ -47,6 +47,7 @@
 #include "NsQuery.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -198,6 +199,8 @@ NsCmdCreate::_request(const QString  &opType,
                       const QString  &text,
                       QString        *createdOpInstance)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI. NiCreate() will call
     // either success() or failure() of the callback object.
 
@@ -217,6 +220,8 @@ NsCmdCreate::_request(const QString  &opType,
                       QUndoCommand   *parent,
                       QString        *createdOpInstance)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI. NiCreate() will call
     // either success() or failure() of the callback object.
 
@@ -49,6 +49,7 @@
 #include "NsInputPlugObject.h"
 #include "NsParserCallback.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <Ni.h>
 #include <QtDebug>
 
@@ -101,6 +102,8 @@ NsCmdErase::exec(const QString  &opInstance,
 void
 NsCmdErase::undo()
 {
+    const NsGraphCallback::NiLocker locker;
+
     qDebug() << "NsCmdErase::undo()";
 
     NsParserCallback pcb(false);
@@ -187,6 +190,8 @@ NsCmdErase::_request(const QString  &opInstance,
                      const bool      merge,
                      const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     const NsOpObject *op(NsOpStore::instance()->queryConstOp(opInstance));
 
     if (0 != op) {
@@ -211,6 +216,8 @@ void
 NsCmdErase::_request(const QString &opInstance,
                      QUndoCommand  *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     const NsOpObject *op(NsOpStore::instance()->queryConstOp(opInstance));
 
     if (0 != op) {
@@ -43,6 +43,7 @@
 #include "NsUndoStack.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -184,6 +185,8 @@ NsCmdFeed::_request(const QString  &inputLongName,
                     const bool      merge,
                     const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text);
@@ -201,6 +204,8 @@ NsCmdFeed::_request(const QString  &inputLongName,
                     const QString  &plugLongName,
                     QUndoCommand   *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent);
@@ -46,6 +46,7 @@
 #include "NsCmdSetOpPosition.h"
 #include "NsOpStore.h"
 #include "NsParserCallback.h"
+#include "NsGraphCallback.h"
 
 #include <QApplication>
 #include <QClipboard>
@@ -93,6 +94,8 @@ NsCmdPaste::_request(const QPointF &mouseScenePos,
                      const bool     merge,
                      const QString &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     const QMimeData *mimeData(QApplication::clipboard()->mimeData());
 
     if (mimeData->hasFormat("application/ni")) {
@@ -145,6 +148,8 @@ void
 NsCmdPaste::_request(const QPointF &mouseScenePos,
                      QUndoCommand  *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     const QMimeData *mimeData(QApplication::clipboard()->mimeData());
 
     if (mimeData->hasFormat("application/ni")) {
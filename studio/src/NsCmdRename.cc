@@ -43,6 +43,7 @@
 #include "NsUndoStack.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -181,6 +182,8 @@ NsCmdRename::_request(const QString  &oldOpInstance,
                       const bool      merge,
                       const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text);
@@ -198,6 +201,8 @@ NsCmdRename::_request(const QString &oldOpInstance,
                       const QString &newOpInstance,
                       QUndoCommand  *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent);
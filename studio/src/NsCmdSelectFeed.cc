@@ -45,6 +45,7 @@
 #include "NsMessageWidget.h"
 #include "NsInputPlugObject.h"
 #include "NsOpStore.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -119,6 +120,8 @@ NsCmdSelectFeed::_Callback::failure(const NtString &msg)
 NsCmdSelectFeed::_CallbackList
 NsCmdSelectFeed::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
     QStringList inputLongNames;
     foreach (const Args &args, argsList) {
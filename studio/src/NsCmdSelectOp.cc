@@ -45,6 +45,7 @@
 #include "NsOpStore.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -119,6 +120,8 @@ NsCmdSelectOp::_Callback::failure(const NtString &msg)
 NsCmdSelectOp::_CallbackList
 NsCmdSelectOp::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
     QStringList opInstances;
     foreach (const Args &args, argsList) {
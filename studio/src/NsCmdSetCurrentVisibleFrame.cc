@@ -44,6 +44,7 @@
 #include "NsTimeToolBar.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -223,6 +224,8 @@ NsCmdSetCurrentVisibleFrame::_request(const int      cvf,
                                       const bool     merge,
                                       const QString &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text, update3DView);
@@ -242,6 +245,8 @@ NsCmdSetCurrentVisibleFrame::_request(const int     cvf,
                                       const bool    update3DView,
                                       QUndoCommand *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent, update3DView);
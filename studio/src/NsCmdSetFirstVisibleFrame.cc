@@ -44,6 +44,7 @@
 #include "NsTimeToolBar.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -215,6 +216,8 @@ NsCmdSetFirstVisibleFrame::_request(const int       fvf,
                                     const bool      merge,
                                     const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text);
@@ -233,6 +236,8 @@ void
 NsCmdSetFirstVisibleFrame::_request(const int     fvf,
                                     QUndoCommand *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent);
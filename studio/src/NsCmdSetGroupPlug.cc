@@ -43,6 +43,7 @@
 #include "NsUndoStack.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -211,6 +212,8 @@ NsCmdSetGroupPlug::_request(const QString  &plugLongName,
                             const bool      merge,
                             const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text);
@@ -228,6 +231,8 @@ NsCmdSetGroupPlug::_request(const QString &plugLongName,
                             const bool     group,
                             QUndoCommand  *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent);
@@ -44,6 +44,7 @@
 #include "NsTimeToolBar.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -215,6 +216,8 @@ NsCmdSetLastVisibleFrame::_request(const int       lvf,
                                    const bool      merge,
                                    const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(stack, merge, text);
@@ -233,6 +236,8 @@ void
 NsCmdSetLastVisibleFrame::_request(const int       lvf,
                                    QUndoCommand   *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     _Callback cb(parent);
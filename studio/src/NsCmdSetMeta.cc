@@ -44,6 +44,7 @@
 #include "NsQuery.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -227,6 +228,8 @@ NsCmdSetMeta::_request(const QString  &longName,
                        const bool      merge,
                        const QString  &text)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     NsCmdSetMeta::_Callback cb(stack, merge, text);
@@ -246,6 +249,8 @@ NsCmdSetMeta::_request(const QString  &longName,
                        const QString  &value,
                        QUndoCommand   *parent)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Create a callback object and provide it to NI.
 
     NsCmdSetMeta::_Callback cb(parent);
@@ -44,6 +44,7 @@
 #include "NsValueObject.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -224,6 +225,8 @@ NsCmdSetOpPosition::_Callback::_notify(const bool success) const
 NsCmdSetOpPosition::_CallbackList
 NsCmdSetOpPosition::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
 
     foreach (const Args &args, argsList) {
@@ -45,6 +45,7 @@
 #include "NsOpStore.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QtDebug>
 
 // -----------------------------------------------------------------------------
@@ -140,6 +141,8 @@ NsCmdSetOpState::_Callback::failure(const NtString &msg)
 NsCmdSetOpState::_CallbackList
 NsCmdSetOpState::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
     QStringList opInstances;
     foreach (const Args &args, argsList) {
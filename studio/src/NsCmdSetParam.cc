@@ -44,6 +44,7 @@
 #include "NsQuery.h"
 #include "NsStringUtils.h"
 #include "NsMessageWidget.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -221,8 +222,12 @@ NsCmdSetParam::_Callback::_notify(const bool success) const
 NsCmdSetParam::_CallbackList
 NsCmdSetParam::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
 
+    NsCmdCentral::instance()->beginValueBatch();
+
     foreach (const Args &args, argsList) {
         _Callback cb; // Create a callback object to provide to NI.
         NiPushRequestCallback(&cb);
@@ -235,6 +240,8 @@ NsCmdSetParam::_request(const ArgsList &argsList)
         }
     }
 
+    NsCmdCentral::instance()->endValueBatch();
+
     return successCallbacks;
 }
 
@@ -44,6 +44,7 @@
 #include "NsQuery.h"
 #include "NsStringUtils.h"
 #include "NsUndoStack.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -233,8 +234,12 @@ NsCmdSetParam3::_Callback::_notify(const bool success) const
 NsCmdSetParam3::_CallbackList
 NsCmdSetParam3::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
 
+    NsCmdCentral::instance()->beginValueBatch();
+
     foreach (const Args &args, argsList) {
         _Callback cb; // Create a callback object to provide to NI.
         NiPushRequestCallback(&cb);
@@ -248,6 +253,8 @@ NsCmdSetParam3::_request(const ArgsList &argsList)
         }
     }
 
+    NsCmdCentral::instance()->endValueBatch();
+
     return successCallbacks;
 }
 
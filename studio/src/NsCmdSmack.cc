@@ -45,6 +45,7 @@
 #include "NsMessageWidget.h"
 #include "NsPlugObject.h"
 #include "NsOpStore.h"
+#include "NsGraphCallback.h"
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -119,6 +120,8 @@ NsCmdSmack::_Callback::failure(const NtString &msg)
 NsCmdSmack::_CallbackList
 NsCmdSmack::_request(const ArgsList &argsList)
 {
+    const NsGraphCallback::NiLocker locker;
+
     _CallbackList successCallbacks;
     QStringList plugLongNames;
     foreach (const Args &args, argsList) {
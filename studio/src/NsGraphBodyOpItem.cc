@@ -101,6 +101,10 @@ NsGraphBodyOpItem::paint(QPainter                       *painter,
 {
     NsGraphOpItem::paint(painter, option, widget);
 
+    if (isCoarseDetail(option, painter)) {
+        return;     // Parent drew a plain rectangle, skip the label.
+    }
+
 #ifndef NS_GRAPH_VIEW_NAME_ITEMS
     //painter->setClipRect(_boundingRect());
     painter->setPen(QPen(Qt::black, 2.));
@@ -133,6 +133,10 @@ protected:
           const QStyleOptionGraphicsItem *option,
           QWidget                        *widget)
     {
+        if (isCoarseDetail(option, painter)) {
+            return;     // Plugs can't be made out when zoomed out.
+        }
+
         const QPen shapePen =
             QPen(NsPreferences::instance()->graphViewPlugLineColor(), 2);
         const QBrush shapeBrush =
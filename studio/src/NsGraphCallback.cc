@@ -42,9 +42,11 @@
 #include "NsCmdSelectAllBodies.h"
 #include "NsCmdSetCurrentVisibleFrame.h"
 #include "NsStringUtils.h"
+#include "NsStepProfiler.h"
 #include <Ni.h>
 #include <QMessageBox>
 #include <QApplication>
+#include <QThread>
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
@@ -99,14 +101,225 @@ NsGraphCallback *NsGraphCallback::_instance = 0;
 
 NsGraphCallback::NsGraphCallback()
     : _cb(*this)
-    , _steppingStopped(false)
-{}
+    , _steppingStopped(0)
+    , _solverStepping(0)
+    , _niMutex(QMutex::Recursive)
+    , _niWaiters(0)
+    , _niOwner(0)
+    , _niDepth(0)
+{
+    // Time bundles are passed across threads when stepping on a solver
+    // thread.
+
+    qRegisterMetaType<NtTimeBundle>("NtTimeBundle");
+}
+
+
+// solverStepping
+// --------------
+//! True while a step runs on the solver thread. [static]
+
+bool
+NsGraphCallback::solverStepping()
+{
+    return (0 != _instance && 0 != _instance->_solverStepping);
+}
+
+// -----------------------------------------------------------------------------
+
+// NiLocker
+// --------
+//! CTOR. Nothing is locked if the graph callback has not been created yet,
+//! since no solver can be running then.
+
+NsGraphCallback::NiLocker::NiLocker(const Mode mode)
+    : _gcb(_instance)
+    , _locked(true)
+{
+    if (0 == _gcb) {
+        return;
+    }
+
+    if (Try == mode) {
+        _locked = _gcb->_tryLockNi();
+    }
+    else {
+        _gcb->_lockNi();
+    }
+
+    if (!_locked) {
+        _gcb = 0;
+    }
+}
+
+
+// ~NiLocker
+// ---------
+//! DTOR.
+
+NsGraphCallback::NiLocker::~NiLocker()
+{
+    if (0 != _gcb) {
+        _gcb->_unlockNi();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// _lockNi
+// -------
+//! Waits for the NI lock. Registered waiters make the solver yield the lock
+//! when it leaves a graph callback.
+
+void
+NsGraphCallback::_lockNi()
+{
+    _niWaiters.ref();
+    _niMutex.lock();
+    _niWaiters.deref();
+    _niOwner = QThread::currentThread();
+    ++_niDepth;
+}
+
+
+// _tryLockNi
+// ----------
+//! Takes the NI lock if it is free, returns false otherwise.
+
+bool
+NsGraphCallback::_tryLockNi()
+{
+    if (!_niMutex.tryLock()) {
+        return false;
+    }
+
+    _niOwner = QThread::currentThread();
+    ++_niDepth;
+    return true;
+}
+
+
+// _unlockNi
+// ---------
+//! Releases one level of the NI lock.
+
+void
+NsGraphCallback::_unlockNi()
+{
+    if (0 == --_niDepth) {
+        _niOwner = 0;
+    }
+    _niMutex.unlock();
+}
+
+
+// _releaseNi
+// ----------
+//! Fully releases the NI lock if it is held by the calling thread. Returns
+//! the recursion depth that was released. The owner and depth are only
+//! touched under the lock, which the recursive mutex lets the calling
+//! thread take unless another thread holds it.
+
+int
+NsGraphCallback::_releaseNi()
+{
+    if (!_niMutex.tryLock()) {
+        return 0;   // Held by another thread.
+    }
+
+    const int depth(QThread::currentThread() == _niOwner ? _niDepth : 0);
+    _niMutex.unlock();
+
+    for (int i(0); i < depth; ++i) {
+        _unlockNi();
+    }
+    return depth;
+}
+
+
+// _reacquireNi
+// ------------
+//! Takes the NI lock back after _releaseNi(). Threads that were waiting for
+//! the lock are let through first, QMutex is not fair.
+
+void
+NsGraphCallback::_reacquireNi(const int depth)
+{
+    if (0 == depth) {
+        return;
+    }
+
+    while (0 != _niWaiters) {
+        QThread::yieldCurrentThread();
+    }
+
+    for (int i(0); i < depth; ++i) {
+        _niMutex.lock();
+        _niOwner = QThread::currentThread();
+        ++_niDepth;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// _onBeginStep
+// ------------
+//! Handles the start of a step on the GUI thread. [slot]
+
+void
+NsGraphCallback::_onBeginStep(const NtTimeBundle &tb)
+{
+    NsCmdSelectAllBodies::exec(false);
+    emitBeginStep(tb);
+}
+
+
+// _onBeginFrame
+// -------------
+//! Handles the start of a frame on the GUI thread. [slot]
+
+void
+NsGraphCallback::_onBeginFrame(const NtTimeBundle &tb)
+{
+    NsCmdSelectAllBodies::exec(false);
+    emitBeginFrame(tb);
+
+    if (!steppingStopped()) {
+        NsCmdSetCurrentVisibleFrame::exec(tb.frame, false);
+    }
+}
+
+
+// _onReset
+// --------
+//! Asks the user to confirm a reset, on the GUI thread. [slot]
+
+bool
+NsGraphCallback::_onReset()
+{
+    const bool ok(
+        QMessageBox::Yes ==
+            QMessageBox::warning(
+                0,
+                QObject::tr("Warning"),
+                QObject::tr("This will reset the graph. Are you sure?"),
+                QMessageBox::Yes | QMessageBox::No));
+
+    if (ok) {
+        emitReset();
+    }
+
+    return ok;
+}
 
 // -----------------------------------------------------------------------------
 
 // _Callback
 // ---------
 //! CTOR. Make sure this is called after NiBegin.
+//!
+//! All callbacks release the NI lock held by the solver while they run, the
+//! GUI may call NI then.
 
 NsGraphCallback::_Callback::_Callback(NsGraphCallback &gcb)
     : NtGraphCallback()
@@ -123,8 +336,11 @@ NsGraphCallback::_Callback::_Callback(NsGraphCallback &gcb)
 bool
 NsGraphCallback::_Callback::beginStep(const NtTimeBundle &tb)
 {
-    NsCmdSelectAllBodies::exec(false);
-    _gcb->emitBeginStep(tb);
+    const _NiRelease release(*_gcb);
+    QMetaObject::invokeMethod(_gcb,
+                              "_onBeginStep",
+                              _connectionType(true),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
     return !_gcb->steppingStopped();
 }
@@ -137,13 +353,14 @@ NsGraphCallback::_Callback::beginStep(const NtTimeBundle &tb)
 bool
 NsGraphCallback::_Callback::beginFrame(const NtTimeBundle &tb)
 {
-    NsCmdSelectAllBodies::exec(false);
-    _gcb->emitBeginFrame(tb);
-
-    if (!_gcb->steppingStopped()) {
-        NsCmdSetCurrentVisibleFrame::exec(tb.frame, false);
-    }
-
+    const _NiRelease release(*_gcb);
+    // Bodies are deselected before the solver replaces them, so wait for
+    // the GUI.
+
+    QMetaObject::invokeMethod(_gcb,
+                              "_onBeginFrame",
+                              _connectionType(true),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
 
     return !_gcb->steppingStopped();
@@ -152,12 +369,18 @@ NsGraphCallback::_Callback::beginFrame(const NtTimeBundle &tb)
 
 // beginTimestep
 // -------------
-//! Called when solve of the given timestep begins.
+//! Called when solve of the given timestep begins. Profiling timestamps are
+//! taken here, on the solver thread, since the notification is queued.
 
 bool
 NsGraphCallback::_Callback::beginTimestep(const NtTimeBundle &tb)
 {
-    _gcb->emitBeginTimeStep(tb);
+    const _NiRelease release(*_gcb);
+    NsStepProfiler::instance()->beginTimeStep(tb);
+    QMetaObject::invokeMethod(_gcb,
+                              "emitBeginTimeStep",
+                              _connectionType(false),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
     return !_gcb->steppingStopped();
 }
@@ -170,7 +393,12 @@ NsGraphCallback::_Callback::beginTimestep(const NtTimeBundle &tb)
 bool
 NsGraphCallback::_Callback::endTimestep(const NtTimeBundle &tb)
 {
-    _gcb->emitEndTimestep(tb);
+    const _NiRelease release(*_gcb);
+    NsStepProfiler::instance()->endTimeStep();
+    QMetaObject::invokeMethod(_gcb,
+                              "emitEndTimestep",
+                              _connectionType(false),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
     return !_gcb->steppingStopped();
 }
@@ -183,7 +411,11 @@ NsGraphCallback::_Callback::endTimestep(const NtTimeBundle &tb)
 bool
 NsGraphCallback::_Callback::endFrame(const NtTimeBundle &tb)
 {
-    _gcb->emitEndFrame(tb);
+    const _NiRelease release(*_gcb);
+    QMetaObject::invokeMethod(_gcb,
+                              "emitEndFrame",
+                              _connectionType(false),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
     return !_gcb->steppingStopped();
 }
@@ -196,7 +428,12 @@ NsGraphCallback::_Callback::endFrame(const NtTimeBundle &tb)
 bool
 NsGraphCallback::_Callback::endStep(const NtTimeBundle &tb)
 {
-    _gcb->emitEndStep(tb);
+    const _NiRelease release(*_gcb);
+    NsStepProfiler::instance()->endStep();
+    QMetaObject::invokeMethod(_gcb,
+                              "emitEndStep",
+                              _connectionType(false),
+                              Q_ARG(NtTimeBundle, tb));
     _wakeGui();
     return !_gcb->steppingStopped();
 }
@@ -210,18 +447,12 @@ NsGraphCallback::_Callback::endStep(const NtTimeBundle &tb)
 bool
 NsGraphCallback::_Callback::reset()
 {
-    const bool ok(
-        QMessageBox::Yes ==
-            QMessageBox::warning(
-                0,
-                QObject::tr("Warning"),
-                QObject::tr("This will reset the graph. Are you sure?"),
-                QMessageBox::Yes | QMessageBox::No));
-
-    if (ok) {
-        _gcb->emitReset();
-    }
-
+    const _NiRelease release(*_gcb);
+    bool ok(false);
+    QMetaObject::invokeMethod(_gcb,
+                              "_onReset",
+                              _connectionType(true),
+                              Q_RETURN_ARG(bool, ok));
     return ok;
 }
 
@@ -235,28 +466,54 @@ void
 NsGraphCallback::_Callback::beginOp(const NtTimeBundle &tb,
                                     const NtString     &opInstance)
 {
-    _gcb->emitBeginOp(tb, fromNbStr(opInstance));
+    const _NiRelease release(*_gcb);
+    NsStepProfiler::instance()->beginRange(NsStepProfiler::SolverLane,
+                                           fromNbStr(opInstance));
+    QMetaObject::invokeMethod(_gcb,
+                              "emitBeginOp",
+                              _connectionType(false),
+                              Q_ARG(NtTimeBundle, tb),
+                              Q_ARG(QString, fromNbStr(opInstance)));
     _wakeGui();
 }
 
 
 // endOp
 // ------
-//! Called when stepping of the Op with the given name is completed.
+//! Called when stepping of the Op with the given name is completed. Blocks
+//! the solver until the GUI has handled the signal, so that live bodies are
+//! cloned while they are in a consistent state. The op's range ends before
+//! that, so that cloning is accounted to the GUI.
 
 void
 NsGraphCallback::_Callback::endOp(const NtTimeBundle &tb,
                                   const NtString     &opInstance)
 {
-    _gcb->emitEndOp(tb, fromNbStr(opInstance));
+    const _NiRelease release(*_gcb);
+    NsStepProfiler::instance()->endRange(NsStepProfiler::SolverLane);
+    QMetaObject::invokeMethod(_gcb,
+                              "emitEndOp",
+                              _connectionType(true),
+                              Q_ARG(NtTimeBundle, tb),
+                              Q_ARG(QString, fromNbStr(opInstance)));
     _wakeGui();
 }
 
 // -----------------------------------------------------------------------------
 
+// _wakeGui
+// --------
+//! Lets the GUI process events while the solver runs on the GUI thread. When
+//! stepping on a solver thread the GUI event loop runs freely and there is
+//! nothing to do. [static]
+
 void
 NsGraphCallback::_Callback::_wakeGui()
 {
+    if (QThread::currentThread() != QCoreApplication::instance()->thread()) {
+        return;
+    }
+
 #if 0
     // Flushes the platform specific event queues.
     // If you are doing graphical changes inside a loop that does not return to 
@@ -289,6 +546,23 @@ NsGraphCallback::_Callback::_wakeGui()
 }
 
 
+// _connectionType
+// ---------------
+//! Returns the connection type used to deliver a notification to the GUI.
+//! Calls are direct when stepping on the GUI thread. From a solver thread
+//! they are queued, or blocking if the solver must wait for the GUI.
+
+Qt::ConnectionType
+NsGraphCallback::_Callback::_connectionType(const bool blocking) const
+{
+    if (QThread::currentThread() == _gcb->thread()) {
+        return Qt::DirectConnection;
+    }
+
+    return (blocking ? Qt::BlockingQueuedConnection : Qt::QueuedConnection);
+}
+
+
 /*
     // cache the bodies for Body Plugs and fields for Field Plugs
 
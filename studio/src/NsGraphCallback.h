@@ -42,8 +42,13 @@
 #define NS_GRAPH_CALLBACK_H
 
 #include <QObject>
+#include <QMetaType>
+#include <QAtomicInt>
+#include <QMutex>
 #include <NiTypes.h>
 
+class QThread;
+
 // -----------------------------------------------------------------------------
 
 // NsGraphCallback
@@ -51,6 +56,21 @@
 //! The NsGraphCallback class, representing the Naiad graph callback.
 //! Updates the information displayed in the user interface during graph
 //! stepping, and provides a way to abort stepping.
+//!
+//! Stepping may run on a solver thread (see NsStepThread). Signals are then
+//! still emitted on the thread the callback object lives in, i.e. the GUI
+//! thread, so that receivers never have to worry about threading. Most
+//! notifications are queued, while those that require the solver to wait
+//! for the GUI, e.g. caching live bodies at the end of an op, block the
+//! solver until they have been handled.
+//!
+//! NI is not thread-safe. The solver holds the NI lock while stepping and
+//! releases it only while it is inside a graph callback. Code that calls NI
+//! therefore holds an NiLocker around the call, see e.g. NsQuery and the
+//! commands. Read-only queries made by the GUI thread while the solver is
+//! busy are answered with their last result instead of waiting for the op
+//! to end, so that the 3D view can be orbited and repainted from cached
+//! resources during a step.
 
 class NsGraphCallback : public QObject
 {
@@ -83,6 +103,53 @@ private:
 
 public:
 
+    // NiLocker
+    // --------
+    //! Scoped NI lock. Waits until the solver yields, unless constructed in
+    //! Try mode, in which case isLocked() tells whether the lock was taken.
+    //! The lock is recursive.
+
+    class NiLocker
+    {
+    public:
+
+        enum Mode {
+            Wait = 0,
+            Try
+        };
+
+        explicit
+        NiLocker(Mode mode = Wait);
+
+        ~NiLocker();
+
+        bool
+        isLocked() const
+        { return _locked; }
+
+    private:    // Member variables.
+
+        NsGraphCallback *_gcb;      //!< Null if nothing to unlock.
+        bool             _locked;
+
+    private:
+
+        NiLocker(const NiLocker&);              //!< Disabled.
+        NiLocker& operator=(const NiLocker&);   //!< Disabled.
+    };
+
+    //! True while a step runs on the solver thread. Does not create the
+    //! singleton. [static]
+    static bool
+    solverStepping();
+
+    //! Set by NsStepThread around a step on the solver thread.
+    void
+    setSolverStepping(const bool stepping)
+    { _solverStepping = (stepping ? 1 : 0); }
+
+public slots:
+
     void
     emitBeginStep(const NtTimeBundle &tb)
     { emit beginStep(tb); }
@@ -119,13 +186,16 @@ public:
     emitEndOp(const NtTimeBundle &tb, const QString &opInstance)
     { emit endOp(tb, opInstance); }
 
+public:
+
+    //! Request stepping to stop. May be called from any thread.
     void
     setSteppingStopped(const bool stop)
-    { _steppingStopped = stop; }
+    { _steppingStopped = (stop ? 1 : 0); }
 
     bool
     steppingStopped() const
-    { return _steppingStopped; }
+    { return (0 != _steppingStopped); }
 
 signals:
 
@@ -156,6 +226,64 @@ signals:
     void 
     endOp(const NtTimeBundle &tb, const QString &opInstance);
 
+private slots:
+
+    void
+    _onBeginStep(const NtTimeBundle &tb);
+
+    void
+    _onBeginFrame(const NtTimeBundle &tb);
+
+    bool
+    _onReset();
+
+private:
+
+    void
+    _lockNi();
+
+    bool
+    _tryLockNi();
+
+    void
+    _unlockNi();
+
+    int
+    _releaseNi();
+
+    void
+    _reacquireNi(int depth);
+
+    // _NiRelease
+    // ----------
+    //! Releases the NI lock held by the calling thread, if any, for the
+    //! lifetime of the object, letting the GUI call NI while the solver
+    //! waits in a graph callback.
+
+    class _NiRelease
+    {
+    public:
+
+        explicit
+        _NiRelease(NsGraphCallback &gcb)
+            : _gcb(&gcb)
+            , _depth(gcb._releaseNi())
+        {}
+
+        ~_NiRelease()
+        { _gcb->_reacquireNi(_depth); }
+
+    private:    // Member variables.
+
+        NsGraphCallback *_gcb;
+        int              _depth;    //!< Recursion depth released.
+
+    private:
+
+        _NiRelease(const _NiRelease&);              //!< Disabled.
+        _NiRelease& operator=(const _NiRelease&);   //!< Disabled.
+    };
+
 private:
 
     class _Callback : public NtGraphCallback
@@ -208,6 +336,9 @@ private:
         static void
         _wakeGui();
 
+        Qt::ConnectionType
+        _connectionType(bool blocking) const;
+
     private:
 
         _Callback();                                //!< Disabled.
@@ -217,8 +348,14 @@ private:
 
 private:    // Member variables.
 
-    _Callback _cb;              //!< Callback instance.
-    bool      _steppingStopped;
+    _Callback  _cb;                 //!< Callback instance.
+    QAtomicInt _steppingStopped;    //!< Non-zero if stepping should stop.
+    QAtomicInt _solverStepping;     //!< Non-zero while the solver steps.
+
+    QMutex     _niMutex;            //!< Serializes NI calls.
+    QAtomicInt _niWaiters;          //!< Threads waiting for the NI lock.
+    QThread   *_niOwner;            //!< Lock holder, under _niMutex.
+    int        _niDepth;            //!< Lock depth, under _niMutex.
 
 private:
 
@@ -226,4 +363,6 @@ private:
     NsGraphCallback& operator=(const NsGraphCallback&);     //!< Disabled.
 };
 
+Q_DECLARE_METATYPE(NtTimeBundle)
+
 #endif  // NS_GRAPH_CALLBACK_H
@@ -235,6 +235,10 @@ NsGraphFeedItem::paint(QPainter                       *painter,
                        const QStyleOptionGraphicsItem *option,
                        QWidget                        *widget)
 {
+    if (isCoarseDetail(option, painter)) {
+        painter->setRenderHint(QPainter::Antialiasing, false);
+    }
+
     switch (_style) {
     default:
     case Normal:
@@ -317,6 +321,18 @@ NsGraphFeedItem::computeShapePath(const QPointF &p1,
     return path;
 }
 
+// indexRect
+// ---------
+//! Returns the scene rectangle covering the feed path and the body items
+//! placed along it, used by the graph scene's spatial index.
+
+QRectF
+NsGraphFeedItem::indexRect() const
+{
+    const qreal pad(0.5*_bodyItemDiameter);
+    return sceneBoundingRect().adjusted(-pad, -pad, pad, pad);
+}
+
 // -----------------------------------------------------------------------------
 
 //void
@@ -346,6 +362,10 @@ NsGraphFeedItem::_setPath()
         computeBoundingRect(_shapePath, 0.5*4);
 
     _updateBodyItemPositions();
+
+    if (0 != graphScene()) {
+        graphScene()->updateFeedIndex(this);
+    }
 }
 
 
@@ -88,6 +88,17 @@ public:
         QGraphicsItem        *parent = 0,
         qreal                 bodyItemDiameter = 16.);
 
+    NsGraphInputPlugItem*
+    inputPlugItem() const
+    { return _input; }
+
+    NsGraphPlugItem*
+    plugItem() const
+    { return _plug; }
+
+    QRectF
+    indexRect() const;
+
 public:     // Style.
 
     enum Style {
@@ -104,6 +104,10 @@ NsGraphFieldOpItem::paint(QPainter                       *painter,
 {
     NsGraphOpItem::paint(painter, option, widget);
 
+    if (isCoarseDetail(option, painter)) {
+        return;     // Parent drew a plain rectangle, skip the label.
+    }
+
 #ifndef NS_GRAPH_VIEW_NAME_ITEMS
     painter->setPen(QPen(Qt::black, 2.));
     painter->setBrush(QBrush(Qt::white));
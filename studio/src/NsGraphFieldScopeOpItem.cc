@@ -123,6 +123,10 @@ NsGraphFieldScopeOpItem::paint(QPainter                       *painter,
 {
     NsGraphOpItem::paint(painter, option, widget);
 
+    if (isCoarseDetail(option, painter)) {
+        return;     // Parent drew a plain rectangle, skip the label.
+    }
+
     painter->setPen(Qt::NoPen);
     painter->setBrush(QBrush(Qt::black));
     painter->drawPath(_sigPath);
@@ -80,6 +80,10 @@ NsGraphGlobalOpItem::paint(QPainter                       *painter,
 {
     NsGraphOpItem::paint(painter, option, widget); // Parent method.
 
+    if (isCoarseDetail(option, painter)) {
+        return;     // Parent drew a plain rectangle, skip the label.
+    }
+
     painter->setPen(QPen(NsPreferences::instance()->graphViewOpTextColor()));
     painter->setFont(_font);
     painter->setRenderHint(QPainter::TextAntialiasing);
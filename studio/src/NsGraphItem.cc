@@ -63,4 +63,37 @@ NsGraphItem::graphScene() const
     return qobject_cast<NsGraphScene*>(scene());
 }
 
+
+// scheduleUpdate
+// --------------
+//! Request a repaint that is coalesced with other scheduled repaints by the
+//! graph scene. Falls back to an immediate update if not in a graph scene.
+
+void
+NsGraphItem::scheduleUpdate()
+{
+    NsGraphScene *gs(graphScene());
+
+    if (0 != gs) {
+        gs->scheduleItemUpdate(this);
+    }
+    else {
+        update();
+    }
+}
+
+
+// isCoarseDetail
+// --------------
+//! Returns true if the item is drawn so small that plugs, labels and
+//! outlines cannot be made out, and a simplified form should be painted
+//! instead. [static]
+
+bool
+NsGraphItem::isCoarseDetail(const QStyleOptionGraphicsItem *option,
+                            const QPainter                 *painter)
+{
+    return 0.35 > option->levelOfDetailFromTransform(painter->worldTransform());
+}
+
 // -----------------------------------------------------------------------------
@@ -138,6 +138,13 @@ protected:
     NsGraphScene*
     graphScene() const;
 
+    void
+    scheduleUpdate();
+
+    static bool
+    isCoarseDetail(const QStyleOptionGraphicsItem *option,
+                   const QPainter                 *painter);
+
 protected:  // Paint events.
 
     virtual QRectF
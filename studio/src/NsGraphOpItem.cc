@@ -133,6 +133,9 @@ NsGraphOpItem::NsGraphOpItem(const NsGraphOpItemArgs &args)
     , _undoStack(args.undoStack())
     , _diameter(args.diameter())
     , _longName(args.op()->longName())
+    , _styleRevision(_paintStyleRevision - 1)
+    , _styleCondition(NsOpObject::None)
+    , _styleEnabled(true)
 {
 #ifdef NS_GRAPH_VIEW_DEBUG
     setAcceptsHoverEvents(true);
@@ -217,17 +220,26 @@ NsGraphOpItem::outputPlugItems() const
 
 // plugItem
 // --------
-//! Returns null if the given plug does not exist.
+//! Returns null if the given plug does not exist. Plugs are looked up by
+//! name in a hash built the first time it is needed, since plug items are
+//! only created when the Op item is constructed.
 
 NsGraphPlugItem*
 NsGraphOpItem::plugItem(const QString &plugLongName) const
 {
-    foreach (NsGraphPlugItem *gpi, plugItems()) {
-        if (plugLongName == gpi->plugObject()->longName()) {
-            return gpi;    // Found, we are done!
+    if (_plugItemsByName.isEmpty()) {
+        foreach (NsGraphPlugItem *gpi, plugItems()) {
+            _plugItemsByName.insert(gpi->plugObject()->name(), gpi);
         }
     }
 
+    NsGraphPlugItem *gpi(
+        _plugItemsByName.value(plugLongName.section(':', -1), 0));
+
+    if (0 != gpi && plugLongName == gpi->plugObject()->longName()) {
+        return gpi;    // Found, we are done!
+    }
+
     return 0;   // Plug not found.
 }
 
@@ -239,13 +251,7 @@ NsGraphOpItem::plugItem(const QString &plugLongName) const
 NsGraphInputPlugItem*
 NsGraphOpItem::inputPlugItem(const QString &plugLongName) const
 {
-    foreach (NsGraphInputPlugItem *gipi, inputPlugItems()) {
-        if (plugLongName == gipi->plugObject()->longName()) {
-            return gipi;    // Found, we are done!
-        }
-    }
-
-    return 0;   // Plug not found.
+    return dynamic_cast<NsGraphInputPlugItem*>(plugItem(plugLongName));
 }
 
 
@@ -256,13 +262,7 @@ NsGraphOpItem::inputPlugItem(const QString &plugLongName) const
 NsGraphOutputPlugItem*
 NsGraphOpItem::outputPlugItem(const QString &plugLongName) const
 {
-    foreach (NsGraphOutputPlugItem *gopi, outputPlugItems()) {
-        if (plugLongName == gopi->plugObject()->longName()) {
-            return gopi;    // Found, we are done!
-        }
-    }
-
-    return 0;   // Plug not found.
+    return dynamic_cast<NsGraphOutputPlugItem*>(plugItem(plugLongName));
 }
 
 
@@ -487,54 +487,39 @@ NsGraphOpItem::paint(QPainter                       *painter,
                      const QStyleOptionGraphicsItem *option,
                      QWidget                        *widget)
 {
-    const QPainterPath shapePath = shape();
     const bool opEnabled = op()->isEnabled();
-    QBrush fb;
-    switch(op()->condition()) {
-    case NsOpObject::Error:
-        fb = errorBrush;
-        break;
-    case NsOpObject::Warning:
-        fb = warningBrush;
-        break;
-    case NsOpObject::Stepping:
-        fb = steppingBrush;
-        break;
-    case NsOpObject::None:
-    default:
-        const QColor categoryColor = 
-            NsPreferences::instance()->graphViewOpCategoryColor(
-                op()->categoryNames().first());
-        const QColor disabledColor =
-            NsPreferences::instance()->graphViewOpDisabledColor();
-        fb = !opEnabled ? QBrush(disabledColor) : QBrush(categoryColor);
-        break;
+    _updatePaintStyle(opEnabled);
+
+    const bool selected = op()->isSelected() || isItemSelected();
+
+    if (isCoarseDetail(option, painter)) {
+        // Zoomed out, draw a plain rectangle. Only selection is shown.
+
+        painter->setRenderHint(QPainter::Antialiasing, false);
+        painter->setPen(selected ? _selectionPen : Qt::NoPen);
+        painter->setBrush(_fillBrush);
+        painter->drawRect(_shapeRect);
+        return;
     }
 
+    const QPainterPath shapePath = shape();
+
     //painter->setClipRect(boundingRect());
-    painter->fillPath(shapePath, fb);
-
-    if (op()->isSelected() || isItemSelected()) {
-        painter->strokePath(
-            shapePath, 
-            QPen(NsPreferences::instance()->graphViewOpLineColor(), 4));
-        painter->strokePath(
-            shapePath, 
-            QPen(NsPreferences::instance()->graphViewSelectionColor(), 2));
+    painter->fillPath(shapePath, _fillBrush);
+
+    if (selected) {
+        painter->strokePath(shapePath, _outlinePen);
+        painter->strokePath(shapePath, _selectionPen);
     }
     else {
-        painter->strokePath(
-            shapePath,
-            QPen(NsPreferences::instance()->graphViewOpLineColor(), 2));
+        painter->strokePath(shapePath, _linePen);
     }
 
     if (!opEnabled) {
-        const QRectF shapeRect = shapePath.boundingRect();
         painter->setBrush(Qt::NoBrush);
-        painter->setPen(
-            QPen(NsPreferences::instance()->graphViewOpLineColor(), 8));
-        painter->drawLine(shapeRect.bottomLeft(), shapeRect.topRight());
-        painter->drawLine(shapeRect.bottomRight(), shapeRect.topLeft());
+        painter->setPen(_crossPen);
+        painter->drawLine(_shapeRect.bottomLeft(), _shapeRect.topRight());
+        painter->drawLine(_shapeRect.bottomRight(), _shapeRect.topLeft());
     }
 
 #ifdef NS_GRAPH_VIEW_DEBUG
@@ -624,6 +609,63 @@ NsGraphOpItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
 
 // -----------------------------------------------------------------------------
 
+// _updatePaintStyle
+// -----------------
+//! Rebuild the cached brushes and pens if the Op condition, the enabled
+//! state or the preferences have changed since the last paint.
+
+void
+NsGraphOpItem::_updatePaintStyle(const bool opEnabled)
+{
+    const NsOpObject::Condition cond = op()->condition();
+
+    if (_styleRevision  == _paintStyleRevision &&
+        _styleCondition == cond &&
+        _styleEnabled   == opEnabled) {
+        return;     // Up to date.
+    }
+
+    const NsPreferences *prefs = NsPreferences::instance();
+
+    switch(cond) {
+    case NsOpObject::Error:
+        _fillBrush = errorBrush;
+        break;
+    case NsOpObject::Warning:
+        _fillBrush = warningBrush;
+        break;
+    case NsOpObject::Stepping:
+        _fillBrush = steppingBrush;
+        break;
+    case NsOpObject::None:
+    default:
+        _fillBrush = !opEnabled ? 
+            QBrush(prefs->graphViewOpDisabledColor()) :
+            QBrush(prefs->graphViewOpCategoryColor(
+                       op()->categoryNames().first()));
+        break;
+    }
+
+    const QColor lineColor = prefs->graphViewOpLineColor();
+    _linePen      = QPen(lineColor, 2);
+    _outlinePen   = QPen(lineColor, 4);
+    _crossPen     = QPen(lineColor, 8);
+    _selectionPen = QPen(prefs->graphViewSelectionColor(), 2);
+
+    if (_shapeRect.isNull()) {
+        _shapeRect = shape().boundingRect();    // Shape is fixed.
+    }
+
+    _styleRevision  = _paintStyleRevision;
+    _styleCondition = cond;
+    _styleEnabled   = opEnabled;
+}
+
+// -----------------------------------------------------------------------------
+
+//! Paint style revision, see invalidatePaintStyles(). [static]
+int NsGraphOpItem::_paintStyleRevision(0);
+
 const QBrush
 NsGraphOpItem::steppingBrush(QColor(0,128,230));//!< Bg if stepping. [static]
 
@@ -44,6 +44,7 @@
 #include "NsGraphItem.h"
 #include "NsOpObject.h"
 #include <NiTypes.h>
+#include <QHash>
 
 class NsUndoStack;
 class NsGraphOpItemArgs;
@@ -125,6 +126,10 @@ public:
     bool
     hasOutputPlugItems() const;
 
+    static void
+    invalidatePaintStyles()
+    { ++_paintStyleRevision; }
+
 protected slots:
 
     void
@@ -158,11 +163,13 @@ protected:  // Hooks.
          _longName = newOpInstance; 
     }
 
+    //! Conditions flip for every Op while stepping, so repaints are
+    //! coalesced by the scene.
     virtual void
     conditionChanged(const NsOpObject::Condition cond)
     { 
         Q_UNUSED(cond);
-        update();
+        scheduleUpdate();
     }
 
     virtual void
@@ -290,17 +297,38 @@ private:
         }
     }
 
+    void
+    _updatePaintStyle(bool opEnabled);
+
 private:    
 
     static const bool _isMovable    = true;
     static const bool _isSelectable = true;
 
+    static int _paintStyleRevision;  //!< Bumped when preferences change.
+
 private:    // Member variables.
 
     NsOpObject  *_op;
     QString      _longName;
     NsUndoStack *_undoStack;
     qreal        _diameter;
+
+    // Paint style, derived from the Op condition, the enabled state and
+    // the preferences. Only rebuilt when one of them changes.
+
+    int                   _styleRevision;
+    NsOpObject::Condition _styleCondition;
+    bool                  _styleEnabled;
+    QBrush                _fillBrush;
+    QPen                  _linePen;
+    QPen                  _outlinePen;      //!< Wide pen behind selection.
+    QPen                  _selectionPen;
+    QPen                  _crossPen;        //!< Disabled Op cross.
+    QRectF                _shapeRect;       //!< Bounds of shape(), cached.
+
+    typedef QHash<QString, NsGraphPlugItem*> _PlugItemHashType;
+    mutable _PlugItemHashType _plugItemsByName;  //!< Plug name to plug item.
 };
 
 #endif // NS_GRAPH_OP_ITEM_H
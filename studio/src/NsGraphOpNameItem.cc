@@ -114,6 +114,10 @@ NsGraphOpNameItem::paint(QPainter                       *painter,
                          const QStyleOptionGraphicsItem *option,
                          QWidget                        *widget)
 {
+    if (isCoarseDetail(option, painter)) {
+        return;     // Labels can't be read when zoomed out.
+    }
+
     const QPen shapePen(NsPreferences::instance()->graphViewOpLineColor(), 2);
     const QBrush shapeBrush(NsPreferences::instance()->graphViewOpBackground());
     painter->setPen(shapePen);
@@ -48,11 +48,31 @@
 #include "NsGraphCallback.h"
 #include "NsGraphOpItemFactory.h"
 #include "NsGraphItem.h"
+#include "NsGraphOpItem.h"
 #include "NsGraphInputPlugItem.h"
 #include "NsGraphOutputPlugItem.h"
 #include "NsGraphFeedItem.h"
 #include "NsMessageWidget.h"
 #include <QDebug>
+#include <cmath>
+
+namespace {
+
+//! Side length of the spatial index cells, in scene units. Roughly the
+//! size of a few Op items.
+
+const qreal cellSize = 256.;
+
+//! Scene rectangle covered by an Op item and its plugs.
+
+QRectF
+opIndexRect(const NsGraphOpItem &opItem)
+{
+    return opItem.sceneBoundingRect() |
+           opItem.mapRectToScene(opItem.childrenBoundingRect());
+}
+
+}   // Namespace.
 
 // -----------------------------------------------------------------------------
 
@@ -77,6 +97,12 @@ NsGraphScene::NsGraphScene(NsUndoStack *undoStack, QObject *parent)
 {
     qDebug() << "NsGraphScene";   
 
+    // Scheduled item repaints are flushed at most every 40 ms.
+
+    _updateTimer.setSingleShot(true);
+    _updateTimer.setInterval(40);
+    connect(&_updateTimer, SIGNAL(timeout()), SLOT(_onUpdateTimeout()));
+
     _createOpItem(NsOpStore::instance()->mutableGlobalOp());
 
 
@@ -130,6 +156,99 @@ NsGraphScene::selectedOpItems()
     return selOpItems;
 }
 
+
+// scheduleItemUpdate
+// ------------------
+//! Repaint the given item when the update timer fires. Items that change
+//! many times in quick succession, e.g. Op conditions while stepping, are
+//! thus repainted once per timer interval rather than once per change.
+
+void
+NsGraphScene::scheduleItemUpdate(NsGraphItem *item)
+{
+    if (!_pendingUpdates.contains(item)) {
+        _pendingUpdates.insert(item, QPointer<NsGraphItem>(item));
+    }
+
+    if (!_updateTimer.isActive()) {
+        _updateTimer.start();
+    }
+}
+
+
+// updateFeedIndex
+// ---------------
+//! Re-insert the feed item into the spatial index after its path changed.
+
+void
+NsGraphScene::updateFeedIndex(NsGraphFeedItem *feedItem)
+{
+    if (_feedItems.value(feedItem->inputPlugItem(), 0) == feedItem) {
+        _indexItem(feedItem, feedItem->indexRect());
+    }
+}
+
+
+// querySelectableItems
+// --------------------
+//! Returns the selectable items whose shapes intersect the given scene
+//! polygon, i.e. the candidates for rubber-band selection. Only the Op and
+//! feed items in the index cells touched by the polygon are tested, along
+//! with their children.
+
+QList<QGraphicsItem*>
+NsGraphScene::querySelectableItems(const QPolygonF &scenePolygon) const
+{
+    QPainterPath path;
+    path.addPolygon(scenePolygon);
+    path.closeSubpath();
+
+    QList<QGraphicsItem*> hits;
+    foreach (NsGraphItem *item, _queryIndex(scenePolygon.boundingRect())) {
+        if (item->isItemSelectable() &&
+            item->collidesWithPath(item->mapFromScene(path),
+                                   Qt::IntersectsItemShape)) {
+            hits.append(item);
+        }
+
+        foreach (QGraphicsItem *child, item->childItems()) {
+            NsGraphItem *graphChild(dynamic_cast<NsGraphItem*>(child));
+
+            if (0 != graphChild && graphChild->isItemSelectable() &&
+                graphChild->collidesWithPath(graphChild->mapFromScene(path),
+                                             Qt::IntersectsItemShape)) {
+                hits.append(graphChild);
+            }
+        }
+    }
+
+    return hits;
+}
+
+
+// queryPlugItems
+// --------------
+//! Returns the plug items whose shapes contain the given scene position.
+
+QList<NsGraphPlugItem*>
+NsGraphScene::queryPlugItems(const QPointF &scenePos) const
+{
+    QList<NsGraphPlugItem*> hits;
+    foreach (NsGraphItem *item, _queryIndex(QRectF(scenePos, QSizeF(0, 0)))) {
+        NsGraphOpItem *opItem(qobject_cast<NsGraphOpItem*>(item));
+
+        if (0 != opItem) {
+            foreach (NsGraphPlugItem *plug, opItem->plugItems()) {
+                if (plug->contains(plug->mapFromScene(scenePos))) {
+                    hits.append(plug);
+                }
+            }
+        }
+    }
+
+    return hits;
+}
+
 // -----------------------------------------------------------------------------
 
 // onFeedChanged
@@ -170,6 +289,55 @@ NsGraphScene::onGraphCleared(const bool success)
     }
 }
 
+
+// onPreferencesChanged
+// --------------------
+//! Colors may have changed. Drop the cached Op paint styles and item
+//! pixmaps. [slot]
+
+void
+NsGraphScene::onPreferencesChanged()
+{
+    NsGraphOpItem::invalidatePaintStyles();
+
+    foreach (QGraphicsItem *item, items()) {
+        item->update();
+    }
+}
+
+
+// _onUpdateTimeout
+// ----------------
+//! Repaint all items scheduled since the last timeout. [slot]
+
+void
+NsGraphScene::_onUpdateTimeout()
+{
+    const _PendingHashType pending(_pendingUpdates);
+    _pendingUpdates.clear();
+
+    foreach (const QPointer<NsGraphItem> &item, pending) {
+        if (0 != item) {
+            item->update();     // Item may have been deleted.
+        }
+    }
+}
+
+
+// _onOpItemMoved
+// --------------
+//! Re-insert the moved Op item into the spatial index. [slot]
+
+void
+NsGraphScene::_onOpItemMoved()
+{
+    NsGraphOpItem *opItem(qobject_cast<NsGraphOpItem*>(sender()));
+
+    if (0 != opItem) {
+        _indexItem(opItem, opIndexRect(*opItem));
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 void
@@ -282,8 +450,12 @@ NsGraphScene::_createOpItem(NsOpObject *op)
             connect(op,     SIGNAL(positionChanged(qreal,qreal)),
                     opItem, SLOT(onPositionChanged(qreal,qreal)));
 
+            connect(opItem, SIGNAL(xChanged()), SLOT(_onOpItemMoved()));
+            connect(opItem, SIGNAL(yChanged()), SLOT(_onOpItemMoved()));
+
             addItem(opItem);    // Pass ownership to graph.
             _opItems.insert(op->handle(), opItem);
+            _indexItem(opItem, opIndexRect(*opItem));
         }
         else {
             NsMessageWidget::instance()->clientWarning(
@@ -309,6 +481,15 @@ NsGraphScene::_eraseOpItem(NsOpObject *op)
     _OpItemHashType::iterator iter(_opItems.find(op->handle()));
 
     if (_opItems.end() != iter) {
+        // Feed items must not outlive the plugs they connect.
+
+        foreach (NsGraphFeedItem *feedItem, _feedItems) {
+            if (feedItem->inputPlugItem()->opItem() == iter.value() ||
+                feedItem->plugItem()->opItem() == iter.value()) {
+                _eraseItem(feedItem);
+            }
+        }
+
         _eraseItem(iter.value());
         _opItems.erase(iter);       // Remove association.
     }
@@ -380,6 +561,8 @@ NsGraphScene::_createFeedItem(const QString &inputLongName,
                 feedItem,        SLOT(onPathChanged()));
 
         addItem(feedItem);    // Pass ownership to graph.
+        _feedItems.insert(input, feedItem);
+        _indexItem(feedItem, feedItem->indexRect());
     }
 }
 
@@ -396,8 +579,8 @@ NsGraphScene::_eraseFeedItem(const QString &inputLongName)
 
 // _findInputPlugItem
 // ------------------
-//! Search for the given input plug in Op items. Returns null if the plug
-//! cannot be found.
+//! Look up the given input plug through its Op item. Returns null if the
+//! plug cannot be found.
 
 NsGraphInputPlugItem*
 NsGraphScene::_findInputPlugItem(const QString &inputLongName) const
@@ -423,27 +606,13 @@ NsGraphScene::_findInputPlugItem(const QString &inputLongName) const
         }
     }
 
-    //foreach (QGraphicsItem *item, items()) {
-    //    NsGraphOpItem *opItem(dynamic_cast<NsGraphOpItem*>(item));
-
-    //    if (0 != opItem) {
-    //        // Search for input plugs in Op items.
-
-    //        NsGraphInputPlugItem *plug(opItem->inputPlugItem(inputLongName));
-
-    //        if (0 != plug) {
-    //            return plug;    // Plug found, we are done!
-    //        }
-    //    }
-    //}
-
     return 0;   // No matching plug found, return null.
 }
 
 
 // _findPlugItem
 // -------------
-//! Search for the given plug in Op items. Returns null if the plug
+//! Look up the given plug through its Op item. Returns null if the plug
 //! cannot be found.
 
 NsGraphPlugItem*
@@ -470,40 +639,19 @@ NsGraphScene::_findPlugItem(const QString &plugLongName) const
         }
     }
 
-    //foreach (QGraphicsItem *item, items()) {
-    //    NsGraphOpItem *opItem(dynamic_cast<NsGraphOpItem*>(item));
-
-    //    if (0 != opItem) {
-    //        // Search for output plugs in Op items.
-
-    //        NsGraphPlugItem *plug(opItem->plugItem(plugLongName));
-
-    //        if (0 != plug) {
-    //            return plug;    // Plug found, we are done!
-    //        }
-    //    }
-    //}
-
     return 0;   // No matching plug found, return null.
 }
 
 
 // _findFeedItem
 // -------------
-//! DOCS
+//! Returns null if no feed is connected to the given input.
 
 NsGraphFeedItem*
 NsGraphScene::_findFeedItem(const QString &inputLongName) const
 {
-    foreach (QGraphicsItem *item, items()) {
-        NsGraphFeedItem *feedItem(dynamic_cast<NsGraphFeedItem*>(item));
-
-        if (0 != feedItem && feedItem->longName() == inputLongName) {
-            return feedItem;
-        }
-    }
-
-    return 0;   // Not found.
+    NsGraphInputPlugItem *input(_findInputPlugItem(inputLongName));
+    return (0 != input ? _feedItems.value(input, 0) : 0);
 }
 
 // -----------------------------------------------------------------------------
@@ -515,6 +663,16 @@ NsGraphScene::_findFeedItem(const QString &inputLongName) const
 void
 NsGraphScene::_eraseItem(NsGraphItem *item)
 {
+    NsGraphFeedItem *feedItem(qobject_cast<NsGraphFeedItem*>(item));
+
+    if (0 != feedItem &&
+        _feedItems.value(feedItem->inputPlugItem(), 0) == feedItem) {
+        _feedItems.remove(feedItem->inputPlugItem());
+    }
+
+    _unindexItem(item);
+    _pendingUpdates.remove(item);
+
     removeItem(item);       // Remove from scene.
     emit itemRemoved(item); // Notify.
     delete item;            // Make sure memory is deallocated.
@@ -523,23 +681,162 @@ NsGraphScene::_eraseItem(NsGraphItem *item)
 
 // _topLevelItems
 // --------------
-//! Returns a list of the top-level items in the scene.
+//! Returns a list of the top-level items managed by the scene, i.e. the Op
+//! and feed items.
 
 QList<QGraphicsItem*>
 NsGraphScene::_topLevelItems() const
 {
     QList<QGraphicsItem*> tli;
-    foreach (QGraphicsItem *item, items()) {
-        if (_isTopLevel(item)) {
-            tli.append(item);
-        }
+    foreach (NsGraphOpItem *opItem, _opItems) {
+        tli.append(opItem);
+    }
+
+    foreach (NsGraphFeedItem *feedItem, _feedItems) {
+        tli.append(feedItem);
     }
-    
+
     return tli;
 }
 
 // -----------------------------------------------------------------------------
 
+// _indexItem
+// ----------
+//! Insert the item into the index cells overlapping the given scene
+//! rectangle. Cells are only touched if the covered range changed.
+
+void
+NsGraphScene::_indexItem(NsGraphItem *item, const QRectF &sceneRect)
+{
+    const QRect range(_cellRange(sceneRect));
+
+    _CellRangeHashType::iterator iter(_cellRanges.find(item));
+
+    if (_cellRanges.end() != iter) {
+        if (iter.value() == range) {
+            return;     // Still in the same cells, nothing to do.
+        }
+
+        _unindexItem(item);
+    }
+
+    for (int i = range.left(); i <= range.right(); ++i) {
+        for (int j = range.top(); j <= range.bottom(); ++j) {
+            _cells[_cellKey(i, j)].append(item);
+        }
+    }
+
+    _cellRanges.insert(item, range);
+}
+
+
+// _unindexItem
+// ------------
+//! Remove the item from all index cells. Does nothing if the item is not
+//! indexed.
+
+void
+NsGraphScene::_unindexItem(NsGraphItem *item)
+{
+    _CellRangeHashType::iterator iter(_cellRanges.find(item));
+
+    if (_cellRanges.end() != iter) {
+        const QRect range(iter.value());
+
+        for (int i = range.left(); i <= range.right(); ++i) {
+            for (int j = range.top(); j <= range.bottom(); ++j) {
+                _CellHashType::iterator cell(_cells.find(_cellKey(i, j)));
+
+                if (_cells.end() != cell) {
+                    cell.value().removeOne(item);
+
+                    if (cell.value().isEmpty()) {
+                        _cells.erase(cell);
+                    }
+                }
+            }
+        }
+
+        _cellRanges.erase(iter);
+    }
+}
+
+
+// _queryIndex
+// -----------
+//! Returns the indexed items whose index rectangles may overlap the given
+//! scene rectangle. Each item is returned once.
+
+QList<NsGraphItem*>
+NsGraphScene::_queryIndex(const QRectF &sceneRect) const
+{
+    const QRect range(_cellRange(sceneRect));
+
+    QList<NsGraphItem*> result;
+    QSet<NsGraphItem*> visited;
+
+    if (qint64(range.width())*range.height() > _cells.size()) {
+        // Query covers more cells than are occupied, e.g. a rubber-band
+        // over a zoomed out view. Visit the occupied cells instead.
+
+        for (_CellHashType::const_iterator cell = _cells.begin();
+             cell != _cells.end();
+             ++cell) {
+            const int i(int(cell.key() >> 32));
+            const int j(int(quint32(cell.key())));
+
+            if (range.contains(i, j)) {
+                foreach (NsGraphItem *item, cell.value()) {
+                    if (!visited.contains(item)) {
+                        visited.insert(item);
+                        result.append(item);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    for (int i = range.left(); i <= range.right(); ++i) {
+        for (int j = range.top(); j <= range.bottom(); ++j) {
+            _CellHashType::const_iterator cell(_cells.find(_cellKey(i, j)));
+
+            if (_cells.end() != cell) {
+                foreach (NsGraphItem *item, cell.value()) {
+                    if (!visited.contains(item)) {
+                        visited.insert(item);
+                        result.append(item);
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+// _cellRange
+// ----------
+//! Returns the inclusive range of index cells overlapped by the given
+//! scene rectangle. [static]
+
+QRect
+NsGraphScene::_cellRange(const QRectF &sceneRect)
+{
+    const QRectF r(sceneRect.normalized());
+
+    return QRect(
+        QPoint(static_cast<int>(std::floor(r.left()/cellSize)),
+               static_cast<int>(std::floor(r.top()/cellSize))),
+        QPoint(static_cast<int>(std::floor(r.right()/cellSize)),
+               static_cast<int>(std::floor(r.bottom()/cellSize))));
+}
+
+// -----------------------------------------------------------------------------
+
 // _isTopLevel
 // -----------
 //! Returns true if the provided item is top-level. [static]
@@ -89,6 +89,18 @@ public:
     QList<NsGraphOpItem*>
     selectedOpItems();
 
+    void
+    scheduleItemUpdate(NsGraphItem *item);
+
+    void
+    updateFeedIndex(NsGraphFeedItem *feedItem);
+
+    QList<QGraphicsItem*>
+    querySelectableItems(const QPolygonF &scenePolygon) const;
+
+    QList<NsGraphPlugItem*>
+    queryPlugItems(const QPointF &scenePos) const;
+
 protected slots:
 
     void
@@ -107,6 +119,17 @@ protected slots:
     void
     onGraphCleared(bool success);
 
+    void
+    onPreferencesChanged();
+
+private slots:
+
+    void
+    _onUpdateTimeout();
+
+    void
+    _onOpItemMoved();
+
 protected:
 
     virtual void
@@ -150,8 +173,6 @@ private:    // Feed items.
     _eraseFeedItem(const QString &inputLongName);
 
 
-    // TODO: These are not nicely implemented...
-
     NsGraphFeedItem*
     _findFeedItem(const QString &inputLongName) const;
 
@@ -169,6 +190,24 @@ private:
     QList<QGraphicsItem*>
     _topLevelItems() const;
 
+private:    // Spatial index.
+
+    void
+    _indexItem(NsGraphItem *item, const QRectF &sceneRect);
+
+    void
+    _unindexItem(NsGraphItem *item);
+
+    QList<NsGraphItem*>
+    _queryIndex(const QRectF &sceneRect) const;
+
+    static QRect
+    _cellRange(const QRectF &sceneRect);
+
+    static quint64
+    _cellKey(int i, int j)
+    { return (quint64(quint32(i)) << 32) | quint64(quint32(j)); }
+
 private:
 
     static bool
@@ -179,6 +218,21 @@ private:    // Member variables.
     typedef QHash<NsValueObjectHandle, NsGraphOpItem*> _OpItemHashType;
     _OpItemHashType _opItems;
 
+    typedef QHash<NsGraphInputPlugItem*, NsGraphFeedItem*> _FeedItemHashType;
+    _FeedItemHashType _feedItems;   //!< Feed items by input plug.
+
+    // Uniform grid over the scene holding the op and feed items, so that
+    // hit tests only visit the items in the cells they touch.
+
+    typedef QHash<quint64, QList<NsGraphItem*> > _CellHashType;
+    typedef QHash<NsGraphItem*, QRect>           _CellRangeHashType;
+    _CellHashType      _cells;
+    _CellRangeHashType _cellRanges;     //!< Cells currently covered by item.
+
+    typedef QHash<NsGraphItem*, QPointer<NsGraphItem> > _PendingHashType;
+    _PendingHashType _pendingUpdates;   //!< Items waiting to be repainted.
+    QTimer           _updateTimer;
+
     NsUndoStack *_undoStack;
 };
 
@@ -557,11 +557,14 @@ NsGraphView::mousePressEvent(QMouseEvent *event)
             }
             else {
                 if (lmb) {
-                    foreach (QGraphicsItem *item, items(event->pos())) {
-                        NsGraphPlugItem *plugItem =
-                            dynamic_cast<NsGraphPlugItem *>(item);
-                        if (0 != plugItem &&
-                            validateFeedPlugs(*plugItem, *pendingPlug())) {
+                    QList<NsGraphPlugItem*> plugItems;
+                    if (0 != graphScene()) {
+                        plugItems = graphScene()->queryPlugItems(
+                            mapToScene(event->pos()));
+                    }
+
+                    foreach (NsGraphPlugItem *plugItem, plugItems) {
+                        if (validateFeedPlugs(*plugItem, *pendingPlug())) {
                             commitPendingFeed(*plugItem);
                             break;  // Valid plug found, we are done!
                         }
@@ -882,9 +885,7 @@ NsGraphView::dragSelect(const QMouseEvent &event)
         // Get list of items with shapes intersecting the drag rectangle.
 
         const QList<QGraphicsItem*> rectItems =
-            graphScene()->items(mapToScene(dragRect),
-                                Qt::IntersectsItemShape,
-                                Qt::AscendingOrder);
+            graphScene()->querySelectableItems(mapToScene(dragRect));
 
         // Select or toggle selection for new items in rubberband rect.
 
@@ -939,11 +940,11 @@ NsGraphView::dragPendingFeed(const QMouseEvent &event)
                    mapToScene(event.pos())));
 
         bool reset = true;
-        foreach (QGraphicsItem *item, items(event.pos())) {
+        foreach (NsGraphPlugItem *plugItem,
+                 gs->queryPlugItems(mapToScene(event.pos()))) {
             // Check for plug items underneath the mouse cursor.
 
-            NsGraphPlugItem *plugItem(dynamic_cast<NsGraphPlugItem*>(item));
-            if (0 != plugItem && plugItem != pendingPlug()) {
+            if (plugItem != pendingPlug()) {
                 // Item underneath the mouse is a plug and it is not the
                 // pending plug.
 
@@ -59,6 +59,7 @@
 #include "NsHelpView.h"
 #include "NsValueEditorWidget.h"
 #include "NsMessageWidget.h"
+#include "NsStepProfilerWidget.h"
 
 #include "NsTimeToolBar.h"
 
@@ -1298,6 +1299,8 @@ NsMainWindow::_createMenus()
     _3DViewMenu->addAction(_drawAxesAction);
     _3DViewMenu->addAction(_3DView->drawItemLabelsAction());
     _3DViewMenu->addAction(_3DView->drawBodyLabelsAction());
+    _3DViewMenu->addAction(_3DView->drawTimingsAction());
+    _3DViewMenu->addAction(_3DView->exportTimingsAction());
     _3DViewMenu->addSeparator();
     _3DViewMenu->addAction(_3DView->nullManipAction());
     _3DViewMenu->addAction(_3DView->translateManipAction());
@@ -1521,7 +1524,22 @@ NsMainWindow::_createDockWidgets()
             Qt::AllDockWidgetAreas));
     addDockWidget(Qt::BottomDockWidgetArea, dockHistory);
 
-    tabifyDockWidget(dockHistory, dockMsg);
+    // Stepping profiler.
+
+    NsDockWidget *dockProfiler(
+        _createDockWidget(
+            "Profiler", 
+            this, 
+            0, 
+            new NsStepProfilerWidget,
+            QDockWidget::DockWidgetClosable |
+            QDockWidget::DockWidgetMovable  |
+            QDockWidget::DockWidgetFloatable,
+            Qt::AllDockWidgetAreas));
+    addDockWidget(Qt::BottomDockWidgetArea, dockProfiler);
+
+    tabifyDockWidget(dockHistory, dockProfiler);
+    tabifyDockWidget(dockProfiler, dockMsg);
 }
 
 // -----------------------------------------------------------------------------
@@ -1768,9 +1786,12 @@ NsMainWindow::_saveGraph(const QString &fileName, const QString &format)
 
     const QString msg("This " + format + " was generated by Naiad Studio");
 
-    NiExportGraph(fromQStr(QFileInfo(fileName).absoluteFilePath()),
-                  fromQStr(msg),
-                  fromQStr(format));
+    {
+        const NsGraphCallback::NiLocker locker;
+        NiExportGraph(fromQStr(QFileInfo(fileName).absoluteFilePath()),
+                      fromQStr(msg),
+                      fromQStr(format));
+    }
     saved = true;
 
     NsMessageWidget::instance()->clientInfo(
@@ -1850,8 +1871,12 @@ NsMainWindow::_openGraph(const QString &fileName)
     //_graphScene->setItemIndexMethod(QGraphicsScene::NoIndex);
     _3DView->setUpdatesEnabled(false);
 
-    NsParserCallback pcb(false);
-    NiParseFile(fromQStr(info.absoluteFilePath()), &pcb);
+    {
+        const NsGraphCallback::NiLocker locker;
+        NsParserCallback pcb(false, 0, true);
+        NiParseFile(fromQStr(info.absoluteFilePath()), &pcb);
+        pcb.endBulkLoad();
+    }
 
     _3DView->setUpdatesEnabled(true);
     //_graphScene->blockSignals(false);
@@ -2116,6 +2141,11 @@ NsMainWindow::_createGraphScene(NsUndoStack *undoStack, QObject *parent)
 
     connect(NsCmdCentral::instance(), SIGNAL(graphCleared(bool)),
             scene,                    SLOT(onGraphCleared(bool)));
+
+    // Connect Graph Scene to preferences.
+
+    connect(NsPreferences::instance(), SIGNAL(changed()),
+            scene,                     SLOT(onPreferencesChanged()));
     
     return scene;
 }
@@ -2254,6 +2284,11 @@ NsMainWindow::_create3DView(Ns3DScene *scene, QWidget *parent)
             view,
             SLOT(update()));
 
+    connect(NsCmdCentral::instance(),
+            SIGNAL(graphLoaded(QStringList,bool)),
+            view,
+            SLOT(update()));
+
     // Connect 3D View to Graph Callback.
 
     connect(NsGraphCallback::instance(), SIGNAL(endFrame(NtTimeBundle)),
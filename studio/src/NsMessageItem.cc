@@ -42,33 +42,28 @@
 
 // -----------------------------------------------------------------------------
 
-// NsMessageItem
-// -------------
-//! CTOR.
-
-NsMessageItem::NsMessageItem(const QStringList &strings,
-                             const Type         type,
-                             const QString     &vobName)
-    : QTreeWidgetItem(strings, type)
-    , _vobName(vobName)
-{
-    setIcon(0, _msgTypeIcon(type));
-}
-
-// -----------------------------------------------------------------------------
+// typeIcon
+// --------
+//! Returns the icon for the given message type. Icons are created once and 
+//! shared between all rows. [static]
 
 QIcon
-NsMessageItem::_msgTypeIcon(const Type type)
+NsMessageItem::typeIcon(const Type type)
 {
+    static const QIcon warningIcon(":/images/warning-16.png");
+    static const QIcon errorIcon(":/images/error-16.png");
+    static const QIcon internalErrorIcon(":/images/internal-error-16.png");
+    static const QIcon emptyIcon(":/images/empty-16.png");
+
     switch (type) {
     case Warning:
-        return QIcon(":/images/warning-16.png");
+        return warningIcon;
     case Error:
-        return QIcon(":/images/error-16.png");
+        return errorIcon;
     case InternalError:
-        return QIcon(":/images/internal-error-16.png");
+        return internalErrorIcon;
     case Info:  // TODO: Info icon??
     default:
-        return QIcon(":/images/empty-16.png");
+        return emptyIcon;
     }
 }
@@ -41,49 +41,68 @@
 #ifndef NS_MESSAGE_ITEM_H
 #define NS_MESSAGE_ITEM_H
 
-#include <QTreeWidgetItem>
+#include <QString>
 #include <QIcon>
 
 // -----------------------------------------------------------------------------
 
-class NsMessageItem : public QTreeWidgetItem
+// NsMessageItem
+// -------------
+//! A single row in the message log. Items are plain values stored in the 
+//! chunks of an NsMessageModel, no widgets are created per message. The 
+//! value-object name is stored as an index into the model's name table.
+
+class NsMessageItem
 {
 public:
 
     //! Message type.
     enum Type {
-        Info = QTreeWidgetItem::UserType,
+        Info = 0,
         Warning,
         Error,
-        InternalError
+        InternalError,
+        TypeCount
     };
 
 public:
 
-    explicit
-    NsMessageItem(const QStringList &strings,
-                  Type               type,
-                  const QString     &vobName = QString());
+    //! CTOR.
+    NsMessageItem()
+        : _vobIndex(-1)
+        , _type(Info)
+    {}
 
-    //! DTOR.
-    virtual
-    ~NsMessageItem()
+    //! CTOR.
+    NsMessageItem(const QString &text, const Type type, const int vobIndex)
+        : _text(text)
+        , _vobIndex(vobIndex)
+        , _type(type)
     {}
 
 public:
 
     const QString&
-    vobName() const
-    { return _vobName; }
+    text() const
+    { return _text; }
+
+    //! Index into the owning model's value-object name table, -1 if none.
+    int
+    vobIndex() const
+    { return _vobIndex; }
 
-private:
+    Type
+    type() const
+    { return static_cast<Type>(_type); }
 
     static QIcon
-    _msgTypeIcon(Type type);
+    typeIcon(Type type);
 
 private:    // Member variables.
 
-    QString _vobName;
+    QString _text;      //!< Message text, newlines already replaced.
+    qint32  _vobIndex;  //!< Value-object name index.
+    quint8  _type;      //!< Message type.
 };
 
 #endif // NS_MESSAGE_ITEM_H
@@ -0,0 +1,388 @@
+// -----------------------------------------------------------------------------
+//
+// NsMessageModel.cc
+//
+// Naiad Studio message model, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB. All rights reserved.
+//
+// This file is part of Open Naiad Studio.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "NsMessageModel.h"
+#include <QTimer>
+
+// -----------------------------------------------------------------------------
+
+// NsMessageModel
+// --------------
+//! CTOR.
+
+NsMessageModel::NsMessageModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , _msgCount(0)
+    , _publishedRows(0)
+    , _flushPending(false)
+    , _vobFilterIndex(-1)
+{
+    for (int t = 0; t < NsMessageItem::TypeCount; ++t) {
+        _typeHidden[t] = false;
+    }
+}
+
+
+// ~NsMessageModel
+// ---------------
+//! DTOR.
+
+NsMessageModel::~NsMessageModel()
+{
+    qDeleteAll(_chunks);
+}
+
+// -----------------------------------------------------------------------------
+
+// rowCount
+// --------
+//! Returns the number of visible rows that have been announced to views.
+
+int
+NsMessageModel::rowCount(const QModelIndex &parent) const
+{
+    return (parent.isValid() ? 0 : _publishedRows);
+}
+
+
+// data
+// ----
+//! Returns data for the given row. Display strings are built on demand, 
+//! only for rows that a view actually needs to draw.
+
+QVariant
+NsMessageModel::data(const QModelIndex &index, const int role) const
+{
+    if (!index.isValid() || index.row() >= _publishedRows) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return displayText(index.row());
+    case Qt::DecorationRole:
+        return NsMessageItem::typeIcon(item(index.row()).type());
+    case VobNameRole:
+        return vobName(index.row());
+    case TypeRole:
+        return static_cast<int>(item(index.row()).type());
+    default:
+        return QVariant();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// append
+// ------
+//! Adds a message to the end of the log. Cost is constant, views are 
+//! notified about new rows later, in batches.
+
+void
+NsMessageModel::append(const QString             &text,
+                       const NsMessageItem::Type  type,
+                       const QString             &vobName)
+{
+    if (_chunks.isEmpty() || _chunks.last()->size() == _chunkSize) {
+        _Chunk *chunk(new _Chunk);
+        chunk->reserve(_chunkSize);
+        _chunks.append(chunk);
+    }
+
+    const int vobIndex(_internVobName(vobName));
+    QString itemText(text);
+    const NsMessageItem msg(itemText.replace('\n', ' '), type, vobIndex);
+
+    const int msgIndex(_msgCount++);
+    _chunks.last()->append(msg);
+    _typeRows[type].append(msgIndex);
+    if (0 <= vobIndex) {
+        _vobRows[vobIndex].append(msgIndex);
+    }
+
+    if (_isVisible(msg)) {
+        _visibleRows.append(msgIndex);
+        if (!_flushPending) {
+            _flushPending = true;
+            QTimer::singleShot(0, this, SLOT(_flush()));
+        }
+    }
+}
+
+
+// clear
+// -----
+//! Removes all messages.
+
+void
+NsMessageModel::clear()
+{
+    beginResetModel();
+    qDeleteAll(_chunks);
+    _chunks.clear();
+    _msgCount = 0;
+    _vobNames.clear();
+    _vobNameIndex.clear();
+    _vobRows.clear();
+    for (int t = 0; t < NsMessageItem::TypeCount; ++t) {
+        _typeRows[t].clear();
+    }
+    _visibleRows.clear();
+    _publishedRows = 0;
+
+    // Keep the filter, interned so that messages without a value-object
+    // never match it.
+
+    _vobFilterIndex = _internVobName(_vobFilter);
+    endResetModel();
+}
+
+
+// item
+// ----
+//! Returns the message shown at the given visible row.
+
+const NsMessageItem&
+NsMessageModel::item(const int row) const
+{
+    return _message(_visibleRows[row]);
+}
+
+
+// vobName
+// -------
+//! Returns the value-object name of the message at the given visible row.
+
+QString
+NsMessageModel::vobName(const int row) const
+{
+    const int vobIndex(item(row).vobIndex());
+    return (0 <= vobIndex ? _vobNames[vobIndex] : QString());
+}
+
+
+// displayText
+// -----------
+//! Returns the text shown for the given visible row.
+
+QString
+NsMessageModel::displayText(const int row) const
+{
+    const NsMessageItem &msg(item(row));
+    if (0 <= msg.vobIndex()) {
+        return _vobNames[msg.vobIndex()] + ": " + msg.text();
+    }
+    return msg.text();
+}
+
+
+// isTypeHidden
+// ------------
+//! Returns true if messages of the given type are filtered out.
+
+bool
+NsMessageModel::isTypeHidden(const NsMessageItem::Type type) const
+{
+    return _typeHidden[type];
+}
+
+
+// setTypeHidden
+// -------------
+//! Shows or hides messages of the given type.
+
+void
+NsMessageModel::setTypeHidden(const NsMessageItem::Type type, const bool hidden)
+{
+    if (_typeHidden[type] != hidden) {
+        _typeHidden[type] = hidden;
+        _rebuildVisible();
+    }
+}
+
+
+// setVobFilter
+// ------------
+//! Shows only messages from the given value-object. An empty name shows 
+//! messages from all value-objects.
+
+void
+NsMessageModel::setVobFilter(const QString &vobName)
+{
+    if (_vobFilter != vobName) {
+        _vobFilter = vobName;
+        _vobFilterIndex = _internVobName(vobName);
+        _rebuildVisible();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// _flush
+// ------
+//! Announces rows appended since the last flush to views. [slot]
+
+void
+NsMessageModel::_flush()
+{
+    _flushPending = false;
+    if (_publishedRows < _visibleRows.size()) {
+        beginInsertRows(QModelIndex(), _publishedRows, _visibleRows.size() - 1);
+        _publishedRows = _visibleRows.size();
+        endInsertRows();
+        emit rowsAppended();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// _message
+// --------
+//! Returns the message with the given storage index.
+
+const NsMessageItem&
+NsMessageModel::_message(const int msgIndex) const
+{
+    return _chunks[msgIndex / _chunkSize]->at(msgIndex % _chunkSize);
+}
+
+
+// _internVobName
+// --------------
+//! Returns the index of the given value-object name in the name table, 
+//! adding it if necessary. Returns -1 for an empty name. A non-empty
+//! filter is always interned, so its index is never -1.
+
+int
+NsMessageModel::_internVobName(const QString &vobName)
+{
+    if (vobName.isEmpty()) {
+        return -1;
+    }
+
+    QHash<QString, int>::const_iterator iter(_vobNameIndex.find(vobName));
+    if (iter != _vobNameIndex.end()) {
+        return iter.value();
+    }
+
+    const int vobIndex(_vobNames.size());
+    _vobNames.append(vobName);
+    _vobNameIndex.insert(vobName, vobIndex);
+    _vobRows.append(QVector<int>());
+    if (vobName == _vobFilter) {
+        _vobFilterIndex = vobIndex;
+    }
+    return vobIndex;
+}
+
+
+// _isVisible
+// ----------
+//! Returns true if the given message passes the current filters.
+
+bool
+NsMessageModel::_isVisible(const NsMessageItem &msg) const
+{
+    if (_typeHidden[msg.type()]) {
+        return false;
+    }
+    if (!_vobFilter.isEmpty() && msg.vobIndex() != _vobFilterIndex) {
+        return false;
+    }
+    return true;
+}
+
+
+// _rebuildVisible
+// ---------------
+//! Rebuilds the visible rows from the type and value-object indices. Only 
+//! the indices of messages that pass the filters are visited.
+
+void
+NsMessageModel::_rebuildVisible()
+{
+    beginResetModel();
+    _visibleRows.clear();
+
+    if (!_vobFilter.isEmpty()) {
+        if (0 <= _vobFilterIndex) {
+            const QVector<int> &rows(_vobRows[_vobFilterIndex]);
+            _visibleRows.reserve(rows.size());
+            for (int i = 0; i < rows.size(); ++i) {
+                if (!_typeHidden[_message(rows[i]).type()]) {
+                    _visibleRows.append(rows[i]);
+                }
+            }
+        }
+    }
+    else {
+        // Merge the sorted per-type index lists of the shown types.
+
+        const QVector<int> *lists[NsMessageItem::TypeCount];
+        int pos[NsMessageItem::TypeCount];
+        int listCount(0);
+        int total(0);
+        for (int t = 0; t < NsMessageItem::TypeCount; ++t) {
+            if (!_typeHidden[t] && !_typeRows[t].isEmpty()) {
+                lists[listCount] = &_typeRows[t];
+                pos[listCount] = 0;
+                total += _typeRows[t].size();
+                ++listCount;
+            }
+        }
+
+        _visibleRows.reserve(total);
+        while (_visibleRows.size() < total) {
+            int best(-1);
+            for (int l = 0; l < listCount; ++l) {
+                if (pos[l] < lists[l]->size() &&
+                    (best < 0 ||
+                     lists[l]->at(pos[l]) < lists[best]->at(pos[best]))) {
+                    best = l;
+                }
+            }
+            _visibleRows.append(lists[best]->at(pos[best]++));
+        }
+    }
+
+    _publishedRows = _visibleRows.size();
+    endResetModel();
+}
@@ -0,0 +1,181 @@
+// -----------------------------------------------------------------------------
+//
+// NsMessageModel.h
+//
+// Naiad Studio message model, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB. All rights reserved.
+//
+// This file is part of Open Naiad Studio.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS_MESSAGE_MODEL_H
+#define NS_MESSAGE_MODEL_H
+
+#include "NsMessageItem.h"
+#include <QAbstractListModel>
+#include <QVector>
+#include <QHash>
+#include <QString>
+
+// -----------------------------------------------------------------------------
+
+// NsMessageModel
+// --------------
+//! Item model holding the message log. Messages are stored in fixed-size 
+//! chunks so that appending never copies previously stored messages, and 
+//! display data is produced on demand when a view asks for it. Rows are 
+//! indexed by message type and by value-object name, which makes changing 
+//! the filter independent of the number of hidden messages.
+//!
+//! Appended messages are announced to views in batches, once per event loop
+//! iteration, rather than one row at a time.
+
+class NsMessageModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+
+    //! Custom item data roles.
+    enum Role {
+        VobNameRole = Qt::UserRole + 1,
+        TypeRole
+    };
+
+public:
+
+    explicit
+    NsMessageModel(QObject *parent = 0);
+
+    virtual
+    ~NsMessageModel();
+
+public:     // QAbstractItemModel interface.
+
+    virtual int
+    rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    virtual QVariant
+    data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+public:
+
+    void
+    append(const QString       &text,
+           NsMessageItem::Type  type,
+           const QString       &vobName = QString());
+
+    void
+    clear();
+
+    //! Returns the total number of stored messages, including hidden ones.
+    int
+    messageCount() const
+    { return _msgCount; }
+
+    const NsMessageItem&
+    item(int row) const;
+
+    QString
+    vobName(int row) const;
+
+    QString
+    displayText(int row) const;
+
+    bool
+    isTypeHidden(NsMessageItem::Type type) const;
+
+    void
+    setTypeHidden(NsMessageItem::Type type, bool hidden);
+
+    //! Returns the value-object name rows are filtered by, empty if none.
+    const QString&
+    vobFilter() const
+    { return _vobFilter; }
+
+    void
+    setVobFilter(const QString &vobName);
+
+signals:
+
+    //! Emitted after a batch of appended rows has been made visible to views.
+    void
+    rowsAppended();
+
+private slots:
+
+    void
+    _flush();
+
+private:
+
+    static const int _chunkSize = 4096; //!< Messages per storage chunk.
+
+    typedef QVector<NsMessageItem> _Chunk;
+
+    const NsMessageItem&
+    _message(int msgIndex) const;
+
+    int
+    _internVobName(const QString &vobName);
+
+    bool
+    _isVisible(const NsMessageItem &msg) const;
+
+    void
+    _rebuildVisible();
+
+private:    // Member variables.
+
+    QVector<_Chunk*> _chunks;   //!< Message storage, never reallocated.
+    int              _msgCount; //!< Total number of stored messages.
+
+    QVector<QString>    _vobNames;      //!< Interned value-object names.
+    QHash<QString, int> _vobNameIndex;  //!< Name to index in _vobNames.
+
+    //! Message indices per type, in message order.
+    QVector<int> _typeRows[NsMessageItem::TypeCount];
+
+    //! Message indices per value-object name index, in message order.
+    QVector<QVector<int> > _vobRows;
+
+    QVector<int> _visibleRows;      //!< Message indices of visible rows.
+    int          _publishedRows;    //!< Number of rows announced to views.
+    bool         _flushPending;     //!< True if a flush has been scheduled.
+
+    bool    _typeHidden[NsMessageItem::TypeCount];  //!< Type filters.
+    QString _vobFilter;         //!< Value-object name filter, empty if none.
+    int     _vobFilterIndex;    //!< Interned index of _vobFilter, or -1.
+};
+
+#endif // NS_MESSAGE_MODEL_H
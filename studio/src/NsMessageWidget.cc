@@ -40,6 +40,7 @@
 
 #include "NsMessageWidget.h"
 #include "NsMessageFilterAction.h"
+#include "NsMessageModel.h"
 #include "NsOpStore.h"
 #include "NsOpObject.h"
 #include "NsCmdCentral.h"
@@ -48,7 +49,7 @@
 #include <QHeaderView>
 #include <QApplication>
 #include <QClipboard>
-#include <QTreeWidgetItemIterator>
+#include <QScrollBar>
 
 // -----------------------------------------------------------------------------
 
@@ -90,21 +91,26 @@ NsMessageWidget *NsMessageWidget::_instance(0);
 //! CTOR.
 
 NsMessageWidget::NsMessageWidget(QWidget *parent)
-    : QTreeWidget(parent)
+    : QTreeView(parent)
+    , _model(new NsMessageModel(this))  // Child.
 {
+    setModel(_model);
     setSelectionMode(ExtendedSelection);
     setSelectionBehavior(SelectRows);
     setRootIsDecorated(false);
     setAllColumnsShowFocus(true);
+    setUniformRowHeights(true); // Avoids measuring every row on scroll.
 
     header()->hide();
 
     _createActions();
     setContextMenuPolicy(Qt::ActionsContextMenu);
 
-    connect(this,
-            SIGNAL(itemSelectionChanged()),
+    connect(selectionModel(),
+            SIGNAL(selectionChanged(QItemSelection,QItemSelection)),
             SLOT(onItemSelectionChanged()));
+    connect(_model, SIGNAL(modelReset()), SLOT(onItemSelectionChanged()));
+    connect(_model, SIGNAL(rowsAppended()), SLOT(onRowsAppended()));
     onItemSelectionChanged();
 
     connect(_cb.notifier(), SIGNAL(info()),    SLOT(_pollServerInfo()));
@@ -198,9 +204,29 @@ NsMessageWidget::serverError(const QString &text, const QString &vobName)
 void
 NsMessageWidget::onItemSelectionChanged()
 {
-    const bool actionsEnabled = !selectedItems().isEmpty();
+    const bool actionsEnabled = selectionModel()->hasSelection();
     _copyAction->setEnabled(actionsEnabled);
     _selectAction->setEnabled(actionsEnabled);
+    _filterOpAction->setEnabled(
+        _filterOpAction->isChecked() ||
+        (selectionModel()->currentIndex().isValid() &&
+         !_model->vobName(selectionModel()->currentIndex().row()).isEmpty()));
+}
+
+
+// onRowsAppended
+// --------------
+//! Makes the most recent message current and scrolls to it. Called once per
+//! batch of appended messages rather than once per message. [slot]
+
+void
+NsMessageWidget::onRowsAppended()
+{
+    const int rows(_model->rowCount());
+    if (0 < rows) {
+        setCurrentIndex(_model->index(rows - 1));
+        scrollToBottom();
+    }
 }
 
 
@@ -212,7 +238,7 @@ void
 NsMessageWidget::onGraphCleared(const bool success)
 {
     if (success) {
-        clear();
+        _model->clear();
     }
 }
 
@@ -268,11 +294,11 @@ void
 NsMessageWidget::_onCopySelection()
 {
     QString text;
-    const QList<QTreeWidgetItem*> selection(selectedItems());
+    const QList<int> selection(_selectedRows());
 
-    foreach (const QTreeWidgetItem *item, selection)
+    foreach (const int row, selection)
     {
-        switch (item->type()) {
+        switch (_model->item(row).type()) {
         case NsMessageItem::Info:
             // TODO!
             break;
@@ -289,7 +315,7 @@ NsMessageWidget::_onCopySelection()
             break;
         }
 
-        text += item->text(0) + "\n";
+        text += _model->displayText(row) + "\n";
     }
 
     QApplication::clipboard()->setText(text);
@@ -303,16 +329,15 @@ NsMessageWidget::_onCopySelection()
 void
 NsMessageWidget::_onSelectSelection()
 {
-    const QList<QTreeWidgetItem *> selection(selectedItems());
+    const QList<int> selection(_selectedRows());
 
-    foreach (const QTreeWidgetItem *twItem, selection) {
-        const NsMessageItem *msgItem(
-            dynamic_cast<const NsMessageItem*>(twItem));
+    foreach (const int row, selection) {
+        const QString vobName(_model->vobName(row));
 
-        if (0 != msgItem && !msgItem->vobName().isEmpty()) {
+        if (!vobName.isEmpty()) {
             NsCmdSelectOp::exec(
                 NsCmdSelectOp::ArgsList() <<
-                    NsCmdSelectOp::Args(msgItem->vobName(), true));
+                    NsCmdSelectOp::Args(vobName, true));
         }
     }
 }
@@ -325,7 +350,7 @@ NsMessageWidget::_onSelectSelection()
 void
 NsMessageWidget::_onClear()
 {
-    clear();
+    _model->clear();
 }
 
 
@@ -337,27 +362,31 @@ void
 NsMessageWidget::_onFilterChanged(const bool                checked,
                                   const NsMessageItem::Type type)
 {
-    QTreeWidgetItemIterator iter(this);
+    // Hidden rows are removed from the model, which also drops them from
+    // the selection.
 
-    while (*iter) {
-        NsMessageItem *msgItem(dynamic_cast<NsMessageItem*>((*iter)));
+    _model->setTypeHidden(type, !checked);
+}
 
-        if (0 != msgItem && msgItem->type() == type) {
-            if (checked) {
-                // Show item.
 
-                msgItem->setHidden(false);
-            }
-            else {
-                // Unselect and hide item.
+// _onFilterOpChanged
+// ------------------
+//! Shows only messages from the op of the current message, or messages from
+//! all ops if unchecked. [slot]
 
-                msgItem->setSelected(false);
-                msgItem->setHidden(true);
-            }
+void
+NsMessageWidget::_onFilterOpChanged(const bool checked)
+{
+    QString vobName;
+    if (checked) {
+        const QModelIndex current(selectionModel()->currentIndex());
+        if (current.isValid()) {
+            vobName = _model->vobName(current.row());
         }
-
-        ++iter;
     }
+
+    _model->setVobFilter(vobName);
+    scrollToBottom();
 }
 
 // -----------------------------------------------------------------------------
@@ -368,34 +397,14 @@ NsMessageWidget::_onFilterChanged(const bool                checked,
 
 // _msg
 // ----
-//! Add a message with a suitable icon to the tree view.
+//! Add a message to the log. The view is updated when the model flushes.
 
 void
 NsMessageWidget::_msg(const QString             &text,
                       const NsMessageItem::Type  type,
                       const QString             &vobName)
 {
-    QString itemText;
-    if (!vobName.isEmpty()) {
-        itemText = vobName + ": " + text;
-    }
-    else {
-        itemText = text;
-    }
-
-    NsMessageItem *item(
-        new NsMessageItem(QStringList(itemText.replace('\n', ' ')),
-                          type,
-                          vobName));
-
-    addTopLevelItem(item);  // Widget takes ownership.
-
-    const bool hidden = _isTypeHidden(type);
-    if (!hidden) {
-        setCurrentItem(item);
-        scrollToBottom();
-    }
-    item->setHidden(hidden);
+    _model->append(text, type, vobName);
 }
 
 
@@ -406,7 +415,7 @@ NsMessageWidget::_msg(const QString             &text,
 int
 NsMessageWidget::_msgCount() const
 {
-    return topLevelItemCount();
+    return _model->messageCount();
 }
 
 
@@ -483,40 +492,36 @@ NsMessageWidget::_createActions()
             SIGNAL(toggled(bool,NsMessageItem::Type)),
             SLOT(_onFilterChanged(bool,NsMessageItem::Type)));
     addAction(_filterErrorsAction);
+
+
+    // Op filter action.
+
+    _filterOpAction = new QAction("Show only this op", this); // Child.
+    _filterOpAction->setStatusTip(
+        "Show only messages from the op of the current message");
+    _filterOpAction->setCheckable(true);
+    _filterOpAction->setChecked(false);
+    _filterOpAction->setEnabled(false);
+    connect(_filterOpAction,
+            SIGNAL(toggled(bool)),
+            SLOT(_onFilterOpChanged(bool)));
+    addAction(_filterOpAction);
 }
 
 
-// _isTypeHidden
+// _selectedRows
 // -------------
-//! DOCS
+//! Returns the selected rows in ascending order.
 
-bool
-NsMessageWidget::_isTypeHidden(const NsMessageItem::Type type) const
+QList<int>
+NsMessageWidget::_selectedRows() const
 {
-    switch (type) {
-    case NsMessageItem::Info:
-        return _isInfoHidden();
-    case NsMessageItem::Warning:
-        return _isWarningHidden();
-    case NsMessageItem::Error:
-        return _isErrorHidden();
-//    case NsMessageItem::InternalError:
-//        return _isInternalErrorHidden();
+    QList<int> rows;
+    foreach (const QModelIndex &index, selectionModel()->selectedRows()) {
+        rows.append(index.row());
     }
-
-    return false;
+    qSort(rows);
+    return rows;
 }
 
-bool
-NsMessageWidget::_isInfoHidden() const
-{ return !_filterInfoAction->isChecked(); }
-
-bool
-NsMessageWidget::_isWarningHidden() const
-{ return !_filterWarningsAction->isChecked(); }
-
-bool
-NsMessageWidget::_isErrorHidden() const
-{ return !_filterErrorsAction->isChecked(); }
-
 // -----------------------------------------------------------------------------
@@ -43,10 +43,11 @@
 
 #include "NsMessageCallback.h"
 #include "NsMessageItem.h"
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QIcon>
 
 class NsMessageFilterAction;
+class NsMessageModel;
 
 QT_BEGIN_NAMESPACE
 class QAction;
@@ -57,9 +58,10 @@ QT_END_NAMESPACE
 
 // NsMessageWidget
 // ---------------
-//! Shows a list of messages, both from Open Naiad Studio and Naiad.
+//! Shows a list of messages, both from Open Naiad Studio and Naiad. Messages
+//! are stored in an NsMessageModel, the view only materializes visible rows.
 
-class NsMessageWidget : public QTreeWidget
+class NsMessageWidget : public QTreeView
 {
     Q_OBJECT
 
@@ -110,6 +112,9 @@ protected slots:
     void
     onItemSelectionChanged();
 
+    void
+    onRowsAppended();
+
     void
     onGraphCleared(bool success);
 
@@ -136,8 +141,8 @@ private slots:
     void
     _onFilterChanged(bool checked, NsMessageItem::Type type);
 
-private:
-
+    void
+    _onFilterOpChanged(bool checked);
 
 private:
 
@@ -152,22 +157,15 @@ private:
     void
     _createActions();
 
-    bool
-    _isTypeHidden(NsMessageItem::Type type) const;
-
-    bool
-    _isInfoHidden() const;
-
-    bool
-    _isWarningHidden() const;
-
-    bool
-    _isErrorHidden() const;
+    QList<int>
+    _selectedRows() const;
 
 private:    // Member variables.
 
     NsMessageCallback _cb;  //!< Receive messages from Ni through callbacks.
 
+    NsMessageModel *_model; //!< Message storage.
+
     QAction *_copyAction;   //!< The Copy action.
     QAction *_selectAction; //!< The Select action.
     QAction *_clearAction;  //!< The Clear action.
@@ -175,6 +173,7 @@ private:    // Member variables.
     NsMessageFilterAction *_filterInfoAction;    //!< The info filter action.
     NsMessageFilterAction *_filterWarningsAction;//!< The warning filter action.
     NsMessageFilterAction *_filterErrorsAction;  //!< The error filter action.
+    QAction               *_filterOpAction;      //!< The op filter action.
 };
 
 #endif // NS_MESSAGE_WIDGET_H
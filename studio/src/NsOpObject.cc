@@ -105,6 +105,7 @@ NsOpObject::NsOpObject(Ng::Op                    &op,
     , _op(&op)
     , _condition(None)
     , _cachePolicy(NoCache)
+    , _empCacheRevision(0)
     , _hasEmpCacheParam(_op->hasParam("EMP Cache") ||
                         _op->hasParam("Geometry Cache") ||
                         _op->hasParam("Particle Cache"))
@@ -453,32 +454,33 @@ void
 NsOpObject::updateEmpBodyCache()
 {
     if (_hasEmpCacheParam) {
+        const NsGraphCallback::NiLocker locker;
         const NtTimeBundle cvftb = queryCurrentVisibleFrameTimeBundle();
         NtBool ok = NI_TRUE;
         if (NiInitCachedBodies(fromQStr(longName()), cvftb, NI_TRUE, &ok)) {
             _updateEmpBodyCache(cvftb);
         }
         else if (!ok) {
-            _empBodyCache.clear();
-            emit empBodyCacheChanged();
+            _clearEmpBodyCache();
         }
     }
 }
 
 
-// onValueChanged
-// --------------
-//! [slot]
+// onValuesChanged
+// ---------------
+//! Called by NsCmdCentral with the changed values this Op is registered
+//! for, i.e. its own values and values of other Ops that affect it (see
+//! NsOpStore). Values are reported once per command, so a multi-component
+//! or multi-parameter edit updates the EMP cache at most once.
 
 void
-NsOpObject::onValueChanged(const QString &valueLongName,
-                           const QString &expr,
-                           int            comp,
-                           bool           success)
+NsOpObject::onValuesChanged(const QStringList &valueLongNames,
+                            const bool         success)
 {    
-    if (success &&         
-        NiQueryParamAffectsOp(fromQStr(valueLongName), 
-                              fromQStr(longName()))) {
+    emit valuesChanged(valueLongNames, success);
+
+    if (success) {
         emit enabledChanged(isEnabled());
 
         // Changing a value does not affect an Op's feed configuration,
@@ -486,6 +488,8 @@ NsOpObject::onValueChanged(const QString &valueLongName,
         // the Op has an EMP cache and if this cache needs to be updated. 
 
         if (_hasEmpCacheParam) {
+            ++_empCacheRevision;    // May read other files now.
+
             //qDebug() << "NsOpObject::onValueChanged";
             //qDebug() << valueLongName << ":" << expr;
             //qDebug() << NiInitCachedBodies(fromQStr(longName()), cvftb);
@@ -500,15 +504,14 @@ NsOpObject::onValueChanged(const QString &valueLongName,
                 bool ok(true);
                 const bool update(initCachedBodies(longName(),cvftb,true,&ok));
 
-                qDebug() << "NsOpObject::onValueChanged - "
+                qDebug() << "NsOpObject::onValuesChanged - "
                          << "Update: " << update << "| Ok: " << ok;
 
                 if (update) {
                     _updateEmpBodyCache(cvftb);
                 } 
                 else if (!ok) {
-                    _empBodyCache.clear();
-                    emit empBodyCacheChanged(); 
+                    _clearEmpBodyCache();
                 }
                 break;
             }
@@ -534,6 +537,8 @@ NsOpObject::onProjectPathChanged(const QString &path,
         // the Op has an EMP cache and if this cache needs to be updated. 
 
         if (_hasEmpCacheParam) {
+            ++_empCacheRevision;    // May read other files now.
+
             switch (_cachePolicy) {
             default:
             case NoCache:   // Do nothing.
@@ -551,8 +556,7 @@ NsOpObject::onProjectPathChanged(const QString &path,
                     _updateEmpBodyCache(cvftb);
                 } 
                 else if (!ok) {
-                    _empBodyCache.clear();
-                    emit empBodyCacheChanged();
+                    _clearEmpBodyCache();
                 }
                 break;
             }
@@ -597,8 +601,7 @@ NsOpObject::onCurrentVisibleFrameChanged(const int  cvf,
                     _updateEmpBodyCache(cvftb);
                 }
                 else if (!ok) {
-                    _empBodyCache.clear();
-                    emit empBodyCacheChanged();
+                    _clearEmpBodyCache();
                 }
                 break;
             }
@@ -886,7 +889,17 @@ NsOpObject::_updateEmpBodyCache(const NtTimeBundle &tb)
             body->eraseShapes();
             break;
         case FullCache: 
-            body->init3DBody();
+            // Bodies read from the cache for the same frame hold the same
+            // data, so their GPU resources can be reused across reloads.
+            // The revision is bumped when values or the project path may
+            // change the files read, so that resources of bodies read
+            // before are not taken back.
+
+            body->init3DBody(QString("%1@%2.%3#%4")
+                             .arg(body->longName())
+                             .arg(tb.frame)
+                             .arg(tb.timestep)
+                             .arg(_empCacheRevision));
             break;
         }
     }
@@ -894,6 +907,24 @@ NsOpObject::_updateEmpBodyCache(const NtTimeBundle &tb)
     emit empBodyCacheChanged();
 }
 
+
+// _clearEmpBodyCache
+// ------------------
+//! Clear the EMP body cache, e.g. when there is no cache file for the
+//! current frame. Observers are only notified if bodies were removed, so
+//! that scrubbing through frames without cache files does not keep
+//! rebuilding the graph and 3D views.
+
+void
+NsOpObject::_clearEmpBodyCache()
+{
+    if (!_empBodyCache.empty()) {
+        _empBodyCache.clear();
+        emit empBodyCacheChanged();
+    }
+}
+
+
 NsOpObject::_BodyCachePolicy
 NsOpObject::_bodyCachePolicy(const int downstreamInputCount, 
                              const int dummyInputCount)
@@ -348,6 +348,10 @@ public:
     emitStateChanged(/*const QString &opState*/)
     { emit stateChanged(/*opState*/); }
 
+    void
+    onValuesChanged(const QStringList &valueLongNames,
+                    bool               success);
+
 protected slots:
 
     //void
@@ -355,12 +359,6 @@ protected slots:
     //              const QString &plugLongName,
     //              bool           success);
 
-    void
-    onValueChanged(const QString &valueLongName,
-                   const QString &expr,
-                   int            comp,
-                   bool           success);
-
     void
     onProjectPathChanged(const QString &path,
                          bool           success);
@@ -389,11 +387,12 @@ signals:
     void
     enabledChanged(bool enabled);
 
-    ////! Emitted when an Op parameter has changed.
-    //void
-    //valueChanged(const QString &valueLongName,
-    //             const QString &expr,
-    //             int            comp);
+    //! Emitted when values that belong to or affect this Op have been
+    //! changed, or failed to change. Param widgets refresh from this rather
+    //! than from every value change in the graph.
+    void
+    valuesChanged(const QStringList &valueLongNames,
+                  bool               success);
 
     //! Emitted when the EMP body cache has changed.
     void
@@ -439,6 +438,9 @@ private:    // EMP body caching.
     void
     _updateEmpBodyCache(const NtTimeBundle &tb);
 
+    void
+    _clearEmpBodyCache();
+
     static _BodyCachePolicy
     _bodyCachePolicy(int downstreamInputCount, int dummyInputCount);
 
@@ -474,6 +476,7 @@ private:    // Member variables.
 
     NsBodyCache      _empBodyCache;
     _BodyCachePolicy _cachePolicy;
+    int              _empCacheRevision; //!< See _updateEmpBodyCache().
 
     bool             _hasEmpCacheParam;
     bool             _hasEnabledParam;
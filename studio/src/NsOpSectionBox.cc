@@ -84,10 +84,35 @@ NsOpSectionBox::NsOpSectionBox(const NsValueSectionObject &vso,
                                NsUndoStack             *undoStack,
                                NsOpObjectBox              &parent)
     : NsValueSectionBox(vso, parent)
+    , _undoStack(undoStack)
+    , _parent(parent)
+    , _stale(false)
 {
-    QVBoxLayout *layout(new QVBoxLayout);    
+    connect(this, SIGNAL(toggled(bool)), SLOT(_refreshIfStale()));
+}
+
+
+// populate
+// --------
+//! Create the parameter widgets of the section.
+
+void
+NsOpSectionBox::populate(QVBoxLayout *layout)
+{
+    const NsValueSectionObject &vso(section());
     const bool isOp = (dynamic_cast<const NsOpObject*>(&vso.valueObject())!=0);
 
+    // Only values that belong to or affect the Op can change what the
+    // parameter widgets display.
+
+    connect(_parent.op(),
+            SIGNAL(valuesChanged(QStringList,bool)),
+            SLOT(_onValuesChanged(QStringList,bool)));
+
+    connect(NsCmdCentral::instance(),
+            SIGNAL(currentVisibleFrameChanged(int,bool,bool)),
+            SLOT(_onCurrentVisibleFrameChanged(int,bool,bool)));
+
     if (isOp && 
         ("Transform"         == vso.name() ||
          "Initial Transform" == vso.name() ||
@@ -100,10 +125,10 @@ NsOpSectionBox::NsOpSectionBox(const NsValueSectionObject &vso,
          "Import Transform"  == vso.name())) {
         NsMetaCheckBoxWidget *mcbw(
             new NsMetaCheckBoxWidget(
-                NsMetaWidgetArgs(parent.op(),
+                NsMetaWidgetArgs(_parent.op(),
                                  0,
                                  "Visible in 3D",
-                                 undoStack,
+                                 _undoStack,
                                  this)));
 
         connect(NsCmdCentral::instance(),
@@ -125,7 +150,7 @@ NsOpSectionBox::NsOpSectionBox(const NsValueSectionObject &vso,
                         vbo->typeName(),
                         fromNbStr(child(fromQStr(vbo->subTypeName())))),
                     NsParamWidgetFactory::ArgsType(
-                        parent.op(), vbo, undoStack, this));
+                        _parent.op(), vbo, _undoStack, this));
 
             if (0 != pbw) {
                 // Factory produced a valid widget, add it to the layout.
@@ -139,15 +164,13 @@ NsOpSectionBox::NsOpSectionBox(const NsValueSectionObject &vso,
                         pbw,
                         SLOT(onMetaChanged(QString,QString,QString,bool)));
 
-                connect(NsCmdCentral::instance(),
-                        SIGNAL(valueChanged(QString,QString,int,bool)),
-                        pbw,
-                        SLOT(onValueChanged(QString,QString,int,bool)));
+                // Value and frame changes are forwarded by the box, see
+                // _onValuesChanged().
 
-                connect(NsCmdCentral::instance(),
-                        SIGNAL(currentVisibleFrameChanged(int,bool,bool)),
+                connect(this,
+                        SIGNAL(valuesChanged(QStringList,bool)),
                         pbw,
-                        SLOT(onCurrentVisibleFrameChanged(int,bool,bool)));
+                        SLOT(onValuesChanged(QStringList,bool)));
 
                 layout->addWidget(pbw);
             }
@@ -158,8 +181,70 @@ NsOpSectionBox::NsOpSectionBox(const NsValueSectionObject &vso,
             }
         }
     }
+}
+
+// -----------------------------------------------------------------------------
+
+// showEvent
+// ---------
+//! Refresh the parameter widgets if changes were skipped while hidden.
+
+void
+NsOpSectionBox::showEvent(QShowEvent *event)
+{
+    NsValueSectionBox::showEvent(event);
+    _refreshIfStale();
+}
+
+// -----------------------------------------------------------------------------
+
+// _onValuesChanged
+// ----------------
+//! Forward value changes to the parameter widgets, or remember that they
+//! need refreshing if the box is not showing. [slot]
+
+void
+NsOpSectionBox::_onValuesChanged(const QStringList &valueLongNames,
+                                 const bool         success)
+{
+    if (_isShowing()) {
+        emit valuesChanged(valueLongNames, success);
+    }
+    else {
+        _stale = true;
+    }
+}
+
 
-    setLayout(layout); // Pass ownership of layout to box.
+// _onCurrentVisibleFrameChanged
+// -----------------------------
+//! Time-varying parameters display the value at the current visible frame,
+//! so a frame change refreshes the parameter widgets too. [slot]
+
+void
+NsOpSectionBox::_onCurrentVisibleFrameChanged(const int  cvf,
+                                              const bool update3DView,
+                                              const bool success)
+{
+    Q_UNUSED(cvf);
+    Q_UNUSED(update3DView);
+
+    _onValuesChanged(QStringList(), success);
+}
+
+
+// _refreshIfStale
+// ---------------
+//! Refresh the parameter widgets once if changes were skipped while the
+//! box was hidden or collapsed. [slot]
+
+void
+NsOpSectionBox::_refreshIfStale()
+{
+    if (_stale && _isShowing()) {
+        _stale = false;
+        emit valuesChanged(QStringList(), true);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -42,10 +42,12 @@
 #define NS_OP_SECTION_BOX_H
 
 #include "NsValueSectionBox.h"      // Base.
+#include <QStringList>
 
 class NsValueSectionObject;
 class NsUndoStack;
 class NsOpObjectBox;
+class QShowEvent;
 
 // -----------------------------------------------------------------------------
 
@@ -53,6 +55,11 @@ class NsOpObjectBox;
 // --------------
 //! The NsOpSectionBox class, representing a collapsible group box in
 //! which the parameters for a specific Op section can be edited.
+//!
+//! Value and frame changes are forwarded to the parameter widgets only
+//! while the box is shown expanded. If changes arrive while it is hidden
+//! or collapsed, e.g. in a recycled box of an Op no longer selected, the
+//! widgets are refreshed once when the box is shown expanded again.
 
 class NsOpSectionBox : public NsValueSectionBox
 {
@@ -69,6 +76,42 @@ public:
     virtual
     ~NsOpSectionBox()
     {}
+
+signals:
+
+    void
+    valuesChanged(const QStringList &valueLongNames, bool success);
+
+protected:
+
+    virtual void
+    populate(QVBoxLayout *layout);
+
+    virtual void
+    showEvent(QShowEvent *event);
+
+private slots:
+
+    void
+    _onValuesChanged(const QStringList &valueLongNames, bool success);
+
+    void
+    _onCurrentVisibleFrameChanged(int cvf, bool update3DView, bool success);
+
+    void
+    _refreshIfStale();
+
+private:
+
+    bool
+    _isShowing() const
+    { return isVisible() && isChecked(); }
+
+private:    // Member variables.
+
+    NsUndoStack   *_undoStack;
+    NsOpObjectBox &_parent;
+    bool           _stale;      //!< Changes were skipped while hidden.
 };
 
 #endif // NS_OP_SECTION_BOX_H
@@ -52,7 +52,10 @@
 #include "NsCmdUnselectAndErase.h"  // TMP!
 #include "NsQuery.h"
 #include "NsStringUtils.h"
+#include "Ns3DResourceCache.h"
+#include "NsStepProfiler.h"
 #include <NgStore.h>
+#include <NiQuery.h>
 #include <QAction>
 
 // -----------------------------------------------------------------------------
@@ -222,89 +225,40 @@ NsOpStore::constSelectedInputs(const bool selected) const
 
 // mutableBodies
 // -------------
-//! DOCS
+//! Returns all cached and live bodies.
 
 QList<NsBodyObject*>
 NsOpStore::mutableBodies()
-{
-    QList<NsBodyObject*> bodies;
-    foreach (NsOpObject *op, _opObjects.values()) {
-        bodies += op->mutableCachedBodies();
-        foreach (NsBodyOutputPlugObject *bopo, op->mutableBodyOutputs()) {
-            bodies += bopo->mutableLiveBodies();
-        }
-    }
-    return bodies;
-}
+{ return _bodies.values(); }
 
 
 // constBodies
 // -----------
-//! DOCS
+//! Returns all cached and live bodies.
 
 QList<const NsBodyObject*>
 NsOpStore::constBodies() const
-{
-    QList<const NsBodyObject *> bodies;
-    foreach (const NsOpObject *op, _opObjects.values()) {
-        bodies += op->constCachedBodies();
-        foreach (const NsBodyOutputPlugObject *bopo, op->constBodyOutputs()) {
-            bodies += bopo->constLiveBodies();
-        }
-    }
-    return bodies;
-}
+{ return constPtrList(_bodies.values()); }
 
 
 // mutableSelectedBodies
 // ---------------------
-//! DOCS
+//! Returns the bodies whose selection state matches the provided flag.
 
 QList<NsBodyObject*>
 NsOpStore::mutableSelectedBodies(const bool selected)
-{
-    QList<NsBodyObject*> bodies;
-    foreach (NsOpObject *op, _opObjects.values()) {
-        foreach (NsBodyObject *bo, op->mutableCachedBodies()) {
-            if (selected == bo->isSelected()) {
-                bodies.append(bo);
-            }
-        }
-        foreach (NsBodyOutputPlugObject *bopo, op->mutableBodyOutputs()) {
-            foreach (NsBodyObject *bo, bopo->mutableLiveBodies()) {
-                if (selected == bo->isSelected()) {
-                    bodies.append(bo);
-                }
-            }
-        }
-    }
-    return bodies;
-}
+{ return (selected ? _selectedBodies : _unselectedBodies).values(); }
 
 
 // constSelectedBodies
 // -------------------
-//! DOCS
+//! Returns the bodies whose selection state matches the provided flag.
 
 QList<const NsBodyObject*>
 NsOpStore::constSelectedBodies(const bool selected) const
 {
-    QList<const NsBodyObject*> bodies;
-    foreach (const NsOpObject *op, _opObjects.values()) {
-        foreach (const NsBodyObject *bo, op->constCachedBodies()) {
-            if (selected == bo->isSelected()) {
-                bodies.append(bo);
-            }
-        }
-        foreach (const NsBodyOutputPlugObject *bopo, op->constBodyOutputs()) {
-            foreach (const NsBodyObject *bo, bopo->constLiveBodies()) {
-                if (selected == bo->isSelected()) {
-                    bodies.append(bo);
-                }
-            }
-        }
-    }
-    return bodies;
+    return constPtrList(
+        (selected ? _selectedBodies : _unselectedBodies).values());
 }
 
 // -----------------------------------------------------------------------------
@@ -384,6 +338,7 @@ NsOpStore::onOpCreated(const QString &opInstance, const bool success)
 {
     if (success) {
         _createOp(opInstance);
+        ++_sceneRevision;
     }
 }
 
@@ -397,6 +352,8 @@ NsOpStore::onOpErased(const QString &opInstance, const bool success)
 {
     if (success) {
         _eraseOp(opInstance);
+        ++_sceneRevision;
+        Ns3DResourceCache::instance()->clear();
     }
 }
 
@@ -412,6 +369,8 @@ NsOpStore::onOpNameChanged(const QString &oldOpInstance,
 {
     if (success) {
         _emitOpNameChanged(oldOpInstance, newOpInstance);
+        ++_sceneRevision;
+        Ns3DResourceCache::instance()->clear();
     }
 }
 
@@ -428,6 +387,7 @@ NsOpStore::onOpStateChanged(const QStringList &opInstances,
         foreach (const QString &opInstance, opInstances) {
             _emitOpStateChanged(opInstance);
         }
+        ++_sceneRevision;
     }
 }
 
@@ -476,6 +436,7 @@ NsOpStore::onGroupPlugChanged(const QString &plugLongName,
 {
     if (success) {
         _emitGroupPlugChanged(plugLongName);
+        ++_sceneRevision;
     }
 }
 
@@ -492,6 +453,7 @@ NsOpStore::onSmackChanged(const QStringList &plugLongNames,
         foreach (const QString &plugLongName, plugLongNames) {
             _emitSmackChanged(plugLongName);
         }
+        ++_sceneRevision;
     }
 }
 
@@ -499,15 +461,17 @@ NsOpStore::onSmackChanged(const QStringList &plugLongNames,
 
 // onFeedChanged
 // -------------
-//! DOCS [slot]
+//! DOCS [slot]. During a bulk load the Op states and cache policies are
+//! refreshed once by onGraphLoaded() instead of once per feed.
 
 void
 NsOpStore::onFeedChanged(const QString &inputLongName,
                          const QString &plugLongName,
                          const bool     success)
 {
-    if (success) {
+    if (success && !NsCmdCentral::instance()->isBulkLoading()) {
         _emitFeedChanged(inputLongName, plugLongName);
+        ++_sceneRevision;
     }
 }
 
@@ -533,25 +497,101 @@ NsOpStore::onBodySelectionChanged(const QStringList &bodyLongNames,
         foreach (const QString &bodyLongName, bodyLongNames) {
             _emitBodySelectionChanged(bodyLongName);
         }
+        ++_sceneRevision;
+    }
+}
+
+
+// onEmpBodyCacheChanged
+// ---------------------
+//! The cached bodies of the sending Op have changed, re-index them. [slot]
+
+void
+NsOpStore::onEmpBodyCacheChanged()
+{
+    NsOpObject *op = qobject_cast<NsOpObject*>(sender());
+    if (0 != op) {
+        _indexBodies(op, op->mutableCachedBodies());
+        ++_sceneRevision;
+    }
+}
+
+
+// onLiveBodyCacheChanged
+// ----------------------
+//! The live bodies of the sending output plug have changed, re-index 
+//! them. [slot]
+
+void
+NsOpStore::onLiveBodyCacheChanged()
+{
+    NsBodyOutputPlugObject *bopo = 
+        qobject_cast<NsBodyOutputPlugObject*>(sender());
+    if (0 != bopo) {
+        _indexBodies(bopo, bopo->mutableLiveBodies());
+        ++_sceneRevision;
     }
 }
 
 // -----------------------------------------------------------------------------
 
-//// onValueChanged
-//// --------------
-////! [slot]
-//
-//void
-//NsOpStore::onValueChanged(const QString &valueLongName,
-//                          const QString &expr,
-//                          const int      comp,
-//                          const bool     success)
-//{
-//    if (success) {
-//        _emitValueChanged(valueLongName, expr, comp);
-//    }
-//}
+// onValuesChanged
+// ---------------
+//! [slot] Bumps the value revision. Any value may be referenced from
+//! expressions on other ops, so no attempt is made to narrow this down.
+//! Values of ops other than scopes may change the bodies read from the
+//! caches, e.g. through file names, so such changes also drop the GPU
+//! resources kept for cached bodies. Ops whose dependencies may have
+//! changed are registered again on the channels of the values they depend
+//! on.
+
+void
+NsOpStore::onValuesChanged(const QStringList &valueLongNames,
+                           const bool         success)
+{
+    if (success) {
+        ++_valueRevision;
+        ++_sceneRevision;
+
+        if (!NsCmdCentral::instance()->isBulkLoading()) {
+            QSet<NsOpObject*> updated;
+            foreach (const QString &valueLongName, valueLongNames) {
+                NsOpObject *op(_findOp(valueLongName.section('.', 0, 0)));
+                if (0 == op || updated.contains(op)) {
+                    continue;
+                }
+
+                bool refs(_opExprValues.value(op).contains(valueLongName));
+                const NsValueBaseObject *vbo(
+                    op->queryConstValue(valueLongName.section('.', 1)));
+                for (int c(0); !refs && 0 != vbo &&
+                               c < vbo->componentCount(); ++c) {
+                    refs = vbo->expr(c).contains('@');
+                }
+
+                // Values without references can still change which Global
+                // values affect the Op, e.g. by switching to the master
+                // voxel size.
+
+                if (refs) {
+                    _updateValueDependencies(op);
+                }
+                else {
+                    _updateGlobalDependencies(op);
+                }
+                updated << op;
+            }
+        }
+
+        foreach (const QString &valueLongName, valueLongNames) {
+            const NsOpObject *op(_findOp(valueLongName.section('.', 0, 0)));
+            if (0 == op || !op->familyName().endsWith("_SCOPE")) {
+                Ns3DResourceCache::instance()->clear();
+                break;
+            }
+        }
+    }
+}
 //
 //
 //// onMetaChanged
@@ -569,13 +609,22 @@ NsOpStore::onBodySelectionChanged(const QStringList &bodyLongNames,
 //    }
 //}
 
-//void
-//NsOpStore::onProjectPathChanged(const QString &path, const bool success)
-//{
-//    if (success) {
-//        _emitProjectPathChanged(path);
-//    }
-//}
+
+// onProjectPathChanged
+// --------------------
+//! Cached bodies are read relative to the project path, so the GPU
+//! resources kept for them may belong to other files now. [slot]
+
+void
+NsOpStore::onProjectPathChanged(const QString &path, const bool success)
+{
+    Q_UNUSED(path);
+
+    if (success) {
+        ++_sceneRevision;
+        Ns3DResourceCache::instance()->clear();
+    }
+}
 
 void
 NsOpStore::onCurrentVisibleFrameChanged(const int  cvf,
@@ -587,6 +636,7 @@ NsOpStore::onCurrentVisibleFrameChanged(const int  cvf,
 
     if (success) {
         _resetOpConditions();
+        ++_sceneRevision;
     }
 }
 
@@ -609,18 +659,235 @@ NsOpStore::onGraphCleared(const bool success)
 {
     if (success) {
         _clear();
+        ++_sceneRevision;
+        Ns3DResourceCache::instance()->clear();
+    }
+}
+
+
+// onGraphLoaded
+// -------------
+//! A graph has been bulk loaded. The loaded Ops received none of the
+//! individual value or feed notifications, so refresh everything they
+//! would have triggered in one go. [slot]
+
+void
+NsOpStore::onGraphLoaded(const QStringList &opInstances, const bool success)
+{
+    if (success) {
+        ++_valueRevision;
+        ++_sceneRevision;
+        Ns3DResourceCache::instance()->clear();
+
+        foreach (NsOpObject *op, mutableOps()) {
+            op->emitStateChanged();
+        }
+
+        foreach (const QString &opInstance, opInstances) {
+            NsOpObject *op = _findOp(opInstance);
+            if (0 != op) {
+                op->updateBodyCachePolicy();
+            }
+        }
+
+        _updateValueDependencies();
     }
 }
 
 // -----------------------------------------------------------------------------
 
+// _registerValues
+// ---------------
+//! Register an Op on the value channels of its own values.
+
+void
+NsOpStore::_registerValues(NsOpObject *op)
+{
+    NsCmdCentral *cc(NsCmdCentral::instance());
+    QStringList &valueLongNames(_opValues[op]);
+
+    foreach (const NsValueBaseObject *vbo, op->constValues()) {
+        valueLongNames << vbo->longName();
+        cc->addValueListener(valueLongNames.last(), op);
+    }
+}
+
+
+// _unregisterValues
+// -----------------
+//! Unregister an Op from all value channels. The channels of its own values
+//! are freed, so they are also forgotten as dependencies of other Ops.
+
+void
+NsOpStore::_unregisterValues(NsOpObject *op)
+{
+    NsCmdCentral *cc(NsCmdCentral::instance());
+
+    foreach (const QString &valueLongName, _opDependencies.take(op)) {
+        cc->removeValueListener(valueLongName, op);
+    }
+
+    _opExprValues.remove(op);
+    _opRefs.remove(op);
+
+    const QStringList valueLongNames(_opValues.take(op));
+    _OpValueHashType::iterator iter(_opDependencies.begin());
+    for (; iter != _opDependencies.end(); ++iter) {
+        foreach (const QString &valueLongName, valueLongNames) {
+            iter.value().removeOne(valueLongName);
+        }
+    }
+
+    cc->eraseValueChannels(valueLongNames);
+}
+
+
+// _updateValueDependencies
+// ------------------------
+//! Register an Op on the value channels of values on other Ops that affect
+//! it. NiQueryParamAffectsOp decides, but asking it about every value in
+//! the graph is too slow, so only two kinds of candidates are asked about:
+//! values of the Global Op, which affect Ops without being referenced, and
+//! values whose name appears in one of the Op's expressions containing
+//! '@', which is how references are written.
+
+void
+NsOpStore::_updateValueDependencies(NsOpObject *op)
+{
+    NsCmdCentral *cc(NsCmdCentral::instance());
+
+    foreach (const QString &valueLongName, _opDependencies.take(op)) {
+        cc->removeValueListener(valueLongName, op);
+    }
+    _opExprValues.remove(op);
+    _opRefs.remove(op);
+
+    QString refs;
+    foreach (const NsValueBaseObject *vbo, op->constValues()) {
+        for (int c(0); c < vbo->componentCount(); ++c) {
+            const QString expr(vbo->expr(c));
+            if (expr.contains('@')) {
+                _opExprValues[op] << vbo->longName();
+                refs += expr;
+                refs += '\n';
+            }
+        }
+    }
+
+    if (!refs.isEmpty()) {
+        _opRefs.insert(op, refs);
+    }
+
+    foreach (const NsOpObject *other, _opObjects) {
+        _addValueDependencies(op, other);
+    }
+}
+
+
+// _updateValueDependencies
+// ------------------------
+//! Resolve the dependencies of all Ops, e.g. after a bulk load.
+
+void
+NsOpStore::_updateValueDependencies()
+{
+    foreach (NsOpObject *op, _opObjects) {
+        _updateValueDependencies(op);
+    }
+}
+
+
+// _updateGlobalDependencies
+// -------------------------
+//! Resolve again which values of the Global Op affect an Op, keeping its
+//! references to other Ops.
+
+void
+NsOpStore::_updateGlobalDependencies(NsOpObject *op)
+{
+    NsCmdCentral *cc(NsCmdCentral::instance());
+
+    const _OpValueHashType::iterator find(_opDependencies.find(op));
+    if (find != _opDependencies.end()) {
+        QStringList::iterator iter(find.value().begin());
+        while (iter != find.value().end()) {
+            if ("Global" == iter->section('.', 0, 0)) {
+                cc->removeValueListener(*iter, op);
+                iter = find.value().erase(iter);
+            }
+            else {
+                ++iter;
+            }
+        }
+    }
+
+    foreach (const NsOpObject *other, _opObjects) {
+        if (_isGlobalOp(other)) {
+            _addValueDependencies(op, other);
+        }
+    }
+}
+
+
+// _addValueDependencies
+// ---------------------
+//! Register an Op on the channels of the values of another Op that affect
+//! it, see _updateValueDependencies(). Returns quickly if the other Op can
+//! not hold candidates, so that a new Op can be offered to all Ops.
+
+void
+NsOpStore::_addValueDependencies(NsOpObject *op, const NsOpObject *other)
+{
+    if (other == op) {
+        return;
+    }
+
+    const bool global(_isGlobalOp(other));
+    const _OpRefHashType::const_iterator refs(_opRefs.find(op));
+    if (!global && refs == _opRefs.end()) {
+        return;     // No candidates.
+    }
+
+    NsCmdCentral *cc(NsCmdCentral::instance());
+    const NtString opLongName(fromQStr(op->longName()));
+    QStringList &valueLongNames(_opDependencies[op]);
+    const NsGraphCallback::NiLocker locker;
+
+    foreach (const NsValueBaseObject *vbo, other->constValues()) {
+        if (global || refs.value().contains(vbo->name())) {
+            const QString valueLongName(vbo->longName());
+            if (!valueLongNames.contains(valueLongName) &&
+                NiQueryParamAffectsOp(fromQStr(valueLongName), opLongName)) {
+                valueLongNames << valueLongName;
+                cc->addValueListener(valueLongName, op);
+            }
+        }
+    }
+}
+
+
+// _isGlobalOp
+// -----------
+//! Returns true if the given Op is the Global Op. Compares names, since
+//! _globalOp is not yet set while the Global Op itself is created. [static]
+
+bool
+NsOpStore::_isGlobalOp(const NsOpObject *op)
+{
+    return "Global" == op->longName();
+}
+
+// -----------------------------------------------------------------------------
+
 // onBeginTimeStep
 // ---------------
-//! [slot]
+//! Stepping rewrites the body caches, so GPU resources kept for cached
+//! bodies are dropped. [slot]
 
 void
 NsOpStore::onBeginTimeStep(const NtTimeBundle &tb)
 {
+    Ns3DResourceCache::instance()->clear();
     _resetOpConditions();
     _emitBeginTimeStep(tb);
 }
@@ -661,6 +928,9 @@ void
 NsOpStore::onReset()
 {
     _reset();
+    ++_sceneRevision;
+    Ns3DResourceCache::instance()->clear();
+    NsStepProfiler::instance()->clear();    // New session.
 }
 
 // -----------------------------------------------------------------------------
@@ -679,10 +949,10 @@ NsOpStore::_createOp(const QString &opInstance)
 
         // Connect Op object to command central.
 
-        connect(NsCmdCentral::instance(),
-                SIGNAL(valueChanged(QString,QString,int,bool)),
-                op,
-                SLOT(onValueChanged(QString,QString,int,bool)));
+        // Value changes are delivered through the value channels, see
+        // _registerValues() and _updateValueDependencies().
+
+        _registerValues(op);
 
         connect(NsCmdCentral::instance(),
                 SIGNAL(metaChanged(QString,QString,QString,bool)),
@@ -704,11 +974,32 @@ NsOpStore::_createOp(const QString &opInstance)
         //        op,
         //        SLOT(onFeedChanged(QString,QString,bool)));
 
+        // Connect body caches to the body index.
+
+        connect(op, SIGNAL(empBodyCacheChanged()),
+                this, SLOT(onEmpBodyCacheChanged()));
+
+        foreach (NsBodyOutputPlugObject *bopo, op->mutableBodyOutputs()) {
+            connect(bopo, SIGNAL(liveBodyCacheChanged()),
+                    this, SLOT(onLiveBodyCacheChanged()));
+        }
+
         _opInstances.insert(opInstance, op->handle());
         _opObjects.insert(op->handle(), op);
         _opFamilies[op->familyName()] << op;
         _opTypes[op->typeName()] << op;
         (op->isSelected() ? _selectedOps : _unselectedOps) << op;
+        _indexOpBodies(op);
+
+        // Values of the new Op may affect other Ops, and vice versa. A bulk
+        // load resolves dependencies once it is done.
+
+        if (!NsCmdCentral::instance()->isBulkLoading()) {
+            _updateValueDependencies(op);
+            foreach (NsOpObject *other, _opObjects) {
+                _addValueDependencies(other, op);
+            }
+        }
 
         //emit opCreated(opInstance);
         emit opObjectCreated(op);
@@ -750,6 +1041,8 @@ NsOpStore::_eraseOp(const QString &opInstance)
             _opTypes[typeName].remove(op);
             _selectedOps.remove(op);
             _unselectedOps.remove(op);
+            _unindexOpBodies(op);
+            _unregisterValues(op);
             _opInstances.erase(i0);
             _opObjects.erase(i1); // Remove handle association.
 
@@ -782,6 +1075,16 @@ NsOpStore::_emitOpNameChanged(const QString &oldOpInstance,
 
         _opInstances.insert(newOpInstance, iter.value());
         _opInstances.erase(iter);
+
+        // Body and value long names contain the Op instance name.
+
+        _indexOpBodies(op);
+        _unregisterValues(op);
+        _registerValues(op);
+        _updateValueDependencies(op);
+        foreach (NsOpObject *other, _opObjects) {
+            _addValueDependencies(other, op);
+        }
     }
 }
 
@@ -801,6 +1104,7 @@ NsOpStore::_emitOpStateChanged(const QString &opInstance)
             // A camera scope state was set to ACTIVE, deactivate all other
             // camera scopes.
 
+            const NsGraphCallback::NiLocker locker;
             foreach (NsOpObject *cam, mutableOpFamily("CAMERA_SCOPE")) {
                 if (cam != op) {
                     NiSetOpState(fromQStr(cam->longName()), "INACTIVE");
@@ -961,12 +1265,98 @@ NsOpStore::_emitBodySelectionChanged(const QString &bodyLongName)
 {
     NsBodyObject *body = _findBody(bodyLongName);
     if (0 != body) {
+        _updateBodySelection(body);
         body->emitSelectionChanged();
     }
 }
 
 // -----------------------------------------------------------------------------
 
+// _indexBodies
+// ------------
+//! Replaces the indexed bodies of the provided cache owner (an Op for cached
+//! bodies, a body output plug for live bodies) with the provided bodies.
+
+void
+NsOpStore::_indexBodies(QObject *source, const QList<NsBodyObject*> &bodies)
+{
+    _unindexBodies(source);
+
+    QStringList &names = _bodySources[source];
+    foreach (NsBodyObject *body, bodies) {
+        const QString bodyLongName = body->longName();
+        names.append(bodyLongName);
+        _bodies.insert(bodyLongName, body);
+        _updateBodySelection(body);
+    }
+}
+
+
+// _unindexBodies
+// --------------
+//! Removes the indexed bodies of the provided cache owner. The body objects
+//! may already have been destroyed, they are not dereferenced.
+
+void
+NsOpStore::_unindexBodies(QObject *source)
+{
+    foreach (const QString &bodyLongName, _bodySources.take(source)) {
+        _bodies.remove(bodyLongName);
+        _selectedBodies.remove(bodyLongName);
+        _unselectedBodies.remove(bodyLongName);
+    }
+}
+
+
+// _indexOpBodies
+// --------------
+//! Re-indexes the cached and live bodies of the provided Op.
+
+void
+NsOpStore::_indexOpBodies(NsOpObject *op)
+{
+    _indexBodies(op, op->mutableCachedBodies());
+    foreach (NsBodyOutputPlugObject *bopo, op->mutableBodyOutputs()) {
+        _indexBodies(bopo, bopo->mutableLiveBodies());
+    }
+}
+
+
+// _unindexOpBodies
+// ----------------
+//! Removes the cached and live bodies of the provided Op from the index.
+
+void
+NsOpStore::_unindexOpBodies(NsOpObject *op)
+{
+    _unindexBodies(op);
+    foreach (NsBodyOutputPlugObject *bopo, op->mutableBodyOutputs()) {
+        _unindexBodies(bopo);
+    }
+}
+
+
+// _updateBodySelection
+// --------------------
+//! Moves the provided body to the selected or unselected index, depending
+//! on its current selection state.
+
+void
+NsOpStore::_updateBodySelection(NsBodyObject *body)
+{
+    const QString bodyLongName = body->longName();
+    if (body->isSelected()) {
+        _unselectedBodies.remove(bodyLongName);
+        _selectedBodies.insert(bodyLongName, body);
+    }
+    else {
+        _selectedBodies.remove(bodyLongName);
+        _unselectedBodies.insert(bodyLongName, body);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 //void
 //NsOpStore::_emitValueChanged(const QString &valueLongName,
 //                             const QString &expr,
@@ -1067,6 +1457,14 @@ NsOpStore::_clear()
     _opTypes.clear();
     _selectedOps.clear();
     _unselectedOps.clear();
+    _bodies.clear();
+    _selectedBodies.clear();
+    _unselectedBodies.clear();
+    _bodySources.clear();
+    _opValues.clear();          // Channels were freed by NsCmdCentral.
+    _opDependencies.clear();
+    _opExprValues.clear();
+    _opRefs.clear();
 
 
     //_opObjects.insert(
@@ -1175,55 +1573,6 @@ NsOpStore::_splitPlugLongName(const QString &plugLongName,
     opInstance = queryPlugOpInstance(plugLongName, &plugName);
 }
 
-// -----------------------------------------------------------------------------
-
-
-NsBodyObject*
-NsOpStore::_findBody(const QString &bodyLongName) const
-{
-    QString opInstance;
-    QString plugName;
-    QString bodyName;
-    _splitBodyLongName(bodyLongName, opInstance, plugName, bodyName);
-    NsBodyObject *body = 0;
-    if (!plugName.isEmpty()) {
-        // Body lives in a plug.
-
-        NsBodyOutputPlugObject *bopo = 
-            _findPlug<NsBodyOutputPlugObject>(plugName);
-
-        if (0 != bopo) {
-            body = bopo->mutableLiveBodyCache().queryMutableBody(bodyName);
-        }
-    }
-    else {
-        NsOpObject *op = _findOp(opInstance);
-        if (0 != op) {
-            body = op->mutableEmpBodyCache().queryMutableBody(bodyName);
-        }
-    }
-    return body;
-}
-
-
-// _splitBodyLongName
-// ------------------
-//! [static]
-
-void
-NsOpStore::_splitBodyLongName(const QString &bodyLongName,
-                              QString       &opInstance,
-                              QString       &plugName,
-                              QString       &bodyName)
-{
-    _splitPlugLongName(
-        queryPlugLongName(bodyLongName, &bodyName), 
-        opInstance, 
-        plugName);
-}
-
-
-
 // -----------------------------------------------------------------------------
 
 // NsOpStore
@@ -1232,6 +1581,8 @@ NsOpStore::_splitBodyLongName(const QString &bodyLongName,
 
 NsOpStore::NsOpStore()
     : QObject()
+    , _valueRevision(0)
+    , _sceneRevision(0)
     , _globalOp(_createOp("Global"))
 {}
 
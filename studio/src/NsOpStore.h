@@ -71,6 +71,11 @@ class QAction;
 // ---------
 //! Singleton.
 //! Note that Op objects can only be added/removed through commands.
+//!
+//! Bodies are indexed by long name and selection state. The indices are
+//! updated incrementally when an Op's body caches emit their changed
+//! signals and when body selection changes, so body queries do not walk
+//! the graph.
 
 class NsOpStore : public QObject
 {
@@ -242,10 +247,12 @@ public:     // Plugs.
 
 public:     // Bodies.
 
+    //! May return null.
     NsBodyObject*
     queryMutableBody(const QString &bodyLongName) const
     { return _findBody(bodyLongName); }
 
+    //! May return null.
     const NsBodyObject*
     queryConstBody(const QString &bodyLongName) const
     { return _findBody(bodyLongName); }
@@ -257,14 +264,27 @@ public:     // Bodies.
     QList<const NsBodyObject*>
     constBodies() const;
 
-    // TODO: Cache selected set?
     QList<NsBodyObject*>
     mutableSelectedBodies(bool selected = true);
 
     QList<const NsBodyObject*>
     constSelectedBodies(bool selected = true) const;
 
-    // TODO: Values.
+public:     // Values.
+
+    //! Incremented every time a value is successfully changed. Clients that
+    //! cache evaluated parameters can compare revisions to detect staleness.
+    int
+    valueRevision() const
+    { return _valueRevision; }
+
+    //! Incremented whenever anything the 3D view scopes draw from may have
+    //! changed: values, the current frame, Ops, feeds or body caches.
+    //! Scopes keep retained draw lists until it changes.
+    int
+    sceneRevision() const
+    { return _sceneRevision; }
+
     // TODO: Feeds.
 
 public:
@@ -332,13 +352,17 @@ protected slots:    // Body slots.
     onBodySelectionChanged(const QStringList &bodyLongNames,
                            bool               success);
 
+    void
+    onEmpBodyCacheChanged();
+
+    void
+    onLiveBodyCacheChanged();
+
 protected slots:    // Value slots.
 
-    //void
-    //onValueChanged(const QString &valueLongName,
-    //               const QString &expr,
-    //               int            comp,
-    //               bool           success);
+    void
+    onValuesChanged(const QStringList &valueLongNames,
+                    bool               success);
 
     //void
     //onMetaChanged(const QString &longName,
@@ -346,8 +370,8 @@ protected slots:    // Value slots.
     //              const QString &value,
     //              bool           success);
 
-    //void
-    //onProjectPathChanged(const QString &path, bool success);
+    void
+    onProjectPathChanged(const QString &path, bool success);
 
     void
     onCurrentVisibleFrameChanged(int cvf, bool update3DView, bool success);
@@ -363,6 +387,9 @@ protected slots:    // Misc.
     void
     onGraphCleared(bool success);
 
+    void
+    onGraphLoaded(const QStringList &opInstances, bool success);
+
     //void
     //onGraphViewFramed(bool, int, bool)
     //{}
@@ -454,6 +481,23 @@ private:    // Body "editing".
     void
     _emitBodySelectionChanged(const QString &bodyLongName);
 
+private:    // Body index.
+
+    void
+    _indexBodies(QObject *source, const QList<NsBodyObject*> &bodies);
+
+    void
+    _unindexBodies(QObject *source);
+
+    void
+    _indexOpBodies(NsOpObject *op);
+
+    void
+    _unindexOpBodies(NsOpObject *op);
+
+    void
+    _updateBodySelection(NsBodyObject *body);
+
 private:    // Value editing.
 
     //void
@@ -469,6 +513,29 @@ private:    // Value editing.
     //void
     //_emitProjectPathChanged(const QString &path);
 
+private:    // Value notification.
+
+    void
+    _registerValues(NsOpObject *op);
+
+    void
+    _unregisterValues(NsOpObject *op);
+
+    void
+    _updateValueDependencies(NsOpObject *op);
+
+    void
+    _updateValueDependencies();
+
+    void
+    _updateGlobalDependencies(NsOpObject *op);
+
+    void
+    _addValueDependencies(NsOpObject *op, const NsOpObject *other);
+
+    static bool
+    _isGlobalOp(const NsOpObject *op);
+
 private:    // Stepping.
 
     void
@@ -531,14 +598,10 @@ private:    // Find plug.
 
 private:    // Find body.
 
+    //! Returns null if not found.
     NsBodyObject*
-    _findBody(const QString &bodyLongName) const;
-
-    static void
-    _splitBodyLongName(const QString &bodyLongName,
-                       QString       &opInstance,
-                       QString       &plugName,
-                       QString       &bodyName);
+    _findBody(const QString &bodyLongName) const
+    { return _bodies.value(bodyLongName, 0); }
 
 private:
 
@@ -562,6 +625,26 @@ private:    // Member variables.
     _OpSetType           _selectedOps;
     _OpSetType           _unselectedOps;
 
+    typedef QHash<QString, NsBodyObject*>   _BodyHashType;
+    typedef QHash<QObject*, QStringList>    _BodySourceHashType;
+
+    _BodyHashType        _bodies;           //!< All bodies, by long name.
+    _BodyHashType        _selectedBodies;   //!< Selected bodies.
+    _BodyHashType        _unselectedBodies; //!< Unselected bodies.
+    _BodySourceHashType  _bodySources;      //!< Names indexed per cache owner.
+
+    typedef QHash<NsOpObject*, QStringList>   _OpValueHashType;
+    typedef QHash<NsOpObject*, QSet<QString> > _OpValueSetHashType;
+    typedef QHash<NsOpObject*, QString>       _OpRefHashType;
+
+    _OpValueHashType     _opValues;         //!< Own values, per Op.
+    _OpValueHashType     _opDependencies;   //!< Values of other Ops, per Op.
+    _OpValueSetHashType  _opExprValues;     //!< Own values with references.
+    _OpRefHashType       _opRefs;           //!< Expressions with references.
+
+    int _valueRevision;
+    int _sceneRevision;
+
     NsOpObject *_globalOp;
 };
 
@@ -43,6 +43,7 @@
 #include "NsValueBaseObject.h"
 #include "NsValueObject.h"
 #include "NsCmdCentral.h"
+#include "NsValueChannel.h"
 #include "NsCmdSetParam.h"
 #include "NsCmdSetMeta.h"
 #include "NsOpStore.h"
@@ -88,6 +89,18 @@ NsParamBaseWidget::onValueChanged(const QString &longName,
 }
 
 
+// onValuesChanged
+// ---------------
+//! DOCS [slot]
+
+void
+NsParamBaseWidget::onValuesChanged(const QStringList &valueLongNames,
+                                   const bool         success)
+{
+    emit valueChanged();
+}
+
+
 // onMetaChanged
 // -------------
 //! DOCS [slot]
@@ -266,7 +279,8 @@ NsParamBaseWidget::onExprEditorActionTriggered(const int comp)
     NsExprEditorDialog *exprEditor(new NsExprEditorDialog(comp, *this));// Child
     connect(exprEditor, SIGNAL(valueEdited(QString,int)),
             this,       SLOT(onValueEdited(QString,int)));
-    connect(NsCmdCentral::instance(),
+    connect(NsCmdCentral::instance()->valueChannel(
+                valueBaseObject()->longName()),
             SIGNAL(valueChanged(QString,QString,int,bool)),
             exprEditor,
             SLOT(onValueChanged(QString,QString,int,bool)));
@@ -90,6 +90,10 @@ public slots:
                    int            comp,
                    bool           success);
 
+    void
+    onValuesChanged(const QStringList &valueLongNames,
+                    bool               success);
+
     void
     onMetaChanged(const QString &longName,
                   const QString &valueType,
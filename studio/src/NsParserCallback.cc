@@ -51,21 +51,66 @@
 #include "NsCmdSetOpState.h"
 #include "NsCmdSetOpPosition.h"
 #include "NsCmdSetGroupPlug.h"
+#include "NsCmdCentral.h"
+#include "NsMessageWidget.h"
 #include <QString>
 #include <QUndoCommand>
 #include <QDebug>
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+// BulkCallback
+// ------------
+//! Request callback used in bulk load mode. Records the outcome of the
+//! request and reports failures, but sends no notifications.
+
+template <class C>
+class BulkCallback : public C
+{
+public:
+
+    //! CTOR.
+    BulkCallback()
+        : C()
+        , _success(false)
+    {}
+
+    virtual ~BulkCallback() {}     //!< DTOR.
+
+    virtual void
+    success()
+    { _success = true; }
+
+    virtual void
+    failure(const NtString &msg)
+    { NsMessageWidget::instance()->serverError(fromNbStr(msg)); }
+
+    bool
+    querySuccess() const
+    { return _success; }
+
+private:    // Member variables.
+
+    bool _success;
+};
+
+}   // Namespace.
+
+// -----------------------------------------------------------------------------
+
 // NsParserCallback
 // ----------------
 //! CTOR.
 
 NsParserCallback::NsParserCallback(const bool     bodyNameOverride,
-                                   QUndoCommand  *parent)
+                                   QUndoCommand  *parent,
+                                   const bool     bulkLoad)
     : NtParserCallback()
     , _bodyNameOverride(bodyNameOverride)
     //, _opPositionOverride(opPositionOverride)
+    , _bulkLoad(bulkLoad)
     , _parent(parent)
 {}
 
@@ -83,7 +128,18 @@ NsParserCallback::create(const NtString &className,
     const QString suggestedOpInstance(fromNbStr(name));
     QString createdOpInstance;
     
-    if (0 != _parent) {
+    if (_bulkLoad) {
+        BulkCallback<NtCreateCallback> cb;
+        NiPushRequestCallback(&cb);
+        NiCreate(type, name);
+
+        if (cb.querySuccess()) {
+            createdOpInstance = fromNbStr(cb.opInstance);
+            _bulkOpInstances.append(createdOpInstance);
+            _bulkOpInstanceSet.insert(createdOpInstance);
+        }
+    }
+    else if (0 != _parent) {
         NsCmdCreate::exec(fromNbStr(type),
                           suggestedOpInstance,
                           *_parent,
@@ -144,7 +200,12 @@ NsParserCallback::setGroupPlug(const NtString& plugLongName,
     const QString renamedPlugLongName = 
         opInstance + QString(":") + plugName;
 
-    if (0 != _parent) {
+    if (_isBulkLoaded(opInstance)) {
+        BulkCallback<NtSetGroupPlugCallback> cb;
+        NiPushRequestCallback(&cb);
+        NiSetGroupPlug(fromQStr(renamedPlugLongName), groupEnabled);
+    }
+    else if (0 != _parent) {
         NsCmdSetGroupPlug::exec(renamedPlugLongName,
                                 groupEnabled,
                                 *_parent);
@@ -202,7 +263,14 @@ NsParserCallback::setParam(const NtString    &longName,
         }
     }
 
-    if (0 != _parent) {
+    if (_isBulkLoaded(opInstance)) {
+        BulkCallback<NtSetParamCallback> cb;
+        NiPushRequestCallback(&cb);
+        NiSetParam(fromQStr(queryParamLongName(opInstance, paramName)),
+                   fromQStr(qExpr),
+                   comp);
+    }
+    else if (0 != _parent) {
         NsCmdSetParam::exec(
             NsCmdSetParam::ArgsList() <<
                 NsCmdSetParam::Args(
@@ -287,7 +355,17 @@ NsParserCallback::feed(const NtString &terminal,
                 outputPlugName);
 
     if (queryValidFeed(inputPlugLongName, outputPlugLongName)) {
-        if (0 != _parent) {
+        if (_bulkLoad) {
+            BulkCallback<NtFeedCallback> cb;
+            NiPushRequestCallback(&cb);
+            NiFeed(fromQStr(inputPlugLongName), fromQStr(outputPlugLongName));
+
+            if (cb.querySuccess()) {
+                _bulkFeeds.append(
+                    qMakePair(inputPlugLongName, outputPlugLongName));
+            }
+        }
+        else if (0 != _parent) {
             NsCmdFeed::exec(inputPlugLongName,
                             outputPlugLongName,
                             *_parent);
@@ -366,6 +444,40 @@ NsParserCallback::createdOpPositionBounds(QPointF &min, QPointF &max) const
     }
 }
 
+
+// endBulkLoad
+// -----------
+//! Finish a bulk load. Announces the created Ops and their feeds, now that
+//! they are fully configured, and then emits a single graph loaded
+//! notification in place of all the value and meta notifications that
+//! were skipped. Does nothing if not in bulk load mode.
+
+void
+NsParserCallback::endBulkLoad()
+{
+    if (!_bulkLoad) {
+        return;
+    }
+
+    NsCmdCentral *cc = NsCmdCentral::instance();
+    cc->beginBulkLoad();
+
+    foreach (const QString &opInstance, _bulkOpInstances) {
+        cc->onOpCreated(opInstance, true);
+    }
+
+    typedef QPair<QString,QString> FeedType;
+    foreach (const FeedType &feed, _bulkFeeds) {
+        cc->onFeedChanged(feed.first, feed.second, true);
+    }
+
+    cc->endBulkLoad(_bulkOpInstances, true);
+
+    _bulkOpInstances.clear();
+    _bulkOpInstanceSet.clear();
+    _bulkFeeds.clear();
+}
+
 // -----------------------------------------------------------------------------
 
 // _isCreated
@@ -391,6 +503,42 @@ NsParserCallback::_createdOpInstance(const QString &opInstance) const
 }
 
 
+// _isBulkLoaded
+// -------------
+//! Returns true if the given Op was created by this callback in bulk load
+//! mode, i.e. it can be configured without commands or notifications.
+
+bool
+NsParserCallback::_isBulkLoaded(const QString &opInstance) const
+{
+    return _bulkLoad && _bulkOpInstanceSet.contains(opInstance);
+}
+
+
+// _execSetMeta
+// ------------
+//! Set a meta value, directly in NI for bulk loaded Ops and through a
+//! command otherwise.
+
+void
+NsParserCallback::_execSetMeta(const QString &metaLongName,
+                               const QString &valueType,
+                               const QString &value)
+{
+    if (_isBulkLoaded(metaLongName.section('.', 0, 0))) {
+        BulkCallback<NtSetMetaCallback> cb;
+        NiPushRequestCallback(&cb);
+        NiSetMeta(fromQStr(metaLongName), fromQStr(valueType), fromQStr(value));
+    }
+    else if (0 != _parent) {
+        NsCmdSetMeta::exec(metaLongName, valueType, value, *_parent);
+    }
+    else {
+        NsCmdSetMeta::exec(metaLongName, valueType, value);
+    }
+}
+
+
 // _setMeta
 // --------
 //! Set a meta value.
@@ -413,30 +561,14 @@ NsParserCallback::_setMeta(const QString &metaLongName,
         std::stringstream ss;
         ss << fromQStr(_cachedx) << "," << fromQStr(value);
         pos = fromNbStr(ss.str());
-        
-        if (0 != _parent) {
-            NsCmdSetMeta::exec(metaLongName, "Pos", pos, *_parent);
-        }
-        else {
-            NsCmdSetMeta::exec(metaLongName, "Pos", pos);
-        }
+        _execSetMeta(metaLongName, "Pos", pos);
     }
     else {
         if ("Pos" == valueType) {  
             pos = value;
         }
 
-        if (0 != _parent) {
-            NsCmdSetMeta::exec(metaLongName,
-                               valueType,
-                               value,
-                               *_parent);
-        }
-        else {
-            NsCmdSetMeta::exec(metaLongName,
-                               valueType,
-                               value);
-        }
+        _execSetMeta(metaLongName, valueType, value);
     }
 
     if (!pos.isEmpty()) {
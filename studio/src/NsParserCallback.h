@@ -44,6 +44,8 @@
 
 #include <Ni.h>
 #include <QMap>
+#include <QSet>
+#include <QPair>
 #include <QString>
 #include <QPointF>
 #include <QStringList>
@@ -58,6 +60,11 @@ class QUndoCommand;
 //! callback. Creates objects in the Naiad graph, as well as in the Naiad
 //! Studio graph. Basically a translator between NI-commands and Naiad Studio
 //! commands.
+//!
+//! In bulk load mode the created Ops are configured directly through NI,
+//! without commands or notifications. The creation and feed notifications
+//! are replayed by endBulkLoad(), followed by a single graphLoaded().
+//! No undo commands are recorded for the bulk loaded Ops.
 
 class NsParserCallback : public NtParserCallback
 {
@@ -65,7 +72,8 @@ public:
 
     explicit
     NsParserCallback(bool          bodyNameOverride,
-                     QUndoCommand *parent                 = 0);
+                     QUndoCommand *parent                 = 0,
+                     bool          bulkLoad               = false);
 
     //! DTOR.
     virtual
@@ -132,6 +140,9 @@ public:
     void
     createdOpPositionBounds(QPointF &min, QPointF &max) const;
 
+    void
+    endBulkLoad();
+
 private:
 
     bool
@@ -140,6 +151,14 @@ private:
     QString
     _createdOpInstance(const QString &opInstance) const;
 
+    bool
+    _isBulkLoaded(const QString &opInstance) const;
+
+    void
+    _execSetMeta(const QString &metaLongName,
+                 const QString &valueType,
+                 const QString &value);
+
     void
     _setMeta(const QString &metaLongName,
              const QString &valueType,
@@ -151,6 +170,14 @@ private:    // Member variables.
 
     bool _bodyNameOverride;
     bool _opPositionOverride;
+    bool _bulkLoad;
+
+    //! Ops created in bulk load mode, in creation order.
+    QStringList   _bulkOpInstances;
+    QSet<QString> _bulkOpInstanceSet;
+
+    //! Feeds made in bulk load mode, as (input, plug) long names.
+    QList<QPair<QString,QString> > _bulkFeeds;
 
     //! Map suggested Op instances to the actually created ones.
     QMap<QString,QString>  _createdOpInstances;
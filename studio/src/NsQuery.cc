@@ -40,6 +40,11 @@
 
 #include "NsQuery.h"
 #include "NsStringUtils.h"
+#include "NsGraphCallback.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QHash>
+#include <QVariant>
 #include <QDebug>
 #include <Ni.h>     // TODO: NiQuery.h?
 #include <NiNb.h>
@@ -53,6 +58,55 @@ const QString _bodyLongNameSeparator("~");
 
 //! Separator character in plug long names.
 const QString _plugLongNameSeparator(":");
+
+//! Last results of read-only queries made by the GUI thread, see _recall().
+//! Only accessed from the GUI thread.
+QHash<QString, QVariant> _memo;
+
+//! True if called from the GUI thread.
+bool
+_guiThread()
+{
+    const QCoreApplication *app(QCoreApplication::instance());
+    return (0 != app && QThread::currentThread() == app->thread());
+}
+
+//! Fetches the last result of a read-only query made by the GUI thread if
+//! the solver is inside an op, so that e.g. the 3D view can be repainted
+//! without waiting for the op to end. Results are remembered regardless of
+//! the time they were evaluated at. Returns false if NI must be queried.
+template <typename T>
+bool
+_recall(const QString &key, T *value)
+{
+    if (!_guiThread()) {
+        return false;
+    }
+
+    const NsGraphCallback::NiLocker locker(NsGraphCallback::NiLocker::Try);
+    if (locker.isLocked()) {
+        return false;   // NI is available.
+    }
+
+    const QHash<QString, QVariant>::const_iterator iter(_memo.constFind(key));
+    if (_memo.constEnd() == iter) {
+        return false;   // Never queried, have to wait.
+    }
+
+    *value = qvariant_cast<T>(*iter);
+    return true;
+}
+
+//! Stores the result of a read-only query made by the GUI thread.
+template <typename T>
+T
+_remember(const QString &key, const T &value)
+{
+    if (_guiThread()) {
+        _memo.insert(key, qVariantFromValue(value));
+    }
+    return value;
+}
 }   // Namespace: anonymous.
 
 // -----------------------------------------------------------------------------
@@ -66,6 +120,8 @@ const QString _plugLongNameSeparator(":");
 QStringList
 queryParamNames(const QString &name, const QString &sectionName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStrList(
@@ -83,6 +139,8 @@ queryParamNames(const QString &name, const QString &sectionName)
 QString
 queryParamTypeName(const QString &name, const QString &paramName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(
@@ -100,6 +158,8 @@ queryParamTypeName(const QString &name, const QString &paramName)
 QString
 queryParamSubTypeName(const QString &name, const QString &paramName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(
@@ -117,12 +177,22 @@ queryParamSubTypeName(const QString &name, const QString &paramName)
 QString
 queryParamLongName(const QString &opInstance, const QString &paramName)
 {
+    const QString key("queryParamLongName:" + opInstance + ":" + paramName);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
-    return fromNbStr(
-        NiQueryParamLongName(
-            fromQStr(opInstance),
-            fromQStr(paramName)));
+    return _remember<QString>(
+        key,
+        fromNbStr(
+            NiQueryParamLongName(
+                fromQStr(opInstance),
+                fromQStr(paramName))));
 }
 
 
@@ -135,6 +205,8 @@ queryParamEnumGroupName(const QString &queryType,
                         const QString &name,
                         const QString &paramName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(
@@ -154,6 +226,8 @@ queryParamEnumItemNames(const QString &queryType,
                         const QString &name,
                         const QString &enumGroupName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStrList(
@@ -172,6 +246,8 @@ QString
 queryParam(const QString     &paramLongName,
            const NtComponent  component)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(NiQueryParam(fromQStr(paramLongName), component));
@@ -187,6 +263,8 @@ queryParam(const QString &opInstance,
            const QString &paramName,
            const int      comp)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(
@@ -203,6 +281,7 @@ queryParam(const QString &opInstance,
 bool
 queryParamExists(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryParamExists(fromQStr(paramLongName)));
 }
 
@@ -214,6 +293,8 @@ queryParamExists(const QString &paramLongName)
 bool
 queryParamReadOnly(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return (NI_TRUE == NiQueryParamReadOnly(fromQStr(paramLongName)));
@@ -227,6 +308,8 @@ queryParamReadOnly(const QString &paramLongName)
 bool
 queryParamHidden(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return (NI_TRUE == NiQueryParamHidden(fromQStr(paramLongName)));
@@ -252,6 +335,7 @@ queryParamHidden(const QString &opInstance,
 int
 queryParamLimit1i(const QString &paramLongName, const QString &limitType)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1i(fromQStr(paramLongName), fromQStr(limitType));
 }
 
@@ -263,6 +347,7 @@ queryParamLimit1i(const QString &paramLongName, const QString &limitType)
 float
 queryParamLimit1f(const QString &paramLongName, const QString &limitType)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1f(fromQStr(paramLongName), fromQStr(limitType));
 }
 
@@ -276,6 +361,7 @@ queryParamLimit3f(const QString &paramLongName,
                   const QString &limitType,
                   const int      comp)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit3f(fromQStr(paramLongName),
                                fromQStr(limitType),
                                comp);
@@ -289,6 +375,7 @@ queryParamLimit3f(const QString &paramLongName,
 int
 queryParamHardMin1i(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1i(fromQStr(paramLongName),NI_PARAM_RANGE_HARD_MIN);
 }
 
@@ -300,6 +387,7 @@ queryParamHardMin1i(const QString &paramLongName)
 int
 queryParamHardMax1i(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1i(fromQStr(paramLongName),NI_PARAM_RANGE_HARD_MAX);
 }
 
@@ -311,6 +399,7 @@ queryParamHardMax1i(const QString &paramLongName)
 int
 queryParamSoftMin1i(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1i(fromQStr(paramLongName),NI_PARAM_RANGE_SOFT_MIN);
 }
 
@@ -322,6 +411,7 @@ queryParamSoftMin1i(const QString &paramLongName)
 int
 queryParamSoftMax1i(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1i(fromQStr(paramLongName),NI_PARAM_RANGE_SOFT_MAX);
 }
 
@@ -333,6 +423,7 @@ queryParamSoftMax1i(const QString &paramLongName)
 float
 queryParamHardMin1f(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1f(fromQStr(paramLongName),NI_PARAM_RANGE_HARD_MIN);
 }
 
@@ -344,6 +435,7 @@ queryParamHardMin1f(const QString &paramLongName)
 float
 queryParamHardMax1f(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1f(fromQStr(paramLongName),NI_PARAM_RANGE_HARD_MAX);
 }
 
@@ -355,6 +447,7 @@ queryParamHardMax1f(const QString &paramLongName)
 float
 queryParamSoftMin1f(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1f(fromQStr(paramLongName),NI_PARAM_RANGE_SOFT_MIN);
 }
 
@@ -366,12 +459,14 @@ queryParamSoftMin1f(const QString &paramLongName)
 float
 queryParamSoftMax1f(const QString &paramLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryParamLimit1f(fromQStr(paramLongName),NI_PARAM_RANGE_SOFT_MAX);
 }
 
 // -----------------------------------------------------------------------------
 
-// Parameter evaluation.
+// Parameter evaluation. While the solver is inside an op the GUI thread is
+// given the last value of the parameter, evaluated at any time.
 
 // evalParam1f
 // -----------
@@ -380,7 +475,14 @@ queryParamSoftMax1f(const QString &paramLongName)
 float
 evalParam1f(const QString &paramLongName, const NtTimeBundle& tb)
 {
-    return NiEvalParam1f(fromQStr(paramLongName), tb);
+    const QString key("evalParam1f:" + paramLongName);
+    float value(0.f);
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<float>(key, NiEvalParam1f(fromQStr(paramLongName), tb));
 }
 
 
@@ -393,7 +495,16 @@ evalParam3f(const QString&      paramLongName,
             const int           comp,
             const NtTimeBundle& tb)
 {
-    return NiEvalParam3f(fromQStr(paramLongName), comp, tb);
+    const QString key(
+        QString("evalParam3f:%1:%2").arg(paramLongName).arg(comp));
+    float value(0.f);
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<float>(
+        key, NiEvalParam3f(fromQStr(paramLongName), comp, tb));
 }
 
 
@@ -405,7 +516,14 @@ int
 evalParam1i(const QString&      paramLongName, 
             const NtTimeBundle& tb)
 {
-    return NiEvalParam1i(fromQStr(paramLongName), tb);
+    const QString key("evalParam1i:" + paramLongName);
+    int value(0);
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<int>(key, NiEvalParam1i(fromQStr(paramLongName), tb));
 }
 
 
@@ -417,7 +535,15 @@ QString
 evalParam1s(const QString&      paramLongName,
             const NtTimeBundle& tb)
 {
-    return fromNbStr(NiEvalParam1s(fromQStr(paramLongName), tb));
+    const QString key("evalParam1s:" + paramLongName);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<QString>(
+        key, fromNbStr(NiEvalParam1s(fromQStr(paramLongName), tb)));
 }
 
 
@@ -428,7 +554,15 @@ evalParam1s(const QString&      paramLongName,
 QString
 evalParam1e(const QString &paramLongName, const NtTimeBundle& tb)
 {
-    return fromNbStr(NiEvalParam1e(fromQStr(paramLongName), tb));
+    const QString key("evalParam1e:" + paramLongName);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<QString>(
+        key, fromNbStr(NiEvalParam1e(fromQStr(paramLongName), tb)));
 }
 
 
@@ -436,6 +570,7 @@ bool
 queryNumericConstantParam(const QString     &paramLongName,
                           const NtComponent  component)
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryNumericConstantParam(fromQStr(paramLongName),
                                                    component));
 }
@@ -461,7 +596,7 @@ NtTimeBundle
 queryFrameTimeBundle(const int frame)
 {
     NtTimeBundle tb(frame, 0, 0, 0, 0, 0, true);
-    const double frame_dt = 1./NiEvalParam1i("Global.Fps", tb);
+    const double frame_dt = 1./evalParam1i("Global.Fps", tb);
     tb.frame_dt=frame_dt;
     tb.dt=frame_dt;
     tb.time=frame*frame_dt;
@@ -489,7 +624,14 @@ queryCurrentVisibleFrameTimeBundle()
 NtTimeBundle
 queryTimeBundle()
 {
-    return NiQueryTimeBundle();
+    const QString key("queryTimeBundle");
+    NtTimeBundle value(Nb::ZeroTimeBundle);
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<NtTimeBundle>(key, NiQueryTimeBundle());
 }
 
 
@@ -500,7 +642,7 @@ queryTimeBundle()
 bool
 queryIsFrameLive(const NtTimeBundle &ftb)
 {
-    const NtTimeBundle cstb = NiQueryTimeBundle();   // Current server time.
+    const NtTimeBundle cstb = queryTimeBundle();     // Current server time.
     return (cstb.frame == ftb.frame && queryStepped());
 }
 
@@ -523,7 +665,14 @@ queryIsFrameLive(const int frame)
 bool
 queryStepped()
 {
-    return (NI_TRUE == NiQueryStepped());
+    const QString key("queryStepped");
+    bool value(false);
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<bool>(key, NI_TRUE == NiQueryStepped());
 }
 
 
@@ -534,6 +683,7 @@ queryStepped()
 bool
 queryStepping()
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryStepping());
 }
 
@@ -550,6 +700,7 @@ queryOpNames(const QString &queryType,
              const QString &opClass, 
              const bool     includeHidden)
 {
+    const NsGraphCallback::NiLocker locker;
     return fromNbStrList(
         NiQueryOpNames(fromQStr(queryType), fromQStr(opClass), includeHidden));
 }
@@ -632,6 +783,8 @@ queryOpMemberNames(const QString &queryType,
                    const QString &name,
                    const QString &member)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStrList(
@@ -764,6 +917,7 @@ queryOpTypeCategories(const QString &opType)
 bool
 queryOpInstanceExists(const QString &opInstance)
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryOpInstanceExists(fromQStr(opInstance)));
 }
 
@@ -775,6 +929,8 @@ queryOpInstanceExists(const QString &opInstance)
 QString
 queryOpTypeName(const QString &opInstance)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(NiQueryTypeName(fromQStr(opInstance)));
@@ -788,6 +944,8 @@ queryOpTypeName(const QString &opInstance)
 QString
 queryOpClassName(const QString &opInstance)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(NiQueryClassName(fromQStr(opInstance)));
@@ -801,6 +959,8 @@ queryOpClassName(const QString &opInstance)
 QString
 queryOpFamilyName(const QString &queryType, const QString &name)
 {
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
     return fromNbStr(NiQueryFamilyName(fromQStr(queryType), fromQStr(name)));
@@ -836,9 +996,18 @@ queryOpTypeFamilyName(const QString &opType)
 QString
 queryOpState(const QString &opInstance)
 {
+    const QString key("queryOpState:" + opInstance);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
-    return fromNbStr(NiQueryOpState(fromQStr(opInstance)));
+    return _remember<QString>(
+        key, fromNbStr(NiQueryOpState(fromQStr(opInstance))));
 }
 
 
@@ -849,6 +1018,7 @@ queryOpState(const QString &opInstance)
 QStringList
 queryUpstreamOpNames(const QString &opInstance, const bool includeRoot)
 {
+    const NsGraphCallback::NiLocker locker;
     return fromNbStrList(
             NiQueryUpstreamOpNames(fromQStr(opInstance), includeRoot));
 }
@@ -864,6 +1034,7 @@ queryUpstreamOpNames(const QString &opInstance, const bool includeRoot)
 bool
 queryValidFeed(const QString &inputLongName, const QString &plugLongName)
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryValidFeed(fromQStr(inputLongName),
                                         fromQStr(plugLongName)));
 }
@@ -878,6 +1049,8 @@ queryFeeds(const QString &opInstance,
            QSet<QString> &feeds,
            const bool     includeDummies)
 {
+    const NsGraphCallback::NiLocker locker;
+
     NtStringSet ntStrSet;
     NiQueryFeeds(fromQStr(opInstance), ntStrSet, includeDummies);
     feeds += fromNbStrSet(ntStrSet);
@@ -892,6 +1065,7 @@ int
 queryDummyFeedCount(const QString &plugLongName,
                     const bool     includeDownstreamInputs)
 {
+    const NsGraphCallback::NiLocker locker;
     return NiQueryDummyFeedCount(fromQStr(plugLongName),
                                  includeDownstreamInputs);
 }
@@ -904,7 +1078,15 @@ queryDummyFeedCount(const QString &plugLongName,
 QString
 queryFeedingBodyOutput(const QString &plugLongName)
 {
-    return fromNbStr(NiQueryFeedingBodyOutput(fromQStr(plugLongName)));
+    const QString key("queryFeedingBodyOutput:" + plugLongName);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<QString>(
+        key, fromNbStr(NiQueryFeedingBodyOutput(fromQStr(plugLongName))));
 }
 
 // -----------------------------------------------------------------------------
@@ -920,6 +1102,7 @@ queryIsGroupPlug(const QString &queryType,
                  const QString &name, 
                  const QString &plugName)
 {
+    const NsGraphCallback::NiLocker locker;
     return (NI_TRUE == NiQueryIsGroupPlug(fromQStr(queryType), 
                                           fromQStr(name), 
                                           fromQStr(plugName)));
@@ -945,8 +1128,17 @@ queryOpTypeIsGroupPlug(const QString &opType, const QString &plugName)
 QString
 queryPlugLongName(const QString &opInstance, const QString &plugName)
 {
-    return fromNbStr(NiQueryPlugLongName(fromQStr(opInstance),
-                                         fromQStr(plugName)));
+    const QString key("queryPlugLongName:" + opInstance + ":" + plugName);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+    return _remember<QString>(
+        key,
+        fromNbStr(NiQueryPlugLongName(fromQStr(opInstance),
+                                      fromQStr(plugName))));
 }
 
 
@@ -957,6 +1149,7 @@ queryPlugLongName(const QString &opInstance, const QString &plugName)
 QString
 queryPlugSignatureName(const QString &opType, const QString &plugName)
 {
+    const NsGraphCallback::NiLocker locker;
     return fromNbStr(NiQueryPlugSignatureName(fromQStr(opType), 
                                               fromQStr(plugName)));
 }
@@ -1019,6 +1212,7 @@ queryPlugOpInstance(const QString &plugLongName, QString *plugName)
 QString
 queryVersion()
 {
+    const NsGraphCallback::NiLocker locker;
     return fromNbStr(NiQueryVersion());
 }
 
@@ -1039,9 +1233,18 @@ QString
 queryMeta(const QString &longName,
           const QString &valueType)
 {
+    const QString key("queryMeta:" + longName + ":" + valueType);
+    QString value;
+    if (_recall(key, &value)) {
+        return value;
+    }
+
+    const NsGraphCallback::NiLocker locker;
+
     // Assume successful query.
 
-    return fromNbStr(NiQueryMeta(fromQStr(longName), fromQStr(valueType)));
+    return _remember<QString>(
+        key, fromNbStr(NiQueryMeta(fromQStr(longName), fromQStr(valueType))));
 }
 
 
@@ -1143,6 +1346,8 @@ queryCachedBodies(const QString      &opInstance,
                   const NtTimeBundle &tb, 
                   bool                applyBodyNamePattern)
 {
+    const NsGraphCallback::NiLocker locker;
+
     typedef std::vector<Nb::Body*> BodyVectorType;
     typedef BodyVectorType::const_iterator BodyIterType;
 
@@ -1167,6 +1372,7 @@ queryCachedBodyNames(const QString      &opInstance,
                      const NtTimeBundle &tb, 
                      const bool          applyBodyNamePattern)
 {
+    const NsGraphCallback::NiLocker locker;
     return fromNbStrList(
         NiQueryCachedBodyNames(fromQStr(opInstance), applyBodyNamePattern, tb));
 
@@ -1191,6 +1397,8 @@ initCachedBodies(const QString      &opInstance,
                       const bool          applyBodyNamePattern,
                       bool               *ok)
 {
+    const NsGraphCallback::NiLocker locker;
+
     NtBool ntOk(false);
     const bool result(
         NiInitCachedBodies(fromQStr(opInstance),
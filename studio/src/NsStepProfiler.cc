@@ -0,0 +1,418 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepProfiler.cc
+//
+// Naiad Studio stepping profiler, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "NsStepProfiler.h"
+#include "Ns3DProfiler.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+
+// instance
+// --------
+//! Provide access to singleton. [static]
+
+NsStepProfiler*
+NsStepProfiler::instance()
+{
+    if (0 == _instance) {
+        createInstance();
+    }
+
+    return _instance;
+}
+
+
+// createInstance
+// --------------
+//! Reset singleton. [static]
+
+void
+NsStepProfiler::createInstance()
+{
+    destroyInstance();
+    _instance = new NsStepProfiler;
+}
+
+
+// destroyInstance
+// ---------------
+//! Reset singleton. [static]
+
+void
+NsStepProfiler::destroyInstance()
+{
+    delete _instance;
+    _instance = 0;
+}
+
+
+//! Singleton pointer. [static]
+NsStepProfiler *NsStepProfiler::_instance = 0;
+
+// -----------------------------------------------------------------------------
+
+// NsStepProfiler
+// --------------
+//! CTOR.
+
+NsStepProfiler::NsStepProfiler()
+    : QObject()
+    , _enabled(true)
+    , _maxSteps(32)
+    , _firstSerial(0)
+    , _stepOpen(false)
+    , _trailing(false)
+{
+    _clear();
+}
+
+// -----------------------------------------------------------------------------
+
+// isEnabled
+// ---------
+//! Returns true if ranges are being recorded.
+
+bool
+NsStepProfiler::isEnabled() const
+{
+    QMutexLocker locker(&_mutex);
+    return _enabled;
+}
+
+
+// setEnabled
+// ----------
+//! Start or stop recording. Recorded steps are kept.
+
+void
+NsStepProfiler::setEnabled(const bool enabled)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (enabled != _enabled) {
+        _enabled = enabled;
+        _stepOpen = false;
+        _trailing = false;
+
+        for (int lane = 0; lane < LaneCount; ++lane) {
+            _open[lane].clear();
+        }
+    }
+}
+
+
+// maxSteps
+// --------
+//! Returns the number of timesteps kept.
+
+int
+NsStepProfiler::maxSteps() const
+{
+    QMutexLocker locker(&_mutex);
+    return _maxSteps;
+}
+
+
+// setMaxSteps
+// -----------
+//! Set the number of timesteps kept. Older steps are dropped.
+
+void
+NsStepProfiler::setMaxSteps(const int maxSteps)
+{
+    {
+        QMutexLocker locker(&_mutex);
+
+        _maxSteps = std::max(1, maxSteps);
+        while (_maxSteps < _steps.size()) {
+            _steps.removeFirst();
+            ++_firstSerial;
+        }
+    }
+
+    emit changed();
+}
+
+
+// beginTimeStep
+// -------------
+//! Start a new timestep. The oldest timestep is dropped if the store is
+//! full. Called on the solver thread.
+
+void
+NsStepProfiler::beginTimeStep(const NtTimeBundle &tb)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (!_enabled) {
+        return;
+    }
+
+    Step step;
+    step.frame = tb.frame;
+    step.timestep = tb.timestep;
+    step.beginMs = Ns3DProfiler::nowMs();
+    step.endMs = -1.;
+    _steps.append(step);
+
+    while (_maxSteps < _steps.size()) {
+        _steps.removeFirst();
+        ++_firstSerial;
+    }
+
+    // Ranges still open on the solver lane belong to the previous step.
+
+    _open[SolverLane].clear();
+    _stepOpen = true;
+    _trailing = false;
+}
+
+
+// endTimeStep
+// -----------
+//! End the current timestep. GUI ranges are added to it until the next
+//! timestep begins. Called on the solver thread.
+
+void
+NsStepProfiler::endTimeStep()
+{
+    {
+        QMutexLocker locker(&_mutex);
+
+        if (!_enabled || !_stepOpen || _steps.isEmpty()) {
+            return;
+        }
+
+        const double now(Ns3DProfiler::nowMs());
+        Step &step(_steps.last());
+        step.endMs = now;
+
+        // Close unbalanced solver ranges.
+
+        foreach (const _OpenRange &open, _open[SolverLane]) {
+            Step *s(_step(open.serial));
+            if (0 != s) {
+                s->ranges[open.index].endMs = now;
+            }
+        }
+
+        _open[SolverLane].clear();
+        _stepOpen = false;
+        _trailing = true;
+    }
+
+    emit changed();
+}
+
+
+// endStep
+// -------
+//! Stepping has ended, stop adding GUI ranges to the last timestep.
+
+void
+NsStepProfiler::endStep()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _trailing = false;
+    }
+
+    emit changed();
+}
+
+
+// beginRange
+// ----------
+//! Start a range on the given lane. Ranges nest within a lane and are
+//! ignored outside timesteps.
+
+void
+NsStepProfiler::beginRange(const Lane lane, const QString &name)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (!_enabled || (!_stepOpen && !_trailing) || _steps.isEmpty()) {
+        _OpenRange ignored;
+        ignored.serial = -1;
+        ignored.index = -1;
+        _open[lane].append(ignored);    // Keep begin/end balanced.
+        return;
+    }
+
+    Step &step(_steps.last());
+
+    Range range;
+    range.name = name;
+    range.lane = lane;
+    range.depth = _open[lane].size();
+    range.beginMs = Ns3DProfiler::nowMs();
+    range.endMs = -1.;
+    step.ranges.append(range);
+
+    _OpenRange open;
+    open.serial = _firstSerial + _steps.size() - 1;
+    open.index = step.ranges.size() - 1;
+    _open[lane].append(open);
+}
+
+
+// endRange
+// --------
+//! End the innermost open range on the given lane and add its time to the
+//! session totals.
+
+void
+NsStepProfiler::endRange(const Lane lane)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (_open[lane].isEmpty()) {
+        return;
+    }
+
+    const _OpenRange open(_open[lane].last());
+    _open[lane].pop_back();
+
+    Step *step(_step(open.serial));
+    if (0 == step) {
+        return;     // Ignored, or dropped from the store.
+    }
+
+    Range &range(step->ranges[open.index]);
+    range.endMs = Ns3DProfiler::nowMs();
+
+    const double ms(range.endMs - range.beginMs);
+    Total &total(_totals[lane][range.name]);
+    total.ms += ms;
+    ++total.count;
+
+    if (0 == range.depth) {
+        _laneTotalMs[lane] += ms;
+    }
+}
+
+
+// steps
+// -----
+//! Returns a copy of the stored timesteps, oldest first.
+
+QList<NsStepProfiler::Step>
+NsStepProfiler::steps() const
+{
+    QMutexLocker locker(&_mutex);
+    return _steps;
+}
+
+
+// totals
+// ------
+//! Returns the session totals of the ranges on the given lane, by name.
+
+NsStepProfiler::TotalHashType
+NsStepProfiler::totals(const Lane lane) const
+{
+    QMutexLocker locker(&_mutex);
+    return _totals[lane];
+}
+
+
+// laneTotalMs
+// -----------
+//! Returns the session total of the outermost ranges on the given lane.
+
+double
+NsStepProfiler::laneTotalMs(const Lane lane) const
+{
+    QMutexLocker locker(&_mutex);
+    return _laneTotalMs[lane];
+}
+
+
+// clear
+// -----
+//! Discard stored timesteps and session totals. [slot]
+
+void
+NsStepProfiler::clear()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _clear();
+    }
+
+    emit changed();
+}
+
+// -----------------------------------------------------------------------------
+
+// _step
+// -----
+//! Returns the stored step with the given serial, or null if it has been
+//! dropped. Requires the mutex to be locked.
+
+NsStepProfiler::Step*
+NsStepProfiler::_step(const int serial)
+{
+    const int i(serial - _firstSerial);
+    return (0 <= serial && 0 <= i && i < _steps.size() ? &_steps[i] : 0);
+}
+
+
+// _clear
+// ------
+//! Requires the mutex to be locked.
+
+void
+NsStepProfiler::_clear()
+{
+    _firstSerial += _steps.size();
+    _steps.clear();
+    _stepOpen = false;
+    _trailing = false;
+
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        _open[lane].clear();
+        _totals[lane].clear();
+        _laneTotalMs[lane] = 0.;
+    }
+}
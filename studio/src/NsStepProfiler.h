@@ -0,0 +1,242 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepProfiler.h
+//
+// Naiad Studio stepping profiler, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS_STEP_PROFILER_H
+#define NS_STEP_PROFILER_H
+
+#include <NiTypes.h>
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+// NsStepProfiler
+// --------------
+//! Collects wall times of the most recent timesteps for the session. Each
+//! timestep holds nested ranges on two lanes: the solver lane, with the ops
+//! stepped by Naiad, and the GUI lane, with the work Studio does on the GUI
+//! thread, e.g. cloning live bodies and redrawing the scopes. Per-name
+//! totals are kept for the whole session, i.e. until the graph is reset.
+//!
+//! Solver ranges are recorded on the solver thread, GUI ranges on the GUI
+//! thread, so all access is serialized. GUI ranges that follow the end of
+//! a timestep, e.g. the redraw it triggers, are added to that timestep
+//! until the next one begins or stepping ends.
+
+class NsStepProfiler : public QObject
+{
+    Q_OBJECT
+
+public:     // Singleton interface.
+
+    static NsStepProfiler*
+    instance();
+
+    static void
+    createInstance();
+
+    static void
+    destroyInstance();
+
+private:
+
+    static NsStepProfiler *_instance;
+
+public:
+
+    enum Lane
+    {
+        SolverLane = 0,
+        GuiLane,
+        LaneCount
+    };
+
+    struct Range
+    {
+        QString name;
+        int     lane;
+        int     depth;          //!< Nesting level within lane.
+        double  beginMs;
+        double  endMs;          //!< Negative while open.
+    };
+
+    struct Step
+    {
+        int            frame;
+        int            timestep;
+        double         beginMs;
+        double         endMs;   //!< Negative while open.
+        QVector<Range> ranges;
+    };
+
+    struct Total
+    {
+        Total()
+            : ms(0.), count(0)
+        {}
+
+        double ms;
+        int    count;
+    };
+
+    typedef QHash<QString, Total> TotalHashType;
+
+public:
+
+    bool
+    isEnabled() const;
+
+    void
+    setEnabled(bool enabled);
+
+    int
+    maxSteps() const;
+
+    void
+    setMaxSteps(int maxSteps);
+
+    void
+    beginTimeStep(const NtTimeBundle &tb);
+
+    void
+    endTimeStep();
+
+    void
+    endStep();
+
+    void
+    beginRange(Lane lane, const QString &name);
+
+    void
+    endRange(Lane lane);
+
+    QList<Step>
+    steps() const;
+
+    TotalHashType
+    totals(Lane lane) const;
+
+    double
+    laneTotalMs(Lane lane) const;
+
+public slots:
+
+    void
+    clear();
+
+signals:
+
+    void
+    changed();
+
+public:
+
+    // Scope
+    // -----
+    //! Records a range for the duration of its scope.
+
+    class Scope
+    {
+    public:
+
+        Scope(const Lane lane, const QString &name)
+            : _lane(lane)
+        { NsStepProfiler::instance()->beginRange(_lane, name); }
+
+        ~Scope()
+        { NsStepProfiler::instance()->endRange(_lane); }
+
+    private:
+
+        Lane _lane;
+
+        Scope(const Scope&);            //!< Disabled.
+        Scope& operator=(const Scope&); //!< Disabled.
+    };
+
+private:
+
+    explicit
+    NsStepProfiler();
+
+    //! DTOR.
+    virtual
+    ~NsStepProfiler()
+    {}
+
+    Step*
+    _step(int serial);
+
+    void
+    _clear();
+
+private:    // Member variables.
+
+    struct _OpenRange
+    {
+        int serial;             //!< Serial of step holding range.
+        int index;              //!< Index of range within step.
+    };
+
+    mutable QMutex _mutex;
+
+    bool        _enabled;
+    int         _maxSteps;
+    QList<Step> _steps;         //!< Oldest first.
+    int         _firstSerial;   //!< Serial of first step in list.
+    bool        _stepOpen;      //!< True between begin and end of timestep.
+    bool        _trailing;      //!< True until next timestep or end of step.
+
+    QVector<_OpenRange> _open[LaneCount];   //!< Stacks of open ranges.
+    TotalHashType       _totals[LaneCount];
+    double              _laneTotalMs[LaneCount];
+
+private:
+
+    NsStepProfiler(const NsStepProfiler&);            //!< Disabled.
+    NsStepProfiler& operator=(const NsStepProfiler&); //!< Disabled.
+};
+
+#endif // NS_STEP_PROFILER_H
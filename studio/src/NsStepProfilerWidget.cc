@@ -0,0 +1,408 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepProfilerWidget.cc
+//
+// Naiad Studio stepping profiler widget, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "NsStepProfilerWidget.h"
+#include "Ns3DProfiler.h"
+
+#include <QCheckBox>
+#include <QEvent>
+#include <QHBoxLayout>
+#include <QHelpEvent>
+#include <QLabel>
+#include <QPainter>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QToolTip>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+
+// NsStepProfilerWidget::_Chart
+// ----------------------------
+//! Draws the flame chart. Each stored range becomes a bar, placed in the
+//! row given by its lane and depth, so that a slow step shows at a glance
+//! whether its time went to the solver or to Studio.
+
+class NsStepProfilerWidget::_Chart : public QWidget
+{
+public:
+
+    explicit
+    _Chart(QWidget *parent = 0)
+        : QWidget(parent)
+    {
+        setMinimumHeight(4*_rowHeight);
+        setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    }
+
+protected:
+
+    virtual bool
+    event(QEvent *event);
+
+    virtual void
+    paintEvent(QPaintEvent *event);
+
+private:
+
+    struct _Hit
+    {
+        QRectF  rect;
+        QString text;
+    };
+
+    void
+    _drawBar(QPainter &painter, const QRectF &rect, const QColor &color,
+             const QString &name, double ms);
+
+    static QColor
+    _color(const QString &name, int lane);
+
+    static const int _rowHeight = 16;
+    static const int _laneGap = 6;
+
+    QVector<_Hit> _hits;    //!< Bars drawn by last paint, for tool tips.
+};
+
+
+// event
+// -----
+//! Shows the name and duration of the bar under the cursor.
+
+bool
+NsStepProfilerWidget::_Chart::event(QEvent *event)
+{
+    if (QEvent::ToolTip == event->type()) {
+        const QHelpEvent *help(static_cast<QHelpEvent*>(event));
+
+        // Later bars are drawn on top, search them first.
+
+        for (int i = _hits.size() - 1; i >= 0; --i) {
+            if (_hits[i].rect.contains(help->pos())) {
+                QToolTip::showText(help->globalPos(), _hits[i].text);
+                return true;
+            }
+        }
+
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+
+// paintEvent
+// ----------
+//! Lays out the stored steps on a common time axis, from the beginning of
+//! the oldest to the end of the latest range.
+
+void
+NsStepProfilerWidget::_Chart::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    _hits.clear();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    const QList<NsStepProfiler::Step> steps(
+        NsStepProfiler::instance()->steps());
+
+    if (steps.isEmpty()) {
+        painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, tr("No timesteps recorded"));
+        return;
+    }
+
+    // Open ranges extend to the current time.
+
+    const double nowMs(Ns3DProfiler::nowMs());
+    const double t0(steps.first().beginMs);
+    double t1(t0);
+    int maxDepth[NsStepProfiler::LaneCount] = { 0, 0 };
+
+    foreach (const NsStepProfiler::Step &step, steps) {
+        t1 = std::max(t1, 0. <= step.endMs ? step.endMs : nowMs);
+        foreach (const NsStepProfiler::Range &range, step.ranges) {
+            t1 = std::max(t1, 0. <= range.endMs ? range.endMs : nowMs);
+            maxDepth[range.lane] = std::max(maxDepth[range.lane], range.depth);
+        }
+    }
+
+    const double scale(width()/std::max(t1 - t0, 1e-3));    // [pixels/ms]
+
+    // The solver lane starts with a row of timesteps, the GUI lane follows
+    // the deepest solver row.
+
+    const int laneTop[NsStepProfiler::LaneCount] = {
+        _rowHeight,
+        (maxDepth[NsStepProfiler::SolverLane] + 2)*_rowHeight + _laneGap
+    };
+
+    foreach (const NsStepProfiler::Step &step, steps) {
+        const double endMs(0. <= step.endMs ? step.endMs : nowMs);
+        const QRectF stepRect((step.beginMs - t0)*scale,
+                              0,
+                              std::max(1., (endMs - step.beginMs)*scale),
+                              _rowHeight);
+        _drawBar(painter,
+                 stepRect,
+                 palette().color(QPalette::Mid),
+                 tr("Frame %1, step %2").arg(step.frame).arg(step.timestep),
+                 endMs - step.beginMs);
+
+        foreach (const NsStepProfiler::Range &range, step.ranges) {
+            const double rangeEndMs(0. <= range.endMs ? range.endMs : nowMs);
+            const QRectF rangeRect(
+                (range.beginMs - t0)*scale,
+                laneTop[range.lane] + range.depth*_rowHeight,
+                std::max(1., (rangeEndMs - range.beginMs)*scale),
+                _rowHeight);
+            _drawBar(painter,
+                     rangeRect,
+                     _color(range.name, range.lane),
+                     range.name,
+                     rangeEndMs - range.beginMs);
+        }
+    }
+
+    painter.setPen(palette().color(QPalette::Mid));
+    painter.drawLine(0, laneTop[NsStepProfiler::GuiLane] - _laneGap/2,
+                     width(), laneTop[NsStepProfiler::GuiLane] - _laneGap/2);
+}
+
+
+// _drawBar
+// --------
+//! Draws a labelled bar and remembers it for tool tips.
+
+void
+NsStepProfilerWidget::_Chart::_drawBar(QPainter      &painter,
+                                       const QRectF  &rect,
+                                       const QColor  &color,
+                                       const QString &name,
+                                       const double   ms)
+{
+    const QString text(QString("%1 (%2 ms)").arg(name).arg(ms, 0, 'f', 2));
+
+    painter.fillRect(rect, color);
+    painter.setPen(color.darker(130));
+    painter.drawRect(rect);
+
+    if (24. < rect.width()) {
+        const QRectF textRect(rect.adjusted(2, 0, -2, 0));
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(textRect,
+                         Qt::AlignLeft | Qt::AlignVCenter,
+                         fontMetrics().elidedText(text,
+                                                  Qt::ElideRight,
+                                                  int(textRect.width())));
+    }
+
+    _Hit hit;
+    hit.rect = rect;
+    hit.text = text;
+    _hits.append(hit);
+}
+
+
+// _color
+// ------
+//! Returns a colour that stays the same for a name across steps. Solver
+//! ranges get cool colours and GUI ranges warm ones. [static]
+
+QColor
+NsStepProfilerWidget::_Chart::_color(const QString &name, const int lane)
+{
+    const int hue(qHash(name) % 120);
+
+    if (NsStepProfiler::SolverLane == lane) {
+        return QColor::fromHsv(150 + hue, 70, 230);
+    }
+
+    return QColor::fromHsv((330 + hue/2) % 360, 110, 250);
+}
+
+// -----------------------------------------------------------------------------
+
+// NsStepProfilerWidget
+// --------------------
+//! CTOR.
+
+NsStepProfilerWidget::NsStepProfilerWidget(QWidget *parent)
+    : QWidget(parent)
+    , _recordCheckBox(new QCheckBox(tr("Record")))
+    , _maxStepsSpinBox(new QSpinBox)
+    , _summaryLabel(new QLabel)
+    , _chart(new _Chart)
+{
+    NsStepProfiler *profiler(NsStepProfiler::instance());
+
+    _recordCheckBox->setChecked(profiler->isEnabled());
+    _recordCheckBox->setStatusTip(
+        tr("Record solver and GUI time for each timestep"));
+
+    _maxStepsSpinBox->setRange(1, 1000);
+    _maxStepsSpinBox->setValue(profiler->maxSteps());
+    _maxStepsSpinBox->setPrefix(tr("Last "));
+    _maxStepsSpinBox->setSuffix(tr(" timesteps"));
+
+    QPushButton *clearButton(new QPushButton(tr("Clear")));
+    clearButton->setStatusTip(tr("Discard recorded timesteps and totals"));
+
+    _summaryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    QHBoxLayout *controlLayout(new QHBoxLayout);
+    controlLayout->addWidget(_recordCheckBox);
+    controlLayout->addWidget(_maxStepsSpinBox);
+    controlLayout->addWidget(clearButton);
+    controlLayout->addWidget(_summaryLabel, 1);
+
+    QVBoxLayout *layout(new QVBoxLayout);
+    layout->setContentsMargins(2, 2, 2, 2);
+    layout->addLayout(controlLayout);
+    layout->addWidget(_chart, 1);
+    setLayout(layout);  // Takes ownership.
+
+    connect(_recordCheckBox, SIGNAL(toggled(bool)),
+            this,            SLOT(_onRecordToggled(bool)));
+    connect(_maxStepsSpinBox, SIGNAL(valueChanged(int)),
+            this,             SLOT(_onMaxStepsChanged(int)));
+    connect(clearButton, SIGNAL(clicked()),
+            profiler,    SLOT(clear()));
+
+    // The profiler may signal from the solver thread, in which case the
+    // call is queued.
+
+    connect(profiler, SIGNAL(changed()),
+            this,     SLOT(onProfilerChanged()));
+
+    _updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+
+// onProfilerChanged
+// -----------------
+//! [slot]
+
+void
+NsStepProfilerWidget::onProfilerChanged()
+{
+    if (isVisible()) {
+        _updateSummary();
+        _chart->update();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// _onRecordToggled
+// ----------------
+//! [slot]
+
+void
+NsStepProfilerWidget::_onRecordToggled(const bool checked)
+{
+    NsStepProfiler::instance()->setEnabled(checked);
+}
+
+
+// _onMaxStepsChanged
+// ------------------
+//! [slot]
+
+void
+NsStepProfilerWidget::_onMaxStepsChanged(const int maxSteps)
+{
+    NsStepProfiler::instance()->setMaxSteps(maxSteps);
+}
+
+// -----------------------------------------------------------------------------
+
+// _updateSummary
+// --------------
+//! Shows the session totals of both lanes and the most expensive range
+//! of each.
+
+void
+NsStepProfilerWidget::_updateSummary()
+{
+    const NsStepProfiler *profiler(NsStepProfiler::instance());
+
+    QStringList parts;
+    const char* const laneNames[NsStepProfiler::LaneCount] = {
+        "Solver", "Studio"
+    };
+
+    for (int lane = 0; lane < NsStepProfiler::LaneCount; ++lane) {
+        const NsStepProfiler::Lane l(static_cast<NsStepProfiler::Lane>(lane));
+        const NsStepProfiler::TotalHashType totals(profiler->totals(l));
+
+        QString part(tr("%1 %2 ms")
+                         .arg(tr(laneNames[lane]))
+                         .arg(profiler->laneTotalMs(l), 0, 'f', 1));
+
+        NsStepProfiler::TotalHashType::const_iterator slowest(totals.end());
+        NsStepProfiler::TotalHashType::const_iterator iter(totals.begin());
+        for (; iter != totals.end(); ++iter) {
+            if (totals.end() == slowest ||
+                slowest.value().ms < iter.value().ms) {
+                slowest = iter;
+            }
+        }
+
+        if (totals.end() != slowest) {
+            part += tr(" (%1: %2 ms in %3)")
+                        .arg(slowest.key())
+                        .arg(slowest.value().ms, 0, 'f', 1)
+                        .arg(slowest.value().count);
+        }
+
+        parts.append(part);
+    }
+
+    _summaryLabel->setText(tr("Session: ") + parts.join(", "));
+}
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepProfilerWidget.h
+//
+// Naiad Studio stepping profiler widget, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB.  All rights reserved. 
+//
+// This file is part of Open Naiad Studio..
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS_STEP_PROFILER_WIDGET_H
+#define NS_STEP_PROFILER_WIDGET_H
+
+#include "NsStepProfiler.h"
+
+#include <QWidget>
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+QT_END_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+// NsStepProfilerWidget
+// --------------------
+//! Shows the timesteps held by NsStepProfiler as a flame chart on a common
+//! time axis, the solver lane above the GUI lane, together with the session
+//! totals of both lanes.
+
+class NsStepProfilerWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+
+    explicit
+    NsStepProfilerWidget(QWidget *parent = 0);
+
+    //! DTOR.
+    virtual
+    ~NsStepProfilerWidget()
+    {}
+
+protected slots:
+
+    void
+    onProfilerChanged();
+
+private slots:
+
+    void
+    _onRecordToggled(bool checked);
+
+    void
+    _onMaxStepsChanged(int maxSteps);
+
+private:
+
+    class _Chart;
+
+    void
+    _updateSummary();
+
+private:    // Member variables.
+
+    QCheckBox *_recordCheckBox;
+    QSpinBox  *_maxStepsSpinBox;
+    QLabel    *_summaryLabel;
+    _Chart    *_chart;
+};
+
+#endif // NS_STEP_PROFILER_WIDGET_H
@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepThread.cc
+//
+// Naiad Studio solver thread, source file.
+//
+// Copyright (c) 2011 Exotic Matter AB. All rights reserved.
+//
+// This file is part of Open Naiad Studio.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#include "NsStepThread.h"
+#include "NsGraphCallback.h"
+#include <NiStep.h>
+#include <QCoreApplication>
+
+// -----------------------------------------------------------------------------
+
+// NsStepThread
+// ------------
+//! CTOR.
+
+NsStepThread::NsStepThread(QObject *parent)
+    : QThread(parent)
+    , _mode(_StepTo)
+    , _frame(0)
+    , _visible(false)
+{}
+
+
+// ~NsStepThread
+// -------------
+//! DTOR. Stops stepping and waits for the solver thread to finish.
+
+NsStepThread::~NsStepThread()
+{
+    stop();
+
+    // The solver may be blocked waiting for the GUI thread, keep processing
+    // events until it has finished.
+
+    while (!wait(10)) {
+        QCoreApplication::processEvents();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// stepTo
+// ------
+//! Starts stepping to the given frame. Returns false if a step is already in
+//! progress.
+
+bool
+NsStepThread::stepTo(const int frame, const bool visible)
+{
+    return _start(_StepTo, frame, visible);
+}
+
+
+// restep
+// ------
+//! Starts re-stepping the current frame. Returns false if a step is already
+//! in progress.
+
+bool
+NsStepThread::restep()
+{
+    return _start(_Restep, 0, false);
+}
+
+
+// stop
+// ----
+//! Requests the current step to stop. Stepping stops at the next point where
+//! the graph callback is allowed to abort the solve.
+
+void
+NsStepThread::stop()
+{
+    if (isRunning()) {
+        NsGraphCallback::instance()->setSteppingStopped(true);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// run
+// ---
+//! Performs the requested step. Runs on the solver thread, holding the NI
+//! lock except while inside graph callbacks.
+
+void
+NsStepThread::run()
+{
+    {
+        const NsGraphCallback::NiLocker locker;
+
+        switch (_mode) {
+        case _StepTo:
+            NiStepTo(_frame, (_visible ? NI_TRUE : NI_FALSE));
+            break;
+        case _Restep:
+            NiRestep();
+            break;
+        }
+    }
+
+    NsGraphCallback::instance()->setSolverStepping(false);
+}
+
+// -----------------------------------------------------------------------------
+
+// _start
+// ------
+//! Starts the solver thread unless it is already running.
+
+bool
+NsStepThread::_start(const _Mode mode, const int frame, const bool visible)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    _mode = mode;
+    _frame = frame;
+    _visible = visible;
+    NsGraphCallback::instance()->setSteppingStopped(false);
+    NsGraphCallback::instance()->setSolverStepping(true);
+    start();
+    return true;
+}
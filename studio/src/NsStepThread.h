@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+//
+// NsStepThread.h
+//
+// Naiad Studio solver thread, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB. All rights reserved.
+//
+// This file is part of Open Naiad Studio.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS_STEP_THREAD_H
+#define NS_STEP_THREAD_H
+
+#include <QThread>
+
+// -----------------------------------------------------------------------------
+
+// NsStepThread
+// ------------
+//! Runs graph stepping on a dedicated solver thread, so that the GUI stays 
+//! responsive while a frame solves. Progress is reported through the 
+//! NsGraphCallback signals, which are delivered on the GUI thread. Stepping
+//! is cancelled through NsGraphCallback::setSteppingStopped().
+//!
+//! Only one step may be in progress at a time. The step actions are disabled
+//! between the beginStep and endStep signals. Other NI calls made by the GUI
+//! while stepping are serialized with the solver through the NI lock, see
+//! NsGraphCallback::NiLocker.
+
+class NsStepThread : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    explicit
+    NsStepThread(QObject *parent = 0);
+
+    virtual
+    ~NsStepThread();
+
+public:
+
+    bool
+    stepTo(int frame, bool visible = false);
+
+    bool
+    restep();
+
+    void
+    stop();
+
+protected:
+
+    virtual void
+    run();
+
+private:
+
+    //! Type of step to perform.
+    enum _Mode {
+        _StepTo = 0,
+        _Restep
+    };
+
+    bool
+    _start(_Mode mode, int frame, bool visible);
+
+private:    // Member variables.
+
+    _Mode _mode;    //!< Type of step to perform.
+    int   _frame;   //!< Target frame, when stepping to a frame.
+    bool  _visible; //!< Step visible frame flag.
+
+private:
+
+    NsStepThread(const NsStepThread&);              //!< Disabled.
+    NsStepThread& operator=(const NsStepThread&);   //!< Disabled.
+};
+
+#endif // NS_STEP_THREAD_H
@@ -41,6 +41,7 @@
 #include "NsTimeSlider.h"
 #include "NsTimeAction.h"
 #include "NsQuery.h"
+#include "NsGraphCallback.h"
 
 // -----------------------------------------------------------------------------
 
@@ -365,10 +366,15 @@ NsTimeSlider::_onActionTriggered(const int action)
 // -----------------------------------------------------------------------------
 
 //! Start playing forward from the current frame with the given interval.
+//! Playback is not started while stepping, see NsTimeToolBar.
 
 void
 NsTimeSlider::_playFwd(const int thresholdTime)
 {
+    if (NsGraphCallback::solverStepping()) {
+        return;
+    }
+
     setRepeatAction(SliderSingleStepAdd,
                     thresholdTime,
                     _playRepeatTime());
@@ -377,10 +383,15 @@ NsTimeSlider::_playFwd(const int thresholdTime)
 
 
 //! Start playing backward from the current frame with the given interval.
+//! Playback is not started while stepping, see NsTimeToolBar.
 
 void
 NsTimeSlider::_playBwd(const int thresholdTime)
 {
+    if (NsGraphCallback::solverStepping()) {
+        return;
+    }
+
     setRepeatAction(SliderSingleStepSub,
                     thresholdTime,
                     _playRepeatTime()); // Repeat time.
@@ -146,6 +146,10 @@ public slots:
     setLastVisibleFrame()
     { triggerAction(SliderToMaximum); }
 
+    void
+    stop()
+    { _stop(); }
+
 protected slots:
 
     void
@@ -44,6 +44,7 @@
 #include "NsTimeToolBar.h"
 #include "NsTimeAction.h"
 #include "NsGraphCallback.h"
+#include "NsStepThread.h"
 #include "NsCmdCentral.h"
 #include "NsCmdSetCurrentVisibleFrame.h"
 #include "NsCmdSetFirstVisibleFrame.h"
@@ -144,6 +145,7 @@ NsTimeToolBar::NsTimeToolBar(QAction     *naiadAction,
           //    QKeySequence(Qt::Key_Escape),
           //    false,
           //    this))
+    , _stepThread(new NsStepThread(this)) // Child.
 {
 
     {
@@ -354,6 +356,15 @@ NsTimeToolBar::NsTimeToolBar(QAction     *naiadAction,
     connect(NsGraphCallback::instance(), SIGNAL(endStep(NtTimeBundle)),
             _stopAction,                 SLOT(onEndStep(NtTimeBundle)));
 
+    connect(_stepThread, SIGNAL(finished()),
+            this,        SLOT(update()));
+
+    // Playback changes the current visible frame from a timer, which would
+    // call NI outside of the NI lock while stepping.
+
+    connect(NsGraphCallback::instance(), SIGNAL(beginStep(NtTimeBundle)),
+            _timeSlider,                 SLOT(stop()));
+
 
     // Add widgets to tool bar.
 
@@ -522,6 +533,11 @@ NsTimeToolBar::_reset(const bool force)
 {
     // TODO: eval time == 0?
 
+    if (_stepThread->isRunning()) {
+        return;
+    }
+
+    const NsGraphCallback::NiLocker locker;
     if (NI_TRUE == NiReset(evalParam1i("Global.First Frame"), force)) {
         qDebug() << "reset";
 
@@ -570,8 +586,7 @@ NsTimeToolBar::_stepToLast()
 {
     qDebug() << "step to";
 
-    NsGraphCallback::instance()->setSteppingStopped(false);
-    NiStepTo(evalParam1i("Global.Last Frame"));
+    _stepThread->stepTo(evalParam1i("Global.Last Frame"));
     update();
 }
 
@@ -583,7 +598,11 @@ NsTimeToolBar::_stepToLast()
 void
 NsTimeToolBar::_stepSingle()
 {
-    const NtTimeBundle cstb0(NiQueryTimeBundle());
+    if (_stepThread->isRunning()) {
+        return;
+    }
+
+    const NtTimeBundle cstb0(queryTimeBundle());
 #if 0
     qDebug() << "Pre Server:" << cstb0.frame << "|" << cstb0.timestep;
     qDebug() << "Pre Client:" << _frameSlider->currentFrame() << "|" << 0;
@@ -592,8 +611,7 @@ NsTimeToolBar::_stepSingle()
 
     qDebug() << "step frame:" << cstb0.frame + 1;
 
-    NsGraphCallback::instance()->setSteppingStopped(false);
-    NiStepTo(cstb0.frame + 1);
+    _stepThread->stepTo(cstb0.frame + 1);
     update();
 
 #if 0
@@ -621,8 +639,7 @@ NsTimeToolBar::_restep()
 
     qDebug() << "restep";
 
-    NsGraphCallback::instance()->setSteppingStopped(false);
-    NiRestep();
+    _stepThread->restep();
     update();
 
 #if 0
@@ -644,12 +661,12 @@ NsTimeToolBar::_stepVisible(const bool force)
     // TODO: eval time == 0?
 
     int cvf(0);
-    if (queryCurrentVisibleFrame(&cvf)) {
+    if (!_stepThread->isRunning() && queryCurrentVisibleFrame(&cvf)) {
+        const NsGraphCallback::NiLocker locker;
         if (NI_TRUE == NiReset(cvf, force)) {
             NsCmdSelectAll::exec(false);
 
-            NsGraphCallback::instance()->setSteppingStopped(false);
-            NiStepTo(cvf, NI_TRUE);
+            _stepThread->stepTo(cvf, true);
             update();
         }
     }
@@ -662,7 +679,7 @@ NsTimeToolBar::_stopStepping()
     if (!NsGraphCallback::instance()->steppingStopped()) {
         // TODO: Use time toolbar actions to stop solve!
 
-        NsGraphCallback::instance()->setSteppingStopped(true);
+        _stepThread->stop();
         update();
     }
 }
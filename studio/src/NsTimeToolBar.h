@@ -46,6 +46,7 @@
 
 class NsUndoStack;
 class NsTimeSlider;
+class NsStepThread;
 
 // -----------------------------------------------------------------------------
 
@@ -236,6 +237,7 @@ private:    // Member variables.
     NsStepAction *_stepVisibleAction;       //!< Step visible action.
     NsStepAction *_stopAction;
 
+    NsStepThread *_stepThread;  //!< Runs the solver off the GUI thread.
 };
 
 // -----------------------------------------------------------------------------
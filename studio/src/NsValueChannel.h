@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------
+//
+// NsValueChannel.h
+//
+// Naiad Studio per-value notification channel, header file.
+//
+// Copyright (c) 2011 Exotic Matter AB. All rights reserved.
+//
+// This file is part of Open Naiad Studio.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of Exotic Matter AB nor its contributors may be used to
+// endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef NS_VALUE_CHANNEL_H
+#define NS_VALUE_CHANNEL_H
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+
+class NsOpObject;
+
+// -----------------------------------------------------------------------------
+
+// NsValueChannel
+// --------------
+//! Notification channel for a single value long name. Obtained from
+//! NsCmdCentral::valueChannel(), which only emits on the channel of the
+//! value that actually changed. Ops registered on the channel, i.e. the
+//! owner of the value and Ops the value affects, are notified once per
+//! value batch rather than per component.
+
+class NsValueChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    //! CTOR.
+    explicit
+    NsValueChannel(QObject *parent = 0)
+        : QObject(parent)
+    {}
+
+    //! DTOR.
+    virtual
+    ~NsValueChannel()
+    {}
+
+    const QSet<NsOpObject*>&
+    ops() const
+    { return _ops; }
+
+    void
+    addOp(NsOpObject *op)
+    { _ops.insert(op); }
+
+    void
+    removeOp(NsOpObject *op)
+    { _ops.remove(op); }
+
+    void
+    emitValueChanged(const QString &valueLongName,
+                     const QString &expr,
+                     const int      comp,
+                     const bool     success)
+    { emit valueChanged(valueLongName, expr, comp, success); }
+
+signals:
+
+    //! Signal emitted when the value of this channel has changed.
+    void
+    valueChanged(const QString &valueLongName,
+                 const QString &expr,
+                 int            comp,
+                 bool           success);
+
+private:    // Member variables.
+
+    QSet<NsOpObject*> _ops;     //!< Registered Ops.
+};
+
+// -----------------------------------------------------------------------------
+
+#endif // NS_VALUE_CHANNEL_H
@@ -209,6 +209,7 @@ NsValueEditorWidget::onGraphCleared(const bool success)
     qDebug() << "NsValueEditorWidget::onGraphCleared";
     if (success) {
         _clear();
+        _clearRecycledBoxes();
     }
 }
 
@@ -220,7 +221,7 @@ NsValueEditorWidget::onGraphCleared(const bool success)
 void
 NsValueEditorWidget::onValueObjectDestroyed(NsValueObject *vo)
 {
-    _removeValueObjectBox(vo);
+    _destroyValueObjectBox(vo);
 }
 
 // -----------------------------------------------------------------------------
@@ -239,8 +240,8 @@ NsValueEditorWidget::_createValueObjectBox<NsBodyObject>(NsBodyObject *body)
 
 // _removeValueObjectBox
 // ---------------------
-//! Remove all value object boxes whose name matches the provided long name,
-//! there should be max one.
+//! Stop showing the box of the given value object, if shown. The box is
+//! kept for reuse.
 
 void
 NsValueEditorWidget::_removeValueObjectBox(NsValueObject *vo)
@@ -249,21 +250,86 @@ NsValueEditorWidget::_removeValueObjectBox(NsValueObject *vo)
         _valueObjectBoxes.find(vo->handle());
 
     if (_valueObjectBoxes.end() != iter) {
-        delete iter.value();            // Remove box.
+        _recycleBox(iter.key(), iter.value());
         _valueObjectBoxes.erase(iter);  // Remove association.
     }
 }
 
 
+// _destroyValueObjectBox
+// ----------------------
+//! Delete the box of the given value object, whether shown or recycled.
+
+void
+NsValueEditorWidget::_destroyValueObjectBox(NsValueObject *vo)
+{
+    delete _valueObjectBoxes.take(vo->handle());
+    delete _takeRecycledBox(vo->handle());
+}
+
+
 // _clear
 // ------
-//! DOCS
+//! Stop showing all boxes. The boxes are kept for reuse.
 
 void
 NsValueEditorWidget::_clear()
 {
-    foreach (NsValueObjectBox *vob, _valueObjectBoxes) {
-        delete vob;             // Remove boxes.
+    _ValueObjectBoxHashType::iterator iter = _valueObjectBoxes.begin();
+    for (; iter != _valueObjectBoxes.end(); ++iter) {
+        _recycleBox(iter.key(), iter.value());
     }
     _valueObjectBoxes.clear();  // Remove associations.
 }
+
+// -----------------------------------------------------------------------------
+
+// _recycleBox
+// -----------
+//! Hide a box and keep it for reuse, deleting the least recently used
+//! recycled box if there are too many.
+
+void
+NsValueEditorWidget::_recycleBox(const NsValueObjectHandle &handle,
+                                 NsValueObjectBox          *vob)
+{
+    _layout->removeWidget(vob);
+    vob->hide();
+    _recycledBoxes.insert(handle, vob);
+    _recycleOrder.append(handle);
+
+    while (_recycleOrder.size() > _maxRecycledBoxes) {
+        delete _recycledBoxes.take(_recycleOrder.takeFirst());
+    }
+}
+
+
+// _takeRecycledBox
+// ----------------
+//! Returns the recycled box of the given value object, now owned by the
+//! caller, or null if there is none.
+
+NsValueObjectBox*
+NsValueEditorWidget::_takeRecycledBox(const NsValueObjectHandle &handle)
+{
+    NsValueObjectBox *vob = _recycledBoxes.take(handle);
+    if (0 != vob) {
+        _recycleOrder.removeOne(handle);
+    }
+    return vob;
+}
+
+
+// _clearRecycledBoxes
+// -------------------
+//! Delete all recycled boxes.
+
+void
+NsValueEditorWidget::_clearRecycledBoxes()
+{
+    foreach (NsValueObjectBox *vob, _recycledBoxes) {
+        delete vob;
+    }
+    _recycledBoxes.clear();
+    _recycleOrder.clear();
+}
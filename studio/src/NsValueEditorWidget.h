@@ -46,6 +46,7 @@
 #include <QVBoxLayout>
 #include <QWidget>
 #include <QHash>
+#include <QList>
 #include <QString>
 
 class NsUndoStack;
@@ -109,18 +110,24 @@ private:
     NsValueObjectBox*
     _createValueObjectBox(V *vo);
 
-    //! Insert a value object box and setup necessary structures.
+    //! Insert a value object box and setup necessary structures. A box
+    //! recently shown for the same value object is reused if available.
     template<class V>
     void
     _insertValueObjectBox(V *vo)
     { 
         if (!_valueObjectBoxes.contains(vo->handle())) {
-            // Make sure box is removed when value object is destroyed.
-
-            NsValueObjectBox *vob = _createValueObjectBox(vo);
-            connect(vo,   SIGNAL(valueObjectDestroyed(NsValueObject*)),
-                    this, SLOT(onValueObjectDestroyed(NsValueObject*)));
+            NsValueObjectBox *vob = _takeRecycledBox(vo->handle());
+            if (0 == vob) {
+                // Make sure box is removed when value object is destroyed.
+
+                vob = _createValueObjectBox(vo);
+                connect(vo,   SIGNAL(valueObjectDestroyed(NsValueObject*)),
+                        this, SLOT(onValueObjectDestroyed(NsValueObject*)),
+                        Qt::UniqueConnection);
+            }
             _layout->insertWidget(_layout->count() - 1, vob);
+            vob->show();
             _valueObjectBoxes.insert(vo->handle(), vob);
         }
     }
@@ -128,15 +135,37 @@ private:
     void
     _removeValueObjectBox(NsValueObject *vo);
 
+    void
+    _destroyValueObjectBox(NsValueObject *vo);
+
     void
     _clear();
 
+private:    // Recycled boxes.
+
+    void
+    _recycleBox(const NsValueObjectHandle &handle, NsValueObjectBox *vob);
+
+    NsValueObjectBox*
+    _takeRecycledBox(const NsValueObjectHandle &handle);
+
+    void
+    _clearRecycledBoxes();
+
 private:    // Member variables.
 
     typedef QHash<NsValueObjectHandle,NsValueObjectBox*>
         _ValueObjectBoxHashType;
     _ValueObjectBoxHashType _valueObjectBoxes;
 
+    // Boxes no longer shown are hidden and kept, most recently used last,
+    // so that selecting the same value objects again does not rebuild
+    // their widgets. At most _maxRecycledBoxes are kept.
+
+    _ValueObjectBoxHashType     _recycledBoxes;
+    QList<NsValueObjectHandle>  _recycleOrder;
+    static const int            _maxRecycledBoxes = 8;
+
     NsUndoStack *_undoStack;  //!< May be null.
     QVBoxLayout *_layout;     //!< The widget's layout.
 };
@@ -41,6 +41,7 @@
 #include "NsValueSectionBox.h"
 #include "NsValueObjectBox.h"
 #include "NsValueSectionObject.h"
+#include <QVBoxLayout>
 
 // -----------------------------------------------------------------------------
 
@@ -59,6 +60,59 @@ NsValueSectionBox::~NsValueSectionBox()
 NsValueSectionBox::NsValueSectionBox(const NsValueSectionObject &vso,
                                      NsValueObjectBox           &parent)
     : NsGroupBox(vso.name(), &parent)
+    , _vso(vso)
+    , _populated(false)
+    , _populatePending(false)
 {
     setFocusPolicy(Qt::NoFocus);
+    setLayout(new QVBoxLayout); // Pass ownership of layout to box.
+
+    connect(this, SIGNAL(toggled(bool)), SLOT(_onToggled(bool)));
+}
+
+
+// paintEvent
+// ----------
+//! Schedule building the section contents the first time the box is
+//! painted expanded. Boxes outside the visible part of a scroll area are
+//! not painted, and so not built until scrolled into view. Building is
+//! queued since adding widgets while painting is not allowed.
+
+void
+NsValueSectionBox::paintEvent(QPaintEvent *event)
+{
+    NsGroupBox::paintEvent(event);
+
+    if (isChecked() && !_populated && !_populatePending) {
+        _populatePending = true;
+        QMetaObject::invokeMethod(this, "_populate", Qt::QueuedConnection);
+    }
+}
+
+
+// _onToggled
+// ----------
+//! Build the section contents the first time the box is expanded. [slot]
+
+void
+NsValueSectionBox::_onToggled(const bool on)
+{
+    if (on && isVisible()) {
+        _populate();
+    }
+}
+
+
+// _populate
+// ---------
+//! Create the section contents, unless already done. [slot]
+
+void
+NsValueSectionBox::_populate()
+{
+    _populatePending = false;
+    if (!_populated) {
+        _populated = true;
+        populate(qobject_cast<QVBoxLayout*>(layout()));
+    }
 }
@@ -45,6 +45,8 @@
 
 class NsValueObjectBox;
 class NsValueSectionObject;
+class QPaintEvent;
+class QVBoxLayout;
 
 // -----------------------------------------------------------------------------
 
@@ -52,6 +54,11 @@ class NsValueSectionObject;
 // -----------------
 //! The NsValueSectionBox class, representing a collapsible group box in
 //! which the values for a specific section can be edited.
+//!
+//! The value widgets are not created with the box, but the first time the
+//! box is painted expanded, i.e. when it enters the visible part of the
+//! editor, so that collapsed, hidden or scrolled out sections cost nothing
+//! to build.
 
 class NsValueSectionBox : public NsGroupBox
 {
@@ -65,6 +72,32 @@ protected:
 
     explicit NsValueSectionBox(const NsValueSectionObject &vso,
                                NsValueObjectBox           &parent);
+
+    const NsValueSectionObject&
+    section() const
+    { return _vso; }
+
+    //! Add the value widgets of the section to the given layout. Called
+    //! once, the first time the box is painted expanded.
+    virtual void
+    populate(QVBoxLayout *layout) = 0;
+
+    virtual void
+    paintEvent(QPaintEvent *event);
+
+private slots:
+
+    void
+    _onToggled(bool on);
+
+    void
+    _populate();
+
+private:    // Member variables.
+
+    const NsValueSectionObject &_vso;
+    bool                        _populated;
+    bool                        _populatePending;
 };
 
 #endif // NS_VALUE_SECTION_BOX_H